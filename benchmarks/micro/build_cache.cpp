@@ -0,0 +1,117 @@
+// benchmarks/micro/build_cache.cpp
+// Coût du cache de compilation `native/build_cache.cpp` sur un arbre de `--modules` modules :
+// build à froid (clé + miss + écriture de chaque image), rebuild sans changement (clé +
+// hit), rebuild incrémental (un module modifié), et débit du hachage des sources (SHA-256).
+// Ce que coûte la compilation elle-même n’est pas mesuré : c’est ce que le hit évite.
+// Les sources : `--kib` Kio de texte par module, images de taille double (pseudo-VITBC).
+// Cache dans un répertoire temporaire supprimé en fin de mesure.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -msha -msse4.1 -Inative benchmarks/micro/build_cache.cpp native/build_cache.cpp
+//       -pthread -o build/bench_build_cache
+//   ./build/bench_build_cache [--modules 35] [--kib 16] [--runs 5]
+
+#include "build_cache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+static const char* const OPTIONS = "opt=O2;debug=line;warnings=warn;dedup_consts=1;strip_debug=0";
+static const char* const VERSION = "vitc 0.1.0";
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+struct Module {
+    std::string src;
+    std::vector<uint8_t> image;
+};
+
+// Un « build » : clé de chaque module, hit ou compilation simulée (l’image) + écriture.
+static double build(vt_bcache* c, const std::vector<Module>& mods, size_t& hits) {
+    const auto t0 = std::chrono::steady_clock::now();
+    hits = 0;
+    for (const Module& m : mods) {
+        vt_bcache_key k;
+        vt_bcache_key_make(m.src.data(), m.src.size(), OPTIONS, VERSION, &k);
+        vt_bcache_blob b{};
+        const int r = vt_bcache_get(c, &k, &b);
+        if (r == 1) {
+            ++hits;
+            vt_bcache_blob_free(&b);
+        } else if (r < 0 || vt_bcache_put(c, &k, m.image.data(), m.image.size()) != 0) {
+            std::fprintf(stderr, "cache : %s\n", std::strerror(r < 0 ? -r : errno));
+            std::exit(1);
+        }
+    }
+    return seconds_since(t0);
+}
+
+int main(int argc, char** argv) {
+    size_t nmods = 35, kib = 16;
+    int runs = 5;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--modules") && i + 1 < argc) nmods = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--kib") && i + 1 < argc) kib = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) runs = std::max(1, std::atoi(argv[++i]));
+    }
+    std::mt19937 g(5);
+    std::vector<Module> mods(nmods);
+    for (Module& m : mods) {
+        m.src.resize(kib * 1024);
+        for (char& ch : m.src) ch = static_cast<char>('a' + g() % 26);
+        m.image.resize(2 * m.src.size());
+        for (uint8_t& b : m.image) b = static_cast<uint8_t>(g());
+    }
+
+    char tmpl[] = "/tmp/vt-bcache-XXXXXX";
+    if (!::mkdtemp(tmpl)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    vt_bcache_config cfg;
+    vt_bcache_config_default(&cfg);
+    cfg.dir = tmpl;
+    vt_bcache* c = vt_bcache_open(&cfg);
+    if (!c) {
+        std::perror("vt_bcache_open");
+        return 1;
+    }
+
+    size_t hits = 0;
+    const double cold = build(c, mods, hits);
+    double warm = 1e30, incr = 1e30;
+    for (int r = 0; r < runs; ++r) warm = std::min(warm, build(c, mods, hits));
+    for (int r = 0; r < runs; ++r) {
+        mods[r % nmods].src[0] = static_cast<char>('A' + r);   // nouvelle clé, donc miss
+        incr = std::min(incr, build(c, mods, hits));
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    vt_bcache_key k;
+    for (int r = 0; r < 64; ++r) vt_bcache_key_make(mods[0].src.data(), mods[0].src.size(), OPTIONS, VERSION, &k);
+    const double sha = seconds_since(t0) / 64;
+
+    std::printf("%zu modules de %zu Kio (images %zu Kio)\n", nmods, kib, 2 * kib);
+    std::printf("%-24s %8.3f ms\n", "build à froid", cold * 1e3);
+    std::printf("%-24s %8.3f ms  (%.1f µs/module)\n", "rebuild sans changement", warm * 1e3, warm * 1e6 / nmods);
+    std::printf("%-24s %8.3f ms  (%zu hits)\n", "rebuild, 1 module", incr * 1e3, hits);
+    std::printf("%-24s %8.0f Mo/s\n", "SHA-256 des sources", kib * 1024 / sha / 1e6);
+    char line[256];
+    vt_bcache_format_stats(c, line, sizeof line);
+    std::printf("%s\n", line);
+    vt_bcache_close(c);
+    std::error_code ec;
+    std::filesystem::remove_all(tmpl, ec);
+    return 0;
+}
@@ -0,0 +1,90 @@
+// benchmarks/micro/fs_atomic_check.cpp
+// Vérification de `native/fs_atomic.cpp` sur les écritures remplacées dans un lot : deux
+// soumissions du même chemin regroupées (max_delay_us) ; la première, jamais matérialisée,
+// doit recevoir le résultat de la seconde. Cas : succès, répertoire absent (échec à
+// l’ouverture), cible qui est un répertoire (échec à la publication) et, hors root,
+// répertoire en lecture seule (échec à la création du temporaire). Code de sortie non nul
+// au moindre écart.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/fs_atomic_check.cpp native/fs_atomic.cpp
+//       -pthread -o build/check_fs_atomic
+//   ./build/check_fs_atomic [--dir /tmp]
+
+#include "fs_atomic.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+static int failures = 0;
+
+// Deux écritures du même chemin dans un lot ; rend les deux résultats.
+static void pair(vt_fsa* s, const std::string& path, int& first, int& second) {
+    const uint64_t a = vt_fsa_submit(s, path.c_str(), "old", 3, nullptr, nullptr);
+    const uint64_t b = vt_fsa_submit(s, path.c_str(), "new", 3, nullptr, nullptr);
+    first = a ? vt_fsa_wait(s, a) : -errno;
+    second = b ? vt_fsa_wait(s, b) : -errno;
+}
+
+static void expect(const char* name, vt_fsa* s, const std::string& path, bool want_ok) {
+    vt_fsa_stats before{}, after{};
+    vt_fsa_get_stats(s, &before);
+    int first = 0, second = 0;
+    pair(s, path, first, second);
+    vt_fsa_get_stats(s, &after);
+    const bool batched = after.superseded == before.superseded + 1;
+    const bool ok = batched && first == second && (second == 0) == want_ok;
+    std::printf("%-28s %s  (remplacée %d, gagnante %d%s)\n", name, ok ? "ok  " : "ÉCHEC", first, second,
+                batched ? "" : ", pas dans le même lot");
+    if (!ok) ++failures;
+}
+
+int main(int argc, char** argv) {
+    std::string base = "/tmp";
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--dir") && i + 1 < argc) base = argv[++i];
+    }
+    std::string root = base + "/vt-fsa-check-XXXXXX";
+    if (!::mkdtemp(root.data())) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    vt_fsa_config cfg;
+    vt_fsa_config_default(&cfg);
+    cfg.max_delay_us = 200000;   // les deux soumissions tombent dans le même lot
+    vt_fsa* s = vt_fsa_open(&cfg);
+
+    expect("succès", s, root + "/f", true);
+    if (std::FILE* f = std::fopen((root + "/f").c_str(), "rb")) {
+        char buf[8] = {};
+        const size_t n = std::fread(buf, 1, sizeof buf, f);
+        std::fclose(f);
+        if (n != 3 || std::memcmp(buf, "new", 3) != 0) {
+            std::printf("succès : contenu inattendu\n");
+            ++failures;
+        }
+    }
+    expect("répertoire absent", s, root + "/absent/f", false);
+    ::mkdir((root + "/dir").c_str(), 0755);
+    expect("cible répertoire", s, root + "/dir", false);
+    if (::geteuid() != 0) {
+        ::mkdir((root + "/ro").c_str(), 0555);
+        expect("répertoire en lecture seule", s, root + "/ro/f", false);
+    } else {
+        std::printf("%-28s ignoré (root)\n", "répertoire en lecture seule");
+    }
+
+    vt_fsa_close(s);
+    std::error_code ec;
+    std::filesystem::permissions(root + "/ro", std::filesystem::perms::owner_all, ec);
+    std::filesystem::remove_all(root, ec);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+// benchmarks/micro/http_client_check.cpp
+// Vérification du parsing de réponse de `native/http_client.cpp` contre un serveur loopback
+// scripté (réponses brutes, une connexion par cas). Cas : 1xx intermédiaire(s) suivi(s)
+// d’une 200 à Content-Length, d’une 200 chunked et d’une 200 délimitée par la fermeture ;
+// la tête intermédiaire ne doit rien laisser (cadrage, keep-alive) à la réponse finale.
+// Code de sortie non nul au moindre écart.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/http_client_check.cpp native/http_client.cpp
+//       -pthread -o build/check_http_client
+//   ./build/check_http_client
+
+#include "http_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+// Accepte une connexion, lit la tête de requête et écrit `reply`. Sans `close_after`, la
+// connexion reste ouverte jusqu’à ce que le client la ferme : une réponse mal cadrée attend
+// alors des octets qui ne viendront pas, au lieu d’être sauvée par la fermeture.
+static void serve_once(int lfd, std::string reply, bool close_after) {
+    const int fd = ::accept(lfd, nullptr, nullptr);
+    if (fd < 0) return;
+    std::string in;
+    char buf[4096];
+    while (in.find("\r\n\r\n") == std::string::npos) {
+        const ssize_t r = ::recv(fd, buf, sizeof buf, 0);
+        if (r <= 0) break;
+        in.append(buf, static_cast<size_t>(r));
+    }
+    size_t off = 0;
+    while (off < reply.size()) {
+        const ssize_t w = ::send(fd, reply.data() + off, reply.size() - off, MSG_NOSIGNAL);
+        if (w <= 0) break;
+        off += static_cast<size_t>(w);
+    }
+    while (!close_after && ::recv(fd, buf, sizeof buf, 0) > 0) {}
+    ::close(fd);
+}
+
+static void expect(const char* name, int lfd, uint16_t port, const std::string& reply, bool close_after,
+                   int want_status, const char* want_body) {
+    vt_httpc_config cfg;
+    vt_httpc_config_default(&cfg);
+    cfg.request_timeout_ms = 2000;
+    vt_httpc* c = vt_httpc_new(&cfg);
+    std::thread srv(serve_once, lfd, reply, close_after);
+    static const char kHead[] = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: keep-alive\r\n\r\n";
+    vt_httpc_request req{};
+    req.host = "127.0.0.1";
+    req.port = port;
+    req.head = kHead;
+    req.head_len = sizeof(kHead) - 1;
+    vt_httpc_response out{};
+    vt_httpc_send_batch(c, &req, &out, 1);
+    vt_httpc_free(c);   // ferme la connexion rendue au pool : le serveur peut finir
+    srv.join();
+    const std::string body(reinterpret_cast<const char*>(out.body), out.body ? out.body_len : 0);
+    const bool ok = out.error == 0 && out.status == want_status && body == want_body;
+    std::printf("%-26s %s  (err %d, status %d, corps %zu o)\n", name, ok ? "ok  " : "ÉCHEC", out.error, out.status,
+                body.size());
+    if (!ok) ++failures;
+    vt_httpc_response_free(&out);
+}
+
+int main() {
+    const int lfd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof addr;
+    if (lfd < 0 || ::bind(lfd, reinterpret_cast<sockaddr*>(&addr), len) != 0 || ::listen(lfd, 8) != 0 ||
+        ::getsockname(lfd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        std::perror("listen");
+        return 1;
+    }
+    const uint16_t port = ntohs(addr.sin_port);
+
+    expect("200 seule", lfd, port, "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\npong", false, 200, "pong");
+    expect("100 puis 200 (longueur)", lfd, port,
+           "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\npong", false, 200, "pong");
+    expect("100, 102 puis 200", lfd, port,
+           "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 102 Processing\r\n\r\n"
+           "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello",
+           false, 200, "hello");
+    expect("100 puis 200 chunked", lfd, port,
+           "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+           "2\r\npo\r\n2\r\nng\r\n0\r\n\r\n",
+           false, 200, "pong");
+    expect("100 puis 200 sans longueur", lfd, port,
+           "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 200 OK\r\nConnection: close\r\n\r\npong", true, 200, "pong");
+
+    ::close(lfd);
+    return failures ? 1 : 0;
+}
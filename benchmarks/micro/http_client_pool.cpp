@@ -0,0 +1,118 @@
+// benchmarks/micro/http_client_pool.cpp
+// Bench loopback du transport client natif : connexion neuve par requête (comportement
+// historique de `Client::send`) vs pool keep-alive, en séquentiel puis par lots concurrents.
+// Le serveur de substitution est le moteur natif `native/http_server.cpp` sur 127.0.0.1.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/http_client_pool.cpp
+//       native/http_client.cpp native/http_server.cpp -pthread -o build/bench_http_client_pool
+//   ./build/bench_http_client_pool [requêtes=20000] [lot=64]
+
+#include "http_client.h"
+#include "http_server.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void on_batch(void*, vt_http_batch* b) {
+    static const char kHeaders[] = "content-type: text/plain\r\n";
+    static const char kBody[] = "pong";
+    for (size_t i = 0; i < vt_http_batch_len(b); ++i) {
+        vt_http_batch_respond(b, i, 200, kHeaders, sizeof(kHeaders) - 1,
+                              reinterpret_cast<const uint8_t*>(kBody), sizeof(kBody) - 1);
+    }
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void report(const char* name, size_t n, double s, vt_httpc* c) {
+    vt_httpc_stats st{};
+    vt_httpc_get_stats(c, &st);
+    std::printf("%-28s %8zu req  %8.3f s  %10.0f req/s  connects=%llu reuses=%llu\n", name, n, s,
+                static_cast<double>(n) / s, static_cast<unsigned long long>(st.connects),
+                static_cast<unsigned long long>(st.reuses));
+}
+
+int main(int argc, char** argv) {
+    const size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const size_t lot = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    vt_http_config scfg;
+    vt_http_config_default(&scfg);
+    scfg.host = "127.0.0.1";
+    scfg.port = 18181;
+    scfg.threads = 2;
+    vt_http_server* srv = vt_http_server_new(&scfg, on_batch, nullptr);
+    if (!srv) { std::perror("vt_http_server_new"); return 1; }
+    std::thread st([srv] { vt_http_server_run(srv); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    static const char kKeep[] = "GET /ping HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: keep-alive\r\n\r\n";
+    static const char kClose[] = "GET /ping HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+    auto make = [](const char* head, size_t len) {
+        vt_httpc_request r{};
+        r.host = "127.0.0.1";
+        r.port = 18181;
+        r.head = head;
+        r.head_len = len;
+        return r;
+    };
+
+    // 1) Historique : une connexion par requête, en série.
+    {
+        vt_httpc* c = vt_httpc_new(nullptr);
+        vt_httpc_request r = make(kClose, sizeof(kClose) - 1);
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < total; ++i) {
+            vt_httpc_response out;
+            vt_httpc_send_batch(c, &r, &out, 1);
+            vt_httpc_response_free(&out);
+        }
+        report("connect-per-request", total, seconds_since(t0), c);
+        vt_httpc_free(c);
+    }
+    // 2) Pool keep-alive, en série.
+    {
+        vt_httpc* c = vt_httpc_new(nullptr);
+        vt_httpc_request r = make(kKeep, sizeof(kKeep) - 1);
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < total; ++i) {
+            vt_httpc_response out;
+            vt_httpc_send_batch(c, &r, &out, 1);
+            vt_httpc_response_free(&out);
+        }
+        report("pooled, sequential", total, seconds_since(t0), c);
+        vt_httpc_free(c);
+    }
+    // 3) Pool keep-alive, lots concurrents sur une boucle.
+    {
+        vt_httpc_config cfg;
+        vt_httpc_config_default(&cfg);
+        cfg.max_idle_per_host = static_cast<uint32_t>(lot);
+        vt_httpc* c = vt_httpc_new(&cfg);
+        std::vector<vt_httpc_request> reqs(lot, make(kKeep, sizeof(kKeep) - 1));
+        std::vector<vt_httpc_response> outs(lot);
+        size_t ok = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t done = 0; done < total; done += lot) {
+            const size_t n = std::min(lot, total - done);
+            ok += static_cast<size_t>(vt_httpc_send_batch(c, reqs.data(), outs.data(), n));
+            for (size_t i = 0; i < n; ++i) vt_httpc_response_free(&outs[i]);
+        }
+        report("pooled, batched", total, seconds_since(t0), c);
+        if (ok != total) std::printf("  (%zu échecs)\n", total - ok);
+        vt_httpc_free(c);
+    }
+
+    vt_http_server_stop(srv);
+    st.join();
+    vt_http_server_free(srv);
+    return 0;
+}
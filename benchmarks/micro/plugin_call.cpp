@@ -0,0 +1,86 @@
+// benchmarks/micro/plugin_call.cpp
+// Coût d’un appel de plugin : chemin historique de `plugin::raw_symbol` (recherche du plugin
+// par nom, dlsym à chaque appel, façade d’appel générique) vs vtable SDK résolue au
+// chargement (trampoline vt_plugin_invoke_i64, puis pointeur appelé directement).
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -fPIC -shared -Inative native/plugin_sample.cpp -o build/libvitte_sample.so
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/plugin_call.cpp native/plugin_host.cpp
+//       -ldl -o build/bench_plugin_call
+//   ./build/bench_plugin_call build/libvitte_sample.so [appels=10000000]
+
+#include "plugin_host.h"
+
+#include <dlfcn.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <string_view>
+
+// Façade générique équivalente à __vitte_call_* : pointeur reçu en u64, non inlinable.
+__attribute__((noinline)) static int64_t facade_call_i64(uint64_t fn, int64_t a, int64_t b) {
+    return reinterpret_cast<int64_t (*)(int64_t, int64_t)>(static_cast<uintptr_t>(fn))(a, b);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void report(const char* name, size_t n, double s, int64_t check) {
+    std::printf("%-30s %10zu appels  %8.3f s  %8.2f ns/appel  (check=%lld)\n", name, n, s,
+                s * 1e9 / static_cast<double>(n), static_cast<long long>(check));
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <libvitte_sample.so> [appels]\n", argv[0]);
+        return 2;
+    }
+    const size_t n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+
+    void* h = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+    if (!h) { std::fprintf(stderr, "dlopen: %s\n", dlerror()); return 1; }
+
+    // Registre par nom, comme __PLUGINS.by_name côté Vitte.
+    std::map<std::string, void*> by_name{{"vitte_sample", h}};
+
+    const uint64_t getter = reinterpret_cast<uintptr_t>(dlsym(h, "vitte_plugin_vtable"));
+    const uint64_t vt = vt_plugin_bind(getter, VT_PLUGIN_VTABLE_ABI);
+    if (!vt) { std::fprintf(stderr, "bind: %d\n", vt_plugin_last_error()); return 1; }
+    vt_plugin_hook(vt, VT_PLUGIN_CAP_INIT);
+
+    // Le symbole « add » exporté par nom n’existe pas : le chemin historique résout la
+    // table de fonctions via dlsym puis cherche l’entrée — c’est le meilleur cas réaliste.
+    int64_t acc = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        void* lib = by_name.find("vitte_sample")->second;
+        auto get = reinterpret_cast<vt_plugin_vtable_getter>(dlsym(lib, "vitte_plugin_vtable"));
+        const vt_plugin_vtable* t = get();
+        uint64_t fn = 0;
+        for (uint32_t k = 0; k < t->fn_count; ++k)
+            if (std::string_view(t->fns[k].name) == "add") { fn = reinterpret_cast<uintptr_t>(t->fns[k].fn.i64); break; }
+        acc = facade_call_i64(fn, acc, 1);
+    }
+    report("lookup (nom + dlsym + façade)", n, seconds_since(t0), acc);
+
+    const uint64_t add = vt_plugin_resolve(vt, "add", VT_SIG_I64_I64);
+    acc = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) acc = vt_plugin_invoke_i64(add, acc, 1);
+    report("vtable (trampoline FFI)", n, seconds_since(t0), acc);
+
+    auto direct = reinterpret_cast<vt_plugin_i64_fn>(static_cast<uintptr_t>(add));
+    acc = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) acc = direct(acc, 1);
+    report("vtable (appel indirect)", n, seconds_since(t0), acc);
+
+    vt_plugin_hook(vt, VT_PLUGIN_CAP_DEINIT);
+    dlclose(h);
+    return 0;
+}
@@ -0,0 +1,196 @@
+// benchmarks/micro/supervisor_core_check.cpp
+// Vérification de `native/supervisor_core.cpp` sans threads ni horloge : les sorties sont
+// signalées à la main et vt_sup_drain() reçoit des instants choisis (backoff fixe, sans
+// jitter). Cas : intensité (fenêtre glissante, escalade), plans one_for_all / rest_for_one
+// (pannes simultanées = un plan, relance dans l’ordre d’ajout à échéance égale), recyclage
+// des slots (pas d’épuisement après des milliers d’ajouts/retraits, sortie périmée d’un
+// ancien occupant ignorée, ordre d’ajout ≠ index du slot). Code de sortie non nul au
+// moindre écart.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/supervisor_core_check.cpp native/supervisor_core.cpp
+//       -pthread -o build/check_supervisor_core
+//   ./build/check_supervisor_core
+
+#include "supervisor_core.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::printf("%s  %s\n", ok ? "ok   " : "ÉCHEC", what);
+    if (!ok) ++failures;
+}
+
+constexpr uint32_t CAP = 8;
+constexpr uint32_t BACKOFF = 10;
+
+// Noyau déterministe : backoff constant de BACKOFF ms, pas de jitter.
+static vt_sup_core* make(uint32_t strategy, uint32_t max_restarts, uint32_t period_ms) {
+    vt_sup_config cfg;
+    vt_sup_config_default(&cfg);
+    cfg.capacity = CAP;
+    cfg.ring_capacity = CAP;
+    cfg.strategy = strategy;
+    cfg.max_restarts = max_restarts;
+    cfg.period_ms = period_ms;
+    cfg.backoff_base_ms = BACKOFF;
+    cfg.backoff_max_ms = BACKOFF;
+    cfg.jitter = 0;
+    return vt_sup_core_new(&cfg);
+}
+
+struct Plan {
+    uint32_t stop[CAP], start[CAP], exited[CAP];
+    vt_sup_plan p{};
+    Plan() {
+        p.stop = stop;
+        p.start = start;
+        p.exited = exited;
+        p.cap = CAP;
+    }
+    std::vector<uint32_t> starts() const { return {start, start + p.n_start}; }
+    std::vector<uint32_t> stops() const { return {stop, stop + p.n_stop}; }
+};
+
+static uint32_t state(vt_sup_core* c, uint32_t slot) { return VT_SUP_WORD_STATE(vt_sup_child_word(c, slot)); }
+static uint32_t gen(vt_sup_core* c, uint32_t slot) { return VT_SUP_WORD_GEN(vt_sup_child_word(c, slot)); }
+
+static uint32_t add_started(vt_sup_core* c, uint32_t restart = VT_SUP_PERMANENT) {
+    const uint32_t slot = static_cast<uint32_t>(vt_sup_child_add(c, restart));
+    vt_sup_child_started(c, slot);
+    return slot;
+}
+
+static void crash(vt_sup_core* c, uint32_t slot) { vt_sup_report_exit(c, slot, gen(c, slot), 1, "boom"); }
+
+// Rejoue les arrêts d’un plan : chaque worker sollicité signale sa sortie.
+static void ack_stops(vt_sup_core* c, const Plan& pl) {
+    for (uint32_t s : pl.stops()) vt_sup_report_exit(c, s, gen(c, s), 0, "");
+}
+
+static void relaunch(vt_sup_core* c, const Plan& pl) {
+    for (uint32_t s : pl.starts()) vt_sup_child_started(c, s);
+}
+
+static void intensity() {
+    // 2 redémarrages par 100 ms : le 3e dans la fenêtre escalade
+    vt_sup_core* c = make(VT_SUP_ONE_FOR_ONE, 2, 100);
+    const uint32_t a = add_started(c), b = add_started(c);
+    Plan pl;
+    uint64_t t = 0;
+    bool ok = true;
+    for (int i = 0; i < 2; ++i) {
+        crash(c, a);
+        vt_sup_drain(c, t, &pl.p);
+        ok &= pl.p.escalate == 0 && pl.p.n_start == 0 && pl.p.next_due_ms == t + BACKOFF;
+        t += BACKOFF;
+        vt_sup_drain(c, t, &pl.p);
+        ok &= pl.starts() == std::vector<uint32_t>{a};
+        relaunch(c, pl);
+    }
+    check(ok, "intensité : redémarrages différés du backoff");
+    check(VT_SUP_WORD_RESTARTS(vt_sup_child_word(c, a)) == 2, "intensité : compteur de redémarrages");
+    crash(c, a);
+    vt_sup_drain(c, t, &pl.p);
+    check(pl.p.escalate == 1 && pl.stops() == std::vector<uint32_t>{b}, "intensité : escalade au 3e");
+    vt_sup_core_free(c);
+
+    // fenêtre glissante : des pannes espacées de plus que la période n’escaladent jamais
+    c = make(VT_SUP_ONE_FOR_ONE, 2, 100);
+    const uint32_t x = add_started(c);
+    ok = true;
+    for (t = 0; t < 2000; t += 60) {
+        crash(c, x);
+        vt_sup_drain(c, t, &pl.p);
+        ok &= pl.p.escalate == 0;
+        vt_sup_drain(c, t + BACKOFF, &pl.p);
+        relaunch(c, pl);
+    }
+    check(ok, "intensité : fenêtre glissante");
+    vt_sup_core_free(c);
+}
+
+static void plans() {
+    // one_for_all : deux pannes dans la même passe = un plan ; arrêt des autres, puis relance
+    // de tout le groupe dans l’ordre d’ajout
+    vt_sup_core* c = make(VT_SUP_ONE_FOR_ALL, 10, 1000);
+    uint32_t s[4];
+    for (uint32_t& x : s) x = add_started(c);
+    crash(c, s[3]);
+    crash(c, s[1]);
+    Plan pl;
+    vt_sup_drain(c, 0, &pl.p);
+    vt_sup_stats st{};
+    vt_sup_get_stats(c, &st);
+    check(st.plans == 1 && pl.stops() == std::vector<uint32_t>{s[0], s[2]}, "one_for_all : un plan, arrêts");
+    ack_stops(c, pl);
+    vt_sup_drain(c, BACKOFF, &pl.p);
+    check(pl.starts() == std::vector<uint32_t>{s[0], s[1], s[2], s[3]}, "one_for_all : relance par ordre d’ajout");
+    relaunch(c, pl);
+    vt_sup_core_free(c);
+
+    // rest_for_one après recyclage : B retiré, E prend son slot mais vient après D
+    c = make(VT_SUP_REST_FOR_ONE, 10, 1000);
+    const uint32_t a = add_started(c), b = add_started(c), cc = add_started(c), d = add_started(c);
+    vt_sup_child_remove(c, b);
+    const uint32_t e = add_started(c);
+    check(e == b, "rest_for_one : slot recyclé");
+    crash(c, cc);
+    vt_sup_drain(c, 0, &pl.p);
+    check(pl.stops() == std::vector<uint32_t>{e, d} || pl.stops() == std::vector<uint32_t>{d, e},
+          "rest_for_one : arrête les suivants (rang d’ajout), pas les précédents");
+    check(state(c, a) == VT_SUP_RUNNING, "rest_for_one : enfant antérieur intact");
+    ack_stops(c, pl);
+    vt_sup_drain(c, BACKOFF, &pl.p);
+    check(pl.starts() == std::vector<uint32_t>{cc, d, e}, "rest_for_one : relance par ordre d’ajout");
+    vt_sup_core_free(c);
+}
+
+static void reuse() {
+    vt_sup_core* c = make(VT_SUP_ONE_FOR_ONE, 1000, 1);
+    bool ok = true;
+    for (int i = 0; i < 10000; ++i) {
+        const int64_t slot = vt_sup_child_add(c, VT_SUP_PERMANENT);
+        if (slot < 0) { ok = false; break; }
+        vt_sup_child_started(c, static_cast<uint32_t>(slot));
+        vt_sup_child_remove(c, static_cast<uint32_t>(slot));
+    }
+    vt_sup_stats st{};
+    vt_sup_get_stats(c, &st);
+    check(ok && st.children == 0, "recyclage : 10000 ajouts/retraits sur 8 slots");
+
+    uint32_t s[CAP];
+    for (uint32_t& x : s) x = add_started(c);
+    check(vt_sup_child_add(c, VT_SUP_PERMANENT) == -ENOSPC, "recyclage : capacité = enfants simultanés");
+
+    // l’ancien occupant sort après le retrait : signalement périmé, le nouveau n’est pas touché
+    const uint32_t old_gen = gen(c, s[2]);
+    vt_sup_child_remove(c, s[2]);
+    const uint32_t n = add_started(c);
+    check(n == s[2] && vt_sup_report_exit(c, n, old_gen, 1, "tard") == -ESTALE && state(c, n) == VT_SUP_RUNNING,
+          "recyclage : sortie de l’ancien occupant périmée");
+    check(VT_SUP_WORD_RESTARTS(vt_sup_child_word(c, n)) == 0, "recyclage : compteur remis à zéro");
+
+    // minuteur d’un enfant retiré : jamais relancé dans le nouvel occupant
+    crash(c, s[5]);
+    Plan pl;
+    vt_sup_drain(c, 0, &pl.p);
+    vt_sup_child_remove(c, s[5]);
+    const uint32_t m = static_cast<uint32_t>(vt_sup_child_add(c, VT_SUP_PERMANENT));
+    vt_sup_drain(c, BACKOFF, &pl.p);
+    check(m == s[5] && pl.p.n_start == 0 && pl.p.next_due_ms == 0 && state(c, m) == VT_SUP_STOPPED,
+          "recyclage : minuteur de l’ancien occupant supprimé");
+    vt_sup_core_free(c);
+}
+
+int main() {
+    intensity();
+    plans();
+    reuse();
+    return failures ? 1 : 0;
+}
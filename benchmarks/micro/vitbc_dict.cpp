@@ -0,0 +1,189 @@
+// benchmarks/micro/vitbc_dict.cpp
+// Petits modules VITBC compressés par `native/vitbc_zstd.cpp` avec et sans dictionnaire
+// entraîné : taille totale des images et temps moyen de décompression d’un module
+// (vt_vitbc_sections_open + accès à toutes les sections, comme un chargeur).
+// Le corpus : `--modules` modules de 1 à 8 Kio, fabriqués à partir d’un vocabulaire commun
+// (noms de constantes, chaînes, suites d’opcodes) : les répétitions sont d’un fichier à
+// l’autre, pas à l’intérieur d’un fichier. Entraînement sur la première moitié, mesures sur
+// la seconde.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/vitbc_dict.cpp native/vitbc_zstd.cpp
+//       -pthread -ldl -o build/bench_vitbc_dict
+//   ./build/bench_vitbc_dict [--modules 2000] [--runs 5] [--level 10] [--dict-size 112640]
+
+#include "vitbc_image.hpp"
+#include "vitbc_zstd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Corpus {
+    std::vector<std::string> names, strings;
+    std::vector<std::vector<uint16_t>> snippets;   // suites d’opcodes (fonctions « types »)
+};
+
+static Corpus vocabulary(std::mt19937& g) {
+    static const char* const parts[] = {"std", "io", "print", "len", "map", "http", "json", "parse", "user",
+                                        "config", "value", "count", "index", "error", "result", "buffer"};
+    Corpus c;
+    for (int i = 0; i < 300; ++i) {
+        std::string n = parts[g() % 16];
+        for (int k = 1 + g() % 3; k > 0; --k) n += std::string(".") + parts[g() % 16];
+        c.names.push_back(n);
+    }
+    for (int i = 0; i < 120; ++i) c.strings.push_back("erreur: " + c.names[g() % c.names.size()] + " introuvable (code " +
+                                                      std::to_string(g() % 100) + ")");
+    for (int i = 0; i < 60; ++i) {
+        std::vector<uint16_t> s(4 + g() % 24);
+        for (uint16_t& op : s) op = static_cast<uint16_t>(g() % 40);
+        c.snippets.push_back(std::move(s));
+    }
+    return c;
+}
+
+static std::vector<uint8_t> module(const Corpus& c, std::mt19937& g) {
+    std::vector<uint8_t> v;
+    auto put = [&v](auto x) {
+        uint8_t b[sizeof x];
+        std::memcpy(b, &x, sizeof x);
+        v.insert(v.end(), b, b + sizeof x);
+    };
+    auto name = [&](const std::string& s) {
+        put(static_cast<uint16_t>(s.size()));
+        v.insert(v.end(), s.begin(), s.end());
+    };
+    const uint32_t nint = 2 + g() % 12, nstr = 1 + g() % 8, nfun = 2 + g() % 12;
+    for (uint32_t i = 0; i < nint; ++i) {
+        name(c.names[g() % c.names.size()]);
+        put(static_cast<int64_t>(g() % 4 ? g() % 16 : g()));
+    }
+    for (uint32_t i = 0; i < nstr; ++i) {
+        name(c.names[g() % c.names.size()]);
+        const std::string& s = c.strings[g() % c.strings.size()];
+        put(static_cast<uint32_t>(s.size()));
+        v.insert(v.end(), s.begin(), s.end());
+    }
+    uint32_t ncode = 0;
+    for (uint32_t f = 0; f < nfun; ++f) {
+        for (uint16_t op : c.snippets[g() % c.snippets.size()]) {
+            const uint8_t argc = op % 3;
+            put(op);
+            put(argc);
+            put(uint8_t{0});
+            for (uint8_t a = 0; a < argc; ++a) put(static_cast<uint64_t>(g() % 8));
+            ++ncode;
+        }
+    }
+
+    using namespace vt::vitbc_detail;
+    std::vector<uint8_t> img(MAGIC, MAGIC + sizeof MAGIC);
+    auto hput = [&img](auto x) {
+        uint8_t b[sizeof x];
+        std::memcpy(b, &x, sizeof x);
+        img.insert(img.end(), b, b + sizeof x);
+    };
+    hput(FILE_VERSION);
+    hput(uint32_t{0});
+    hput(int64_t{0});
+    hput(nint);
+    hput(uint32_t{0});
+    hput(nstr);
+    hput(uint32_t{0});
+    hput(ncode);
+    img.insert(img.end(), v.begin(), v.end());
+    hput(crc32_ieee(img.data() + sizeof MAGIC, img.size() - sizeof MAGIC));
+    img.insert(img.end(), TRAILER_MAGIC, TRAILER_MAGIC + sizeof TRAILER_MAGIC);
+    return img;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void check(int e, const char* what) {
+    if (e < 0) {
+        std::fprintf(stderr, "%s : %s\n", what, vt_vitbc_strerror(e));
+        std::exit(1);
+    }
+}
+
+// Taille totale des images compressées, puis temps moyen de chargement d’un module.
+static void bench(const char* name, const std::vector<std::vector<uint8_t>>& mods, int level, uint16_t dict, int runs) {
+    std::vector<vt_vitbc_buf> out(mods.size());
+    size_t total = 0;
+    vt_vitbc_zopts o;
+    vt_vitbc_zopts_default(&o);
+    o.level = level;
+    o.threads = 1;
+    o.dict_id = dict;
+    for (size_t i = 0; i < mods.size(); ++i) {
+        check(vt_vitbc_compress(mods[i].data(), mods[i].size(), &o, &out[i]), "compression");
+        total += out[i].len;
+    }
+    double best = 1e30;
+    for (int r = 0; r < runs; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const vt_vitbc_buf& b : out) {
+            vt_vitbc_sections* s = nullptr;
+            const uint8_t* p = nullptr;
+            check(vt_vitbc_sections_open(b.data, b.len, &s), "ouverture");
+            check(vt_vitbc_sections_get(s, 0, vt_vitbc_sections_size(s), &p), "décompression");
+            vt_vitbc_sections_free(s);
+        }
+        best = std::min(best, seconds_since(t0));
+    }
+    std::printf("%-18s %8.1f Ko  %7.1f o/module  %7.2f µs/module\n", name, total / 1e3,
+                static_cast<double>(total) / mods.size(), best * 1e6 / mods.size());
+    for (vt_vitbc_buf& b : out) vt_vitbc_buf_free(&b);
+}
+
+int main(int argc, char** argv) {
+    size_t nmods = 2000, dict_size = 110 * 1024;
+    int runs = 5, level = 10;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--modules") && i + 1 < argc) nmods = std::max(4, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) runs = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--level") && i + 1 < argc) level = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--dict-size") && i + 1 < argc) dict_size = std::strtoul(argv[++i], nullptr, 10);
+    }
+    if (!vt_vitbc_zstd_available()) {
+        std::fprintf(stderr, "libzstd introuvable\n");
+        return 1;
+    }
+    std::mt19937 g(7);
+    const Corpus c = vocabulary(g);
+    std::vector<std::vector<uint8_t>> train, eval;
+    size_t raw = 0;
+    for (size_t i = 0; i < nmods; ++i) {
+        (i % 2 ? eval : train).push_back(module(c, g));
+        if (i % 2) raw += eval.back().size();
+    }
+
+    std::vector<const uint8_t*> ptrs;
+    std::vector<size_t> lens;
+    for (const auto& m : train) {
+        ptrs.push_back(m.data());
+        lens.push_back(m.size());
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    vt_vitbc_buf dict{};
+    check(vt_vitbc_dict_train(ptrs.data(), lens.data(), ptrs.size(), dict_size, 0, &dict), "entraînement");
+    const double train_s = seconds_since(t0);
+    const int id = vt_vitbc_dict_register(dict.data, dict.len);
+    check(id, "enregistrement");
+
+    std::printf("%zu modules évalués (%.1f Ko bruts, %.0f o/module), dictionnaire %zu o (id %d, %.0f ms sur %zu modules)\n",
+                eval.size(), raw / 1e3, static_cast<double>(raw) / eval.size(), dict.len, id, train_s * 1e3,
+                train.size());
+    bench("sans dictionnaire", eval, level, 0, runs);
+    bench("dictionnaire", eval, level, static_cast<uint16_t>(id), runs);
+    vt_vitbc_buf_free(&dict);
+    return 0;
+}
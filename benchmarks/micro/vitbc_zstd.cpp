@@ -0,0 +1,115 @@
+// benchmarks/micro/vitbc_zstd.cpp
+// Décompression des sections VITBC par `native/vitbc_zstd.cpp` : une seule trame (équivalent
+// du flux unique de loader.rs, décodé en série avant usage), trames de 64 Kio sur 1 thread
+// puis sur tous les cœurs, et accès à la demande (premier octet touché : une seule trame).
+// Les sections : `--mib` Mio pseudo-bytecode (ops de 9 octets, opérandes peu variés,
+// compressible comme du vrai code).
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/vitbc_zstd.cpp native/vitbc_zstd.cpp
+//       -pthread -ldl -o build/bench_vitbc_zstd
+//   ./build/bench_vitbc_zstd [--mib 64] [--runs 5] [--level 10]
+
+#include "vitbc_image.hpp"
+#include "vitbc_zstd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static std::vector<uint8_t> image(size_t bytes) {
+    using namespace vt::vitbc_detail;
+    std::vector<uint8_t> v(MAGIC, MAGIC + sizeof MAGIC);
+    auto put = [&v](auto x) {
+        uint8_t b[sizeof x];
+        std::memcpy(b, &x, sizeof x);
+        v.insert(v.end(), b, b + sizeof x);
+    };
+    put(FILE_VERSION);
+    put(uint32_t{0});
+    put(int64_t{0});
+    for (int i = 0; i < 4; ++i) put(uint32_t{0});
+    put(static_cast<uint32_t>(bytes / 9));   // CODE
+    std::mt19937 g(42);
+    for (size_t i = 0; i < bytes / 9; ++i) {
+        v.push_back(static_cast<uint8_t>(g() % 24));
+        put(static_cast<uint64_t>(g() % 64 < 48 ? g() % 16 : g() % 4096));
+    }
+    put(crc32_ieee(v.data() + sizeof MAGIC, v.size() - sizeof MAGIC));
+    v.insert(v.end(), TRAILER_MAGIC, TRAILER_MAGIC + sizeof TRAILER_MAGIC);
+    return v;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static vt_vitbc_buf compress(const std::vector<uint8_t>& img, int level, uint32_t block) {
+    vt_vitbc_zopts o;
+    vt_vitbc_zopts_default(&o);
+    o.level = level;
+    o.block_size = block;
+    vt_vitbc_buf c{};
+    if (const int e = vt_vitbc_compress(img.data(), img.size(), &o, &c); e != VT_VITBC_OK) {
+        std::fprintf(stderr, "compression : %s\n", vt_vitbc_strerror(e));
+        std::exit(1);
+    }
+    return c;
+}
+
+// threads == UINT32_MAX : à la demande (premier octet seulement).
+static void bench(const char* name, const vt_vitbc_buf& c, unsigned threads, int runs) {
+    double best = 1e30;
+    vt_vitbc_sections_stats st{};
+    for (int r = 0; r < runs; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        vt_vitbc_sections* s = nullptr;
+        int e = vt_vitbc_sections_open(c.data, c.len, &s);
+        const uint8_t* p = nullptr;
+        if (e == VT_VITBC_OK) e = threads == UINT32_MAX ? vt_vitbc_sections_get(s, 0, 1, &p)
+                                                        : vt_vitbc_sections_load_all(s, threads);
+        if (e != VT_VITBC_OK) {
+            std::fprintf(stderr, "%s : %s\n", name, vt_vitbc_strerror(e));
+            std::exit(1);
+        }
+        best = std::min(best, seconds_since(t0));
+        vt_vitbc_sections_get_stats(s, &st);
+        vt_vitbc_sections_free(s);
+    }
+    // Débit en octets décodés (CRC de l’image compris dans le temps).
+    const double decoded = st.decoded == st.frames ? st.raw_size : st.decoded * 64.0 * 1024;
+    std::printf("%-22s image %7.1f Mo  %6u trames (%6u décodées)  %8.2f ms  %7.0f Mo/s\n", name, c.len / 1e6,
+                st.frames, st.decoded, best * 1e3, decoded / best / 1e6);
+}
+
+int main(int argc, char** argv) {
+    size_t mib = 64;
+    int runs = 5, level = 10;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--mib") && i + 1 < argc) mib = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) runs = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--level") && i + 1 < argc) level = std::atoi(argv[++i]);
+    }
+    if (!vt_vitbc_zstd_available()) {
+        std::fprintf(stderr, "libzstd introuvable\n");
+        return 1;
+    }
+    const std::vector<uint8_t> img = image(mib << 20);
+    vt_vitbc_buf one = compress(img, level, UINT32_MAX);
+    vt_vitbc_buf framed = compress(img, level, 64u * 1024);
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("sections %.1f Mo, niveau %d, %u cœurs\n", (img.size() - 52) / 1e6, level, hw);
+    bench("1 trame", one, 1, runs);
+    bench("64 Kio, 1 thread", framed, 1, runs);
+    bench("64 Kio, tous les cœurs", framed, hw, runs);
+    bench("64 Kio, 1er accès", framed, UINT32_MAX, runs);
+    vt_vitbc_buf_free(&one);
+    vt_vitbc_buf_free(&framed);
+    return 0;
+}
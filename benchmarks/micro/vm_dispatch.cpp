@@ -0,0 +1,384 @@
+// benchmarks/micro/vm_dispatch.cpp
+// Débit du moteur natif `native/vm_interp.cpp` sur des chunks `.vitbc` (format Chunk de
+// vitte-core) : boucle entière, boucle flottante, fib récursif (Call avec cache en ligne) et
+// boucle d’appels à une fonction chaude à boucle interne (cible du JIT), boucle d’appels à
+// une native hôte (vt_register_native, import résolu au chargement), liste chaînée de
+// fermetures avec déchets (nursery + collectes, pauses affichées via vt_vm_get_gc_stats).
+// Sans argument, les programmes sont construits en mémoire ; `--emit DIR` les écrit
+// pour les repasser à la VM Rust (mêmes octets, empreinte FNV valide pour Chunk::from_bytes).
+// `--superops MASK` choisit les superinstructions (0 : aucune, défaut : toutes) ;
+// `--profile` exécute chaque programme en mode profil et affiche le poids de chaque motif
+// du menu et le masque retenu par vt_vm_superops_select(). `--jit [seuil]` active le JIT
+// x86-64 (VT_VM_BACKEND_JIT) et affiche ses compteurs (compilations, entrées, deopts).
+// `--no-verify` charge sans vérificateur (tests de pile à chaque op, pour comparer).
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/vm_dispatch.cpp native/vm_interp.cpp
+//       native/vt_value.cpp native/vt_native.cpp -o build/bench_vm_dispatch
+//   ./build/bench_vm_dispatch [--emit build/vm_bench] [--runs 5] [--superops 0x7ff]
+//       [--profile [part]] [--jit [seuil]] [--no-verify] [fichiers.vitbc…]
+//
+// Côté Rust, sur les mêmes fichiers : `vitte_core::runtime::eval::eval_chunk` (boucles
+// uniquement : ni Call, ni fermetures, ni imports natifs dans les VM Rust actuelles), chronométré autour de
+// `Chunk::from_bytes` + `eval_chunk(&chunk, EvalOptions { max_steps: None, .. })`.
+
+#include "vm_chunk.hpp"
+#include "vm_interp.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using vt::ChunkOpCode;
+
+static vt::ChunkOp op(ChunkOpCode c, int64_t a = 0, uint8_t n = 0) {
+    vt::ChunkOp o;
+    o.code = c;
+    o.a = static_cast<uint32_t>(a);
+    o.n = n;
+    return o;
+}
+
+static vt::ChunkConst k_int(int64_t i) {
+    vt::ChunkConst c;
+    c.kind = vt::ChunkConstKind::I64;
+    c.i = i;
+    return c;
+}
+
+static vt::ChunkConst k_float(double f) {
+    vt::ChunkConst c;
+    c.kind = vt::ChunkConstKind::F64;
+    c.f = f;
+    return c;
+}
+
+// i = 0; acc = 0; while i < n { acc = acc + i % 7; i = i + 1 } return acc
+static std::vector<uint8_t> loop_int(int64_t n) {
+    vt::Chunk c;
+    c.consts = {k_int(0), k_int(n), k_int(7), k_int(1)};
+    c.ops = {
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        // 4 : boucle
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 11),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 2),
+        op(ChunkOpCode::Mod), op(ChunkOpCode::Add), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 3), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 0), op(ChunkOpCode::Jump, -15),
+        // 19 : sortie
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::Return),
+    };
+    return vt::encode_chunk(c);
+}
+
+// x = 0.0; i = 0; while i < n { x = x * 0.5 + 0.25; i = i + 1 } return x
+static std::vector<uint8_t> loop_float(int64_t n) {
+    vt::Chunk c;
+    c.consts = {k_int(0), k_int(n), k_float(0.5), k_float(0.25), k_int(1), k_float(0.0)};
+    c.ops = {
+        op(ChunkOpCode::LoadConst, 5), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 11),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 2), op(ChunkOpCode::Mul),
+        op(ChunkOpCode::LoadConst, 3), op(ChunkOpCode::Add), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 4), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 1), op(ChunkOpCode::Jump, -15),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::Return),
+    };
+    return vt::encode_chunk(c);
+}
+
+// fib(n) = n < 2 ? n : fib(n - 1) + fib(n - 2)
+static std::vector<uint8_t> fib(int64_t n) {
+    vt::Chunk c;
+    c.consts = {k_int(n), k_int(2), k_int(1)};
+    c.ops = {
+        op(ChunkOpCode::MakeClosure, 0, 0), op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::Call, 0, 1),
+        op(ChunkOpCode::Return),
+        // 4 : fib
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 2), op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::Return),
+        op(ChunkOpCode::MakeClosure, 0, 0), op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 2),
+        op(ChunkOpCode::Sub), op(ChunkOpCode::Call, 0, 1),
+        op(ChunkOpCode::MakeClosure, 0, 0), op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 1),
+        op(ChunkOpCode::Sub), op(ChunkOpCode::Call, 0, 1),
+        op(ChunkOpCode::Add), op(ChunkOpCode::Return),
+    };
+    c.symbols = {{"fib", 4}};
+    return vt::encode_chunk(c);
+}
+
+// f(n) = { s = 0; j = 0; while j < n { s = s + j % 7; j = j + 1 } s }
+// acc = 0; i = 0; while i < calls { acc = acc + f(inner); i = i + 1 } return acc
+static std::vector<uint8_t> calls_loop(int64_t calls, int64_t inner) {
+    vt::Chunk c;
+    c.consts = {k_int(0), k_int(1), k_int(calls), k_int(inner), k_int(7)};
+    c.ops = {
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        // 4 : boucle d’appels
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 2), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 11),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::MakeClosure, 0, 0), op(ChunkOpCode::LoadConst, 3),
+        op(ChunkOpCode::Call, 0, 1), op(ChunkOpCode::Add), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 0), op(ChunkOpCode::Jump, -15),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::Return),
+        // 21 : f
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 2),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 11),
+        op(ChunkOpCode::LoadLocal, 2), op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 4),
+        op(ChunkOpCode::Mod), op(ChunkOpCode::Add), op(ChunkOpCode::StoreLocal, 2),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 1), op(ChunkOpCode::Jump, -15),
+        op(ChunkOpCode::LoadLocal, 2), op(ChunkOpCode::Return),
+    };
+    c.symbols = {{"f", 21}};
+    return vt::encode_chunk(c);
+}
+
+static int native_add(void*, const vt_value* a, size_t, vt_value* ret) {
+    if (!vt_value_is_int(a[0]) || !vt_value_is_int(a[1])) return -1;
+    *ret = vt_value_int(vt_value_as_int(a[0]) + vt_value_as_int(a[1]));
+    return 0;
+}
+
+// acc = 0; i = 0; while i < n { acc = bench.add(acc, i); i = i + 1 } return acc
+static std::vector<uint8_t> native_loop(int64_t n) {
+    vt::Chunk c;
+    c.consts = {k_int(0), k_int(1), k_int(n)};
+    c.ops = {
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 2), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 10),
+        op(ChunkOpCode::MakeClosure, 0, 0), op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadLocal, 0),
+        op(ChunkOpCode::Call, 0, 2), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 0), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 0), op(ChunkOpCode::Jump, -14),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::Return),
+    };
+    c.symbols = {{"bench.add", VT_NATIVE_IMPORT_PC}};
+    return vt::encode_chunk(c);
+}
+
+// list = null; i = 0; while i < n { list = fn[list, i] ; fn[list, i] (jeté) ; i = i + 1 } return i
+static std::vector<uint8_t> closure_list(int64_t n) {
+    vt::Chunk c;
+    c.consts = {k_int(0), k_int(1), k_int(n)};
+    c.ops = {
+        op(ChunkOpCode::LoadNull), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::LoadConst, 0), op(ChunkOpCode::StoreLocal, 1),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 2), op(ChunkOpCode::Lt),
+        op(ChunkOpCode::JumpIfFalse, 9),
+        op(ChunkOpCode::MakeClosure, 0, 2), op(ChunkOpCode::StoreLocal, 0),
+        op(ChunkOpCode::MakeClosure, 0, 2), op(ChunkOpCode::Pop),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::LoadConst, 1), op(ChunkOpCode::Add),
+        op(ChunkOpCode::StoreLocal, 1), op(ChunkOpCode::Jump, -13),
+        op(ChunkOpCode::LoadLocal, 1), op(ChunkOpCode::Return),
+    };
+    c.symbols = {{"main", 0}};
+    return vt::encode_chunk(c);
+}
+
+static bool read_file(const char* path, std::vector<uint8_t>& out) {
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[1 << 16];
+    size_t got;
+    while ((got = std::fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + got);
+    std::fclose(f);
+    return true;
+}
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// Cumule dans `acc` le profil d’une exécution ; false si le programme échoue.
+static bool profile(const char* name, const std::vector<uint8_t>& bytes, vt_vm_profile& acc) {
+    vt_vm_program* p = nullptr;
+    if (vt_vm_program_load(bytes.data(), bytes.size(), VT_VM_LOAD_PROFILE, &p) != VT_VM_OK) {
+        std::fprintf(stderr, "%s : %s\n", name, vt_vm_program_error());
+        return false;
+    }
+    vt_vm* vm = vt_vm_new(nullptr);
+    vt_vm_set_print(vm, [](void*, const char*, size_t) {}, nullptr);
+    vt_vm_result r{};
+    const bool ok = vt_vm_run(vm, p, nullptr, &r) == VT_VM_OK;
+    if (!ok) std::fprintf(stderr, "%s : %s\n", name, vt_vm_last_error(vm));
+    vt_vm_profile pr{};
+    vt_vm_program_profile(p, &pr);
+    std::printf("%-24s ops=%llu\n", name, static_cast<unsigned long long>(pr.ops));
+    acc.ops += pr.ops;
+    acc.blocks += pr.blocks;
+    acc.nsuperops = pr.nsuperops;
+    for (uint32_t m = 0; m < pr.nsuperops; ++m) acc.superops[m] += pr.superops[m];
+    vt_vm_free(vm);
+    vt_vm_program_free(p);
+    return ok;
+}
+
+static void print_profile(const vt_vm_profile& acc, double share) {
+    const double ops = acc.ops ? static_cast<double>(acc.ops) : 1.0;
+    for (uint32_t m = 0; m < acc.nsuperops; ++m) {
+        std::printf("  %-18s %14llu  %6.2f %%\n", vt_vm_superop_name(m),
+                    static_cast<unsigned long long>(acc.superops[m]), 100.0 * static_cast<double>(acc.superops[m]) / ops);
+    }
+    std::printf("masque (part >= %.3g) : 0x%llx\n", share,
+                static_cast<unsigned long long>(vt_vm_superops_select(&acc, share)));
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void bench(const char* name, const std::vector<uint8_t>& bytes, int runs, uint64_t superops,
+                  uint32_t jit_threshold, uint32_t load_flags) {
+    vt_vm_program* p = nullptr;
+    if (vt_vm_program_load_ex(bytes.data(), bytes.size(), load_flags, superops, &p) != VT_VM_OK) {
+        std::fprintf(stderr, "%s : %s\n", name, vt_vm_program_error());
+        return;
+    }
+    vt_vm_config cfg;
+    vt_vm_config_default(&cfg);
+    if (jit_threshold) {
+        cfg.backend = VT_VM_BACKEND_JIT;
+        cfg.jit_threshold = jit_threshold;
+    }
+    vt_vm* vm = vt_vm_new(&cfg);
+    vt_vm_set_print(vm, [](void*, const char*, size_t) {}, nullptr);
+    double best = 1e30;
+    vt_vm_result r{};
+    for (int i = 0; i < runs; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (vt_vm_run(vm, p, nullptr, &r) != VT_VM_OK) {
+            std::fprintf(stderr, "%s : %s\n", name, vt_vm_last_error(vm));
+            break;
+        }
+        const double s = seconds_since(t0);
+        if (s < best) best = s;
+    }
+    vt_vm_stats st{};
+    vt_vm_get_stats(vm, &st);
+    vt_vm_code_stats cs{};
+    vt_vm_program_code_stats(p, &cs);
+    char res[64];
+    if (r.kind == VT_VM_FLOAT) {
+        std::snprintf(res, sizeof(res), "%.6g", r.f);
+    } else {
+        std::snprintf(res, sizeof(res), "%lld", static_cast<long long>(r.i));
+    }
+    const uint64_t lookups = st.call_ic_hits + st.call_ic_misses;
+    std::printf("%-24s %10.3f ms  résultat=%-14s appels=%llu natives=%llu ic_miss=%llu ic_hit=%.2f%% insns=%u/%u\n",
+                name, best * 1e3, res, static_cast<unsigned long long>(st.calls / static_cast<uint64_t>(runs)),
+                static_cast<unsigned long long>(st.native_calls / static_cast<uint64_t>(runs)),
+                static_cast<unsigned long long>(st.call_ic_misses),
+                lookups ? 100.0 * static_cast<double>(st.call_ic_hits) / static_cast<double>(lookups) : 100.0,
+                cs.insns, cs.ops);
+    if (jit_threshold) {
+        std::printf("%-24s jit : compilées=%llu entrées=%llu deopts=%llu rendues=%llu code=%llu o\n", "",
+                    static_cast<unsigned long long>(st.jit_compiled), static_cast<unsigned long long>(st.jit_entries),
+                    static_cast<unsigned long long>(st.jit_deopts), static_cast<unsigned long long>(st.jit_discarded),
+                    static_cast<unsigned long long>(st.jit_code_bytes));
+    }
+    vt_vm_gc_stats gc{};
+    vt_vm_get_gc_stats(vm, &gc);
+    if (gc.minor + gc.major) {
+        std::printf("%-24s gc : mineures=%llu majeures=%llu pause max=%.3f ms cumul=%.3f ms promus=%llu o\n", "",
+                    static_cast<unsigned long long>(gc.minor / static_cast<uint64_t>(runs)),
+                    static_cast<unsigned long long>(gc.major / static_cast<uint64_t>(runs)),
+                    static_cast<double>(gc.max_pause_ns) * 1e-6,
+                    static_cast<double>(gc.pause_ns) * 1e-6 / runs,
+                    static_cast<unsigned long long>(gc.promoted_bytes / static_cast<uint64_t>(runs)));
+    }
+    vt_vm_free(vm);
+    vt_vm_program_free(p);
+}
+
+int main(int argc, char** argv) {
+    int runs = 5;
+    uint64_t superops = VT_VM_SUPEROPS_DEFAULT;
+    uint32_t load_flags = 0;
+    double share = -1.0;   // < 0 : pas de profil
+    uint32_t jit = 0;      // seuil d’appels ; 0 : interpréteur seul
+    const char* emit = nullptr;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--no-verify")) {
+            load_flags |= VT_VM_LOAD_NO_VERIFY;
+        } else if (!std::strcmp(argv[i], "--superops") && i + 1 < argc) {
+            superops = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--profile")) {
+            share = i + 1 < argc && argv[i + 1][0] == '0' ? std::atof(argv[++i]) : 0.01;
+        } else if (!std::strcmp(argv[i], "--jit")) {
+            jit = i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))
+                      ? static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])))
+                      : 1000;
+        } else if (!std::strcmp(argv[i], "--emit") && i + 1 < argc) {
+            emit = argv[++i];
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    vt_register_native("bench.add", native_add, 2, VT_NATIVE_PURE);
+
+    vt_vm_profile acc{};
+    if (files.empty()) {
+        const struct {
+            const char* name;
+            std::vector<uint8_t> bytes;
+        } progs[] = {
+            {"loop_int.vitbc", loop_int(10'000'000)},
+            {"loop_float.vitbc", loop_float(10'000'000)},
+            {"fib30.vitbc", fib(30)},
+            {"calls_loop.vitbc", calls_loop(10'000, 1'000)},
+            {"native_loop.vitbc", native_loop(10'000'000)},
+            {"closure_list.vitbc", closure_list(1'000'000)},
+        };
+        for (const auto& pr : progs) {
+            if (emit && !write_file(std::string(emit) + "/" + pr.name, pr.bytes)) {
+                std::fprintf(stderr, "écriture impossible : %s/%s\n", emit, pr.name);
+                return 1;
+            }
+            if (share >= 0) {
+                profile(pr.name, pr.bytes, acc);
+            } else {
+                bench(pr.name, pr.bytes, runs, superops, jit, load_flags);
+            }
+        }
+        if (share >= 0) print_profile(acc, share);
+        return 0;
+    }
+
+    for (const char* path : files) {
+        std::vector<uint8_t> bytes;
+        if (!read_file(path, bytes)) {
+            std::fprintf(stderr, "lecture impossible : %s\n", path);
+            continue;
+        }
+        if (share >= 0) {
+            profile(path, bytes, acc);
+        } else {
+            bench(path, bytes, runs, superops, jit, load_flags);
+        }
+    }
+    if (share >= 0) print_profile(acc, share);
+    return 0;
+}
@@ -0,0 +1,783 @@
+// benchmarks/micro/vm_fuzz.cpp
+// Fuzz différentiel du moteur natif `native/vm_interp.cpp`, du JIT (`native/vm_jit.hpp`) et
+// du vérificateur de chargement (`native/vm_verify.hpp`). Par numéro de programme :
+// - Programme structuré : `fonctions` fonctions chaudes appelées `--iters` fois par une
+//   boucle de haut niveau (arguments et locaux capturés dérivés du compteur), corps tirés
+//   au hasard (arithmétique, comparaisons, si/sinon, boucles bornées, appels et appels
+//   terminaux vers les fonctions précédentes, upvalues). Les constantes mêlent petits
+//   entiers, entiers proches de 2^47 (dépassement 48 bits) et flottants : les gardes du JIT
+//   échouent en cours de run (désoptimisation). Un programme sur 8 est « sauvage »
+//   (booléens, null, chaînes, ReturnVoid dans l’arithmétique) : erreurs de type attendues,
+//   au même pc partout. Exécuté par l’interpréteur (chargé prouvé), sans vérification
+//   (VT_VM_LOAD_NO_VERIFY, pile testée à chaque op) et par le JIT (seuil 1, seuil tiré au
+//   hasard, 2 désoptimisations avant retour à l’interpréteur).
+// - Flux d’ops aléatoire (StreamGen) : refus du chargeur identiques sous tous les flags ;
+//   sinon chargé prouvé ou non selon le vérificateur, et exécuté sans vérification, par
+//   défaut (sans tests de pile s’il est prouvé) et par le JIT. Un flux prouvé ne doit
+//   jamais produire d’erreur de pile dans la version testée.
+// - Chunk malformé : un défaut injecté dans le programme structuré (sous-dépassements, y
+//   compris sur un chemin jamais pris, jonction incohérente, ConstIx / FuncIx / cible de
+//   saut / symbole hors limites, indice d’upvalue hors de u16) doit être refusé sous
+//   VT_VM_LOAD_STRICT (ou au chargement quel que soit le flag pour les indices), et son
+//   exécution en repli testé doit échouer proprement, à l’identique partout.
+// Partout : code de retour, résultat, sortie de Print et message d’erreur identiques. Code
+// de sortie 1 au premier écart (graine et numéro affichés ; `--emit DIR` écrit le chunk
+// fautif, à repasser à bench_vm_dispatch). À lancer aussi sous -fsanitize=address,undefined.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/vm_fuzz.cpp native/vm_interp.cpp
+//       native/vt_value.cpp native/vt_native.cpp -o build/fuzz_vm
+//   ./build/fuzz_vm [--programs 2000] [--seed 1] [--program N] [--iters 200] [--emit DIR]
+
+#include "vm_chunk.hpp"
+#include "vm_interp.h"
+#include "vm_verify.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using vt::ChunkOpCode;
+
+static vt::ChunkConst k_int(int64_t i) {
+    vt::ChunkConst c;
+    c.kind = vt::ChunkConstKind::I64;
+    c.i = i;
+    return c;
+}
+
+static vt::ChunkConst k_float(double f) {
+    vt::ChunkConst c;
+    c.kind = vt::ChunkConstKind::F64;
+    c.f = f;
+    return c;
+}
+
+static const char* const FN_NAMES[] = {"f0", "f1", "f2", "f3", "f4", "f5"};
+constexpr uint32_t MAX_FNS = 6;
+constexpr uint32_t USER_LOCALS = 4;   // locaux 0..3 ; 4 : compteur (haut niveau), 4..5 : boucles
+
+// Générateur : pile équilibrée par construction (le programme passe le vérificateur).
+class Gen {
+public:
+    Gen(uint64_t seed, uint32_t iters) : g_(seed), iters_(iters) {}
+
+    vt::Chunk program() {
+        wild_ = chance(12);
+        consts();
+        const uint32_t nf = 1 + rnd(MAX_FNS);
+        for (uint32_t f = 0; f < nf; ++f) fns_.push_back(Fn{rnd(3), rnd(3), 0});
+
+        top_level();
+        for (uint32_t f = 0; f < nf; ++f) {
+            fns_[f].pc = static_cast<uint32_t>(c_.ops.size());
+            body(f);
+        }
+        for (uint32_t f = 0; f < nf; ++f) c_.symbols.push_back({FN_NAMES[f], fns_[f].pc});
+        return std::move(c_);
+    }
+
+private:
+    struct Fn {
+        uint32_t argc, nup, pc;
+    };
+
+    std::mt19937_64 g_;
+    uint32_t iters_;
+    vt::Chunk c_;
+    std::vector<Fn> fns_;
+    std::vector<uint32_t> nums_, others_;
+    uint32_t k_zero_ = 0, k_one_ = 0, k_iters_ = 0, k_bound_[2] = {0, 0};
+    bool wild_ = false;
+    // Fonction en cours : indice (MAX_FNS : haut niveau), appels restants, boucles ouvertes.
+    uint32_t cur_ = MAX_FNS;
+    int calls_left_ = 0;
+    uint32_t loops_ = 0;
+
+    uint32_t rnd(uint32_t n) { return static_cast<uint32_t>(g_() % n); }
+    bool chance(uint32_t pct) { return rnd(100) < pct; }
+
+    uint32_t konst(vt::ChunkConst k) {
+        c_.consts.push_back(k);
+        return static_cast<uint32_t>(c_.consts.size() - 1);
+    }
+
+    void consts() {
+        k_zero_ = konst(k_int(0));
+        k_one_ = konst(k_int(1));
+        k_iters_ = konst(k_int(iters_));
+        k_bound_[0] = konst(k_int(2));
+        k_bound_[1] = konst(k_int(3));
+        nums_ = {k_zero_, k_one_, k_bound_[0], k_bound_[1]};
+        for (int i = 0; i < 6; ++i) nums_.push_back(konst(k_int(static_cast<int64_t>(rnd(41)) - 20)));
+        const int64_t big = (int64_t(1) << 47) - 1 - rnd(64);
+        nums_.push_back(konst(k_int(big)));
+        nums_.push_back(konst(k_int(-big)));
+        nums_.push_back(konst(k_int(int64_t(1) << 40)));
+        for (double f : {0.5, -1.25, 3.0, 1e300}) nums_.push_back(konst(k_float(f)));
+        if (!wild_) return;
+        vt::ChunkConst b, n, s;
+        b.kind = vt::ChunkConstKind::Bool;
+        b.b = true;
+        s.kind = vt::ChunkConstKind::Str;
+        s.s = "ab";
+        others_ = {konst(b), konst(n), konst(s)};
+    }
+
+    size_t emit(ChunkOpCode code, uint32_t a = 0, uint8_t n = 0) {
+        vt::ChunkOp o;
+        o.code = code;
+        o.a = a;
+        o.n = n;
+        c_.ops.push_back(o);
+        return c_.ops.size() - 1;
+    }
+    size_t here() const { return c_.ops.size(); }
+    void patch(size_t at, size_t target) {
+        c_.ops[at].a = static_cast<uint32_t>(static_cast<int32_t>(target) - static_cast<int32_t>(at) - 1);
+    }
+
+    // Nombre (sauf programme sauvage) : constante, local, upvalue, compteur de boucle.
+    void leaf() {
+        if (wild_ && chance(6)) {
+            const uint32_t r = rnd(5);
+            if (r < 3) emit(ChunkOpCode::LoadConst, others_[r]);
+            else emit(r == 3 ? ChunkOpCode::LoadFalse : ChunkOpCode::LoadNull);
+            return;
+        }
+        const uint32_t nup = cur_ < MAX_FNS ? fns_[cur_].nup : 0;
+        const uint32_t r = rnd(10);
+        if (r < 4) {
+            emit(ChunkOpCode::LoadConst, nums_[rnd(static_cast<uint32_t>(nums_.size()))]);
+        } else if (r < 8 || (!nup && !loops_)) {
+            emit(ChunkOpCode::LoadLocal, rnd(USER_LOCALS));
+        } else if (nup && (r == 8 || !loops_)) {
+            emit(ChunkOpCode::LoadUpvalue, rnd(nup));
+        } else {
+            emit(ChunkOpCode::LoadLocal, USER_LOCALS + rnd(loops_));
+        }
+    }
+
+    // Booléen : comparaison ou négation (programme sauvage : aussi un nombre).
+    void cond(int depth) {
+        if (wild_ && chance(10)) return num(depth);
+        static const ChunkOpCode cmp[] = {ChunkOpCode::Lt, ChunkOpCode::Le, ChunkOpCode::Gt,
+                                          ChunkOpCode::Ge, ChunkOpCode::Eq, ChunkOpCode::Ne};
+        num(depth - 1);
+        num(depth - 1);
+        emit(cmp[rnd(6)]);
+        if (chance(15)) emit(ChunkOpCode::Not);
+    }
+
+    void num(int depth) {
+        static const ChunkOpCode bin[] = {ChunkOpCode::Add, ChunkOpCode::Add, ChunkOpCode::Sub, ChunkOpCode::Sub,
+                                          ChunkOpCode::Mul, ChunkOpCode::Mul, ChunkOpCode::Div, ChunkOpCode::Mod};
+        const uint32_t r = depth <= 0 ? 0 : rnd(12);
+        if (r < 4) {
+            leaf();
+        } else if (r < 8) {
+            num(depth - 1);
+            num(depth - 1);
+            emit(bin[rnd(8)]);
+        } else if (r < 9) {
+            num(depth - 1);
+            emit(ChunkOpCode::Neg);
+        } else if (r < 10) {   // c ? a : b
+            cond(depth - 1);
+            const size_t jf = emit(ChunkOpCode::JumpIfFalse);
+            num(depth - 1);
+            const size_t j = emit(ChunkOpCode::Jump);
+            patch(jf, here());
+            num(depth - 1);
+            patch(j, here());
+        } else if (can_call()) {
+            call(false);
+        } else {
+            leaf();
+        }
+    }
+
+    // Appels : vers une fonction précédente (graphe acyclique), hors boucle (coût borné).
+    bool can_call() const { return cur_ > 0 && calls_left_ > 0 && loops_ == 0; }
+
+    void call(bool tail) {
+        const uint32_t f = rnd(std::min<uint32_t>(cur_, static_cast<uint32_t>(fns_.size())));
+        --calls_left_;
+        emit(ChunkOpCode::MakeClosure, f, static_cast<uint8_t>(fns_[f].nup));
+        for (uint32_t a = 0; a < fns_[f].argc; ++a) num(1);
+        emit(tail ? ChunkOpCode::TailCall : ChunkOpCode::Call, f, static_cast<uint8_t>(fns_[f].argc));
+    }
+
+    void stmt(int depth) {
+        const uint32_t nup = cur_ < MAX_FNS ? fns_[cur_].nup : 0;
+        const uint32_t r = depth <= 0 ? rnd(4) : rnd(10);
+        if (r < 2) {
+            num(2);
+            emit(ChunkOpCode::StoreLocal, rnd(USER_LOCALS));
+        } else if (r < 3) {
+            num(2);
+            emit(ChunkOpCode::Print);
+        } else if (r < 4) {
+            num(2);
+            if (nup) emit(ChunkOpCode::StoreUpvalue, rnd(nup));
+            else emit(ChunkOpCode::Pop);
+        } else if (r < 7) {   // si / sinon
+            cond(2);
+            const size_t jf = emit(ChunkOpCode::JumpIfFalse);
+            block(depth - 1);
+            if (chance(50)) {
+                const size_t j = emit(ChunkOpCode::Jump);
+                patch(jf, here());
+                block(depth - 1);
+                patch(j, here());
+            } else {
+                patch(jf, here());
+            }
+        } else if (loops_ < 2) {   // for c in 0..K
+            const uint32_t c = USER_LOCALS + loops_;
+            emit(ChunkOpCode::LoadConst, k_zero_);
+            emit(ChunkOpCode::StoreLocal, c);
+            const size_t head = here();
+            emit(ChunkOpCode::LoadLocal, c);
+            emit(ChunkOpCode::LoadConst, k_bound_[rnd(2)]);
+            emit(ChunkOpCode::Lt);
+            const size_t jf = emit(ChunkOpCode::JumpIfFalse);
+            ++loops_;
+            block(depth - 1);
+            --loops_;
+            emit(ChunkOpCode::LoadLocal, c);
+            emit(ChunkOpCode::LoadConst, k_one_);
+            emit(ChunkOpCode::Add);
+            emit(ChunkOpCode::StoreLocal, c);
+            patch(emit(ChunkOpCode::Jump), head);
+            patch(jf, here());
+        } else {
+            num(2);
+            emit(ChunkOpCode::StoreLocal, rnd(USER_LOCALS));
+        }
+    }
+
+    void block(int depth) {
+        for (uint32_t n = 1 + rnd(3); n > 0; --n) stmt(depth);
+    }
+
+    // Locaux non-arguments initialisés : un local nul dans l’arithmétique serait une erreur
+    // de type (voulue seulement dans les programmes sauvages).
+    void body(uint32_t f) {
+        cur_ = f;
+        calls_left_ = 2;
+        for (uint32_t l = fns_[f].argc; l < USER_LOCALS; ++l) {
+            emit(ChunkOpCode::LoadConst, nums_[rnd(static_cast<uint32_t>(nums_.size()))]);
+            emit(ChunkOpCode::StoreLocal, l);
+        }
+        block(2);
+        const uint32_t r = rnd(10);
+        if (wild_ && r == 0) {
+            emit(ChunkOpCode::ReturnVoid);
+        } else if (r < 3 && f > 0) {
+            calls_left_ = 1;
+            call(true);
+        } else {
+            num(3);
+            emit(ChunkOpCode::Return);
+        }
+    }
+
+    // locaux = 0 ; i = 0 ; tant que i < iters { locaux 0..3 = f(i) ; print fk(…) pour chaque k ; i += 1 }
+    void top_level() {
+        cur_ = MAX_FNS;
+        for (uint32_t l = 0; l <= USER_LOCALS; ++l) {
+            emit(ChunkOpCode::LoadConst, k_zero_);
+            emit(ChunkOpCode::StoreLocal, l);
+        }
+        const size_t head = here();
+        emit(ChunkOpCode::LoadLocal, USER_LOCALS);
+        emit(ChunkOpCode::LoadConst, k_iters_);
+        emit(ChunkOpCode::Lt);
+        const size_t jf = emit(ChunkOpCode::JumpIfFalse);
+        loops_ = 1;   // le compteur est lisible comme une feuille
+        for (uint32_t l = 0; l < USER_LOCALS; ++l) {
+            emit(ChunkOpCode::LoadLocal, USER_LOCALS);
+            if (l) {
+                num(1);
+                emit(l % 2 ? ChunkOpCode::Mul : ChunkOpCode::Add);
+            }
+            emit(ChunkOpCode::StoreLocal, l);
+        }
+        for (uint32_t f = 0; f < fns_.size(); ++f) {
+            emit(ChunkOpCode::MakeClosure, f, static_cast<uint8_t>(fns_[f].nup));
+            for (uint32_t a = 0; a < fns_[f].argc; ++a) num(1);
+            emit(ChunkOpCode::Call, f, static_cast<uint8_t>(fns_[f].argc));
+            emit(ChunkOpCode::Print);
+        }
+        loops_ = 0;
+        emit(ChunkOpCode::LoadLocal, USER_LOCALS);
+        emit(ChunkOpCode::LoadConst, k_one_);
+        emit(ChunkOpCode::Add);
+        emit(ChunkOpCode::StoreLocal, USER_LOCALS);
+        patch(emit(ChunkOpCode::Jump), head);
+        patch(jf, here());
+        emit(ChunkOpCode::LoadLocal, 0);
+        emit(ChunkOpCode::Return);
+    }
+};
+
+// Flux d’ops sans structure : profondeur suivie en ligne droite, sauts en avant seulement.
+// Un flux sur deux est « négligé » (1 op sur 10 ignore la profondeur, sauts plus longs),
+// un sur quatre porte des indices hors limites (ConstIx, FuncIx, cibles de saut, symboles).
+// Ni TailCall ni saut arrière : tout run termine (récursion bornée par max_frames).
+class StreamGen {
+public:
+    explicit StreamGen(uint64_t seed) : g_(seed) {}
+
+    vt::Chunk program() {
+        sloppy_ = chance(50);
+        bad_ = chance(25);
+        nk_ = 1 + rnd(6);
+        for (uint32_t i = 0; i < nk_; ++i) {
+            c_.consts.push_back(chance(80) ? k_int(static_cast<int64_t>(rnd(21)) - 10) : k_float(0.5 * rnd(8)));
+        }
+        nf_ = rnd(4);
+        std::vector<uint32_t> starts;
+        for (uint32_t seg = 0; seg <= nf_; ++seg) {
+            starts.push_back(static_cast<uint32_t>(c_.ops.size()));
+            segment(seg);
+        }
+        for (uint32_t f = 0; f < nf_; ++f) c_.symbols.push_back({FN_NAMES[f], starts[f + 1]});
+        if (bad_ && chance(10)) {
+            c_.symbols.push_back({FN_NAMES[MAX_FNS - 1], static_cast<uint32_t>(c_.ops.size()) + 1 + rnd(4)});
+        }
+        return std::move(c_);
+    }
+
+private:
+    std::mt19937_64 g_;
+    vt::Chunk c_;
+    uint32_t nk_ = 0, nf_ = 0;
+    bool sloppy_ = false, bad_ = false;
+
+    uint32_t rnd(uint32_t n) { return static_cast<uint32_t>(g_() % n); }
+    bool chance(uint32_t pct) { return rnd(100) < pct; }
+    bool oob() { return bad_ && chance(5); }
+
+    void emit(ChunkOpCode code, uint32_t a = 0, uint8_t n = 0) {
+        vt::ChunkOp o;
+        o.code = code;
+        o.a = a;
+        o.n = n;
+        c_.ops.push_back(o);
+    }
+
+    // Segment `seg` : 0 = haut niveau, sinon fonction FuncIx seg - 1.
+    void segment(uint32_t seg) {
+        const size_t end = c_.ops.size() + 4 + rnd(28);
+        int32_t d = 0;
+        while (c_.ops.size() < end) {
+            const auto code = static_cast<ChunkOpCode>(rnd(vt::kChunkOpCount));
+            vt::ChunkOp probe;
+            probe.code = code;
+            probe.n = static_cast<uint8_t>(rnd(4));
+            int32_t pop, push;
+            vt::vm::stack_effect(probe, pop, push);
+            const bool valid = !sloppy_ || chance(90);
+            if (valid && pop > d) continue;
+            if (code == ChunkOpCode::TailCall || code == ChunkOpCode::Return || code == ChunkOpCode::ReturnVoid) {
+                continue;
+            }
+
+            switch (code) {
+            case ChunkOpCode::LoadConst:
+                emit(code, oob() ? nk_ + rnd(3) : rnd(nk_));
+                break;
+            case ChunkOpCode::LoadLocal: case ChunkOpCode::StoreLocal:
+                emit(code, rnd(6));
+                break;
+            case ChunkOpCode::LoadUpvalue: case ChunkOpCode::StoreUpvalue:
+                emit(code, rnd(3));
+                break;
+            case ChunkOpCode::Jump: case ChunkOpCode::JumpIfFalse: {
+                const auto room = static_cast<uint32_t>(end - c_.ops.size());
+                // Hors saut vide, la profondeur à la cible diffère souvent : refus du vérificateur.
+                uint32_t off = sloppy_ || chance(20) ? rnd(std::min<uint32_t>(room, 6)) : 0;
+                if (oob()) {
+                    off = chance(50) ? room + 64 : static_cast<uint32_t>(-static_cast<int32_t>(c_.ops.size()) - 2);
+                }
+                emit(code, off);
+                break;
+            }
+            case ChunkOpCode::MakeClosure:
+                if (!nf_ && !bad_) continue;
+                emit(code, oob() || !nf_ ? nf_ + rnd(2) : rnd(nf_), static_cast<uint8_t>(rnd(3)));
+                break;
+            case ChunkOpCode::Call:
+                // Le plus souvent : fermeture d’une fonction suivante, arguments, Call.
+                if (valid && seg < nf_) {
+                    const uint32_t f = seg + rnd(nf_ - seg);
+                    emit(ChunkOpCode::MakeClosure, f, static_cast<uint8_t>(rnd(3)));
+                    for (uint8_t a = 0; a < probe.n; ++a) emit(ChunkOpCode::LoadConst, rnd(nk_));
+                    pop = 0;
+                    push = 1;
+                }
+                emit(code, 0, probe.n);
+                break;
+            default:
+                emit(code);
+                break;
+            }
+            d = std::max(0, d - pop + push);
+        }
+        if (d > 0) {
+            emit(ChunkOpCode::Return);
+        } else if (seg == 0) {
+            emit(ChunkOpCode::LoadNull);
+            emit(ChunkOpCode::Return);
+        } else {
+            emit(ChunkOpCode::ReturnVoid);
+        }
+    }
+};
+
+// Insère `ins` devant l’op `at` : sauts recalés (une cible `at` garde l’op d’origine),
+// symboles d’entrée `at` dirigés sur les ops insérées.
+static void insert_ops(vt::Chunk& c, uint32_t at, const std::vector<vt::ChunkOp>& ins) {
+    const auto k = static_cast<int64_t>(ins.size());
+    for (uint32_t pc = 0; pc < c.ops.size(); ++pc) {
+        vt::ChunkOp& op = c.ops[pc];
+        if (op.code != ChunkOpCode::Jump && op.code != ChunkOpCode::JumpIfFalse) continue;
+        const int64_t t = op.jump_target(pc);
+        const int64_t from = pc < at ? pc : pc + k;
+        const int64_t to = t < at ? t : t + k;
+        op.a = static_cast<uint32_t>(static_cast<int32_t>(to - from - 1));
+    }
+    c.ops.insert(c.ops.begin() + at, ins.begin(), ins.end());
+    for (vt::ChunkSymbol& s : c.symbols) {
+        if (s.pc != VT_NATIVE_IMPORT_PC && s.pc > at) s.pc += static_cast<uint32_t>(k);
+    }
+}
+
+static vt::ChunkOp mk(ChunkOpCode code, uint32_t a = 0, uint8_t n = 0) {
+    vt::ChunkOp o;
+    o.code = code;
+    o.a = a;
+    o.n = n;
+    return o;
+}
+
+// Défauts injectés dans un programme valide. load : code attendu de tout chargement
+// (VT_VM_OK : chargeable, refusé seulement sous VT_VM_LOAD_STRICT) ; run : code attendu de
+// l’exécution (1 : quelconque, identique dans tous les modes).
+enum Defect {
+    D_POP, D_CALL, D_RETURN, D_UNTAKEN, D_JOIN, D_CONST, D_FUNC, D_JUMP_END, D_JUMP_NEG, D_SYMBOL, D_LOCAL16,
+    D_COUNT,
+};
+
+static const struct {
+    const char* name;
+    int load;
+    int run;
+} DEFECTS[D_COUNT] = {
+    {"sous-dépassement : Pop", VT_VM_OK, VT_VM_E_STACK},
+    {"sous-dépassement : Call 2", VT_VM_OK, VT_VM_E_STACK},
+    {"sous-dépassement : Return", VT_VM_OK, VT_VM_E_STACK},
+    {"sous-dépassement, chemin jamais pris", VT_VM_OK, 1},
+    {"jonction incohérente", VT_VM_OK, 1},
+    {"ConstIx hors du pool", VT_VM_E_BOUNDS, 0},
+    {"FuncIx hors des symboles", VT_VM_E_BOUNDS, 0},
+    {"saut après la fin", VT_VM_E_BOUNDS, 0},
+    {"saut avant le début", VT_VM_E_BOUNDS, 0},
+    {"symbole hors du code", VT_VM_E_BOUNDS, 0},
+    {"upvalue hors de u16 (format 2)", VT_VM_E_FORMAT, 0},
+};
+
+struct Outcome {
+    int rc = 0;
+    vt_vm_result r{};
+    std::string result;   // résultat formaté (la vue STR ne survit pas au vt_vm)
+    std::string out;      // sortie de Print
+    std::string error;
+    vt_vm_stats stats{};
+};
+
+static std::string describe(const vt_vm_result& r) {
+    char buf[64];
+    switch (r.kind) {
+    case VT_VM_NULL: return "null";
+    case VT_VM_BOOL: return r.i ? "true" : "false";
+    case VT_VM_INT: std::snprintf(buf, sizeof buf, "%lld", static_cast<long long>(r.i)); return buf;
+    case VT_VM_FLOAT: std::snprintf(buf, sizeof buf, "%.17g", r.f); return buf;
+    case VT_VM_STR: case VT_VM_BYTES: return "\"" + std::string(r.s, r.n) + "\"";
+    case VT_VM_FUNC: std::snprintf(buf, sizeof buf, "fn#%lld", static_cast<long long>(r.i)); return buf;
+    default: std::snprintf(buf, sizeof buf, "kind %d", r.kind); return buf;
+    }
+}
+
+struct Mode {
+    const char* name;
+    uint32_t backend, threshold, max_deopts;
+};
+
+// max_frames : 0 = défaut ; borné pour les flux aléatoires (récursion possible).
+static Outcome run(const vt_vm_program* p, const Mode& m, uint32_t max_frames = 0) {
+    vt_vm_config cfg;
+    vt_vm_config_default(&cfg);
+    cfg.backend = m.backend;
+    cfg.jit_threshold = m.threshold;
+    cfg.jit_max_deopts = m.max_deopts;
+    if (max_frames) cfg.max_frames = max_frames;
+    Outcome o;
+    vt_vm* vm = vt_vm_new(&cfg);
+    vt_vm_set_print(
+        vm, [](void* user, const char* s, size_t n) { static_cast<std::string*>(user)->append(s, n).push_back('\n'); },
+        &o.out);
+    o.rc = vt_vm_run(vm, p, nullptr, &o.r);
+    if (o.rc == VT_VM_OK) o.result = describe(o.r);
+    else o.error = vt_vm_last_error(vm);
+    vt_vm_get_stats(vm, &o.stats);
+    vt_vm_free(vm);
+    return o;
+}
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// Premier écart entre deux sorties de Print : numéro de ligne.
+static size_t first_diff_line(const std::string& a, const std::string& b) {
+    size_t line = 1;
+    for (size_t i = 0; i < std::min(a.size(), b.size()) && a[i] == b[i]; ++i) line += a[i] == '\n';
+    return line;
+}
+
+static const Mode INTERP = {"interpréteur", VT_VM_BACKEND_INTERP, 0, 0};
+
+class Fuzz {
+public:
+    uint64_t seed = 1;
+    uint32_t iters = 200;
+    const char* emit = nullptr;
+
+    uint64_t failed_runs = 0, compiled = 0, entries = 0, deopts = 0, discarded = 0;
+    uint64_t streams = 0, proven = 0, refused_verify = 0, refused_load = 0, stream_errors = 0;
+    uint64_t defects[D_COUNT] = {};
+
+    // Programme structuré : interpréteur (vérifié) = sans vérification = JIT ×3.
+    bool programs(uint64_t n) {
+        const std::vector<uint8_t> bytes = vt::encode_chunk(Gen(seed * 1'000'003 + n, iters).program());
+        vt_vm_program *p = nullptr, *pn = nullptr;
+        if (load(bytes, VT_VM_LOAD_STRICT, &p) != VT_VM_OK || load(bytes, VT_VM_LOAD_NO_VERIFY, &pn) != VT_VM_OK) {
+            vt_vm_program_free(p);
+            return fail("programme", n, bytes, "chargement refusé : %s", vt_vm_program_error());
+        }
+        std::mt19937 g(static_cast<uint32_t>(n));
+        const Outcome ref = run(p, INTERP);
+        const Mode modes[] = {
+            {"jit seuil 1", VT_VM_BACKEND_JIT, 1, 0},
+            {"jit seuil n", VT_VM_BACKEND_JIT, static_cast<uint32_t>(2 + g() % 63), 0},
+            {"jit 2 deopts", VT_VM_BACKEND_JIT, 1, 2},
+        };
+        bool ok = same(ref, run(pn, INTERP), INTERP.name, "sans vérification");
+        for (const Mode& m : modes) {
+            const Outcome o = run(p, m);
+            ok = same(ref, o, INTERP.name, m.name) && ok;
+            compiled += o.stats.jit_compiled;
+            entries += o.stats.jit_entries;
+            deopts += o.stats.jit_deopts;
+            discarded += o.stats.jit_discarded;
+        }
+        vt_vm_program_free(p);
+        vt_vm_program_free(pn);
+        failed_runs += ref.rc != VT_VM_OK;
+        return ok || fail("programme", n, bytes, "exécutions divergentes");
+    }
+
+    // Flux aléatoire : les refus du chargeur ne dépendent pas du vérificateur ; un flux prouvé
+    // s’exécute sans tests de pile et ne doit jamais rencontrer d’erreur de pile dans la
+    // version testée ; un flux non prouvé est refusé sous VT_VM_LOAD_STRICT et exécuté avec
+    // tests sinon. Dans les deux cas : testé = par défaut = JIT.
+    bool stream(uint64_t n) {
+        const std::vector<uint8_t> bytes = vt::encode_chunk(StreamGen(seed * 1'000'033 + n).program());
+        vt_vm_program *ps = nullptr, *pn = nullptr, *pd = nullptr;
+        const int rs = load(bytes, VT_VM_LOAD_STRICT, &ps);
+        const int rn = load(bytes, VT_VM_LOAD_NO_VERIFY, &pn);
+        const int rd = load(bytes, 0, &pd);
+        ++streams;
+        bool ok = true;
+        if (rn != VT_VM_OK) {
+            ++refused_load;
+            if (rs != rn || rd != rn) {
+                ok = fail("flux", n, bytes, "refus du chargeur incohérents : %d / %d / %d", rs, rn, rd);
+            }
+        } else if (rd != VT_VM_OK || (rs != VT_VM_OK && rs != VT_VM_E_VERIFY)) {
+            ok = fail("flux", n, bytes, "chargement : strict %d, défaut %d", rs, rd);
+        } else {
+            vt_vm_code_stats cs{};
+            vt_vm_program_code_stats(pd, &cs);
+            if ((cs.verified == 1) != (rs == VT_VM_OK)) {
+                ok = fail("flux", n, bytes, "verified=%u, strict %d", cs.verified, rs);
+            }
+            (rs == VT_VM_OK ? proven : refused_verify) += 1;
+            const Outcome ref = run(pn, INTERP, STREAM_FRAMES);
+            stream_errors += ref.rc != VT_VM_OK;
+            if (rs == VT_VM_OK && ref.rc == VT_VM_E_STACK) {
+                ok = fail("flux", n, bytes, "prouvé, mais erreur de pile à l’exécution : %s", ref.error.c_str());
+            }
+            const char* name = rs == VT_VM_OK ? "vérifié" : "repli testé";
+            const Mode jit = {"jit", VT_VM_BACKEND_JIT, 1, 0};
+            const bool agree = same(ref, run(pd, INTERP, STREAM_FRAMES), "sans vérification", name) &&
+                               same(ref, run(pd, jit, STREAM_FRAMES), "sans vérification", "jit");
+            if (!agree) ok = fail("flux", n, bytes, "exécutions divergentes");
+        }
+        vt_vm_program_free(ps);
+        vt_vm_program_free(pn);
+        vt_vm_program_free(pd);
+        return ok;
+    }
+
+    // Défaut injecté dans un programme structuré valide (sous-dépassements au pc 0, exécutés
+    // en premier ; les autres à l’entrée du haut niveau ou d’une fonction).
+    bool malformed(uint64_t n) {
+        const auto kind = static_cast<Defect>(n % D_COUNT);
+        std::mt19937 g(static_cast<uint32_t>(n * 7 + 1));
+        vt::Chunk c = Gen(seed * 1'000'003 + n, iters).program();
+        uint32_t at = 0;
+        if (kind > D_RETURN && g() % 2) at = c.symbols[g() % c.symbols.size()].pc;
+        const auto nops = static_cast<uint32_t>(c.ops.size());
+        switch (kind) {
+        case D_POP: insert_ops(c, at, {mk(ChunkOpCode::Pop)}); break;
+        case D_CALL: insert_ops(c, at, {mk(ChunkOpCode::Call, 0, 2)}); break;
+        case D_RETURN: insert_ops(c, at, {mk(ChunkOpCode::Return)}); break;
+        case D_UNTAKEN:
+            insert_ops(c, at, {mk(ChunkOpCode::LoadFalse), mk(ChunkOpCode::JumpIfFalse, 1), mk(ChunkOpCode::Pop)});
+            break;
+        case D_JOIN:
+            insert_ops(c, at, {mk(ChunkOpCode::LoadTrue), mk(ChunkOpCode::JumpIfFalse, 1), mk(ChunkOpCode::LoadNull)});
+            break;
+        case D_CONST: insert_ops(c, at, {mk(ChunkOpCode::LoadConst, static_cast<uint32_t>(c.consts.size()))}); break;
+        case D_FUNC: insert_ops(c, at, {mk(ChunkOpCode::MakeClosure, static_cast<uint32_t>(c.symbols.size()))}); break;
+        case D_JUMP_END: insert_ops(c, at, {mk(ChunkOpCode::Jump, nops + 8)}); break;
+        case D_JUMP_NEG:
+            insert_ops(c, at, {mk(ChunkOpCode::Jump, static_cast<uint32_t>(-static_cast<int32_t>(at) - 2))});
+            break;
+        case D_SYMBOL: c.symbols.push_back({FN_NAMES[MAX_FNS - 1], nops + 1}); break;
+        case D_LOCAL16: insert_ops(c, at, {mk(ChunkOpCode::LoadUpvalue, 0x10000)}); break;
+        default: break;
+        }
+        const std::vector<uint8_t> bytes = kind == D_LOCAL16 ? vt::encode_chunk_v2(c) : vt::encode_chunk(c);
+        const auto& want = DEFECTS[kind];
+        vt_vm_program *ps = nullptr, *pn = nullptr, *pd = nullptr;
+        const int rs = load(bytes, VT_VM_LOAD_STRICT, &ps);
+        const int rn = load(bytes, VT_VM_LOAD_NO_VERIFY, &pn);
+        const int rd = load(bytes, 0, &pd);
+        bool ok = true;
+        if (want.load != VT_VM_OK) {
+            if (rs != want.load || rn != want.load || rd != want.load) {
+                ok = fail(want.name, n, bytes, "chargements %d / %d / %d, attendu %d", rs, rn, rd, want.load);
+            }
+        } else if (rs != VT_VM_E_VERIFY || rn != VT_VM_OK || rd != VT_VM_OK) {
+            ok = fail(want.name, n, bytes, "chargements strict %d / sans vérification %d / défaut %d", rs, rn, rd);
+        } else {
+            const Outcome ref = run(pn, INTERP);
+            if (want.run != 1 && ref.rc != want.run) {
+                ok = fail(want.name, n, bytes, "exécution : rc %d, attendu %d", ref.rc, want.run);
+            }
+            const bool agree = same(ref, run(pd, INTERP), "sans vérification", "repli testé") &&
+                               same(ref, run(pd, {"jit", VT_VM_BACKEND_JIT, 1, 0}), "sans vérification", "jit");
+            if (!agree) ok = fail(want.name, n, bytes, "exécutions divergentes");
+        }
+        defects[kind] += ok;
+        vt_vm_program_free(ps);
+        vt_vm_program_free(pn);
+        vt_vm_program_free(pd);
+        return ok;
+    }
+
+private:
+    static constexpr uint32_t STREAM_FRAMES = 256;
+
+    static int load(const std::vector<uint8_t>& bytes, uint32_t flags, vt_vm_program** p) {
+        *p = nullptr;
+        return vt_vm_program_load(bytes.data(), bytes.size(), flags, p);
+    }
+
+    bool same(const Outcome& ref, const Outcome& o, const char* ref_name, const char* name) {
+        const bool ok = ref.rc == o.rc && ref.result == o.result && ref.out == o.out && ref.error == o.error;
+        if (ok) return true;
+        std::fprintf(stderr, "%s diffère de %s\n", name, ref_name);
+        std::fprintf(stderr, "  %-18s : rc %d  %s%s\n", ref_name, ref.rc, ref.result.c_str(), ref.error.c_str());
+        std::fprintf(stderr, "  %-18s : rc %d  %s%s\n", name, o.rc, o.result.c_str(), o.error.c_str());
+        if (ref.out != o.out) {
+            std::fprintf(stderr, "  sorties Print différentes à la ligne %zu\n", first_diff_line(ref.out, o.out));
+        }
+        return false;
+    }
+
+    // Affiche le cas (graine, numéro) et écrit le chunk sous --emit. Rend toujours false.
+    __attribute__((format(printf, 5, 6)))
+    bool fail(const char* what, uint64_t n, const std::vector<uint8_t>& bytes, const char* fmt, ...) {
+        std::fprintf(stderr, "%s %llu (graine %llu) : ", what, static_cast<unsigned long long>(n),
+                     static_cast<unsigned long long>(seed));
+        va_list ap;
+        va_start(ap, fmt);
+        std::vfprintf(stderr, fmt, ap);
+        va_end(ap);
+        std::fputc('\n', stderr);
+        if (emit) {
+            const std::string path =
+                std::string(emit) + "/vm_fuzz_" + std::to_string(seed) + "_" + std::to_string(n) + ".vitbc";
+            if (write_file(path, bytes)) std::fprintf(stderr, "  chunk : %s\n", path.c_str());
+        }
+        return false;
+    }
+};
+
+int main(int argc, char** argv) {
+    Fuzz fz;
+    uint64_t programs = 2000;
+    int64_t only = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--programs") && i + 1 < argc) programs = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) fz.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--program") && i + 1 < argc) only = std::atoll(argv[++i]);
+        else if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) fz.iters = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--emit") && i + 1 < argc) fz.emit = argv[++i];
+    }
+
+    const uint64_t first = only >= 0 ? static_cast<uint64_t>(only) : 0;
+    const uint64_t last = only >= 0 ? first + 1 : programs;
+    for (uint64_t n = first; n < last; ++n) {
+        if (!fz.programs(n) || !fz.stream(n) || !fz.malformed(n)) return 1;
+    }
+
+    const uint64_t count = last - first;
+    std::printf("programmes : %llu identiques sur 5 exécutions (dont %llu en erreur partout) ; jit : compilées=%llu "
+                "entrées=%llu deopts=%llu rendues=%llu\n",
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(fz.failed_runs),
+                static_cast<unsigned long long>(fz.compiled), static_cast<unsigned long long>(fz.entries),
+                static_cast<unsigned long long>(fz.deopts), static_cast<unsigned long long>(fz.discarded));
+    std::printf("flux aléatoires : %llu — prouvés %llu, refusés par le vérificateur %llu, par le chargeur %llu ; "
+                "%llu runs en erreur\n",
+                static_cast<unsigned long long>(fz.streams), static_cast<unsigned long long>(fz.proven),
+                static_cast<unsigned long long>(fz.refused_verify), static_cast<unsigned long long>(fz.refused_load),
+                static_cast<unsigned long long>(fz.stream_errors));
+    std::printf("chunks malformés refusés :\n");
+    for (int k = 0; k < D_COUNT; ++k) {
+        std::printf("  %6llu  %s\n", static_cast<unsigned long long>(fz.defects[k]), DEFECTS[k].name);
+    }
+#if defined(__x86_64__) && defined(__linux__)
+    if (count && !fz.compiled) {
+        std::fprintf(stderr, "aucune fonction compilée : le JIT n’a pas été exercé\n");
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,147 @@
+// benchmarks/micro/vm_load.cpp
+// Coût de chargement d’un chunk par `native/vm_interp.cpp` selon qu’il porte ses infos de
+// debug ou non : temps de vt_vm_program_load_file() (projection mmap, lignes et fichiers
+// bornés et hachés mais pas décodés) et RSS gagné, puis coût du premier décodage (première
+// ligne demandée) et taille de la table compacte. Le RSS est mesuré dans un processus fils
+// (un chargement par processus : l’allocateur ne recycle rien d’une mesure à l’autre).
+// Le programme : `ops` Nop suivis de Return, un run de ligne par op (pire cas du format :
+// 12 octets par run dans le chunk). `--format 2` écrit le format à plat (encode_chunk_v2 :
+// ops copiées d’un bloc, lignes ni lues ni hachées au chargement) au lieu du bincode.
+//
+// Build & run :
+//   g++ -std=c++20 -O2 -Inative benchmarks/micro/vm_load.cpp native/vm_interp.cpp
+//       native/vt_value.cpp native/vt_native.cpp -o build/bench_vm_load
+//   ./build/bench_vm_load [--ops 2000000] [--runs 5] [--dir /tmp] [--format 1|2]
+
+#include "vm_chunk.hpp"
+#include "vm_interp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+static std::vector<uint8_t> program(uint32_t nops, bool with_debug, int format) {
+    vt::Chunk c;
+    c.ops.resize(nops);   // Nop
+    vt::ChunkOp ret;
+    ret.code = vt::ChunkOpCode::ReturnVoid;
+    c.ops.push_back(ret);
+    c.symbols = {{"main", 0}};
+    if (with_debug) {
+        c.lines.reserve(c.ops.size());
+        for (uint32_t pc = 0; pc <= nops; ++pc) c.lines.push_back({pc, 1 + pc / 4, 1});
+        c.has_main_file = true;
+        c.main_file = "main.vt";
+        c.files = {"main.vt"};
+    } else {
+        c.stripped = true;
+    }
+    return format == 2 ? vt::encode_chunk_v2(c) : vt::encode_chunk(c);
+}
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// Pages résidentes (Linux) ; 0 ailleurs.
+static long rss_kib() {
+    long pages = 0;
+    if (std::FILE* f = std::fopen("/proc/self/statm", "r")) {
+        long size = 0;
+        if (std::fscanf(f, "%ld %ld", &size, &pages) != 2) pages = 0;
+        std::fclose(f);
+    }
+    return pages * 4;
+}
+
+// RSS ajouté par un chargement, dans un fils ; -1 si la mesure échoue.
+static long load_rss_kib(const std::string& path) {
+    int fds[2];
+    if (::pipe(fds) != 0) return -1;
+    const pid_t pid = ::fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        ::close(fds[0]);
+        const long r0 = rss_kib();
+        vt_vm_program* p = nullptr;
+        long d = vt_vm_program_load_file(path.c_str(), 0, &p) == 0 ? rss_kib() - r0 : -1;
+        (void)!::write(fds[1], &d, sizeof(d));
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+    long d = -1;
+    if (::read(fds[0], &d, sizeof(d)) != sizeof(d)) d = -1;
+    ::close(fds[0]);
+    ::waitpid(pid, nullptr, 0);
+    return d;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void bench(const char* name, const std::string& path, size_t size, long rss, int runs) {
+    double best = 1e30, first_line = 0;
+    vt_vm_code_stats cs{};
+    for (int r = 0; r < runs; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        vt_vm_program* p = nullptr;
+        if (vt_vm_program_load_file(path.c_str(), 0, &p) != 0) {
+            std::fprintf(stderr, "%s : %s\n", name, vt_vm_program_error());
+            std::exit(1);
+        }
+        best = std::min(best, seconds_since(t0));
+        const auto t1 = std::chrono::steady_clock::now();
+        (void)vt_vm_program_line_for_pc(p, 0);
+        first_line = seconds_since(t1);
+        vt_vm_program_code_stats(p, &cs);
+        vt_vm_program_free(p);
+    }
+    std::printf("%-8s fichier %7.1f Mo  chargement %8.2f ms  RSS +%7ld Kio  1re ligne %8.2f ms  table %7.1f Ko\n",
+                name, size / 1e6, best * 1e3, rss, first_line * 1e3, cs.line_bytes / 1e3);
+}
+
+int main(int argc, char** argv) {
+    uint32_t nops = 2000000;
+    int runs = 5;
+    std::string dir = "/tmp";
+    int format = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ops") && i + 1 < argc) nops = static_cast<uint32_t>(std::atol(argv[++i]));
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) runs = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--dir") && i + 1 < argc) dir = argv[++i];
+        else if (!std::strcmp(argv[i], "--format") && i + 1 < argc) format = std::atoi(argv[++i]) == 2 ? 2 : 1;
+    }
+
+    const std::string ps = dir + "/vm_load_stripped.vitbc";
+    const std::string pf = dir + "/vm_load_full.vitbc";
+    size_t ss = 0, sf = 0;
+    {
+        const std::vector<uint8_t> stripped = program(nops, false, format);
+        const std::vector<uint8_t> full = program(nops, true, format);
+        ss = stripped.size();
+        sf = full.size();
+        if (!write_file(ps, stripped) || !write_file(pf, full)) {
+            std::fprintf(stderr, "écriture impossible dans %s\n", dir.c_str());
+            return 1;
+        }
+    }
+    // Les deux fils partent du même état du tas.
+    const long rs = load_rss_kib(ps);
+    const long rf = load_rss_kib(pf);
+    bench("strippé", ps, ss, rs, runs);
+    bench("complet", pf, sf, rf, runs);
+    std::remove(ps.c_str());
+    std::remove(pf.c_str());
+    return 0;
+}
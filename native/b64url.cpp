@@ -0,0 +1,185 @@
+// native/b64url.cpp
+// Codec base64url vectorisé (cf. b64url.h).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -mssse3 -fPIC -c native/b64url.cpp -o build/b64url.o
+//
+// Remarques :
+// - Encodage (schéma de W. Muła) : pshufb répartit 12 octets en 16 groupes de 6 bits,
+//   deux multiplications 16 bits les alignent, puis une table de décalages (pshufb)
+//   transforme chaque index en caractère.
+// - Décodage : classement par plages (A-Z, a-z, 0-9, '-', '_') avec détection des
+//   caractères invalides, puis maddubs/madd recompactent 16 × 6 bits en 12 octets.
+// - Les jetons de pagination font quelques dizaines d’octets : le pas de 16 suffit, pas de
+//   chemin AVX2 dédié.
+
+#include "b64url.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace vt_b64 {
+
+constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+constexpr uint8_t BAD = 0xFF;
+
+struct DecodeTable {
+    uint8_t v[256];
+};
+
+constexpr DecodeTable make_decode_table() {
+    DecodeTable t{};
+    for (int i = 0; i < 256; ++i) t.v[i] = BAD;
+    for (int i = 0; i < 64; ++i) t.v[static_cast<uint8_t>(ALPHABET[i])] = static_cast<uint8_t>(i);
+    return t;
+}
+
+constexpr DecodeTable DEC = make_decode_table();
+
+#if defined(__SSSE3__)
+// 12 octets (sur 16 lus) → 16 caractères.
+static inline __m128i encode12(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i idx = _mm_or_si128(t1, t3);
+    // 0..25 → 13, 26..51 → 0, 52..61 → 1..10, 62 → 11, 63 → 12
+    __m128i sel = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    sel = _mm_or_si128(sel, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62,
+                                        '_' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, sel), idx);
+}
+
+static inline __m128i in_range(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+}
+
+// 16 caractères → 12 octets dans out[0..12). false si un caractère est hors alphabet.
+static inline bool decode16(const char* in, uint8_t* out) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i up = in_range(v, 'A', 'Z');
+    const __m128i lo = in_range(v, 'a', 'z');
+    const __m128i dg = in_range(v, '0', '9');
+    const __m128i dash = _mm_cmpeq_epi8(v, _mm_set1_epi8('-'));
+    const __m128i us = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    const __m128i any = _mm_or_si128(_mm_or_si128(up, lo), _mm_or_si128(dg, _mm_or_si128(dash, us)));
+    if (_mm_movemask_epi8(any) != 0xFFFF) return false;
+    // valeur = v + décalage de la plage (les plages sont disjointes)
+    __m128i off = _mm_and_si128(up, _mm_set1_epi8(-'A'));
+    off = _mm_or_si128(off, _mm_and_si128(lo, _mm_set1_epi8(26 - 'a')));
+    off = _mm_or_si128(off, _mm_and_si128(dg, _mm_set1_epi8(52 - '0')));
+    off = _mm_or_si128(off, _mm_and_si128(dash, _mm_set1_epi8(62 - '-')));
+    off = _mm_or_si128(off, _mm_and_si128(us, _mm_set1_epi8(63 - '_')));
+    const __m128i vals = _mm_add_epi8(v, off);
+    const __m128i ab = _mm_maddubs_epi16(vals, _mm_set1_epi32(0x01400140));
+    __m128i packed = _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+    packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    alignas(16) uint8_t tmp[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(tmp), packed);
+    std::memcpy(out, tmp, 12);
+    return true;
+}
+#endif
+
+thread_local std::string tls_buf;
+
+} // namespace vt_b64
+
+VT_EXTERN_C_BEGIN
+
+VT_API size_t vt_b64url_encoded_len(size_t n) { return (n / 3) * 4 + (n % 3 ? n % 3 + 1 : 0); }
+
+VT_API size_t vt_b64url_encode(const void* in, size_t n, char* out) {
+    using vt_b64::ALPHABET;
+    const uint8_t* p = static_cast<const uint8_t*>(in);
+    size_t i = 0, o = 0;
+#if defined(__SSSE3__)
+    for (; i + 16 <= n; i += 12, o += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), vt_b64::encode12(v));
+    }
+#endif
+    for (; i + 3 <= n; i += 3, o += 4) {
+        const uint32_t w = (uint32_t(p[i]) << 16) | (uint32_t(p[i + 1]) << 8) | p[i + 2];
+        out[o] = ALPHABET[w >> 18];
+        out[o + 1] = ALPHABET[(w >> 12) & 63];
+        out[o + 2] = ALPHABET[(w >> 6) & 63];
+        out[o + 3] = ALPHABET[w & 63];
+    }
+    if (n - i == 1) {
+        out[o++] = ALPHABET[p[i] >> 2];
+        out[o++] = ALPHABET[(p[i] & 3) << 4];
+    } else if (n - i == 2) {
+        const uint32_t w = (uint32_t(p[i]) << 8) | p[i + 1];
+        out[o++] = ALPHABET[w >> 10];
+        out[o++] = ALPHABET[(w >> 4) & 63];
+        out[o++] = ALPHABET[(w & 15) << 2];
+    }
+    return o;
+}
+
+VT_API int64_t vt_b64url_decode(const char* in, size_t n, void* out, size_t cap) {
+    using vt_b64::DEC;
+    using vt_b64::BAD;
+    while (n && in[n - 1] == '=') --n;
+    if (n % 4 == 1) return -EINVAL;
+    const size_t need = (n / 4) * 3 + (n % 4 ? n % 4 - 1 : 0);
+    if (need > cap) return -ENOSPC;
+    uint8_t* q = static_cast<uint8_t*>(out);
+    size_t i = 0, o = 0;
+#if defined(__SSSE3__)
+    // 16 caractères lus, 12 octets écrits : la garde `i + 16 <= n` suffit des deux côtés.
+    for (; i + 16 <= n; i += 16, o += 12)
+        if (!vt_b64::decode16(in + i, q + o)) return -EINVAL;
+#endif
+    for (; i + 4 <= n; i += 4, o += 3) {
+        const uint8_t a = DEC.v[uint8_t(in[i])], b = DEC.v[uint8_t(in[i + 1])];
+        const uint8_t c = DEC.v[uint8_t(in[i + 2])], d = DEC.v[uint8_t(in[i + 3])];
+        if ((a | b | c | d) & 0xC0) return -EINVAL;   // BAD = 0xFF, valeurs < 64
+        const uint32_t w = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+        q[o] = uint8_t(w >> 16);
+        q[o + 1] = uint8_t(w >> 8);
+        q[o + 2] = uint8_t(w);
+    }
+    if (n - i >= 2) {
+        const uint8_t a = DEC.v[uint8_t(in[i])], b = DEC.v[uint8_t(in[i + 1])];
+        if (a == BAD || b == BAD) return -EINVAL;
+        q[o++] = uint8_t((a << 2) | (b >> 4));
+        if (n - i == 3) {
+            const uint8_t c = DEC.v[uint8_t(in[i + 2])];
+            if (c == BAD) return -EINVAL;
+            q[o++] = uint8_t((b << 4) | (c >> 2));
+        }
+    }
+    return static_cast<int64_t>(o);
+}
+
+VT_API const char* vt_b64url_encode_cstr(const char* in, size_t n) {
+    std::string& b = vt_b64::tls_buf;
+    b.resize(vt_b64url_encoded_len(n));
+    b.resize(vt_b64url_encode(in, n, b.data()));
+    return b.c_str();
+}
+
+VT_API const char* vt_b64url_decode_cstr(const char* in, size_t n) {
+    std::string& b = vt_b64::tls_buf;
+    b.resize(n);
+    const int64_t r = vt_b64url_decode(in, n, b.data(), b.size());
+    if (r < 0) { b.clear(); return b.c_str(); }
+    b.resize(static_cast<size_t>(r));
+    if (std::memchr(b.data(), 0, b.size())) b.clear();
+    return b.c_str();
+}
+
+VT_EXTERN_C_END
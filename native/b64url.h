@@ -0,0 +1,40 @@
+// native/b64url.h
+// Codec base64url (RFC 4648 §5, alphabet A-Z a-z 0-9 - _, sans remplissage) vectorisé :
+// 12 octets ↔ 16 caractères par pas (SSSE3), repli scalaire pour la queue.
+//
+// API C exposée (ABI stable pour FFI):
+//   size_t      vt_b64url_encoded_len(size_t n);
+//   size_t      vt_b64url_encode(const void* in, size_t n, char* out);
+//   int64_t     vt_b64url_decode(const char* in, size_t n, void* out, size_t cap);
+//   const char* vt_b64url_encode_cstr(const char* in, size_t n);
+//   const char* vt_b64url_decode_cstr(const char* in, size_t n);
+//
+// Remarques :
+// - Le décodage accepte un éventuel remplissage `=` final et refuse tout autre caractère
+//   hors alphabet, ainsi qu’une longueur ≡ 1 (mod 4).
+// - Les variantes *_cstr écrivent dans un tampon par thread (valide jusqu’au prochain appel
+//   du même thread) : c’est la forme attendue par `-> String` côté Vitte. Le décodage
+//   rend "" si le jeton est invalide ou si la charge utile contient un octet NUL.
+
+#ifndef VITTE_NATIVE_B64URL_H
+#define VITTE_NATIVE_B64URL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+VT_API size_t      vt_b64url_encoded_len(size_t n);
+// `out` doit contenir vt_b64url_encoded_len(n) octets (pas de NUL ajouté). Retourne la longueur.
+VT_API size_t      vt_b64url_encode(const void* in, size_t n, char* out);
+// Retourne le nombre d’octets décodés, -EINVAL (entrée invalide) ou -ENOSPC (cap trop petit).
+VT_API int64_t     vt_b64url_decode(const char* in, size_t n, void* out, size_t cap);
+
+VT_API const char* vt_b64url_encode_cstr(const char* in, size_t n);
+VT_API const char* vt_b64url_decode_cstr(const char* in, size_t n);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_B64URL_H
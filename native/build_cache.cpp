@@ -0,0 +1,538 @@
+// native/build_cache.cpp
+// Cache de compilation adressé par contenu (cf. build_cache.h pour l’API C et le format).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -msha -msse4.1 -fPIC -c native/build_cache.cpp -o build/build_cache.o
+//   g++ build/app.o build/build_cache.o -pthread -o bin/vitc
+//
+// Remarques :
+// - POSIX (rename atomique dans un même système de fichiers, openat/fdopendir).
+// - SHA-256 par les instructions SHA (x86) avec -msha -msse4.1 : ~700 Mo/s contre ~170 Mo/s,
+//   et c’est l’essentiel du coût d’un hit.
+// - Une entrée ne dépend que de sa clé : aucun index partagé à tenir à jour, donc rien à
+//   verrouiller. La taille du cache n’est connue qu’en le balayant (éviction).
+
+#include "build_cache.h"
+#include "vitbc_image.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace vt_bcache_impl {
+
+using vt::vitbc_detail::crc32_ieee;
+using vt::vitbc_detail::load_le;
+
+constexpr char ENTRY_MAGIC[4] = {'V', 'T', 'C', 'E'};
+constexpr uint32_t ENTRY_VERSION = 1;
+constexpr size_t ENTRY_HEADER = 4 + 4 + 8 + 4 + 4 + 32;
+constexpr uint64_t DEFAULT_MAX_BYTES = 512ull << 20;
+constexpr time_t TOUCH_AFTER_S = 60;
+constexpr time_t STALE_TMP_S = 3600;
+
+/* ───────────────────────────── SHA-256 (FIPS 180-4) ───────────────────────────── */
+
+class Sha256 {
+public:
+    void update(const void* data, size_t n) {
+        auto* p = static_cast<const uint8_t*>(data);
+        total_ += n;
+        if (fill_) {
+            const size_t k = std::min(n, sizeof buf_ - fill_);
+            std::memcpy(buf_ + fill_, p, k);
+            fill_ += k;
+            p += k;
+            n -= k;
+            if (fill_ < sizeof buf_) return;
+            blocks(buf_, 1);
+            fill_ = 0;
+        }
+        blocks(p, n / 64);
+        p += n & ~size_t{63};
+        n &= 63;
+        std::memcpy(buf_, p, n);
+        fill_ = n;
+    }
+
+    // Champ préfixé par sa longueur (u64 LE) : ("ab","c") ≠ ("a","bc").
+    void field(const void* data, size_t n) {
+        const uint64_t len = n;
+        update(&len, sizeof len);
+        update(data, n);
+    }
+
+    void finish(uint8_t out[32]) {
+        const uint64_t bits = total_ * 8;
+        const uint8_t pad = 0x80;
+        update(&pad, 1);
+        static const uint8_t zeros[64] = {};
+        update(zeros, (fill_ <= 56 ? 56 : 120) - fill_);
+        uint8_t len[8];
+        for (int i = 0; i < 8; ++i) len[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        update(len, 8);
+        for (int i = 0; i < 8; ++i) {
+            for (int b = 0; b < 4; ++b) out[4 * i + b] = static_cast<uint8_t>(h_[i] >> (24 - 8 * b));
+        }
+    }
+
+private:
+    static constexpr uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+    // État rangé en ABEF / CDGH pour sha256rnds2 ; 4 rondes par groupe de 4 mots.
+    void blocks(const uint8_t* p, size_t n) {
+        if (!n) return;
+        const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+        __m128i t = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h_)), 0xB1);      // CDAB
+        __m128i s1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h_ + 4)), 0x1B); // EFGH
+        __m128i s0 = _mm_alignr_epi8(t, s1, 8);                                                         // ABEF
+        s1 = _mm_blend_epi16(s1, t, 0xF0);                                                              // CDGH
+        for (; n; --n, p += 64) {
+            const __m128i abef = s0, cdgh = s1;
+            __m128i w[4];
+            for (int g = 0; g < 16; ++g) {
+                __m128i& m = w[g & 3];
+                if (g < 4) {
+                    m = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * g)), bswap);
+                } else {
+                    // W[t-16] + σ0(W[t-15]) + W[t-7], puis + σ1(W[t-2]).
+                    const __m128i w7 = _mm_alignr_epi8(w[(g + 3) & 3], w[(g + 2) & 3], 4);
+                    m = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(m, w[(g + 1) & 3]), w7), w[(g + 3) & 3]);
+                }
+                __m128i k = _mm_add_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 4 * g)));
+                s1 = _mm_sha256rnds2_epu32(s1, s0, k);
+                s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(k, 0x0E));
+            }
+            s0 = _mm_add_epi32(s0, abef);
+            s1 = _mm_add_epi32(s1, cdgh);
+        }
+        t = _mm_shuffle_epi32(s0, 0x1B);                                                        // FEBA
+        s1 = _mm_shuffle_epi32(s1, 0xB1);                                                       // DCHG
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(h_), _mm_blend_epi16(t, s1, 0xF0));         // DCBA
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(h_ + 4), _mm_alignr_epi8(s1, t, 8));        // HGFE
+    }
+#else
+    void blocks(const uint8_t* p, size_t n) {
+        for (; n; --n, p += 64) block(p);
+    }
+#endif
+
+    void block(const uint8_t* p) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = uint32_t{p[4 * i]} << 24 | uint32_t{p[4 * i + 1]} << 16 | uint32_t{p[4 * i + 2]} << 8 | p[4 * i + 3];
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = h_[0], b = h_[1], c = h_[2], d = h_[3], e = h_[4], f = h_[5], g = h_[6], h = h_[7];
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        h_[0] += a;
+        h_[1] += b;
+        h_[2] += c;
+        h_[3] += d;
+        h_[4] += e;
+        h_[5] += f;
+        h_[6] += g;
+        h_[7] += h;
+    }
+
+    uint32_t h_[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    uint8_t buf_[64];
+    size_t fill_ = 0;
+    uint64_t total_ = 0;
+};
+
+/* ───────────────────────────── Fichiers ───────────────────────────── */
+
+static std::string hex(const vt_bcache_key& k) {
+    static const char digits[] = "0123456789abcdef";
+    std::string s(64, '0');
+    for (int i = 0; i < 32; ++i) {
+        s[2 * i] = digits[k.bytes[i] >> 4];
+        s[2 * i + 1] = digits[k.bytes[i] & 15];
+    }
+    return s;
+}
+
+static int read_all(int fd, uint8_t* p, size_t n) {
+    while (n) {
+        const ssize_t r = ::read(fd, p, n);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        if (r == 0) return -EIO;   // fichier plus court que son en-tête ne le dit
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return 0;
+}
+
+static int writev_all(int fd, iovec* iov, int cnt) {
+    while (cnt) {
+        const ssize_t w = ::writev(fd, iov, cnt);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        size_t left = static_cast<size_t>(w);
+        while (cnt && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --cnt;
+        }
+        if (cnt) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+    return 0;
+}
+
+static int mkdir_p(const std::string& path) {
+    std::string cur;
+    for (size_t i = 0; i <= path.size(); ++i) {
+        if (i < path.size() && path[i] != '/') continue;
+        cur = path.substr(0, i);
+        if (cur.empty()) continue;
+        if (::mkdir(cur.c_str(), 0755) != 0 && errno != EEXIST) return -errno;
+    }
+    return 0;
+}
+
+struct Scanned {
+    time_t mtime;
+    uint64_t size;
+    std::string path;
+};
+
+} // namespace vt_bcache_impl
+
+struct vt_bcache {
+    vt_bcache_config cfg{};
+    std::string root;                       // sans '/' final
+    std::atomic<uint64_t> tmp_seq{0};
+    std::atomic<uint64_t> since_scan{0};    // octets écrits depuis le dernier balayage
+    std::atomic<bool> evicting{false};
+
+    std::atomic<uint64_t> hits{0}, misses{0}, stores{0}, stored_bytes{0}, corrupt{0}, evictions{0},
+                          evicted_bytes{0}, errors{0};
+
+    std::string entry_path(const vt_bcache_key& k) const {
+        const std::string h = vt_bcache_impl::hex(k);
+        return root + "/" + h.substr(0, 2) + "/" + h.substr(2);
+    }
+};
+
+namespace vt_bcache_impl {
+
+// Entrée invalide : supprimée (un autre processus la réécrira), comptée comme miss.
+static int drop_corrupt(vt_bcache* c, const std::string& path) {
+    ::unlink(path.c_str());
+    c->corrupt.fetch_add(1, std::memory_order_relaxed);
+    c->misses.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+static int scan_and_evict(vt_bcache* c, uint64_t max_bytes) {
+    std::vector<Scanned> entries;
+    uint64_t total = 0;
+    const time_t now = std::time(nullptr);
+    const int rootfd = ::open(c->root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootfd < 0) return -errno;
+    for (int shard = -1; shard < 256; ++shard) {
+        char name[4];
+        if (shard < 0) std::memcpy(name, "tmp", 4);
+        else std::snprintf(name, sizeof name, "%02x", shard);
+        const int dfd = ::openat(rootfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dfd < 0) continue;
+        DIR* d = ::fdopendir(dfd);
+        if (!d) {
+            ::close(dfd);
+            continue;
+        }
+        while (dirent* e = ::readdir(d)) {
+            if (e->d_name[0] == '.') continue;
+            struct stat st;
+            if (::fstatat(dfd, e->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISREG(st.st_mode)) continue;
+            if (shard < 0) {
+                if (now - st.st_mtime > STALE_TMP_S) ::unlinkat(dfd, e->d_name, 0);
+                continue;
+            }
+            total += static_cast<uint64_t>(st.st_size);
+            entries.push_back({st.st_mtime, static_cast<uint64_t>(st.st_size),
+                               c->root + "/" + name + "/" + e->d_name});
+        }
+        ::closedir(d);
+    }
+    ::close(rootfd);
+    if (total <= max_bytes) return 0;
+
+    // Les moins récemment utilisées d’abord, jusqu’à 90 % : pas de balayage à chaque build.
+    const uint64_t target = max_bytes / 10 * 9;
+    std::sort(entries.begin(), entries.end(), [](const Scanned& a, const Scanned& b) { return a.mtime < b.mtime; });
+    int removed = 0;
+    for (const Scanned& e : entries) {
+        if (total <= target) break;
+        total -= e.size;
+        if (::unlink(e.path.c_str()) != 0) continue;   // déjà évincée par un autre processus
+        ++removed;
+        c->evictions.fetch_add(1, std::memory_order_relaxed);
+        c->evicted_bytes.fetch_add(e.size, std::memory_order_relaxed);
+    }
+    return removed;
+}
+
+// Un seul balayage à la fois dans le processus ; les autres appelants passent leur tour.
+static int try_evict(vt_bcache* c, uint64_t max_bytes) {
+    bool expected = false;
+    if (!c->evicting.compare_exchange_strong(expected, true, std::memory_order_acquire)) return 0;
+    c->since_scan.store(0, std::memory_order_relaxed);
+    const int r = scan_and_evict(c, max_bytes);
+    c->evicting.store(false, std::memory_order_release);
+    return r;
+}
+
+} // namespace vt_bcache_impl
+
+extern "C" {
+
+VT_API void vt_bcache_key_make(const void* src, size_t len, const char* options, const char* compiler_version,
+                               vt_bcache_key* out) {
+    if (!out) return;
+    using vt_bcache_impl::Sha256;
+    uint8_t src_hash[32];
+    Sha256 s;
+    s.update(src, src ? len : 0);
+    s.finish(src_hash);
+
+    static const char domain[] = "vitbc-cache/1";
+    Sha256 k;
+    k.field(domain, sizeof domain - 1);
+    k.field(compiler_version ? compiler_version : "", compiler_version ? std::strlen(compiler_version) : 0);
+    k.field(options ? options : "", options ? std::strlen(options) : 0);
+    k.field(src_hash, sizeof src_hash);
+    k.finish(out->bytes);
+}
+
+VT_API void vt_bcache_key_hex(const vt_bcache_key* k, char out[65]) {
+    if (!k || !out) return;
+    std::memcpy(out, vt_bcache_impl::hex(*k).c_str(), 65);
+}
+
+VT_API void vt_bcache_config_default(vt_bcache_config* cfg) {
+    if (!cfg) return;
+    cfg->dir = nullptr;
+    cfg->max_bytes = vt_bcache_impl::DEFAULT_MAX_BYTES;
+    cfg->file_mode = 0644;
+    cfg->flags = 0;
+}
+
+VT_API vt_bcache* vt_bcache_open(const vt_bcache_config* cfg) {
+    auto* c = new vt_bcache();
+    vt_bcache_config_default(&c->cfg);
+    if (cfg) {
+        if (cfg->max_bytes) c->cfg.max_bytes = cfg->max_bytes;
+        if (cfg->file_mode) c->cfg.file_mode = cfg->file_mode;
+        c->cfg.flags = cfg->flags;
+    }
+    if (cfg && cfg->dir && *cfg->dir) {
+        c->root = cfg->dir;
+    } else if (const char* env = std::getenv("VITTE_CACHE_DIR"); env && *env) {
+        c->root = env;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        c->root = std::string(home) + "/.vitte/cache";
+    } else {
+        delete c;
+        errno = ENOENT;
+        return nullptr;
+    }
+    while (c->root.size() > 1 && c->root.back() == '/') c->root.pop_back();
+    if (const int e = vt_bcache_impl::mkdir_p(c->root + "/tmp"); e != 0) {
+        delete c;
+        errno = -e;
+        return nullptr;
+    }
+    c->cfg.dir = nullptr;   // la chaîne de l’appelant ne survit pas forcément
+    return c;
+}
+
+VT_API void vt_bcache_close(vt_bcache* c) {
+    if (!c) return;
+    if (!(c->cfg.flags & VT_BCACHE_NO_AUTO_EVICT) && c->stores.load(std::memory_order_relaxed))
+        vt_bcache_impl::try_evict(c, c->cfg.max_bytes);
+    if (c->cfg.flags & VT_BCACHE_PRINT_STATS) {
+        char line[256];
+        vt_bcache_format_stats(c, line, sizeof line);
+        std::fprintf(stderr, "%s\n", line);
+    }
+    delete c;
+}
+
+VT_API int vt_bcache_get(vt_bcache* c, const vt_bcache_key* k, vt_bcache_blob* out) {
+    using namespace vt_bcache_impl;
+    if (!c || !k || !out) return -EINVAL;
+    *out = vt_bcache_blob{};
+    const std::string path = c->entry_path(*k);
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno != ENOENT) return -errno;
+        c->misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    struct Closer {
+        int fd;
+        ~Closer() { ::close(fd); }
+    } closer{fd};
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) return -errno;
+    uint8_t head[ENTRY_HEADER];
+    if (static_cast<uint64_t>(st.st_size) < ENTRY_HEADER || read_all(fd, head, sizeof head) != 0)
+        return drop_corrupt(c, path);
+    const uint64_t len = load_le<uint64_t>(head + 8);
+    if (std::memcmp(head, ENTRY_MAGIC, 4) != 0 || load_le<uint32_t>(head + 4) != ENTRY_VERSION ||
+        len != static_cast<uint64_t>(st.st_size) - ENTRY_HEADER || std::memcmp(head + 24, k->bytes, 32) != 0)
+        return drop_corrupt(c, path);
+
+    auto* data = static_cast<uint8_t*>(std::malloc(len ? len : 1));
+    if (!data) return -ENOMEM;
+    if (read_all(fd, data, len) != 0 || crc32_ieee(data, len) != load_le<uint32_t>(head + 16)) {
+        std::free(data);
+        return drop_corrupt(c, path);
+    }
+    // Date d’accès pour l’éviction LRU (atime n’est pas fiable : noatime, relatime).
+    if (std::time(nullptr) - st.st_mtime > TOUCH_AFTER_S) ::futimens(fd, nullptr);
+    out->data = data;
+    out->len = len;
+    c->hits.fetch_add(1, std::memory_order_relaxed);
+    return 1;
+}
+
+VT_API int vt_bcache_put(vt_bcache* c, const vt_bcache_key* k, const void* data, size_t len) {
+    using namespace vt_bcache_impl;
+    if (!c || !k || (!data && len)) return -EINVAL;
+    const std::string path = c->entry_path(*k);
+
+    uint8_t head[ENTRY_HEADER] = {};
+    const uint32_t version = ENTRY_VERSION, crc = crc32_ieee(static_cast<const uint8_t*>(data), len);
+    const uint64_t len64 = len;
+    std::memcpy(head, ENTRY_MAGIC, 4);
+    std::memcpy(head + 4, &version, 4);
+    std::memcpy(head + 8, &len64, 8);
+    std::memcpy(head + 16, &crc, 4);
+    std::memcpy(head + 24, k->bytes, 32);
+
+    // Nom temporaire unique entre processus (pid) et threads (séquence du cache).
+    char name[64];
+    std::snprintf(name, sizeof name, "/tmp/%ld.%llu", static_cast<long>(::getpid()),
+                  static_cast<unsigned long long>(c->tmp_seq.fetch_add(1, std::memory_order_relaxed)));
+    const std::string tmp = c->root + name;
+    const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, c->cfg.file_mode);
+    int err = fd < 0 ? -errno : 0;
+    if (fd >= 0) {
+        iovec iov[2] = {{head, sizeof head}, {const_cast<void*>(data), len}};
+        err = writev_all(fd, iov, 2);
+        if (::close(fd) != 0 && err == 0) err = -errno;
+    }
+    if (err == 0 && ::rename(tmp.c_str(), path.c_str()) != 0) {
+        // Premier passage dans ce répertoire de shard : on le crée et on réessaie.
+        err = -errno;
+        if (err == -ENOENT) {
+            const std::string shard = path.substr(0, path.rfind('/'));
+            if (::mkdir(shard.c_str(), 0755) == 0 || errno == EEXIST)
+                err = ::rename(tmp.c_str(), path.c_str()) == 0 ? 0 : -errno;
+        }
+    }
+    if (err != 0) {
+        if (fd >= 0) ::unlink(tmp.c_str());
+        c->errors.fetch_add(1, std::memory_order_relaxed);
+        return err;
+    }
+    c->stores.fetch_add(1, std::memory_order_relaxed);
+    c->stored_bytes.fetch_add(len, std::memory_order_relaxed);
+    const uint64_t added = c->since_scan.fetch_add(len + ENTRY_HEADER, std::memory_order_relaxed) + len + ENTRY_HEADER;
+    if (!(c->cfg.flags & VT_BCACHE_NO_AUTO_EVICT) && added > c->cfg.max_bytes / 8) try_evict(c, c->cfg.max_bytes);
+    return 0;
+}
+
+VT_API void vt_bcache_blob_free(vt_bcache_blob* b) {
+    if (!b) return;
+    std::free(b->data);
+    b->data = nullptr;
+    b->len = 0;
+}
+
+VT_API int vt_bcache_evict(vt_bcache* c, uint64_t max_bytes) {
+    if (!c) return -EINVAL;
+    return vt_bcache_impl::scan_and_evict(c, max_bytes ? max_bytes : c->cfg.max_bytes);
+}
+
+VT_API void vt_bcache_get_stats(const vt_bcache* c, vt_bcache_stats* out) {
+    if (!c || !out) return;
+    out->hits          = c->hits.load(std::memory_order_relaxed);
+    out->misses        = c->misses.load(std::memory_order_relaxed);
+    out->stores        = c->stores.load(std::memory_order_relaxed);
+    out->stored_bytes  = c->stored_bytes.load(std::memory_order_relaxed);
+    out->corrupt       = c->corrupt.load(std::memory_order_relaxed);
+    out->evictions     = c->evictions.load(std::memory_order_relaxed);
+    out->evicted_bytes = c->evicted_bytes.load(std::memory_order_relaxed);
+    out->errors        = c->errors.load(std::memory_order_relaxed);
+}
+
+VT_API size_t vt_bcache_format_stats(const vt_bcache* c, char* buf, size_t cap) {
+    vt_bcache_stats s{};
+    vt_bcache_get_stats(c, &s);
+    const uint64_t lookups = s.hits + s.misses;
+    const int n = std::snprintf(buf, cap,
+                                "cache : hits %llu, miss %llu (%.0f %%), écrits %llu (%.1f Ko), évincés %llu, "
+                                "corrompus %llu, erreurs %llu",
+                                static_cast<unsigned long long>(s.hits), static_cast<unsigned long long>(s.misses),
+                                lookups ? 100.0 * static_cast<double>(s.hits) / static_cast<double>(lookups) : 0.0,
+                                static_cast<unsigned long long>(s.stores), static_cast<double>(s.stored_bytes) / 1e3,
+                                static_cast<unsigned long long>(s.evictions),
+                                static_cast<unsigned long long>(s.corrupt), static_cast<unsigned long long>(s.errors));
+    return n < 0 ? 0 : static_cast<size_t>(n);
+}
+
+} // extern "C"
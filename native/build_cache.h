@@ -0,0 +1,118 @@
+// native/build_cache.h
+// Cache de compilation adressé par contenu : clé (source, options de compilation, version
+// du compilateur) → image VITBC, dans ~/.vitte/cache, partagé sans verrou entre builds
+// concurrents.
+//
+// API C exposée (ABI stable pour FFI):
+//   void       vt_bcache_key_make(const void* src, size_t len, const char* options,
+//                                 const char* compiler_version, vt_bcache_key* out);
+//   void       vt_bcache_key_hex(const vt_bcache_key* k, char out[65]);
+//   void       vt_bcache_config_default(vt_bcache_config* cfg);
+//   vt_bcache* vt_bcache_open(const vt_bcache_config* cfg);
+//   void       vt_bcache_close(vt_bcache* c);
+//   int        vt_bcache_get(vt_bcache* c, const vt_bcache_key* k, vt_bcache_blob* out);
+//   int        vt_bcache_put(vt_bcache* c, const vt_bcache_key* k, const void* data, size_t len);
+//   void       vt_bcache_blob_free(vt_bcache_blob* b);
+//   int        vt_bcache_evict(vt_bcache* c, uint64_t max_bytes);
+//   void       vt_bcache_get_stats(const vt_bcache* c, vt_bcache_stats* out);
+//   size_t     vt_bcache_format_stats(const vt_bcache* c, char* buf, size_t cap);
+//
+// Clé : SHA-256 de (version du compilateur, options, SHA-256 de la source), champs préfixés
+// par leur longueur. `options` : tout ce qui change la sortie, sérialisé par l’appelant
+// (Config : opt_level, debug_info, codegen… ; nom du fichier si les infos de debug le
+// portent).
+//
+// Disque :
+//   <dir>/ab/cdef…          entrée (64 chiffres hex de la clé, 2 premiers en répertoire)
+//   <dir>/tmp/              fichiers en cours d’écriture
+// Entrée = { "VTCE", version u32, len u64, crc32 u32, 0 u32, clé 32 o } + image.
+//
+// Concurrence (plusieurs processus, plusieurs threads) :
+// - Publication par rename(2) d’un fichier temporaire complet : un lecteur voit l’entrée
+//   entière ou rien ; deux écrivains d’une même clé produisent le même contenu.
+// - Aucun verrou : une éviction concurrente d’une entrée en cours de lecture est sans effet
+//   (le descripteur ouvert garde le fichier).
+// - Pas de fsync : une entrée perdue dans un crash se recompile ; une entrée tronquée ou
+//   corrompue (longueur, clé ou CRC faux) est supprimée et comptée comme miss.
+//
+// Éviction LRU bornée en taille :
+// - La date de modification sert de date d’accès : posée à l’écriture, rafraîchie par un
+//   hit (au plus une fois par minute et par entrée).
+// - Balayage complet du cache (stat de chaque entrée) puis suppression des plus anciennes
+//   jusqu’à 90 % de max_bytes. Automatique à la fermeture si ce processus a écrit, et en
+//   cours de route tous les max_bytes / 8 octets écrits : un build sans miss ne balaie rien.
+// - Fichiers temporaires de plus d’une heure (écrivain interrompu) supprimés au passage.
+//
+// Codes de retour : 0 (ou 1 pour un hit) si OK, -errno sinon. POSIX.
+
+#ifndef VITTE_NATIVE_BUILD_CACHE_H
+#define VITTE_NATIVE_BUILD_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum {
+    VT_BCACHE_PRINT_STATS   = 1u << 0,   // ligne de stats sur stderr à la fermeture
+    VT_BCACHE_NO_AUTO_EVICT = 1u << 1,   // éviction seulement par vt_bcache_evict()
+};
+
+typedef struct vt_bcache_key {
+    uint8_t bytes[32];
+} vt_bcache_key;
+
+typedef struct vt_bcache_config {
+    const char* dir;         // NULL : $VITTE_CACHE_DIR, sinon $HOME/.vitte/cache
+    uint64_t    max_bytes;   // taille max du cache (0 = 512 Mio)
+    uint32_t    file_mode;   // permissions des entrées (0 = 0644, umask appliqué)
+    uint32_t    flags;       // VT_BCACHE_*
+} vt_bcache_config;
+
+typedef struct vt_bcache_blob {
+    uint8_t* data;           // malloc, à rendre par vt_bcache_blob_free
+    size_t   len;
+} vt_bcache_blob;
+
+typedef struct vt_bcache_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t stores;         // entrées écrites par ce processus
+    uint64_t stored_bytes;
+    uint64_t corrupt;        // entrées invalides supprimées (aussi comptées en misses)
+    uint64_t evictions;      // entrées supprimées par l’éviction
+    uint64_t evicted_bytes;
+    uint64_t errors;         // écritures échouées
+} vt_bcache_stats;
+
+typedef struct vt_bcache vt_bcache;
+
+VT_API void       vt_bcache_key_make(const void* src, size_t len, const char* options,
+                                     const char* compiler_version, vt_bcache_key* out);
+VT_API void       vt_bcache_key_hex(const vt_bcache_key* k, char out[65]);
+
+VT_API void       vt_bcache_config_default(vt_bcache_config* cfg);
+// Crée les répertoires au besoin. NULL si impossible (errno positionné).
+VT_API vt_bcache* vt_bcache_open(const vt_bcache_config* cfg);
+// Éviction automatique éventuelle, stats (VT_BCACHE_PRINT_STATS), puis libération.
+VT_API void       vt_bcache_close(vt_bcache* c);
+
+// 1 : hit (*out rempli), 0 : miss, -errno : erreur de lecture.
+VT_API int        vt_bcache_get(vt_bcache* c, const vt_bcache_key* k, vt_bcache_blob* out);
+// Copie `data` dans le cache. 0 ou -errno (le build continue sans cache).
+VT_API int        vt_bcache_put(vt_bcache* c, const vt_bcache_key* k, const void* data, size_t len);
+VT_API void       vt_bcache_blob_free(vt_bcache_blob* b);
+
+// Ramène le cache sous `max_bytes` (0 = celui de la config). Rend le nombre d’entrées
+// supprimées ou -errno.
+VT_API int        vt_bcache_evict(vt_bcache* c, uint64_t max_bytes);
+
+VT_API void       vt_bcache_get_stats(const vt_bcache* c, vt_bcache_stats* out);
+// « cache : hits 34, miss 1 (97 %), écrits 1 (12.3 Ko), évincés 0, … » ; comme snprintf.
+VT_API size_t     vt_bcache_format_stats(const vt_bcache* c, char* buf, size_t cap);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_BUILD_CACHE_H
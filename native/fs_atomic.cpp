@@ -0,0 +1,427 @@
+// native/fs_atomic.cpp
+// Écriture atomique durable avec group commit (cf. fs_atomic.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/fs_atomic.cpp -o build/fs_atomic.o
+//   g++ build/app.o build/fs_atomic.o -pthread -o bin/worker-jobs
+//
+// Remarques :
+// - Linux (O_TMPFILE ≥ 3.11, io_uring ≥ 5.1 optionnel).
+// - Étapes d’un lot : écrire → fdatasync (parallèle) → publier (ordre FIFO) → fsync(dir) ×1.
+
+#include "fs_atomic.h"
+#include "uring.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace vt_fsa_impl {
+
+struct Req {
+    uint64_t           ticket = 0;
+    std::string        path;
+    std::vector<char>  data;
+    vt_fsa_done_fn     fn = nullptr;
+    void*              user = nullptr;
+
+    // état de commit
+    std::string        dir;
+    std::string        name;
+    int                dirfd = -1;
+    int                fd = -1;
+    bool               tmpfile = false;   // O_TMPFILE (pas de nom tant que non lié)
+    std::string        tmp_name;          // nom temporaire dans `dir`
+    int                err = 0;
+    bool               superseded = false;
+    Req*               winner = nullptr;      // écriture du même chemin qui l’a remplacée
+};
+
+static void split_path(const std::string& p, std::string& dir, std::string& name) {
+    const size_t k = p.rfind('/');
+    if (k == std::string::npos) { dir = "."; name = p; return; }
+    dir = k == 0 ? "/" : p.substr(0, k);
+    name = p.substr(k + 1);
+}
+
+static int write_all(int fd, const char* p, size_t n) {
+    while (n) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+    return 0;
+}
+
+} // namespace vt_fsa_impl
+
+struct vt_fsa {
+    vt_fsa_config cfg{};
+
+    std::mutex                          mu;
+    std::condition_variable             cv_work;   // committer
+    std::condition_variable             cv_done;   // vt_fsa_wait
+    std::deque<vt_fsa_impl::Req*>       queue;
+    std::unordered_map<uint64_t, int>   results;   // tickets sans callback, non encore lus
+    uint64_t                            next_ticket = 1;
+    uint64_t                            done_upto = 0;   // tous les tickets ≤ sont terminés
+    bool                                stopping = false;
+    bool                                tmpfile_ok = true;
+    std::thread                         committer;
+
+    std::atomic<uint64_t> writes{0}, failed{0}, batches{0}, file_syncs{0}, dir_syncs{0},
+                          superseded{0}, tmpfile{0};
+};
+
+namespace vt_fsa_impl {
+
+class Committer {
+public:
+    explicit Committer(vt_fsa* s) : s_(s) {
+        if (!(s->cfg.flags & VT_FSA_NO_URING)) ring_.init(256);
+    }
+
+    void run() {
+        std::vector<Req*> batch;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(s_->mu);
+                s_->cv_work.wait(lk, [&] { return s_->stopping || !s_->queue.empty(); });
+                if (s_->queue.empty() && s_->stopping) return;
+                if (s_->cfg.max_delay_us && s_->queue.size() < s_->cfg.max_batch && !s_->stopping) {
+                    s_->cv_work.wait_for(lk, std::chrono::microseconds(s_->cfg.max_delay_us), [&] {
+                        return s_->stopping || s_->queue.size() >= s_->cfg.max_batch;
+                    });
+                }
+                while (!s_->queue.empty() && batch.size() < s_->cfg.max_batch) {
+                    batch.push_back(s_->queue.front());
+                    s_->queue.pop_front();
+                }
+            }
+            commit(batch);
+            complete(batch);
+            batch.clear();
+        }
+    }
+
+private:
+    vt_fsa*   s_;
+    vt::Uring ring_;
+    uint32_t  gen_ = 0;   // lot courant, dans les 32 bits hauts de user_data
+
+    void commit(std::vector<Req*>& batch) {
+        // Dernière écriture gagnante par chemin.
+        std::unordered_map<std::string, Req*> winners;
+        for (size_t i = batch.size(); i-- > 0;) {
+            auto [it, first] = winners.emplace(batch[i]->path, batch[i]);
+            if (!first) {
+                batch[i]->superseded = true;
+                batch[i]->winner = it->second;
+                s_->superseded.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 1) Répertoires ouverts une fois par lot.
+        std::unordered_map<std::string, int> dirs;
+        for (Req* r : batch) {
+            if (r->superseded) continue;
+            split_path(r->path, r->dir, r->name);
+            auto it = dirs.find(r->dir);
+            if (it == dirs.end()) {
+                int dfd = ::open(r->dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                it = dirs.emplace(r->dir, dfd < 0 ? -errno : dfd).first;
+            }
+            if (it->second < 0) r->err = it->second;
+            else r->dirfd = it->second;
+        }
+
+        // 2) Données dans un fichier temporaire.
+        for (Req* r : batch) {
+            if (r->superseded || r->err) continue;
+            r->err = create_temp(*r);
+            if (!r->err) r->err = write_all(r->fd, r->data.data(), r->data.size());
+        }
+
+        // 3) Synchronisation des données, en parallèle.
+        sync_files(batch);
+
+        // 4) Publication dans l’ordre de soumission.
+        std::unordered_set<int> touched;
+        for (Req* r : batch) {
+            if (r->superseded) continue;
+            if (!r->err) r->err = publish(*r);
+            if (!r->err) touched.insert(r->dirfd);
+            cleanup(*r);
+        }
+
+        // 5) Un fsync par répertoire : rend les renommages durables pour tout le lot.
+        std::unordered_map<int, int> dir_err;
+        for (int dfd : touched) {
+            int e = 0;
+            while (::fsync(dfd) < 0) {
+                if (errno == EINTR) continue;
+                e = -errno;
+                break;
+            }
+            dir_err[dfd] = e;
+            s_->dir_syncs.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (Req* r : batch) {
+            if (!r->superseded && !r->err && dir_err[r->dirfd]) r->err = dir_err[r->dirfd];
+        }
+        // Une écriture remplacée n’est durable que si la gagnante l’est : même résultat.
+        for (Req* r : batch) {
+            if (r->superseded) r->err = r->winner->err;
+        }
+        for (auto& kv : dirs) if (kv.second >= 0) ::close(kv.second);
+        s_->batches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int create_temp(Req& r) {
+        const mode_t mode = static_cast<mode_t>(s_->cfg.file_mode);
+        bool try_tmpfile;
+        {
+            std::lock_guard<std::mutex> lk(s_->mu);
+            try_tmpfile = s_->tmpfile_ok && !(s_->cfg.flags & VT_FSA_NO_TMPFILE);
+        }
+        if (try_tmpfile) {
+            int fd = ::openat(r.dirfd, ".", O_TMPFILE | O_WRONLY | O_CLOEXEC, mode);
+            if (fd >= 0) {
+                r.fd = fd;
+                r.tmpfile = true;
+                return 0;
+            }
+            if (errno == EOPNOTSUPP || errno == EISDIR || errno == EINVAL) {
+                std::lock_guard<std::mutex> lk(s_->mu);
+                s_->tmpfile_ok = false;   // FS sans O_TMPFILE : on ne réessaie plus
+            } else {
+                return -errno;
+            }
+        }
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            r.tmp_name = r.name + ".tmp." + std::to_string(r.ticket) + "." + std::to_string(attempt);
+            int fd = ::openat(r.dirfd, r.tmp_name.c_str(),
+                              O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, mode);
+            if (fd >= 0) {
+                r.fd = fd;
+                return 0;
+            }
+            if (errno != EEXIST) {
+                r.tmp_name.clear();
+                return -errno;
+            }
+        }
+        r.tmp_name.clear();
+        return -EEXIST;
+    }
+
+    void sync_files(std::vector<Req*>& batch) {
+        std::vector<Req*> todo;
+        for (Req* r : batch) if (!r->superseded && !r->err) todo.push_back(r);
+        s_->file_syncs.fetch_add(todo.size(), std::memory_order_relaxed);
+
+        if (ring_.ok() && todo.size() > 1) {
+            // Chaque CQE porte son lot : celles d’un lot abandonné sur erreur, arrivées plus
+            // tard, sont ignorées au lieu d’être attribuées à l’indice d’un autre lot.
+            const uint64_t tag = uint64_t(++gen_) << 32;
+            size_t inflight = 0;
+            for (size_t i = 0; i < todo.size(); ++i) {
+                io_uring_sqe* sqe = ring_.sqe();
+                if (!sqe) { todo[i]->err = sync_one(todo[i]->fd); continue; }
+                sqe->opcode = IORING_OP_FSYNC;
+                sqe->fd = todo[i]->fd;
+                sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+                sqe->user_data = tag | i;
+                ++inflight;
+            }
+            while (inflight > 0) {
+                int rc = ring_.submit_and_wait(1);
+                if (rc < 0 && rc != -EINTR) break;
+                ring_.for_each_cqe([&](const io_uring_cqe& c) {
+                    if ((c.user_data & ~uint64_t(UINT32_MAX)) != tag) return;   // lot précédent
+                    if (c.res < 0) todo[c.user_data & UINT32_MAX]->err = c.res;
+                    --inflight;
+                });
+            }
+            if (inflight > 0) {
+                // Anneau en erreur : on retombe sur des fdatasync synchrones.
+                for (Req* r : todo) if (!r->err) r->err = sync_one(r->fd);
+            }
+            return;
+        }
+        for (Req* r : todo) r->err = sync_one(r->fd);
+    }
+
+    static int sync_one(int fd) {
+        while (::fdatasync(fd) < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        return 0;
+    }
+
+    int publish(Req& r) {
+        if (r.tmpfile) {
+            char proc[64];
+            std::snprintf(proc, sizeof(proc), "/proc/self/fd/%d", r.fd);
+            // Cible absente : lien direct, atomique et sans renommage.
+            if (::linkat(AT_FDCWD, proc, r.dirfd, r.name.c_str(), AT_SYMLINK_FOLLOW) == 0) {
+                s_->tmpfile.fetch_add(1, std::memory_order_relaxed);
+                return 0;
+            }
+            if (errno != EEXIST) return -errno;
+            for (int attempt = 0; attempt < 8; ++attempt) {
+                r.tmp_name = r.name + ".tmp." + std::to_string(r.ticket) + "." + std::to_string(attempt);
+                if (::linkat(AT_FDCWD, proc, r.dirfd, r.tmp_name.c_str(), AT_SYMLINK_FOLLOW) == 0) break;
+                r.tmp_name.clear();
+                if (errno != EEXIST) return -errno;
+            }
+            if (r.tmp_name.empty()) return -EEXIST;
+            s_->tmpfile.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (::renameat(r.dirfd, r.tmp_name.c_str(), r.dirfd, r.name.c_str()) < 0) return -errno;
+        r.tmp_name.clear();
+        return 0;
+    }
+
+    static void cleanup(Req& r) {
+        if (r.fd >= 0) ::close(r.fd);
+        r.fd = -1;
+        if (!r.tmp_name.empty() && r.dirfd >= 0) ::unlinkat(r.dirfd, r.tmp_name.c_str(), 0);
+        r.tmp_name.clear();
+    }
+
+    void complete(std::vector<Req*>& batch) {
+        uint64_t last = 0;
+        {
+            std::lock_guard<std::mutex> lk(s_->mu);
+            for (Req* r : batch) {
+                if (!r->fn) s_->results[r->ticket] = r->err;
+                last = r->ticket;
+            }
+            s_->done_upto = last;
+        }
+        s_->cv_done.notify_all();
+        for (Req* r : batch) {
+            if (r->err) s_->failed.fetch_add(1, std::memory_order_relaxed);
+            s_->writes.fetch_add(1, std::memory_order_relaxed);
+            if (r->fn) r->fn(r->user, r->err);
+            delete r;
+        }
+    }
+};
+
+} // namespace vt_fsa_impl
+
+extern "C" {
+
+VT_API void vt_fsa_config_default(vt_fsa_config* cfg) {
+    if (!cfg) return;
+    cfg->max_batch = 256;
+    cfg->max_delay_us = 0;
+    cfg->file_mode = 0644;
+    cfg->flags = 0;
+}
+
+VT_API vt_fsa* vt_fsa_open(const vt_fsa_config* cfg) {
+    auto* s = new vt_fsa();
+    vt_fsa_config_default(&s->cfg);
+    if (cfg) {
+        if (cfg->max_batch) s->cfg.max_batch = cfg->max_batch;
+        s->cfg.max_delay_us = cfg->max_delay_us;
+        if (cfg->file_mode) s->cfg.file_mode = cfg->file_mode;
+        s->cfg.flags = cfg->flags;
+    }
+    s->committer = std::thread([s] { vt_fsa_impl::Committer(s).run(); });
+    return s;
+}
+
+VT_API void vt_fsa_close(vt_fsa* s) {
+    if (!s) return;
+    {
+        std::lock_guard<std::mutex> lk(s->mu);
+        s->stopping = true;
+    }
+    s->cv_work.notify_all();
+    if (s->committer.joinable()) s->committer.join();
+    delete s;
+}
+
+VT_API uint64_t vt_fsa_submit(vt_fsa* s, const char* path, const void* data, size_t len,
+                              vt_fsa_done_fn fn, void* user) {
+    if (!s || !path || !*path || (!data && len)) { errno = EINVAL; return 0; }
+    auto* r = new vt_fsa_impl::Req();
+    r->path = path;
+    if (r->path.back() == '/') { delete r; errno = EISDIR; return 0; }
+    r->data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + len);
+    r->fn = fn;
+    r->user = user;
+    {
+        std::lock_guard<std::mutex> lk(s->mu);
+        if (s->stopping) { delete r; errno = ESHUTDOWN; return 0; }
+        r->ticket = s->next_ticket++;
+        s->queue.push_back(r);
+    }
+    const uint64_t t = r->ticket;   // `r` appartient désormais au committer
+    s->cv_work.notify_one();
+    return t;
+}
+
+VT_API int vt_fsa_wait(vt_fsa* s, uint64_t ticket) {
+    if (!s || !ticket) return -EINVAL;
+    std::unique_lock<std::mutex> lk(s->mu);
+    if (ticket >= s->next_ticket) return -EINVAL;
+    s->cv_done.wait(lk, [&] { return s->done_upto >= ticket; });
+    auto it = s->results.find(ticket);
+    if (it == s->results.end()) return -ENOENT;   // déjà lu, ou livré à un callback
+    int err = it->second;
+    s->results.erase(it);
+    return err;
+}
+
+VT_API int vt_fsa_poll(vt_fsa* s, uint64_t ticket, int* err) {
+    if (!s || !ticket) return 0;
+    std::lock_guard<std::mutex> lk(s->mu);
+    if (s->done_upto < ticket) return 0;
+    auto it = s->results.find(ticket);
+    if (err) *err = it == s->results.end() ? -ENOENT : it->second;
+    if (it != s->results.end()) s->results.erase(it);
+    return 1;
+}
+
+VT_API int vt_fsa_write(vt_fsa* s, const char* path, const void* data, size_t len) {
+    const uint64_t t = vt_fsa_submit(s, path, data, len, nullptr, nullptr);
+    if (!t) return -errno;
+    return vt_fsa_wait(s, t);
+}
+
+VT_API void vt_fsa_get_stats(const vt_fsa* s, vt_fsa_stats* out) {
+    if (!s || !out) return;
+    out->writes     = s->writes.load(std::memory_order_relaxed);
+    out->failed     = s->failed.load(std::memory_order_relaxed);
+    out->batches    = s->batches.load(std::memory_order_relaxed);
+    out->file_syncs = s->file_syncs.load(std::memory_order_relaxed);
+    out->dir_syncs  = s->dir_syncs.load(std::memory_order_relaxed);
+    out->superseded = s->superseded.load(std::memory_order_relaxed);
+    out->tmpfile    = s->tmpfile.load(std::memory_order_relaxed);
+}
+
+} // extern "C"
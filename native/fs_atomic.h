@@ -0,0 +1,86 @@
+// native/fs_atomic.h
+// Service d’écriture atomique durable avec "group commit".
+//
+// API C exposée (ABI stable pour FFI):
+//   void      vt_fsa_config_default(vt_fsa_config* cfg);
+//   vt_fsa*   vt_fsa_open(const vt_fsa_config* cfg);
+//   void      vt_fsa_close(vt_fsa* s);                       // vide la file puis arrête
+//   int       vt_fsa_write(vt_fsa* s, const char* path, const void* data, size_t len);
+//   uint64_t  vt_fsa_submit(vt_fsa* s, const char* path, const void* data, size_t len,
+//                           vt_fsa_done_fn fn, void* user);
+//   int       vt_fsa_wait(vt_fsa* s, uint64_t ticket);
+//   int       vt_fsa_poll(vt_fsa* s, uint64_t ticket, int* err);
+//   void      vt_fsa_get_stats(const vt_fsa* s, vt_fsa_stats* out);
+//
+// Garanties (identiques à write_atomic + fsync) :
+// - Au retour de vt_fsa_write() (ou à la complétion d’un ticket) sans erreur, le nouveau
+//   contenu ET l’entrée de répertoire sont durables.
+// - Un lecteur voit l’ancien contenu ou le nouveau, jamais un mélange.
+// - En cas d’erreur, la cible n’est pas modifiée.
+//
+// Group commit :
+// - Un thread "committer" draine les requêtes en attente par lots : données écrites puis
+//   synchronisées en parallèle (io_uring IORING_OP_FSYNC si dispo), publication dans
+//   l’ordre de soumission, puis UN fsync par répertoire touché pour tout le lot.
+// - Deux écritures du même chemin dans un lot : seule la dernière est matérialisée
+//   (l’intermédiaire n’aurait jamais été observable durablement) ; l’intermédiaire reçoit
+//   le résultat de la dernière, erreur comprise.
+// - Fichiers temporaires en O_TMPFILE + linkat (aucun résidu visible après crash) ;
+//   repli automatique sur "<path>.tmp.<n>" + rename si le FS ne le supporte pas.
+
+#ifndef VITTE_NATIVE_FS_ATOMIC_H
+#define VITTE_NATIVE_FS_ATOMIC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum {
+    VT_FSA_NO_TMPFILE = 1u << 0,   // force le chemin "fichier temporaire nommé"
+    VT_FSA_NO_URING   = 1u << 1,   // fdatasync séquentiels au lieu d’io_uring
+};
+
+typedef struct vt_fsa_config {
+    uint32_t max_batch;      // requêtes max par commit (0 = 256)
+    uint32_t max_delay_us;   // attente max pour grossir un lot (0 = pas d’attente)
+    uint32_t file_mode;      // permissions des fichiers créés (0 = 0644, umask appliqué)
+    uint32_t flags;          // VT_FSA_*
+} vt_fsa_config;
+
+typedef struct vt_fsa_stats {
+    uint64_t writes;         // requêtes terminées
+    uint64_t failed;
+    uint64_t batches;        // commits de groupe
+    uint64_t file_syncs;     // fdatasync de fichiers
+    uint64_t dir_syncs;      // fsync de répertoires (≤ 1 par répertoire et par lot)
+    uint64_t superseded;     // écritures écrasées dans le même lot
+    uint64_t tmpfile;        // publications via O_TMPFILE + linkat
+} vt_fsa_stats;
+
+typedef struct vt_fsa vt_fsa;
+
+// Appelé depuis le thread committer ; `err` = 0 ou -errno.
+typedef void (*vt_fsa_done_fn)(void* user, int err);
+
+VT_API void     vt_fsa_config_default(vt_fsa_config* cfg);
+VT_API vt_fsa*  vt_fsa_open(const vt_fsa_config* cfg);
+VT_API void     vt_fsa_close(vt_fsa* s);
+
+// Synchrone : soumet puis attend. Retourne 0 ou -errno.
+VT_API int      vt_fsa_write(vt_fsa* s, const char* path, const void* data, size_t len);
+
+// Asynchrone : les données sont copiées. Retourne un ticket (> 0) ou 0 si refusé.
+// Si `fn` est fourni, le résultat est livré au callback (et non conservé pour wait/poll).
+VT_API uint64_t vt_fsa_submit(vt_fsa* s, const char* path, const void* data, size_t len,
+                              vt_fsa_done_fn fn, void* user);
+VT_API int      vt_fsa_wait(vt_fsa* s, uint64_t ticket);
+// Retourne 1 si le ticket est terminé (résultat dans *err), 0 sinon.
+VT_API int      vt_fsa_poll(vt_fsa* s, uint64_t ticket, int* err);
+VT_API void     vt_fsa_get_stats(const vt_fsa* s, vt_fsa_stats* out);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_FS_ATOMIC_H
@@ -0,0 +1,652 @@
+// native/http_client.cpp
+// Transport HTTP/1.1 client natif (cf. http_client.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/http_client.cpp -o build/http_client.o
+//   g++ build/app.o build/http_client.o -pthread -o bin/app
+//
+// Remarques :
+// - Linux (epoll). Une boucle epoll par appel de vt_httpc_send_batch().
+// - Résolution DNS via getaddrinfo (bloquante), mise en cache 60 s par hôte.
+
+#include "http_client.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vt_http_client {
+
+static uint64_t now_ms() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(
+        duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+static inline char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+static bool ieq(const char* a, size_t an, const char* b) {
+    const size_t bn = std::strlen(b);
+    if (an != bn) return false;
+    for (size_t i = 0; i < an; ++i) {
+        if (lower(a[i]) != b[i]) return false;
+    }
+    return true;
+}
+
+static bool icontains(const char* v, size_t n, const char* needle) {
+    const size_t k = std::strlen(needle);
+    for (size_t i = 0; i + k <= n; ++i) {
+        size_t j = 0;
+        while (j < k && lower(v[i + j]) == needle[j]) ++j;
+        if (j == k) return true;
+    }
+    return false;
+}
+
+struct Idle {
+    int      fd;
+    uint64_t since;
+};
+
+struct Resolved {
+    sockaddr_storage addr;
+    socklen_t        len;
+    uint64_t         expires;
+};
+
+// Décodeur chunked incrémental : consomme `in` à partir de `pos`.
+struct Chunked {
+    enum class St { Size, Data, DataCrlf, Trailer, Done } st = St::Size;
+    uint64_t left = 0;
+
+    // Retourne -1 si invalide, sinon 0 ; `st == Done` quand le message est complet.
+    int feed(const std::string& in, size_t& pos, std::string& out) {
+        while (pos < in.size() && st != St::Done) {
+            switch (st) {
+                case St::Size: {
+                    size_t e = in.find("\r\n", pos);
+                    if (e == std::string::npos) return 0;
+                    uint64_t n = 0;
+                    size_t i = pos;
+                    int digits = 0;
+                    for (; i < e; ++i) {
+                        char c = in[i];
+                        int d;
+                        if (c >= '0' && c <= '9') d = c - '0';
+                        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+                        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+                        else break;   // extensions ";…" ignorées
+                        if (++digits > 15) return -1;
+                        n = (n << 4) | static_cast<uint64_t>(d);
+                    }
+                    if (!digits) return -1;
+                    pos = e + 2;
+                    left = n;
+                    st = n ? St::Data : St::Trailer;
+                    break;
+                }
+                case St::Data: {
+                    size_t take = static_cast<size_t>(std::min<uint64_t>(left, in.size() - pos));
+                    out.append(in, pos, take);
+                    pos += take;
+                    left -= take;
+                    if (!left) st = St::DataCrlf;
+                    break;
+                }
+                case St::DataCrlf:
+                    if (in.size() - pos < 2) return 0;
+                    if (in[pos] != '\r' || in[pos + 1] != '\n') return -1;
+                    pos += 2;
+                    st = St::Size;
+                    break;
+                case St::Trailer: {
+                    size_t e = in.find("\r\n", pos);
+                    if (e == std::string::npos) return 0;
+                    st = (e == pos) ? St::Done : St::Trailer;   // ligne vide = fin
+                    pos = e + 2;
+                    break;
+                }
+                case St::Done:
+                    break;
+            }
+        }
+        return 0;
+    }
+};
+
+enum class St { Connecting, Writing, Reading, Done };
+
+struct Op {
+    const vt_httpc_request* req = nullptr;
+    vt_httpc_response*      out = nullptr;
+    std::string             key;
+    int                     fd = -1;
+    bool                    reused = false;
+    bool                    retried = false;
+    bool                    idempotent = false;
+    bool                    head_method = false;
+    St                      st = St::Connecting;
+    size_t                  woff = 0;            // octets envoyés (tête puis corps)
+    std::string             rbuf;
+    size_t                  head_end = 0;        // 0 = tête pas encore reçue
+    int64_t                 content_len = -1;
+    bool                    chunked = false;
+    bool                    until_close = false;
+    bool                    keep_alive = true;
+    size_t                  body_pos = 0;
+    Chunked                 dechunk;
+    std::string             body;
+    uint64_t                deadline = 0;
+    uint64_t                connect_deadline = 0;
+};
+
+} // namespace vt_http_client
+
+struct vt_httpc {
+    vt_httpc_config cfg{};
+
+    std::mutex                                                  mu;
+    std::condition_variable                                     cv;
+    std::unordered_map<std::string, std::vector<vt_http_client::Idle>> pools;
+    std::unordered_map<std::string, vt_http_client::Resolved>          dns;
+    bool                                                        stopping = false;
+    std::thread                                                 reaper;
+
+    std::atomic<uint64_t> requests{0}, connects{0}, reuses{0}, retries{0}, reaped{0};
+};
+
+namespace vt_http_client {
+
+static void reaper_loop(vt_httpc* c) {
+    const auto period = std::chrono::milliseconds(std::max<uint32_t>(c->cfg.idle_timeout_ms / 2, 250));
+    std::unique_lock<std::mutex> lk(c->mu);
+    while (!c->stopping) {
+        c->cv.wait_for(lk, period);
+        if (c->stopping) break;
+        const uint64_t now = now_ms();
+        for (auto it = c->pools.begin(); it != c->pools.end();) {
+            auto& v = it->second;
+            auto keep = std::remove_if(v.begin(), v.end(), [&](const Idle& i) {
+                if (now - i.since < c->cfg.idle_timeout_ms) return false;
+                ::close(i.fd);
+                c->reaped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            });
+            v.erase(keep, v.end());
+            it = v.empty() ? c->pools.erase(it) : std::next(it);
+        }
+    }
+}
+
+// Connexion inactive encore saine ? (pas d’EOF ni d’octets parasites en attente)
+static bool still_alive(int fd) {
+    char b;
+    ssize_t r = ::recv(fd, &b, 1, MSG_PEEK | MSG_DONTWAIT);
+    return r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+static int checkout(vt_httpc* c, const std::string& key) {
+    std::lock_guard<std::mutex> lk(c->mu);
+    auto it = c->pools.find(key);
+    if (it == c->pools.end()) return -1;
+    auto& v = it->second;
+    while (!v.empty()) {
+        Idle i = v.back();   // LIFO : la plus chaude d’abord
+        v.pop_back();
+        if (now_ms() - i.since < c->cfg.idle_timeout_ms && still_alive(i.fd)) return i.fd;
+        ::close(i.fd);
+        c->reaped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return -1;
+}
+
+static void checkin(vt_httpc* c, const std::string& key, int fd) {
+    std::lock_guard<std::mutex> lk(c->mu);
+    auto& v = c->pools[key];
+    if (c->stopping || v.size() >= c->cfg.max_idle_per_host) {
+        ::close(fd);
+        return;
+    }
+    v.push_back(Idle{fd, now_ms()});
+}
+
+static int resolve(vt_httpc* c, const char* host, uint16_t port, sockaddr_storage& out, socklen_t& len) {
+    const std::string key = std::string(host) + ":" + std::to_string(port);
+    {
+        std::lock_guard<std::mutex> lk(c->mu);
+        auto it = c->dns.find(key);
+        if (it != c->dns.end() && it->second.expires > now_ms()) {
+            out = it->second.addr;
+            len = it->second.len;
+            return 0;
+        }
+    }
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    addrinfo* res = nullptr;
+    const std::string svc = std::to_string(port);
+    if (getaddrinfo(host, svc.c_str(), &hints, &res) != 0 || !res) return -EHOSTUNREACH;
+    std::memcpy(&out, res->ai_addr, res->ai_addrlen);
+    len = static_cast<socklen_t>(res->ai_addrlen);
+    freeaddrinfo(res);
+    std::lock_guard<std::mutex> lk(c->mu);
+    c->dns[key] = Resolved{out, len, now_ms() + 60000};
+    return 0;
+}
+
+class Batch {
+public:
+    Batch(vt_httpc* c, const vt_httpc_request* reqs, vt_httpc_response* out, size_t n)
+        : c_(c), ops_(n) {
+        for (size_t i = 0; i < n; ++i) {
+            Op& op = ops_[i];
+            op.req = &reqs[i];
+            op.out = &out[i];
+            std::memset(op.out, 0, sizeof(*op.out));
+            op.key = std::string(reqs[i].host ? reqs[i].host : "") + ":" + std::to_string(reqs[i].port);
+            const char* h = reqs[i].head ? reqs[i].head : "";
+            op.head_method = std::strncmp(h, "HEAD ", 5) == 0;
+            op.idempotent = op.head_method || std::strncmp(h, "GET ", 4) == 0 ||
+                            std::strncmp(h, "PUT ", 4) == 0 || std::strncmp(h, "DELETE ", 7) == 0 ||
+                            std::strncmp(h, "OPTIONS ", 8) == 0;
+            const uint32_t t = reqs[i].timeout_ms ? reqs[i].timeout_ms : c->cfg.request_timeout_ms;
+            op.deadline = now_ms() + t;
+        }
+    }
+
+    int run() {
+        ep_ = epoll_create1(EPOLL_CLOEXEC);
+        if (ep_ < 0) {
+            for (Op& op : ops_) finish(op, -errno);
+            return 0;
+        }
+        for (size_t i = 0; i < ops_.size(); ++i) start(i);
+
+        std::vector<epoll_event> evs(64);
+        while (active_ > 0) {
+            const uint64_t now = now_ms();
+            uint64_t next = UINT64_MAX;
+            for (Op& op : ops_) {
+                if (op.st == St::Done) continue;
+                const uint64_t d = op.st == St::Connecting ? std::min(op.deadline, op.connect_deadline)
+                                                           : op.deadline;
+                if (d <= now) { fail(op, -ETIMEDOUT); continue; }
+                next = std::min(next, d);
+            }
+            if (active_ == 0) break;
+            const int wait = static_cast<int>(std::min<uint64_t>(next - now, 1000));
+            int n = epoll_wait(ep_, evs.data(), static_cast<int>(evs.size()), wait);
+            if (n < 0 && errno != EINTR) break;
+            for (int k = 0; k < n; ++k) on_event(ops_[evs[k].data.u64], evs[k].events);
+        }
+        ::close(ep_);
+
+        int ok = 0;
+        for (Op& op : ops_) {
+            if (op.st != St::Done) finish(op, -ETIMEDOUT);
+            if (op.out->error == 0) ++ok;
+        }
+        return ok;
+    }
+
+private:
+    vt_httpc*       c_;
+    std::vector<Op> ops_;
+    int             ep_ = -1;
+    size_t          active_ = 0;
+
+    size_t index_of(const Op& op) const { return static_cast<size_t>(&op - ops_.data()); }
+
+    void watch(Op& op, uint32_t events, bool add) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = index_of(op);
+        epoll_ctl(ep_, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, op.fd, &ev);
+    }
+
+    void start(size_t i) {
+        Op& op = ops_[i];
+        ++active_;
+        c_->requests.fetch_add(1, std::memory_order_relaxed);
+        connect_or_reuse(op);
+    }
+
+    void connect_or_reuse(Op& op) {
+        op.woff = 0;
+        op.rbuf.clear();
+        reset_response(op);
+        int fd = op.retried ? -1 : checkout(c_, op.key);
+        if (fd >= 0) {
+            op.fd = fd;
+            op.reused = true;
+            op.st = St::Writing;
+            c_->reuses.fetch_add(1, std::memory_order_relaxed);
+            watch(op, EPOLLOUT, true);
+            write_some(op);   // socket déjà connectée : pas besoin d’attendre EPOLLOUT
+            return;
+        }
+        op.reused = false;
+        if (!op.req->host) { fail(op, -EINVAL); return; }
+        sockaddr_storage addr{};
+        socklen_t len = 0;
+        int r = resolve(c_, op.req->host, op.req->port, addr, len);
+        if (r < 0) { fail(op, r); return; }
+        fd = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) { fail(op, -errno); return; }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        op.fd = fd;
+        c_->connects.fetch_add(1, std::memory_order_relaxed);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), len) == 0) {
+            op.st = St::Writing;
+        } else if (errno == EINPROGRESS) {
+            op.st = St::Connecting;
+            op.connect_deadline = now_ms() + c_->cfg.connect_timeout_ms;
+        } else {
+            fail(op, -errno);
+            return;
+        }
+        watch(op, EPOLLOUT, true);
+    }
+
+    void on_event(Op& op, uint32_t events) {
+        if (op.st == St::Done) return;
+        if (op.st == St::Connecting) {
+            int err = 0;
+            socklen_t l = sizeof(err);
+            getsockopt(op.fd, SOL_SOCKET, SO_ERROR, &err, &l);
+            if (err) { fail(op, -err); return; }
+            op.st = St::Writing;
+        }
+        if (op.st == St::Writing) {
+            write_some(op);
+            return;
+        }
+        if (op.st == St::Reading && (events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP))) read_some(op);
+    }
+
+    void write_some(Op& op) {
+        const size_t hl = op.req->head_len;
+        const size_t total = hl + op.req->body_len;
+        while (op.woff < total) {
+            iovec iov[2];
+            int cnt = 0;
+            if (op.woff < hl) {
+                iov[cnt++] = {const_cast<char*>(op.req->head) + op.woff, hl - op.woff};
+                if (op.req->body_len) iov[cnt++] = {const_cast<uint8_t*>(op.req->body), op.req->body_len};
+            } else {
+                const size_t bo = op.woff - hl;
+                iov[cnt++] = {const_cast<uint8_t*>(op.req->body) + bo, op.req->body_len - bo};
+            }
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = static_cast<size_t>(cnt);
+            ssize_t w = ::sendmsg(op.fd, &msg, MSG_NOSIGNAL);
+            if (w > 0) { op.woff += static_cast<size_t>(w); continue; }
+            if (w < 0 && errno == EINTR) continue;
+            if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+            retry_or_fail(op, -(w < 0 ? errno : EPIPE));
+            return;
+        }
+        op.st = St::Reading;
+        watch(op, EPOLLIN | EPOLLRDHUP, false);
+    }
+
+    void read_some(Op& op) {
+        for (;;) {
+            const size_t old = op.rbuf.size();
+            op.rbuf.resize(old + 64 * 1024);
+            ssize_t r = ::recv(op.fd, op.rbuf.data() + old, 64 * 1024, 0);
+            op.rbuf.resize(old + (r > 0 ? static_cast<size_t>(r) : 0));
+            if (r > 0) {
+                if (op.rbuf.size() > c_->cfg.max_response_bytes) { fail(op, -EMSGSIZE); return; }
+                if (progress(op)) return;
+                continue;
+            }
+            if (r == 0) {
+                if (op.head_end && op.until_close) { complete(op, false); return; }
+                retry_or_fail(op, op.rbuf.empty() ? -ECONNRESET : -EPROTO);
+                return;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            retry_or_fail(op, -errno);
+            return;
+        }
+    }
+
+    // Avance le parsing ; true si l’opération est terminée (succès ou erreur).
+    bool progress(Op& op) {
+        if (!op.head_end) {
+            size_t e = op.rbuf.find("\r\n\r\n");
+            if (e == std::string::npos) return false;
+            if (!parse_head(op, e)) { fail(op, -EPROTO); return true; }
+            // 1xx intermédiaire : on l’ignore et on attend la vraie réponse, sans rien garder
+            // de ce que `parse_head` a déduit de la tête intermédiaire.
+            if (op.out->status >= 100 && op.out->status < 200) {
+                std::free(op.out->head);
+                op.out->head = nullptr;
+                op.out->head_len = 0;
+                op.rbuf.erase(0, e + 4);
+                reset_response(op);
+                return progress(op);
+            }
+        }
+        if (op.chunked) {
+            if (op.dechunk.feed(op.rbuf, op.body_pos, op.body) < 0) { fail(op, -EPROTO); return true; }
+            if (op.dechunk.st == Chunked::St::Done) { complete(op, op.keep_alive); return true; }
+            return false;
+        }
+        if (op.until_close) return false;
+        if (op.rbuf.size() - op.head_end >= static_cast<uint64_t>(op.content_len)) {
+            op.body.assign(op.rbuf, op.head_end, static_cast<size_t>(op.content_len));
+            complete(op, op.keep_alive && op.rbuf.size() - op.head_end == static_cast<uint64_t>(op.content_len));
+            return true;
+        }
+        return false;
+    }
+
+    // État de parsing propre à une réponse (tête, cadrage du corps, décodeur chunked).
+    static void reset_response(Op& op) {
+        op.head_end = 0;
+        op.content_len = -1;
+        op.chunked = false;
+        op.until_close = false;
+        op.keep_alive = true;
+        op.body_pos = 0;
+        op.dechunk = Chunked{};
+        op.body.clear();
+    }
+
+    bool parse_head(Op& op, size_t e) {
+        const char* p = op.rbuf.data();
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\r', e + 2));
+        if (!line_end || line_end - p < 12 || std::memcmp(p, "HTTP/1.", 7) != 0) return false;
+        const bool http10 = p[7] == '0';
+        int status = 0;
+        for (int i = 9; i < 12; ++i) {
+            if (p[i] < '0' || p[i] > '9') return false;
+            status = status * 10 + (p[i] - '0');
+        }
+        op.out->status = status;
+        op.keep_alive = !http10;
+
+        const char* q = line_end + 2;
+        const char* end = p + e + 2;
+        const char* hdr_begin = q;
+        while (q < end) {
+            const char* le = static_cast<const char*>(std::memchr(q, '\r', end - q));
+            if (!le) return false;
+            const char* colon = static_cast<const char*>(std::memchr(q, ':', le - q));
+            if (colon) {
+                const char* v = colon + 1;
+                while (v < le && (*v == ' ' || *v == '\t')) ++v;
+                const size_t vn = static_cast<size_t>(le - v);
+                if (ieq(q, colon - q, "content-length")) {
+                    op.content_len = std::strtoll(std::string(v, vn).c_str(), nullptr, 10);
+                    if (op.content_len < 0) return false;
+                } else if (ieq(q, colon - q, "transfer-encoding")) {
+                    if (icontains(v, vn, "chunked")) op.chunked = true;
+                } else if (ieq(q, colon - q, "connection")) {
+                    if (icontains(v, vn, "close")) op.keep_alive = false;
+                    else if (icontains(v, vn, "keep-alive")) op.keep_alive = true;
+                }
+            }
+            q = le + 2;
+        }
+        op.out->head_len = static_cast<size_t>(end - hdr_begin);
+        op.head_end = e + 4;
+        op.body_pos = op.head_end;
+
+        const bool no_body = op.head_method || status == 204 || status == 304;
+        if (no_body) { op.chunked = false; op.content_len = 0; }
+        else if (!op.chunked && op.content_len < 0) { op.until_close = true; op.keep_alive = false; }
+        // Garde les en-têtes bruts pour le côté Vitte.
+        op.out->head = static_cast<char*>(std::malloc(op.out->head_len + 1));
+        if (!op.out->head) return false;
+        std::memcpy(op.out->head, hdr_begin, op.out->head_len);
+        op.out->head[op.out->head_len] = '\0';
+        return true;
+    }
+
+    void complete(Op& op, bool reusable) {
+        if (op.until_close) op.body.assign(op.rbuf, op.head_end, std::string::npos);
+        op.out->body_len = op.body.size();
+        op.out->body = static_cast<uint8_t*>(std::malloc(op.body.size() ? op.body.size() : 1));
+        if (op.body.size()) std::memcpy(op.out->body, op.body.data(), op.body.size());
+        op.out->reused = op.reused ? 1 : 0;
+        epoll_ctl(ep_, EPOLL_CTL_DEL, op.fd, nullptr);
+        if (reusable) checkin(c_, op.key, op.fd);
+        else ::close(op.fd);
+        op.fd = -1;
+        finish(op, 0);
+    }
+
+    void retry_or_fail(Op& op, int err) {
+        if (op.reused && !op.retried && op.idempotent && op.rbuf.empty()) {
+            epoll_ctl(ep_, EPOLL_CTL_DEL, op.fd, nullptr);
+            ::close(op.fd);
+            op.fd = -1;
+            op.retried = true;
+            c_->retries.fetch_add(1, std::memory_order_relaxed);
+            connect_or_reuse(op);
+            return;
+        }
+        fail(op, err);
+    }
+
+    void fail(Op& op, int err) {
+        if (op.fd >= 0) {
+            epoll_ctl(ep_, EPOLL_CTL_DEL, op.fd, nullptr);
+            ::close(op.fd);
+            op.fd = -1;
+        }
+        std::free(op.out->head);
+        op.out->head = nullptr;
+        op.out->head_len = 0;
+        finish(op, err);
+    }
+
+    void finish(Op& op, int err) {
+        if (op.st == St::Done) return;
+        op.out->error = err;
+        op.st = St::Done;
+        if (active_) --active_;
+    }
+};
+
+} // namespace vt_http_client
+
+extern "C" {
+
+VT_API void vt_httpc_config_default(vt_httpc_config* cfg) {
+    if (!cfg) return;
+    cfg->max_idle_per_host = 8;
+    cfg->idle_timeout_ms = 30000;
+    cfg->connect_timeout_ms = 5000;
+    cfg->request_timeout_ms = 30000;
+    cfg->max_response_bytes = 64ull * 1024 * 1024;
+}
+
+VT_API vt_httpc* vt_httpc_new(const vt_httpc_config* cfg) {
+    auto* c = new vt_httpc();
+    vt_httpc_config_default(&c->cfg);
+    if (cfg) {
+        if (cfg->max_idle_per_host) c->cfg.max_idle_per_host = cfg->max_idle_per_host;
+        if (cfg->idle_timeout_ms) c->cfg.idle_timeout_ms = cfg->idle_timeout_ms;
+        if (cfg->connect_timeout_ms) c->cfg.connect_timeout_ms = cfg->connect_timeout_ms;
+        if (cfg->request_timeout_ms) c->cfg.request_timeout_ms = cfg->request_timeout_ms;
+        if (cfg->max_response_bytes) c->cfg.max_response_bytes = cfg->max_response_bytes;
+    }
+    c->reaper = std::thread(vt_http_client::reaper_loop, c);
+    return c;
+}
+
+VT_API void vt_httpc_free(vt_httpc* c) {
+    if (!c) return;
+    {
+        std::lock_guard<std::mutex> lk(c->mu);
+        c->stopping = true;
+    }
+    c->cv.notify_all();
+    if (c->reaper.joinable()) c->reaper.join();
+    for (auto& kv : c->pools) {
+        for (auto& i : kv.second) ::close(i.fd);
+    }
+    delete c;
+}
+
+VT_API int vt_httpc_send_batch(vt_httpc* c, const vt_httpc_request* reqs,
+                               vt_httpc_response* out, size_t n) {
+    if (!c || (!reqs && n) || (!out && n)) return -EINVAL;
+    if (!n) return 0;
+    return vt_http_client::Batch(c, reqs, out, n).run();
+}
+
+VT_API void vt_httpc_response_free(vt_httpc_response* r) {
+    if (!r) return;
+    std::free(r->head);
+    std::free(r->body);
+    r->head = nullptr;
+    r->body = nullptr;
+    r->head_len = r->body_len = 0;
+}
+
+VT_API void vt_httpc_get_stats(const vt_httpc* c, vt_httpc_stats* out) {
+    if (!c || !out) return;
+    out->requests = c->requests.load(std::memory_order_relaxed);
+    out->connects = c->connects.load(std::memory_order_relaxed);
+    out->reuses   = c->reuses.load(std::memory_order_relaxed);
+    out->retries  = c->retries.load(std::memory_order_relaxed);
+    out->reaped   = c->reaped.load(std::memory_order_relaxed);
+    uint64_t idle = 0;
+    {
+        std::lock_guard<std::mutex> lk(const_cast<vt_httpc*>(c)->mu);
+        for (auto& kv : c->pools) idle += kv.second.size();
+    }
+    out->idle = idle;
+}
+
+} // extern "C"
@@ -0,0 +1,86 @@
+// native/http_client.h
+// Transport HTTP/1.1 client natif : pools keep-alive par hôte, connexions non bloquantes,
+// requêtes concurrentes sur une seule boucle epoll.
+//
+// API C exposée (ABI stable pour FFI):
+//   void        vt_httpc_config_default(vt_httpc_config* cfg);
+//   vt_httpc*   vt_httpc_new(const vt_httpc_config* cfg);
+//   void        vt_httpc_free(vt_httpc* c);
+//   int         vt_httpc_send_batch(vt_httpc* c, const vt_httpc_request* reqs,
+//                                   vt_httpc_response* out, size_t n);
+//   void        vt_httpc_response_free(vt_httpc_response* r);
+//   void        vt_httpc_get_stats(const vt_httpc* c, vt_httpc_stats* out);
+//
+// Modèle :
+// - Le côté Vitte (`modules/http_client.vitte`) construit la tête de requête (ligne + en-têtes)
+//   et garde la main sur redirections, gzip et TLS ; le transport ne gère que http:// en clair.
+// - Les connexions sont prises dans un pool "hôte:port" (vérif. de fraîcheur par MSG_PEEK),
+//   puis rendues après une réponse complète si le serveur n’a pas demandé `Connection: close`.
+// - Un thread "reaper" ferme les connexions inactives au-delà de `idle_timeout_ms`.
+// - Une requête idempotente qui échoue sur une connexion réutilisée AVANT tout octet de
+//   réponse est rejouée une fois sur une connexion neuve (cas du keep-alive fermé côté serveur).
+// - vt_httpc_send_batch() est ré-entrant : plusieurs threads peuvent partager un même client.
+
+#ifndef VITTE_NATIVE_HTTP_CLIENT_H
+#define VITTE_NATIVE_HTTP_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef struct vt_httpc_config {
+    uint32_t max_idle_per_host;   // connexions inactives conservées par hôte (0 = 8)
+    uint32_t idle_timeout_ms;     // durée de vie d’une connexion inactive (0 = 30 s)
+    uint32_t connect_timeout_ms;  // délai de connexion TCP (0 = 5 s)
+    uint32_t request_timeout_ms;  // délai total par requête, si non précisé (0 = 30 s)
+    uint64_t max_response_bytes;  // tête + corps (0 = 64 MiB)
+} vt_httpc_config;
+
+typedef struct vt_httpc_request {
+    const char*    host;          // nom ou IP (résolu une fois, puis mis en cache)
+    uint16_t       port;
+    const char*    head;          // "METHOD /path HTTP/1.1\r\n…\r\n\r\n" (Host inclus)
+    size_t         head_len;
+    const uint8_t* body;
+    size_t         body_len;
+    uint32_t       timeout_ms;    // 0 = config.request_timeout_ms
+} vt_httpc_request;
+
+typedef struct vt_httpc_response {
+    int      error;               // 0 ou -errno (-ETIMEDOUT, -ECONNREFUSED, -EPROTO…)
+    int      status;
+    char*    head;                // lignes d’en-têtes brutes (sans la ligne de statut), malloc
+    size_t   head_len;
+    uint8_t* body;                // corps dé-chunké, malloc
+    size_t   body_len;
+    uint8_t  reused;              // 1 si servi par une connexion du pool
+} vt_httpc_response;
+
+typedef struct vt_httpc_stats {
+    uint64_t requests;
+    uint64_t connects;
+    uint64_t reuses;
+    uint64_t retries;
+    uint64_t reaped;
+    uint64_t idle;                // connexions actuellement au repos dans les pools
+} vt_httpc_stats;
+
+typedef struct vt_httpc vt_httpc;
+
+VT_API void      vt_httpc_config_default(vt_httpc_config* cfg);
+VT_API vt_httpc* vt_httpc_new(const vt_httpc_config* cfg);
+VT_API void      vt_httpc_free(vt_httpc* c);
+
+// Exécute `n` requêtes en parallèle. Retourne le nombre de réponses sans erreur.
+// Chaque `out[i]` doit ensuite être libéré par vt_httpc_response_free().
+VT_API int       vt_httpc_send_batch(vt_httpc* c, const vt_httpc_request* reqs,
+                                     vt_httpc_response* out, size_t n);
+VT_API void      vt_httpc_response_free(vt_httpc_response* r);
+VT_API void      vt_httpc_get_stats(const vt_httpc* c, vt_httpc_stats* out);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_HTTP_CLIENT_H
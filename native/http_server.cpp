@@ -0,0 +1,935 @@
+// native/http_server.cpp
+// Moteur HTTP/1.1 natif pour les services Vitte (cf. http_server.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/http_server.cpp -o build/http_server.o
+//   g++ build/app.o build/http_server.o -pthread -o bin/web-echo
+//
+// Remarques :
+// - Linux uniquement (io_uring/epoll, SO_REUSEPORT, eventfd).
+// - io_uring est piloté en appels système bruts (native/uring.hpp) : pas de liburing.
+// - Pas de chunked transfer-encoding en entrée (501), comme le parseur Vitte d’origine.
+
+#include "http_server.h"
+#include "uring.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vt_http {
+
+struct Conn;
+
+struct Entry {
+    Conn*           conn = nullptr;
+    vt_http_request req{};
+    size_t          hdr_begin = 0;    // index dans batch.headers
+    std::string     out;              // réponse sérialisée (vide = pas encore répondu)
+    bool            answered = false;
+};
+
+} // namespace vt_http
+
+struct vt_http_batch {
+    std::vector<vt_http::Entry>  entries;
+    std::vector<vt_http_header>  headers;
+    const char*                  date = "";   // "date: …\r\n" du réacteur courant
+};
+
+namespace vt_http {
+
+constexpr size_t   kRxInitial   = 16 * 1024;
+constexpr unsigned kRingEntries = 1024;
+constexpr uint64_t kWakeTag     = ~0ull;
+
+enum Op : uint64_t { OP_ACCEPT = 1, OP_RECV = 2, OP_SEND = 3, OP_TICK = 4, OP_WAKE = 5 };
+
+static inline uint64_t tag(uint64_t id, Op op) { return (id << 4) | op; }
+
+static uint64_t now_ms() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(
+        duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+static const char* reason(int status) {
+    switch (status) {
+        case 100: return "Continue";
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 413: return "Payload Too Large";
+        case 415: return "Unsupported Media Type";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        default:  return status < 500 ? "Unknown" : "Internal Server Error";
+    }
+}
+
+static inline char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+static bool ieq(const char* a, size_t an, const char* b, size_t bn) {
+    if (an != bn) return false;
+    for (size_t i = 0; i < an; ++i) {
+        if (lower(a[i]) != lower(b[i])) return false;
+    }
+    return true;
+}
+
+// Cherche un jeton (séparé par des virgules) dans une valeur d’en-tête, sans casse.
+static bool has_token(const char* v, size_t n, const char* tok) {
+    const size_t tn = std::strlen(tok);
+    size_t i = 0;
+    while (i < n) {
+        while (i < n && (v[i] == ' ' || v[i] == '\t' || v[i] == ',')) ++i;
+        size_t s = i;
+        while (i < n && v[i] != ',') ++i;
+        size_t e = i;
+        while (e > s && (v[e - 1] == ' ' || v[e - 1] == '\t')) --e;
+        if (ieq(v + s, e - s, tok, tn)) return true;
+    }
+    return false;
+}
+
+static inline bool is_tchar(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return true;
+    if (c >= 'A' && c <= 'Z') return true;
+    if (c >= '0' && c <= '9') return true;
+    return std::strchr("!#$%&'*+-.^_`|~", c) != nullptr && c != 0;
+}
+
+/* ———— Parseur (index zéro-copie) ———— */
+
+enum class Parse { Ok, Incomplete, Bad, HeaderTooLarge, BodyTooLarge, Unsupported };
+
+struct Limits {
+    uint32_t max_header;
+    uint64_t max_body;
+};
+
+// Analyse une requête dans [p, p+n). Les vues de `r` et les en-têtes ajoutés à
+// `hdrs` pointent dans le buffer d’entrée. `consumed` = taille tête + corps.
+static Parse parse_request(const char* p, size_t n, const Limits& lim, vt_http_request& r,
+                           std::vector<vt_http_header>& hdrs, size_t& consumed) {
+    const size_t scan = std::min<size_t>(n, lim.max_header);
+    const char* end = static_cast<const char*>(memmem(p, scan, "\r\n\r\n", 4));
+    if (!end) return n >= lim.max_header ? Parse::HeaderTooLarge : Parse::Incomplete;
+    const size_t head_len = static_cast<size_t>(end - p) + 4;
+    const char* const head_end = end + 2;   // pointe sur la ligne vide
+
+    // Ligne de requête : METHOD SP TARGET SP HTTP/1.x CRLF
+    const char* q = p;
+    const char* line_end = static_cast<const char*>(std::memchr(q, '\r', head_end - q));
+    if (!line_end || line_end[1] != '\n') return Parse::Bad;
+
+    const char* m = q;
+    while (q < line_end && is_tchar(static_cast<unsigned char>(*q))) ++q;
+    if (q == m || q >= line_end || *q != ' ') return Parse::Bad;
+    r.method = m;
+    r.method_len = static_cast<uint32_t>(q - m);
+    ++q;
+
+    const char* t = q;
+    while (q < line_end && *q != ' ') ++q;
+    if (q == t || q >= line_end) return Parse::Bad;
+    r.target = t;
+    r.target_len = static_cast<uint32_t>(q - t);
+    ++q;
+
+    if (line_end - q != 8 || std::memcmp(q, "HTTP/1.", 7) != 0) return Parse::Bad;
+    if (q[7] != '0' && q[7] != '1') return Parse::Unsupported;
+    r.version_minor = static_cast<uint8_t>(q[7] - '0');
+
+    // En-têtes
+    bool keep_alive = r.version_minor == 1;
+    bool have_len = false;
+    uint64_t body_len = 0;
+    q = line_end + 2;
+    while (q < head_end) {
+        const char* le = static_cast<const char*>(std::memchr(q, '\r', head_end - q + 1));
+        if (!le || le[1] != '\n') return Parse::Bad;
+        if (*q == ' ' || *q == '\t') return Parse::Bad;   // obs-fold refusé
+        const char* colon = static_cast<const char*>(std::memchr(q, ':', le - q));
+        if (!colon || colon == q) return Parse::Bad;
+        for (const char* c = q; c < colon; ++c) {
+            if (!is_tchar(static_cast<unsigned char>(*c))) return Parse::Bad;
+        }
+        const char* v = colon + 1;
+        const char* ve = le;
+        while (v < ve && (*v == ' ' || *v == '\t')) ++v;
+        while (ve > v && (ve[-1] == ' ' || ve[-1] == '\t')) --ve;
+
+        vt_http_header h;
+        h.name = q;
+        h.name_len = static_cast<uint32_t>(colon - q);
+        h.value = v;
+        h.value_len = static_cast<uint32_t>(ve - v);
+        hdrs.push_back(h);
+
+        if (ieq(h.name, h.name_len, "content-length", 14)) {
+            if (h.value_len == 0 || h.value_len > 19) return Parse::Bad;
+            uint64_t cl = 0;
+            for (uint32_t i = 0; i < h.value_len; ++i) {
+                char c = h.value[i];
+                if (c < '0' || c > '9') return Parse::Bad;
+                cl = cl * 10 + static_cast<uint64_t>(c - '0');
+            }
+            if (have_len && cl != body_len) return Parse::Bad;
+            have_len = true;
+            body_len = cl;
+        } else if (ieq(h.name, h.name_len, "transfer-encoding", 17)) {
+            return Parse::Unsupported;
+        } else if (ieq(h.name, h.name_len, "connection", 10)) {
+            if (has_token(h.value, h.value_len, "close")) keep_alive = false;
+            else if (has_token(h.value, h.value_len, "keep-alive")) keep_alive = true;
+        }
+        q = le + 2;
+    }
+
+    if (body_len > lim.max_body) return Parse::BodyTooLarge;
+    if (n - head_len < body_len) return Parse::Incomplete;
+
+    r.keep_alive = keep_alive ? 1 : 0;
+    r.body = reinterpret_cast<const uint8_t*>(p + head_len);
+    r.body_len = body_len;
+    consumed = head_len + static_cast<size_t>(body_len);
+    return Parse::Ok;
+}
+
+/* ———— Connexions ———— */
+
+struct Conn {
+    uint64_t          id = 0;
+    int               fd = -1;
+    char              peer[64] = {0};
+    std::vector<char> rx;
+    size_t            rx_off = 0;    // début des octets non consommés
+    size_t            rx_len = 0;    // fin des octets reçus
+    std::string       tx;            // en vol (ne pas modifier pendant un SEND io_uring)
+    std::string       tx_next;       // réponses en attente
+    size_t            tx_off = 0;
+    uint64_t          last_active = 0;
+    uint32_t          in_batch = 0;  // requêtes du batch courant qui pointent dans rx
+    uint32_t          pending = 0;   // opérations io_uring en vol
+    bool              closing = false;   // plus de lecture ; fermer quand tx vidé
+    bool              dead = false;      // socket inutilisable
+    bool              touched = false;   // présent dans la liste post-dispatch
+    bool              recv_armed = false;
+    bool              send_armed = false;
+};
+
+} // namespace vt_http
+
+struct vt_http_server {
+    vt_http_config               cfg{};
+    vt_http_batch_fn             fn = nullptr;
+    void*                        user = nullptr;
+    std::vector<int>             listen_fds;     // 1 par réacteur (REUSEPORT) ou 1 partagé
+    std::vector<int>             wake_fds;
+    std::atomic<bool>            stopping{false};
+    std::atomic<uint64_t>        next_conn_id{1};
+    bool                         use_uring = false;
+
+    std::atomic<uint64_t> accepted{0}, closed{0}, requests{0}, batches{0}, bad_requests{0};
+};
+
+namespace vt_http {
+
+class Reactor {
+public:
+    Reactor(vt_http_server* srv, unsigned index)
+        : srv_(srv), index_(index),
+          listen_fd_(srv->listen_fds[srv->listen_fds.size() == 1 ? 0 : index]),
+          wake_fd_(srv->wake_fds[index]) {
+        lim_.max_header = srv->cfg.max_header_bytes;
+        lim_.max_body = srv->cfg.max_body_bytes;
+        batch_.entries.reserve(srv->cfg.max_batch);
+        batch_.headers.reserve(srv->cfg.max_batch * 16);
+        touched_.reserve(srv->cfg.max_batch);
+        refresh_date();
+    }
+
+    int run() {
+        if (srv_->cfg.flags & VT_HTTP_PIN_CPUS) pin_cpu();
+        if (srv_->use_uring && ring_.init(kRingEntries)) return run_uring();
+        return run_epoll();
+    }
+
+private:
+    vt_http_server* srv_;
+    unsigned        index_;
+    int             listen_fd_;
+    int             wake_fd_;
+    Limits          lim_{};
+
+    std::unordered_map<uint64_t, std::unique_ptr<Conn>> conns_;
+    vt_http_batch       batch_;
+    std::vector<Conn*>  touched_;
+    char                date_line_[64] = {0};
+    time_t              date_sec_ = 0;
+    uint64_t            last_sweep_ = 0;
+
+    // epoll
+    int epfd_ = -1;
+    // io_uring
+    vt::Uring                ring_;
+    sockaddr_in              acc_addr_{};
+    socklen_t                acc_len_ = sizeof(sockaddr_in);
+    __kernel_timespec        tick_{1, 0};
+    uint64_t                 wake_buf_ = 0;
+
+    /* ———— Commun ———— */
+
+    void pin_cpu() {
+        unsigned ncpu = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index_ % ncpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    void refresh_date() {
+        time_t now = std::time(nullptr);
+        if (now == date_sec_) return;
+        date_sec_ = now;
+        tm g;
+        gmtime_r(&now, &g);
+        std::strftime(date_line_, sizeof(date_line_), "date: %a, %d %b %Y %H:%M:%S GMT\r\n", &g);
+    }
+
+    Conn* new_conn(int fd, const sockaddr_in* addr) {
+        auto c = std::make_unique<Conn>();
+        c->id = srv_->next_conn_id.fetch_add(1, std::memory_order_relaxed);
+        c->fd = fd;
+        c->rx.resize(kRxInitial);
+        c->last_active = now_ms();
+        char ip[INET_ADDRSTRLEN] = "-";
+        if (addr) inet_ntop(AF_INET, &addr->sin_addr, ip, sizeof(ip));
+        std::snprintf(c->peer, sizeof(c->peer), "%s:%u", ip,
+                      addr ? static_cast<unsigned>(ntohs(addr->sin_port)) : 0u);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        Conn* raw = c.get();
+        conns_.emplace(raw->id, std::move(c));
+        srv_->accepted.fetch_add(1, std::memory_order_relaxed);
+        return raw;
+    }
+
+    void destroy(Conn* c) {
+        if (c->fd >= 0) ::close(c->fd);
+        c->fd = -1;
+        srv_->closed.fetch_add(1, std::memory_order_relaxed);
+        conns_.erase(c->id);
+    }
+
+    // Ferme dès que possible : jamais tant que le batch référence rx.
+    void maybe_close(Conn* c) {
+        if (c->in_batch > 0 || c->touched) return;
+        const bool drained = c->tx_off >= c->tx.size() && c->tx_next.empty();
+        if (!c->dead && !(c->closing && drained)) return;
+        if (c->pending > 0) {
+            // io_uring : shutdown() réveille les opérations en vol ; on détruira à la dernière CQE.
+            if (!c->dead) ::shutdown(c->fd, SHUT_RDWR);
+            c->dead = true;
+            return;
+        }
+        destroy(c);
+    }
+
+    // Réserve de la place dans rx. false si la limite est atteinte.
+    bool ensure_room(Conn* c) {
+        if (c->in_batch == 0 && c->rx_off > 0) {
+            const size_t rem = c->rx_len - c->rx_off;
+            if (rem) std::memmove(c->rx.data(), c->rx.data() + c->rx_off, rem);
+            c->rx_len = rem;
+            c->rx_off = 0;
+        }
+        if (c->rx_len < c->rx.size()) return true;
+        if (c->in_batch > 0) return false;   // l’appelant doit d’abord dispatcher
+        const size_t cap = static_cast<size_t>(lim_.max_header) + static_cast<size_t>(lim_.max_body);
+        if (c->rx.size() >= cap) return false;
+        c->rx.resize(std::min(cap, c->rx.size() * 2));
+        return true;
+    }
+
+    void write_error(Conn* c, int status) {
+        char buf[256];
+        const char* msg = reason(status);
+        int n = std::snprintf(buf, sizeof(buf),
+                              "HTTP/1.1 %d %s\r\ncontent-type: text/plain; charset=utf-8\r\n"
+                              "content-length: %zu\r\n%sconnection: close\r\n\r\n%s",
+                              status, msg, std::strlen(msg), date_line_, msg);
+        c->tx_next.append(buf, static_cast<size_t>(n));
+        c->closing = true;
+        srv_->bad_requests.fetch_add(1, std::memory_order_relaxed);
+        mark_touched(c);
+    }
+
+    void mark_touched(Conn* c) {
+        if (!c->touched) {
+            c->touched = true;
+            touched_.push_back(c);
+        }
+    }
+
+    // Indexe toutes les requêtes complètes de rx dans le batch courant.
+    void parse_available(Conn* c) {
+        while (!c->closing && c->rx_off < c->rx_len) {
+            vt_http::Entry e;
+            e.conn = c;
+            e.hdr_begin = batch_.headers.size();
+            size_t consumed = 0;
+            Parse st = parse_request(c->rx.data() + c->rx_off, c->rx_len - c->rx_off, lim_,
+                                     e.req, batch_.headers, consumed);
+            if (st != Parse::Ok) batch_.headers.resize(e.hdr_begin);
+            switch (st) {
+                case Parse::Ok: break;
+                case Parse::Incomplete: return;
+                case Parse::Bad:            write_error(c, 400); return;
+                case Parse::HeaderTooLarge: write_error(c, 431); return;
+                case Parse::BodyTooLarge:   write_error(c, 413); return;
+                case Parse::Unsupported:    write_error(c, 501); return;
+            }
+            e.req.conn_id = c->id;
+            e.req.peer = c->peer;
+            e.req.header_count = static_cast<uint32_t>(batch_.headers.size() - e.hdr_begin);
+            c->rx_off += consumed;
+            c->in_batch++;
+            if (!e.req.keep_alive) c->closing = true;
+            batch_.entries.push_back(std::move(e));
+            mark_touched(c);
+            if (batch_.entries.size() >= srv_->cfg.max_batch) {
+                const uint64_t id = c->id;
+                dispatch();
+                if (!conns_.count(id)) return;
+            }
+        }
+    }
+
+    // Livre le batch au callback puis pousse les réponses, dans l’ordre, vers les connexions.
+    void dispatch() {
+        if (!batch_.entries.empty()) {
+            for (auto& e : batch_.entries) e.req.headers = batch_.headers.data() + e.hdr_begin;
+            batch_.date = date_line_;
+            srv_->fn(srv_->user, &batch_);
+
+            for (auto& e : batch_.entries) {
+                Conn* c = e.conn;
+                if (!e.answered) {
+                    vt_http_batch_respond(&batch_, static_cast<size_t>(&e - batch_.entries.data()),
+                                          500, nullptr, 0, nullptr, 0);
+                }
+                if (!c->dead) {
+                    if (c->tx_next.empty()) c->tx_next.swap(e.out);
+                    else c->tx_next.append(e.out);
+                }
+                c->in_batch--;
+            }
+            srv_->requests.fetch_add(batch_.entries.size(), std::memory_order_relaxed);
+            srv_->batches.fetch_add(1, std::memory_order_relaxed);
+            batch_.entries.clear();
+            batch_.headers.clear();
+        }
+        for (Conn* c : touched_) {
+            c->touched = false;
+            after_dispatch(c);
+        }
+        touched_.clear();
+    }
+
+    void after_dispatch(Conn* c) {
+        if (ring_.ok()) {
+            if (!c->dead) {
+                arm_send(c);
+                if (!c->closing) arm_recv(c);
+            }
+        } else if (!c->dead) {
+            flush_epoll(c);
+        }
+        maybe_close(c);
+    }
+
+    void sweep_idle() {
+        const uint64_t now = now_ms();
+        if (now - last_sweep_ < 1000) return;
+        last_sweep_ = now;
+        refresh_date();
+        std::vector<Conn*> idle;
+        for (auto& kv : conns_) {
+            Conn* c = kv.second.get();
+            if (c->in_batch == 0 && !c->touched && now - c->last_active > srv_->cfg.idle_timeout_ms) idle.push_back(c);
+        }
+        for (Conn* c : idle) {
+            c->dead = true;
+            maybe_close(c);
+        }
+    }
+
+    void close_all() {
+        std::vector<Conn*> all;
+        all.reserve(conns_.size());
+        for (auto& kv : conns_) all.push_back(kv.second.get());
+        for (Conn* c : all) destroy(c);
+    }
+
+    /* ———— epoll ———— */
+
+    int run_epoll() {
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epfd_ < 0) return -errno;
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | (srv_->listen_fds.size() == 1 ? EPOLLEXCLUSIVE : 0u);
+        ev.data.u64 = 0;
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, listen_fd_, &ev) < 0) return -errno;
+        ev.events = EPOLLIN;
+        ev.data.u64 = kWakeTag;
+        epoll_ctl(epfd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+
+        std::vector<epoll_event> events(256);
+        while (!srv_->stopping.load(std::memory_order_acquire)) {
+            int n = epoll_wait(epfd_, events.data(), static_cast<int>(events.size()), 1000);
+            if (n < 0 && errno != EINTR) break;
+            for (int i = 0; i < n; ++i) {
+                const uint64_t id = events[i].data.u64;
+                if (id == 0) { accept_epoll(); continue; }
+                if (id == kWakeTag) continue;
+                auto it = conns_.find(id);
+                if (it == conns_.end()) continue;
+                Conn* c = it->second.get();
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) read_epoll(c);
+                if (conns_.count(id) && (events[i].events & EPOLLOUT)) {
+                    flush_epoll(c);
+                    maybe_close(c);
+                }
+            }
+            dispatch();
+            sweep_idle();
+        }
+        close_all();
+        ::close(epfd_);
+        return 0;
+    }
+
+    void accept_epoll() {
+        for (;;) {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            int fd = accept4(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                return;   // EAGAIN, EMFILE… : on réessaiera au prochain réveil
+            }
+            Conn* c = new_conn(fd, &addr);
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            ev.data.u64 = c->id;
+            if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) < 0) destroy(c);
+        }
+    }
+
+    void read_epoll(Conn* c) {
+        const uint64_t id = c->id;
+        while (!c->closing && !c->dead) {
+            if (!ensure_room(c)) {
+                if (c->in_batch > 0) {
+                    dispatch();
+                    if (!conns_.count(id)) return;
+                    continue;
+                }
+                write_error(c, 431);
+                break;
+            }
+            ssize_t r = ::recv(c->fd, c->rx.data() + c->rx_len, c->rx.size() - c->rx_len, 0);
+            if (r > 0) {
+                c->rx_len += static_cast<size_t>(r);
+                c->last_active = now_ms();
+                parse_available(c);
+                if (!conns_.count(id)) return;
+                continue;
+            }
+            if (r == 0) { c->closing = true; break; }
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) c->dead = true;
+            break;
+        }
+        mark_touched(c);
+    }
+
+    void flush_epoll(Conn* c) {
+        for (;;) {
+            if (c->tx_off >= c->tx.size()) {
+                c->tx.clear();
+                c->tx_off = 0;
+                if (c->tx_next.empty()) return;
+                c->tx.swap(c->tx_next);
+            }
+            ssize_t w = ::send(c->fd, c->tx.data() + c->tx_off, c->tx.size() - c->tx_off, MSG_NOSIGNAL);
+            if (w > 0) { c->tx_off += static_cast<size_t>(w); continue; }
+            if (w < 0 && errno == EINTR) continue;
+            if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;   // EPOLLOUT suivra
+            c->dead = true;
+            return;
+        }
+    }
+
+    /* ———— io_uring ———— */
+
+    int run_uring() {
+        arm_accept();
+        arm_tick();
+        arm_wake();
+        while (!srv_->stopping.load(std::memory_order_acquire)) {
+            int r = ring_.submit_and_wait(1);
+            if (r < 0 && r != -EBUSY && r != -EAGAIN) break;
+            ring_.for_each_cqe([this](const io_uring_cqe& cqe) { on_cqe(cqe); });
+            dispatch();
+        }
+        close_all();
+        ring_.close();
+        return 0;
+    }
+
+    void arm_accept() {
+        io_uring_sqe* s = ring_.sqe();
+        if (!s) return;
+        acc_len_ = sizeof(acc_addr_);
+        s->opcode = IORING_OP_ACCEPT;
+        s->fd = listen_fd_;
+        s->addr = reinterpret_cast<uint64_t>(&acc_addr_);
+        s->addr2 = reinterpret_cast<uint64_t>(&acc_len_);
+        s->accept_flags = SOCK_CLOEXEC;
+        s->user_data = tag(0, OP_ACCEPT);
+    }
+
+    void arm_tick() {
+        io_uring_sqe* s = ring_.sqe();
+        if (!s) return;
+        s->opcode = IORING_OP_TIMEOUT;
+        s->fd = -1;
+        s->addr = reinterpret_cast<uint64_t>(&tick_);
+        s->len = 1;
+        s->user_data = tag(0, OP_TICK);
+    }
+
+    void arm_wake() {
+        io_uring_sqe* s = ring_.sqe();
+        if (!s) return;
+        s->opcode = IORING_OP_READ;
+        s->fd = wake_fd_;
+        s->addr = reinterpret_cast<uint64_t>(&wake_buf_);
+        s->len = sizeof(wake_buf_);
+        s->user_data = tag(0, OP_WAKE);
+    }
+
+    void arm_recv(Conn* c) {
+        if (c->recv_armed || c->closing || c->dead || c->in_batch > 0) return;
+        if (!ensure_room(c)) { write_error(c, 431); arm_send(c); return; }
+        io_uring_sqe* s = ring_.sqe();
+        if (!s) { c->dead = true; return; }
+        s->opcode = IORING_OP_RECV;
+        s->fd = c->fd;
+        s->addr = reinterpret_cast<uint64_t>(c->rx.data() + c->rx_len);
+        s->len = static_cast<uint32_t>(c->rx.size() - c->rx_len);
+        s->user_data = tag(c->id, OP_RECV);
+        c->recv_armed = true;
+        c->pending++;
+    }
+
+    void arm_send(Conn* c) {
+        if (c->send_armed || c->dead) return;
+        if (c->tx_off >= c->tx.size()) {
+            c->tx.clear();
+            c->tx_off = 0;
+            if (c->tx_next.empty()) return;
+            c->tx.swap(c->tx_next);
+        }
+        io_uring_sqe* s = ring_.sqe();
+        if (!s) { c->dead = true; return; }
+        s->opcode = IORING_OP_SEND;
+        s->fd = c->fd;
+        s->addr = reinterpret_cast<uint64_t>(c->tx.data() + c->tx_off);
+        s->len = static_cast<uint32_t>(c->tx.size() - c->tx_off);
+        s->msg_flags = MSG_NOSIGNAL;
+        s->user_data = tag(c->id, OP_SEND);
+        c->send_armed = true;
+        c->pending++;
+    }
+
+    void on_cqe(const io_uring_cqe& cqe) {
+        const Op op = static_cast<Op>(cqe.user_data & 0xF);
+        const uint64_t id = cqe.user_data >> 4;
+        switch (op) {
+            case OP_ACCEPT:
+                if (cqe.res >= 0) {
+                    Conn* c = new_conn(cqe.res, &acc_addr_);
+                    arm_recv(c);
+                }
+                if (!srv_->stopping.load(std::memory_order_relaxed)) arm_accept();
+                return;
+            case OP_TICK:
+                sweep_idle();
+                arm_tick();
+                return;
+            case OP_WAKE:
+                arm_wake();
+                return;
+            default:
+                break;
+        }
+
+        auto it = conns_.find(id);
+        if (it == conns_.end()) return;
+        Conn* c = it->second.get();
+        c->pending--;
+
+        if (op == OP_RECV) {
+            c->recv_armed = false;
+            if (cqe.res > 0 && !c->dead) {
+                c->rx_len += static_cast<size_t>(cqe.res);
+                c->last_active = now_ms();
+                parse_available(c);
+                if (!conns_.count(id)) return;
+                mark_touched(c);   // ré-armement après dispatch (rx ne doit pas bouger avant)
+                return;
+            }
+            if (cqe.res == 0) c->closing = true;
+            else if (cqe.res != -EINTR && cqe.res != -EAGAIN) c->dead = true;
+            mark_touched(c);
+            return;
+        }
+
+        if (op == OP_SEND) {
+            c->send_armed = false;
+            if (cqe.res > 0 && !c->dead) {
+                c->tx_off += static_cast<size_t>(cqe.res);
+                arm_send(c);
+            } else if (cqe.res < 0 && cqe.res != -EINTR && cqe.res != -EAGAIN) {
+                c->dead = true;
+            } else {
+                arm_send(c);
+            }
+            maybe_close(c);
+        }
+    }
+};
+
+static bool probe_uring() {
+    vt::Uring r;
+    return r.init(2);
+}
+
+static int open_listener(const vt_http_config& cfg, bool reuseport) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -errno;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (reuseport && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+        int e = errno;
+        ::close(fd);
+        return -e;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(cfg.port);
+    if (inet_pton(AF_INET, cfg.host ? cfg.host : "0.0.0.0", &addr.sin_addr) != 1) {
+        ::close(fd);
+        return -EINVAL;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, 4096) < 0) {
+        int e = errno;
+        ::close(fd);
+        return -e;
+    }
+    return fd;
+}
+
+} // namespace vt_http
+
+extern "C" {
+
+VT_API void vt_http_config_default(vt_http_config* cfg) {
+    if (!cfg) return;
+    std::memset(cfg, 0, sizeof(*cfg));
+    cfg->host = "0.0.0.0";
+    cfg->port = 8080;
+    cfg->backend = VT_HTTP_BACKEND_AUTO;
+}
+
+VT_API vt_http_server* vt_http_server_new(const vt_http_config* cfg, vt_http_batch_fn fn, void* user) {
+    if (!cfg || !fn) { errno = EINVAL; return nullptr; }
+
+    auto s = std::make_unique<vt_http_server>();
+    s->cfg = *cfg;
+    s->fn = fn;
+    s->user = user;
+    if (!s->cfg.threads) s->cfg.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (!s->cfg.max_batch) s->cfg.max_batch = 64;
+    if (!s->cfg.max_header_bytes) s->cfg.max_header_bytes = 64 * 1024;
+    if (!s->cfg.max_body_bytes) s->cfg.max_body_bytes = 8ull * 1024 * 1024;
+    if (!s->cfg.idle_timeout_ms) s->cfg.idle_timeout_ms = 30000;
+
+    if (s->cfg.backend != VT_HTTP_BACKEND_EPOLL) s->use_uring = vt_http::probe_uring();
+    if (s->cfg.backend == VT_HTTP_BACKEND_URING && !s->use_uring) { errno = ENOSYS; return nullptr; }
+
+    // Une socket SO_REUSEPORT par réacteur ; à défaut, une socket partagée.
+    for (uint32_t i = 0; i < s->cfg.threads; ++i) {
+        int fd = vt_http::open_listener(s->cfg, true);
+        if (fd == -ENOPROTOOPT || fd == -EINVAL) {
+            for (int f : s->listen_fds) ::close(f);
+            s->listen_fds.clear();
+            fd = vt_http::open_listener(s->cfg, false);
+            if (fd < 0) { errno = -fd; return nullptr; }
+            s->listen_fds.push_back(fd);
+            break;
+        }
+        if (fd < 0) {
+            for (int f : s->listen_fds) ::close(f);
+            errno = -fd;
+            return nullptr;
+        }
+        s->listen_fds.push_back(fd);
+    }
+    for (uint32_t i = 0; i < s->cfg.threads; ++i) {
+        s->wake_fds.push_back(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    }
+    return s.release();
+}
+
+VT_API int vt_http_server_run(vt_http_server* s) {
+    if (!s) return -EINVAL;
+    std::vector<std::thread> threads;
+    std::vector<int> rc(s->cfg.threads, 0);
+    for (uint32_t i = 1; i < s->cfg.threads; ++i) {
+        threads.emplace_back([s, i, &rc] { rc[i] = vt_http::Reactor(s, i).run(); });
+    }
+    rc[0] = vt_http::Reactor(s, 0).run();
+    s->stopping.store(true, std::memory_order_release);
+    for (int fd : s->wake_fds) { uint64_t one = 1; (void)!::write(fd, &one, sizeof(one)); }
+    for (auto& t : threads) t.join();
+    for (int r : rc) if (r < 0) return r;
+    return 0;
+}
+
+VT_API void vt_http_server_stop(vt_http_server* s) {
+    if (!s) return;
+    s->stopping.store(true, std::memory_order_release);
+    for (int fd : s->wake_fds) { uint64_t one = 1; (void)!::write(fd, &one, sizeof(one)); }
+}
+
+VT_API void vt_http_server_free(vt_http_server* s) {
+    if (!s) return;
+    for (int fd : s->listen_fds) ::close(fd);
+    for (int fd : s->wake_fds) if (fd >= 0) ::close(fd);
+    delete s;
+}
+
+VT_API const char* vt_http_server_backend(const vt_http_server* s) {
+    if (!s) return "none";
+    return s->use_uring ? "io_uring" : "epoll";
+}
+
+VT_API void vt_http_server_stats(const vt_http_server* s, vt_http_stats* out) {
+    if (!s || !out) return;
+    out->accepted     = s->accepted.load(std::memory_order_relaxed);
+    out->closed       = s->closed.load(std::memory_order_relaxed);
+    out->requests     = s->requests.load(std::memory_order_relaxed);
+    out->batches      = s->batches.load(std::memory_order_relaxed);
+    out->bad_requests = s->bad_requests.load(std::memory_order_relaxed);
+}
+
+VT_API size_t vt_http_batch_len(const vt_http_batch* b) {
+    return b ? b->entries.size() : 0;
+}
+
+VT_API const vt_http_request* vt_http_batch_get(const vt_http_batch* b, size_t i) {
+    if (!b || i >= b->entries.size()) return nullptr;
+    return &b->entries[i].req;
+}
+
+VT_API int vt_http_batch_respond(vt_http_batch* b, size_t i, int status,
+                                 const char* headers, size_t headers_len,
+                                 const uint8_t* body, size_t body_len) {
+    if (!b || i >= b->entries.size()) return -EINVAL;
+    vt_http::Entry& e = b->entries[i];
+    if (e.answered) return -EALREADY;
+    if (status < 100 || status > 999) status = 500;
+
+    const bool no_body = status == 204 || status == 304 || (status >= 100 && status < 200);
+    const bool head = e.req.method_len == 4 && std::memcmp(e.req.method, "HEAD", 4) == 0;
+
+    char line[96];
+    int n = std::snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n", status, vt_http::reason(status));
+    std::string& out = e.out;
+    out.clear();
+    out.reserve(static_cast<size_t>(n) + headers_len + 96 + (head || no_body ? 0 : body_len));
+    out.append(line, static_cast<size_t>(n));
+    if (headers && headers_len) {
+        out.append(headers, headers_len);
+        if (headers_len < 2 || headers[headers_len - 2] != '\r' || headers[headers_len - 1] != '\n') {
+            out.append("\r\n");
+        }
+    }
+    if (!no_body) {
+        n = std::snprintf(line, sizeof(line), "content-length: %zu\r\n", body_len);
+        out.append(line, static_cast<size_t>(n));
+    }
+    out.append(b->date);
+    out.append(e.req.keep_alive ? "connection: keep-alive\r\n\r\n" : "connection: close\r\n\r\n");
+    if (!no_body && !head && body && body_len) out.append(reinterpret_cast<const char*>(body), body_len);
+    e.answered = true;
+    return 0;
+}
+
+VT_API int vt_http_header_find(const vt_http_request* r, const char* name,
+                               const char** value, size_t* value_len) {
+    if (!r || !name) return 0;
+    const size_t n = std::strlen(name);
+    for (uint32_t i = 0; i < r->header_count; ++i) {
+        const vt_http_header& h = r->headers[i];
+        if (vt_http::ieq(h.name, h.name_len, name, n)) {
+            if (value) *value = h.value;
+            if (value_len) *value_len = h.value_len;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // extern "C"
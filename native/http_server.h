@@ -0,0 +1,123 @@
+// native/http_server.h
+// Moteur HTTP/1.1 natif (multi-réacteur, io_uring avec repli epoll).
+//
+// API C exposée (ABI stable pour FFI):
+//   void               vt_http_config_default(vt_http_config* cfg);
+//   vt_http_server*    vt_http_server_new(const vt_http_config* cfg, vt_http_batch_fn fn, void* user);
+//   int                vt_http_server_run(vt_http_server* s);     // bloque jusqu’à stop()
+//   void               vt_http_server_stop(vt_http_server* s);    // thread-safe / signal-safe
+//   void               vt_http_server_free(vt_http_server* s);
+//   const char*        vt_http_server_backend(const vt_http_server* s);
+//   void               vt_http_server_stats(const vt_http_server* s, vt_http_stats* out);
+//   size_t             vt_http_batch_len(const vt_http_batch* b);
+//   const vt_http_request* vt_http_batch_get(const vt_http_batch* b, size_t i);
+//   int                vt_http_batch_respond(vt_http_batch* b, size_t i, int status,
+//                                            const char* headers, size_t headers_len,
+//                                            const uint8_t* body, size_t body_len);
+//   int                vt_http_header_find(const vt_http_request* r, const char* name,
+//                                          const char** value, size_t* value_len);
+//
+// Modèle :
+// - Un réacteur (thread + boucle d’événements) par cœur, chacun avec sa propre
+//   socket d’écoute SO_REUSEPORT : le noyau répartit les connexions.
+// - io_uring si disponible (noyau ≥ 5.6, pas de seccomp), sinon epoll (edge-triggered).
+// - Les requêtes sont indexées SANS copie : méthode, cible, en-têtes et corps sont
+//   des vues (pointeur + longueur) dans le buffer de réception de la connexion.
+//   Ces vues ne sont valides QUE pendant l’appel du callback.
+// - Keep-alive et pipelining HTTP/1.1 ; les réponses partent dans l’ordre des requêtes.
+// - Toutes les requêtes complètes d’un tour de boucle sont livrées en UN appel
+//   (vt_http_batch_fn), ce qui amortit le passage FFI vers le runtime Vitte.
+//
+// Le callback est invoqué depuis plusieurs réacteurs en parallèle : il doit être
+// ré-entrant (c’est le cas d’une `middleware::Chain` sans état partagé mutable).
+
+#ifndef VITTE_NATIVE_HTTP_SERVER_H
+#define VITTE_NATIVE_HTTP_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum {
+    VT_HTTP_BACKEND_AUTO  = 0,
+    VT_HTTP_BACKEND_URING = 1,
+    VT_HTTP_BACKEND_EPOLL = 2,
+};
+
+enum {
+    VT_HTTP_PIN_CPUS = 1u << 0,   // épingle le réacteur i sur le cœur i
+};
+
+typedef struct vt_http_config {
+    const char* host;             // adresse IPv4 d’écoute (NULL = "0.0.0.0")
+    uint16_t    port;             // port TCP
+    uint32_t    threads;          // nb de réacteurs (0 = nb de cœurs)
+    uint32_t    max_batch;        // requêtes max par appel du callback (0 = 64)
+    uint32_t    max_header_bytes; // taille max ligne de requête + en-têtes (0 = 64 KiB)
+    uint64_t    max_body_bytes;   // taille max du corps (0 = 8 MiB)
+    uint32_t    idle_timeout_ms;  // fermeture des connexions inactives (0 = 30 s)
+    uint32_t    backend;          // VT_HTTP_BACKEND_*
+    uint32_t    flags;            // VT_HTTP_PIN_CPUS, …
+} vt_http_config;
+
+typedef struct vt_http_header {
+    const char* name;             // vue dans le buffer de réception (casse d’origine)
+    uint32_t    name_len;
+    const char* value;            // espaces de tête/queue retirés
+    uint32_t    value_len;
+} vt_http_header;
+
+typedef struct vt_http_request {
+    uint64_t              conn_id;      // identifiant de connexion (unique par serveur)
+    const char*           method;
+    uint32_t              method_len;
+    const char*           target;       // chemin + query brute (non décodée)
+    uint32_t              target_len;
+    uint8_t               version_minor; // 0 = HTTP/1.0, 1 = HTTP/1.1
+    uint8_t               keep_alive;    // 1 si la connexion reste ouverte après réponse
+    const vt_http_header* headers;
+    uint32_t              header_count;
+    const uint8_t*        body;
+    uint64_t              body_len;
+    const char*           peer;          // "ip:port" (chaîne C, stable pendant la connexion)
+} vt_http_request;
+
+typedef struct vt_http_stats {
+    uint64_t accepted;
+    uint64_t closed;
+    uint64_t requests;
+    uint64_t batches;
+    uint64_t bad_requests;
+} vt_http_stats;
+
+typedef struct vt_http_server vt_http_server;
+typedef struct vt_http_batch  vt_http_batch;
+
+// `headers` : bloc préformaté "nom: valeur\r\n"… (sans content-length/connection/date,
+// ajoutés par le moteur). Les données sont copiées avant retour.
+typedef void (*vt_http_batch_fn)(void* user, vt_http_batch* batch);
+
+VT_API void             vt_http_config_default(vt_http_config* cfg);
+VT_API vt_http_server*  vt_http_server_new(const vt_http_config* cfg, vt_http_batch_fn fn, void* user);
+VT_API int              vt_http_server_run(vt_http_server* s);
+VT_API void             vt_http_server_stop(vt_http_server* s);
+VT_API void             vt_http_server_free(vt_http_server* s);
+VT_API const char*      vt_http_server_backend(const vt_http_server* s);
+VT_API void             vt_http_server_stats(const vt_http_server* s, vt_http_stats* out);
+
+VT_API size_t                 vt_http_batch_len(const vt_http_batch* b);
+VT_API const vt_http_request* vt_http_batch_get(const vt_http_batch* b, size_t i);
+VT_API int                    vt_http_batch_respond(vt_http_batch* b, size_t i, int status,
+                                                    const char* headers, size_t headers_len,
+                                                    const uint8_t* body, size_t body_len);
+
+// Recherche insensible à la casse. Retourne 1 si trouvé, 0 sinon.
+VT_API int vt_http_header_find(const vt_http_request* r, const char* name,
+                               const char** value, size_t* value_len);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_HTTP_SERVER_H
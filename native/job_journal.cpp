@@ -0,0 +1,919 @@
+// native/job_journal.cpp
+// Journal segmenté de la file de jobs (cf. job_journal.h pour l’API C et le format).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -msse4.2 -fPIC -c native/job_journal.cpp -o build/job_journal.o
+//   g++ build/app.o build/job_journal.o -pthread -o bin/worker-jobs
+//
+// Remarques :
+// - POSIX (mmap, flock, fdatasync). CRC32C matériel si compilé avec SSE4.2, table sinon.
+// - L’index est une table à adressage ouvert (sondage linéaire, tombstones) : l’emplacement
+//   d’une clé ne change pas lors d’un snapshot, seuls (fichier, offset) sont réécrits.
+
+#include "job_journal.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace vt_journal {
+
+constexpr char SEG_MAGIC[8]  = {'V','T','J','S','E','G','0','1'};
+constexpr char SNAP_MAGIC[8] = {'V','T','J','S','N','P','0','1'};
+constexpr char IDX_MAGIC[8]  = {'V','T','J','I','D','X','0','1'};
+
+constexpr uint8_t REC_PUT = 1;
+constexpr uint8_t REC_DEL = 2;
+
+constexpr uint64_t SLOT_EMPTY = 0;
+constexpr uint64_t SLOT_TOMB  = 1;
+constexpr uint32_t FILE_SNAP  = 0;   // sinon : numéro de segment (≥ 1)
+
+struct FileHdr {
+    char     magic[8];
+    uint64_t base_lsn;   // segment : premier LSN ; snapshot : dernier LSN couvert
+    uint64_t count;      // snapshot : nombre d’enregistrements
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHdr) == 32);
+
+struct RecHdr {
+    uint32_t crc;        // CRC32C de tout ce qui suit (en-tête restant + clé + valeur)
+    uint32_t len;        // en-tête + clé + valeur, hors padding
+    uint64_t lsn;
+    uint8_t  type;
+    uint8_t  pad;
+    uint16_t klen;
+    uint32_t vlen;
+};
+static_assert(sizeof(RecHdr) == 24);
+
+struct IdxHdr {
+    char     magic[8];
+    uint32_t version;
+    uint32_t clean;          // 1 = fermé proprement, index cohérent avec les fichiers
+    uint64_t snapshot_lsn;
+    uint64_t next_lsn;
+    uint64_t slots;
+    uint64_t live;
+    uint64_t used;           // live + tombstones
+    uint32_t tail_seg;
+    uint32_t pad;
+    uint64_t tail_off;
+    uint64_t reserved[7];
+};
+static_assert(sizeof(IdxHdr) == 128);
+
+struct Slot {
+    uint64_t hash;           // 0 = vide, 1 = tombstone
+    uint32_t file;
+    uint32_t pad;
+    uint64_t off;
+};
+static_assert(sizeof(Slot) == 24);
+
+static inline size_t align8(size_t n) { return (n + 7) & ~size_t(7); }
+
+/* ———————————————————— CRC32C / hachage ———————————————————— */
+
+#if defined(__SSE4_2__)
+static uint32_t crc32c(const uint8_t* p, size_t n, uint32_t crc = 0) {
+    crc = ~crc;
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = static_cast<uint32_t>(_mm_crc32_u64(crc, v));
+        p += 8;
+        n -= 8;
+    }
+    while (n--) crc = _mm_crc32_u8(crc, *p++);
+    return ~crc;
+}
+#else
+struct CrcTable {
+    uint32_t t[256];
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1u)));
+            t[i] = c;
+        }
+    }
+};
+static uint32_t crc32c(const uint8_t* p, size_t n, uint32_t crc = 0) {
+    static const CrcTable tab;
+    crc = ~crc;
+    while (n--) crc = tab.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+#endif
+
+static uint64_t hash_key(const char* k, size_t n) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ (n * 0xC2B2AE3D27D4EB4Full);
+    const auto* p = reinterpret_cast<const uint8_t*>(k);
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        h = (h ^ v) * 0xFF51AFD7ED558CCDull;
+        h ^= h >> 32;
+        p += 8;
+        n -= 8;
+    }
+    uint64_t v = 0;
+    std::memcpy(&v, p, n);
+    h = (h ^ v) * 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h < 2 ? h + 2 : h;
+}
+
+static uint32_t rec_crc(const RecHdr* r) {
+    const auto* p = reinterpret_cast<const uint8_t*>(r) + sizeof(uint32_t);
+    return crc32c(p, r->len - sizeof(uint32_t));
+}
+
+/* ———————————————————— Fichiers ———————————————————— */
+
+struct Mapped {
+    int      fd = -1;
+    uint8_t* base = nullptr;
+    size_t   size = 0;
+    uint64_t base_lsn = 0;
+    uint64_t used = sizeof(FileHdr);   // segment : fin des enregistrements valides
+
+    const FileHdr* hdr() const { return reinterpret_cast<const FileHdr*>(base); }
+
+    void unmap() {
+        if (base) ::munmap(base, size);
+        if (fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+        size = 0;
+    }
+};
+
+// Mappe en lecture ; `flags` = O_RDWR si l’appelant écrit ensuite par le descripteur.
+static int map_ro(const std::string& path, Mapped& m, int flags = O_RDWR) {
+    m.fd = ::open(path.c_str(), flags | O_CLOEXEC);
+    if (m.fd < 0) return -errno;
+    struct stat st;
+    if (::fstat(m.fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(FileHdr)) {
+        int e = errno ? -errno : -EBADMSG;
+        m.unmap();
+        return e;
+    }
+    m.size = static_cast<size_t>(st.st_size);
+    void* p = ::mmap(nullptr, m.size, PROT_READ, MAP_SHARED, m.fd, 0);
+    if (p == MAP_FAILED) {
+        int e = -errno;
+        m.unmap();
+        return e;
+    }
+    m.base = static_cast<uint8_t*>(p);
+    m.base_lsn = m.hdr()->base_lsn;
+    return 0;
+}
+
+static int write_all(int fd, const void* data, size_t n, uint64_t off) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    while (n) {
+        ssize_t w = ::pwrite(fd, p, n, static_cast<off_t>(off));
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+        off += static_cast<uint64_t>(w);
+    }
+    return 0;
+}
+
+static int fsync_dir(const std::string& dir) {
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return -errno;
+    int rc = ::fsync(fd) < 0 ? -errno : 0;
+    ::close(fd);
+    return rc;
+}
+
+static int mkdir_p(const std::string& dir) {
+    std::string cur;
+    size_t i = 0;
+    while (i <= dir.size()) {
+        size_t k = dir.find('/', i);
+        if (k == std::string::npos) k = dir.size();
+        cur = dir.substr(0, k);
+        if (!cur.empty() && ::mkdir(cur.c_str(), 0755) < 0 && errno != EEXIST) return -errno;
+        i = k + 1;
+    }
+    return 0;
+}
+
+// Valide l’enregistrement à `off`. Retourne sa taille alignée, ou 0 s’il est invalide.
+// `want_lsn` = 0 : pas de contrôle de séquence (snapshot).
+static size_t check_rec(const Mapped& m, uint64_t off, uint64_t want_lsn) {
+    if (off + sizeof(RecHdr) > m.size) return 0;
+    const auto* r = reinterpret_cast<const RecHdr*>(m.base + off);
+    if (r->len < sizeof(RecHdr) || off + r->len > m.size) return 0;
+    if (r->type != REC_PUT && r->type != REC_DEL) return 0;
+    if (sizeof(RecHdr) + r->klen + uint64_t(r->vlen) != r->len) return 0;
+    if (want_lsn && r->lsn != want_lsn) return 0;
+    if (rec_crc(r) != r->crc) return 0;
+    return align8(r->len);
+}
+
+} // namespace vt_journal
+
+using namespace vt_journal;
+
+struct vt_jj {
+    std::string  dir;
+    vt_jj_config cfg{};
+    std::mutex   mu;
+    int          lock_fd = -1;
+
+    Mapped                     snap;
+    std::map<uint32_t, Mapped> segs;       // numéro → segment
+    uint32_t                   cur = 0;    // segment d’écriture
+    uint64_t                   next_lsn = 1;
+    uint64_t                   snapshot_lsn = 0;
+
+    int     idx_fd = -1;
+    size_t  idx_size = 0;
+    IdxHdr* ih = nullptr;
+    Slot*   slots = nullptr;
+
+    std::vector<uint8_t> buf;
+    bool                 opened = false;   // index cohérent : peut être marqué propre
+    bool                 readonly = false; // vue (vt_jj_open_readonly) : index anonyme, aucune écriture
+
+    vt_jj_stats st{};
+
+    std::string path(const char* name) const { return dir + "/" + name; }
+    std::string seg_path(uint32_t n) const {
+        char b[32];
+        std::snprintf(b, sizeof(b), "seg-%08x.vtj", n);
+        return path(b);
+    }
+
+    /* ——— Accès aux enregistrements ——— */
+
+    const RecHdr* rec(uint32_t file, uint64_t off) const {
+        const Mapped& m = file == FILE_SNAP ? snap : segs.at(file);
+        return reinterpret_cast<const RecHdr*>(m.base + off);
+    }
+    static const char* rkey(const RecHdr* r) { return reinterpret_cast<const char*>(r + 1); }
+    static const void* rval(const RecHdr* r) { return rkey(r) + r->klen; }
+
+    /* ——— Index ——— */
+
+    int idx_map(size_t slots_n, bool reset) {
+        const size_t want = sizeof(IdxHdr) + slots_n * sizeof(Slot);
+        if (ih) ::munmap(ih, idx_size);
+        ih = nullptr;
+        if (idx_fd >= 0 && ::ftruncate(idx_fd, static_cast<off_t>(want)) < 0) return -errno;
+        // Sans fichier d’index (vue en lecture seule) : mémoire anonyme, déjà à zéro.
+        void* p = idx_fd >= 0 ? ::mmap(nullptr, want, PROT_READ | PROT_WRITE, MAP_SHARED, idx_fd, 0)
+                              : ::mmap(nullptr, want, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return -errno;
+        idx_size = want;
+        ih = static_cast<IdxHdr*>(p);
+        slots = reinterpret_cast<Slot*>(ih + 1);
+        if (reset) {
+            std::memset(p, 0, want);
+            std::memcpy(ih->magic, IDX_MAGIC, 8);
+            ih->version = 1;
+            ih->slots = slots_n;
+        }
+        return 0;
+    }
+
+    // Retourne l’emplacement de `key` (trouvé = true) ou l’emplacement d’insertion.
+    size_t find(uint64_t h, const char* key, size_t klen, bool& found) const {
+        const size_t mask = ih->slots - 1;
+        size_t i = h & mask;
+        size_t ins = SIZE_MAX;
+        for (;;) {
+            const Slot& s = slots[i];
+            if (s.hash == SLOT_EMPTY) {
+                found = false;
+                return ins != SIZE_MAX ? ins : i;
+            }
+            if (s.hash == SLOT_TOMB) {
+                if (ins == SIZE_MAX) ins = i;
+            } else if (s.hash == h) {
+                const RecHdr* r = rec(s.file, s.off);
+                if (r->klen == klen && std::memcmp(rkey(r), key, klen) == 0) {
+                    found = true;
+                    return i;
+                }
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    int idx_grow() {
+        std::vector<Slot> live;
+        live.reserve(ih->live);
+        for (size_t i = 0; i < ih->slots; ++i)
+            if (slots[i].hash >= 2) live.push_back(slots[i]);
+        IdxHdr keep = *ih;
+        const size_t n = ih->slots * 2;
+        if (int rc = idx_map(n, true); rc < 0) return rc;
+        keep.slots = n;
+        keep.used = keep.live = live.size();
+        *ih = keep;
+        for (const Slot& s : live) {
+            size_t i = s.hash & (n - 1);
+            while (slots[i].hash != SLOT_EMPTY) i = (i + 1) & (n - 1);
+            slots[i] = s;
+        }
+        st.index_slots = n;
+        return 0;
+    }
+
+    int idx_apply(const RecHdr* r, uint32_t file, uint64_t off) {
+        if ((ih->used + 1) * 10 > ih->slots * 7) {
+            if (int rc = idx_grow(); rc < 0) return rc;
+        }
+        const uint64_t h = hash_key(rkey(r), r->klen);
+        bool found;
+        size_t i = find(h, rkey(r), r->klen, found);
+        if (r->type == REC_PUT) {
+            if (!found) {
+                if (slots[i].hash == SLOT_EMPTY) ++ih->used;
+                ++ih->live;
+            }
+            slots[i] = Slot{h, file, 0, off};
+        } else if (found) {
+            slots[i] = Slot{SLOT_TOMB, 0, 0, 0};
+            --ih->live;
+        }
+        return 0;
+    }
+
+    /* ——— Segments ——— */
+
+    int new_segment(uint32_t n, uint64_t base_lsn, size_t min_bytes) {
+        Mapped m;
+        const std::string p = seg_path(n);
+        m.fd = ::open(p.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m.fd < 0) return -errno;
+        m.size = std::max<size_t>(cfg.segment_bytes, min_bytes + sizeof(FileHdr));
+        if (::posix_fallocate(m.fd, 0, static_cast<off_t>(m.size)) != 0 &&
+            ::ftruncate(m.fd, static_cast<off_t>(m.size)) < 0) {
+            int e = -errno;
+            m.unmap();
+            ::unlink(p.c_str());
+            return e;
+        }
+        FileHdr h{};
+        std::memcpy(h.magic, SEG_MAGIC, 8);
+        h.base_lsn = base_lsn;
+        int rc = write_all(m.fd, &h, sizeof(h), 0);
+        if (rc == 0 && ::fdatasync(m.fd) < 0) rc = -errno;
+        if (rc == 0) rc = fsync_dir(dir);
+        void* pm = rc == 0 ? ::mmap(nullptr, m.size, PROT_READ, MAP_SHARED, m.fd, 0) : MAP_FAILED;
+        if (pm == MAP_FAILED) {
+            if (rc == 0) rc = -errno;
+            m.unmap();
+            ::unlink(p.c_str());
+            return rc;
+        }
+        m.base = static_cast<uint8_t*>(pm);
+        m.base_lsn = base_lsn;
+        segs[n] = m;
+        cur = n;
+        st.segments = segs.size();
+        return 0;
+    }
+
+    // Rejoue un segment depuis `off`. Retourne 1, 0 si une queue invalide a été trouvée,
+    // ou -errno.
+    int replay(uint32_t n, Mapped& m, uint64_t off) {
+        for (;;) {
+            size_t sz = check_rec(m, off, next_lsn);
+            if (!sz) break;
+            const auto* r = reinterpret_cast<const RecHdr*>(m.base + off);
+            if (int rc = idx_apply(r, n, off); rc < 0) return rc;
+            ++next_lsn;
+            ++st.replayed;
+            off += sz;
+        }
+        m.used = off;
+        // Queue propre = zéros jusqu’à la fin du fichier (préallocation).
+        const size_t probe = std::min<size_t>(m.size - off, sizeof(RecHdr));
+        for (size_t i = 0; i < probe; ++i)
+            if (m.base[off + i]) return 0;
+        return 1;
+    }
+
+    // Remet à zéro la fin d’un segment après une queue déchirée : un enregistrement
+    // orphelin au-delà ne doit jamais être repris après de nouveaux ajouts.
+    void zero_tail(Mapped& m) {
+        const off_t end = static_cast<off_t>(m.size);
+        if (::fallocate(m.fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                        static_cast<off_t>(m.used), end - static_cast<off_t>(m.used)) < 0) {
+            if (::ftruncate(m.fd, static_cast<off_t>(m.used)) == 0)
+                (void)::ftruncate(m.fd, end);
+        }
+        (void)::fdatasync(m.fd);
+        st.torn = 1;
+    }
+
+    /* ——— Ouverture ——— */
+
+    int open_all() {
+        if (int rc = mkdir_p(dir); rc < 0) return rc;
+
+        lock_fd = ::open(path("LOCK").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (lock_fd < 0) return -errno;
+        if (::flock(lock_fd, LOCK_EX | LOCK_NB) < 0) return errno == EWOULDBLOCK ? -EBUSY : -errno;
+
+        // 1) Snapshot.
+        int rc = map_ro(path("snapshot.vtj"), snap);
+        if (rc == 0) {
+            if (std::memcmp(snap.hdr()->magic, SNAP_MAGIC, 8) != 0) return -EBADMSG;
+            snapshot_lsn = snap.base_lsn;
+        } else if (rc != -ENOENT) {
+            return rc;
+        }
+        next_lsn = snapshot_lsn + 1;
+
+        // 2) Segments (les plus anciens, déjà couverts par le snapshot, sont supprimés).
+        if (DIR* d = ::opendir(dir.c_str())) {
+            while (dirent* e = ::readdir(d)) {
+                unsigned n = 0;
+                char tail = 0;
+                if (std::sscanf(e->d_name, "seg-%8x.vt%c", &n, &tail) != 2 || tail != 'j' ||
+                    std::strlen(e->d_name) != 16 || n == 0)
+                    continue;
+                Mapped m;
+                if (map_ro(seg_path(n), m) < 0) continue;
+                if (std::memcmp(m.hdr()->magic, SEG_MAGIC, 8) != 0 || m.base_lsn <= snapshot_lsn) {
+                    m.unmap();
+                    ::unlink(seg_path(n).c_str());
+                    continue;
+                }
+                segs[n] = m;
+            }
+            ::closedir(d);
+        }
+
+        // 3) Index : réutilisé si fermeture propre, sinon reconstruit.
+        idx_fd = ::open(path("index.vtj").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (idx_fd < 0) return -errno;
+        struct stat sb;
+        if (::fstat(idx_fd, &sb) < 0) return -errno;
+
+        bool clean = false;
+        if (static_cast<size_t>(sb.st_size) >= sizeof(IdxHdr)) {
+            IdxHdr h;
+            if (::pread(idx_fd, &h, sizeof(h), 0) == static_cast<ssize_t>(sizeof(h)) &&
+                std::memcmp(h.magic, IDX_MAGIC, 8) == 0 && h.clean == 1 &&
+                h.snapshot_lsn == snapshot_lsn && h.slots && (h.slots & (h.slots - 1)) == 0 &&
+                static_cast<size_t>(sb.st_size) == sizeof(IdxHdr) + h.slots * sizeof(Slot) &&
+                segs.count(h.tail_seg) && segs.rbegin()->first == h.tail_seg) {
+                if ((rc = idx_map(h.slots, false)) < 0) return rc;
+                Mapped& m = segs[h.tail_seg];
+                // Rien après la queue enregistrée ? (sinon le drapeau ment : reconstruction)
+                if (h.tail_off >= sizeof(FileHdr) && h.tail_off <= m.size && h.tail_off % 8 == 0 &&
+                    !check_rec(m, h.tail_off, h.next_lsn)) {
+                    clean = true;
+                    cur = h.tail_seg;
+                    next_lsn = h.next_lsn;
+                    m.used = h.tail_off;
+                    for (auto& [n, s] : segs) {
+                        if (n != cur) s.used = s.size;
+                        st.log_bytes += s.used - sizeof(FileHdr);
+                    }
+                }
+            }
+        }
+
+        if (!clean) {
+            if ((rc = rebuild()) < 0) return rc;
+        }
+
+        if (segs.empty()) {
+            if ((rc = new_segment(1, next_lsn, 0)) < 0) return rc;
+        } else {
+            cur = segs.rbegin()->first;
+        }
+
+        ih->clean = 0;
+        ih->snapshot_lsn = snapshot_lsn;
+        ::msync(ih, sizeof(IdxHdr), MS_SYNC);
+
+        st.clean_start = clean ? 1 : 0;
+        st.segments = segs.size();
+        st.index_slots = ih->slots;
+        return 0;
+    }
+
+    // Vue en lecture seule, sans flock : snapshot + segments rejoués dans un index anonyme.
+    // Rien n’est écrit (ni index, ni queue remise à zéro, ni quarantaine). Un writer actif
+    // peut compacter pendant l’ouverture : snapshot et segments de générations différentes
+    // (trou de LSN avant le premier segment) ⇒ -EAGAIN, l’appelant recommence. Une queue
+    // en cours d’écriture ou déchirée arrête simplement la relecture (préfixe cohérent).
+    int open_view(bool last_try) {
+        readonly = true;
+        int rc = map_ro(path("snapshot.vtj"), snap, O_RDONLY);
+        if (rc == 0) {
+            if (std::memcmp(snap.hdr()->magic, SNAP_MAGIC, 8) != 0) return -EBADMSG;
+            snapshot_lsn = snap.base_lsn;
+        } else if (rc != -ENOENT) {
+            return rc;
+        }
+        next_lsn = snapshot_lsn + 1;
+
+        DIR* d = ::opendir(dir.c_str());
+        if (!d) return -errno;
+        while (dirent* e = ::readdir(d)) {
+            unsigned n = 0;
+            char tail = 0;
+            if (std::sscanf(e->d_name, "seg-%8x.vt%c", &n, &tail) != 2 || tail != 'j' ||
+                std::strlen(e->d_name) != 16 || n == 0)
+                continue;
+            Mapped m;
+            if (map_ro(seg_path(n), m, O_RDONLY) < 0) continue;   // supprimé entre-temps
+            if (std::memcmp(m.hdr()->magic, SEG_MAGIC, 8) != 0 || m.base_lsn <= snapshot_lsn) {
+                m.unmap();   // en création, ou couvert par le snapshot
+                continue;
+            }
+            segs[n] = m;
+        }
+        ::closedir(d);
+
+        uint64_t n = snap.base ? snap.hdr()->count : 0;
+        size_t want = cfg.index_slots;
+        while (want < 2 * n + 16) want <<= 1;
+        if ((rc = idx_map(want, true)) < 0) return rc;
+        if (snap.base) {
+            uint64_t off = sizeof(FileHdr);
+            for (uint64_t i = 0; i < n; ++i) {
+                size_t sz = check_rec(snap, off, 0);
+                if (!sz) return -EBADMSG;
+                if ((rc = idx_apply(reinterpret_cast<const RecHdr*>(snap.base + off), FILE_SNAP, off)) < 0)
+                    return rc;
+                off += sz;
+            }
+        }
+        for (auto it = segs.begin(); it != segs.end(); ++it) {
+            if (it->second.base_lsn != next_lsn) {
+                if (it == segs.begin() && !last_try) return -EAGAIN;
+                break;
+            }
+            if ((rc = replay(it->first, it->second, sizeof(FileHdr))) < 0) return rc;
+            st.log_bytes += it->second.used - sizeof(FileHdr);
+        }
+        st.segments = segs.size();
+        st.index_slots = ih->slots;
+        return 0;
+    }
+
+    int rebuild() {
+        uint64_t n = snap.base ? snap.hdr()->count : 0;
+        size_t want = cfg.index_slots;
+        while (want < 2 * n + 16) want <<= 1;
+        if (int rc = idx_map(want, true); rc < 0) return rc;
+
+        // Snapshot : lecture séquentielle, O(taille du snapshot).
+        if (snap.base) {
+            uint64_t off = sizeof(FileHdr);
+            for (uint64_t i = 0; i < n; ++i) {
+                size_t sz = check_rec(snap, off, 0);
+                if (!sz) return -EBADMSG;   // écrit + fsync avant rename : corruption réelle
+                const auto* r = reinterpret_cast<const RecHdr*>(snap.base + off);
+                if (r->lsn > snapshot_lsn) return -EBADMSG;
+                if (int rc = idx_apply(r, FILE_SNAP, off); rc < 0) return rc;
+                off += sz;
+            }
+        }
+
+        // Queue du journal : LSN consécutifs d’un segment à l’autre.
+        for (auto it = segs.begin(); it != segs.end(); ++it) {
+            Mapped& m = it->second;
+            if (m.base_lsn != next_lsn) {
+                // Trou de séquence : les segments suivants ne sont pas rejouables.
+                quarantine(it);
+                break;
+            }
+            int rc = replay(it->first, m, sizeof(FileHdr));
+            if (rc < 0) return rc;
+            st.log_bytes += m.used - sizeof(FileHdr);
+            if (rc == 0) {
+                zero_tail(m);
+                quarantine(std::next(it));
+                break;
+            }
+        }
+        return 0;
+    }
+
+    void quarantine(std::map<uint32_t, Mapped>::iterator from) {
+        for (auto it = from; it != segs.end();) {
+            it->second.unmap();
+            const std::string p = seg_path(it->first);
+            ::rename(p.c_str(), (p + ".corrupt").c_str());
+            it = segs.erase(it);
+            st.torn = 1;
+        }
+    }
+
+    /* ——— Écriture ——— */
+
+    int append(uint8_t type, const char* key, size_t klen, const void* val, size_t vlen) {
+        if (readonly) return -EROFS;
+        if (klen == 0 || klen > UINT16_MAX || vlen > UINT32_MAX - sizeof(RecHdr) - klen) return -EINVAL;
+        const size_t len = sizeof(RecHdr) + klen + vlen;
+        const size_t sz = align8(len);
+        buf.assign(sz, 0);
+        auto* r = reinterpret_cast<RecHdr*>(buf.data());
+        r->len = static_cast<uint32_t>(len);
+        r->lsn = next_lsn;
+        r->type = type;
+        r->klen = static_cast<uint16_t>(klen);
+        r->vlen = static_cast<uint32_t>(vlen);
+        std::memcpy(buf.data() + sizeof(RecHdr), key, klen);
+        if (vlen) std::memcpy(buf.data() + sizeof(RecHdr) + klen, val, vlen);
+        r->crc = rec_crc(r);
+
+        Mapped* m = &segs[cur];
+        if (m->used + sz > m->size) {
+            if (int rc = new_segment(cur + 1, next_lsn, sz); rc < 0) return rc;
+            m = &segs[cur];
+        }
+        if (int rc = write_all(m->fd, buf.data(), sz, m->used); rc < 0) return rc;
+        if (cfg.sync_mode == VT_JJ_SYNC_ALWAYS && ::fdatasync(m->fd) < 0) return -errno;
+
+        const uint64_t off = m->used;
+        m->used += sz;
+        ++next_lsn;
+        ++st.appends;
+        st.log_bytes += sz;
+        if (int rc = idx_apply(rec(cur, off), cur, off); rc < 0) return rc;
+
+        if (st.log_bytes >= cfg.snapshot_bytes) (void)snapshot();
+        return 0;
+    }
+
+    /* ——— Snapshot ——— */
+
+    int snapshot() {
+        if (readonly) return -EROFS;
+        if (st.log_bytes == 0) return 0;
+        // Nouveau segment : tout ce qui précède est couvert par le snapshot.
+        if (int rc = new_segment(cur + 1, next_lsn, 0); rc < 0) return rc;
+        const uint64_t upto = next_lsn - 1;
+
+        const std::string tmp = path("snapshot.vtj.tmp");
+        int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return -errno;
+
+        std::vector<std::pair<size_t, uint64_t>> moved;   // emplacement d’index → nouvel offset
+        moved.reserve(ih->live);
+        std::vector<uint8_t> out;
+        out.reserve(1u << 20);
+        FileHdr h{};
+        std::memcpy(h.magic, SNAP_MAGIC, 8);
+        h.base_lsn = upto;
+        h.count = ih->live;
+        out.insert(out.end(), reinterpret_cast<uint8_t*>(&h), reinterpret_cast<uint8_t*>(&h + 1));
+
+        int rc = 0;
+        uint64_t off = 0;
+        for (size_t i = 0; i < ih->slots && rc == 0; ++i) {
+            if (slots[i].hash < 2) continue;
+            const RecHdr* r = rec(slots[i].file, slots[i].off);
+            const auto* p = reinterpret_cast<const uint8_t*>(r);
+            moved.emplace_back(i, off + out.size());
+            out.insert(out.end(), p, p + align8(r->len));
+            if (out.size() >= (1u << 20)) {
+                rc = write_all(fd, out.data(), out.size(), off);
+                off += out.size();
+                out.clear();
+            }
+        }
+        if (rc == 0 && !out.empty()) rc = write_all(fd, out.data(), out.size(), off);
+        if (rc == 0 && ::fdatasync(fd) < 0) rc = -errno;
+        ::close(fd);
+        if (rc == 0 && ::rename(tmp.c_str(), path("snapshot.vtj").c_str()) < 0) rc = -errno;
+        if (rc == 0) rc = fsync_dir(dir);
+        if (rc < 0) {
+            ::unlink(tmp.c_str());
+            return rc;
+        }
+
+        // À partir d’ici l’index est incohérent avec le disque jusqu’à la remise à jour
+        // (clean = 0 : un crash provoque une reconstruction à la réouverture).
+        Mapped fresh;
+        if ((rc = map_ro(path("snapshot.vtj"), fresh)) < 0) return rc;
+        snap.unmap();
+        snap = fresh;
+        for (auto& [i, o] : moved) {
+            slots[i].file = FILE_SNAP;
+            slots[i].off = o;
+        }
+        snapshot_lsn = upto;
+        ih->snapshot_lsn = upto;
+
+        for (auto it = segs.begin(); it != segs.end() && it->first != cur;) {
+            it->second.unmap();
+            ::unlink(seg_path(it->first).c_str());
+            it = segs.erase(it);
+        }
+        st.segments = segs.size();
+        st.log_bytes = 0;
+        ++st.snapshots;
+        return 0;
+    }
+
+    void close_all() {
+        if (ih && opened) {
+            bool synced = true;
+            if (segs.count(cur)) synced = ::fdatasync(segs[cur].fd) == 0;
+            if (synced) {
+                ih->next_lsn = next_lsn;
+                ih->tail_seg = cur;
+                ih->tail_off = segs.count(cur) ? segs[cur].used : 0;
+                ih->snapshot_lsn = snapshot_lsn;
+                ::msync(ih, idx_size, MS_SYNC);
+                ih->clean = 1;
+                ::msync(ih, sizeof(IdxHdr), MS_SYNC);
+            }
+        }
+        if (ih) {
+            ::munmap(ih, idx_size);
+            ih = nullptr;
+        }
+        if (idx_fd >= 0) ::close(idx_fd);
+        for (auto& [n, m] : segs) m.unmap();
+        segs.clear();
+        snap.unmap();
+        if (lock_fd >= 0) ::close(lock_fd);   // libère le flock
+    }
+};
+
+extern "C" {
+
+VT_API void vt_jj_config_default(vt_jj_config* cfg) {
+    if (!cfg) return;
+    cfg->segment_bytes = 64ull << 20;
+    cfg->snapshot_bytes = 256ull << 20;
+    cfg->sync_mode = VT_JJ_SYNC_ALWAYS;
+    cfg->index_slots = 65536;
+}
+
+VT_API vt_jj* vt_jj_open(const char* dir, const vt_jj_config* cfg, int* err) {
+    if (!dir || !*dir) {
+        if (err) *err = -EINVAL;
+        return nullptr;
+    }
+    auto* j = new vt_jj();
+    j->dir = dir;
+    while (j->dir.size() > 1 && j->dir.back() == '/') j->dir.pop_back();
+    vt_jj_config_default(&j->cfg);
+    if (cfg) {
+        if (cfg->segment_bytes) j->cfg.segment_bytes = cfg->segment_bytes;
+        if (cfg->snapshot_bytes) j->cfg.snapshot_bytes = cfg->snapshot_bytes;
+        j->cfg.sync_mode = cfg->sync_mode;
+        if (cfg->index_slots) j->cfg.index_slots = cfg->index_slots;
+    }
+    size_t p2 = 16;
+    while (p2 < j->cfg.index_slots) p2 <<= 1;
+    j->cfg.index_slots = static_cast<uint32_t>(p2);
+
+    int rc = j->open_all();
+    if (rc < 0) {
+        j->close_all();
+        delete j;
+        if (err) *err = rc;
+        return nullptr;
+    }
+    j->opened = true;
+    if (err) *err = 0;
+    return j;
+}
+
+VT_API vt_jj* vt_jj_open_readonly(const char* dir, int* err) {
+    if (!dir || !*dir) {
+        if (err) *err = -EINVAL;
+        return nullptr;
+    }
+    int rc = -EAGAIN;
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        auto* j = new vt_jj();
+        j->dir = dir;
+        while (j->dir.size() > 1 && j->dir.back() == '/') j->dir.pop_back();
+        vt_jj_config_default(&j->cfg);
+        j->cfg.index_slots = 1024;
+        rc = j->open_view(attempt == 7);
+        if (rc == 0) {
+            if (err) *err = 0;
+            return j;
+        }
+        j->close_all();
+        delete j;
+        if (rc != -EAGAIN) break;
+    }
+    if (err) *err = rc;
+    return nullptr;
+}
+
+VT_API void vt_jj_close(vt_jj* j) {
+    if (!j) return;
+    {
+        std::lock_guard<std::mutex> lk(j->mu);
+        j->close_all();
+    }
+    delete j;
+}
+
+VT_API int vt_jj_put(vt_jj* j, const char* key, size_t klen, const void* val, size_t vlen) {
+    if (!j || !key || (!val && vlen)) return -EINVAL;
+    std::lock_guard<std::mutex> lk(j->mu);
+    return j->append(REC_PUT, key, klen, val, vlen);
+}
+
+VT_API int vt_jj_del(vt_jj* j, const char* key, size_t klen) {
+    if (!j || !key) return -EINVAL;
+    std::lock_guard<std::mutex> lk(j->mu);
+    bool found;
+    j->find(hash_key(key, klen), key, klen, found);
+    if (!found) return -ENOENT;
+    return j->append(REC_DEL, key, klen, nullptr, 0);
+}
+
+VT_API int vt_jj_get(vt_jj* j, const char* key, size_t klen, const void** val, size_t* vlen) {
+    if (!j || !key) return -EINVAL;
+    std::lock_guard<std::mutex> lk(j->mu);
+    bool found;
+    size_t i = j->find(hash_key(key, klen), key, klen, found);
+    if (!found) return -ENOENT;
+    const RecHdr* r = j->rec(j->slots[i].file, j->slots[i].off);
+    if (val) *val = vt_jj::rval(r);
+    if (vlen) *vlen = r->vlen;
+    return 0;
+}
+
+VT_API int vt_jj_iter_next(vt_jj* j, uint64_t* cursor, const char** key, size_t* klen,
+                           const void** val, size_t* vlen) {
+    if (!j || !cursor) return 0;
+    std::lock_guard<std::mutex> lk(j->mu);
+    for (uint64_t i = *cursor; i < j->ih->slots; ++i) {
+        const Slot& s = j->slots[i];
+        if (s.hash < 2) continue;
+        const RecHdr* r = j->rec(s.file, s.off);
+        if (key) *key = vt_jj::rkey(r);
+        if (klen) *klen = r->klen;
+        if (val) *val = vt_jj::rval(r);
+        if (vlen) *vlen = r->vlen;
+        *cursor = i + 1;
+        return 1;
+    }
+    *cursor = j->ih->slots;
+    return 0;
+}
+
+VT_API int vt_jj_sync(vt_jj* j) {
+    if (!j) return -EINVAL;
+    if (j->readonly) return -EROFS;
+    std::lock_guard<std::mutex> lk(j->mu);
+    return ::fdatasync(j->segs[j->cur].fd) < 0 ? -errno : 0;
+}
+
+VT_API int vt_jj_snapshot(vt_jj* j) {
+    if (!j) return -EINVAL;
+    std::lock_guard<std::mutex> lk(j->mu);
+    return j->snapshot();
+}
+
+VT_API uint64_t vt_jj_count(const vt_jj* j) {
+    return j && j->ih ? j->ih->live : 0;
+}
+
+VT_API void vt_jj_get_stats(const vt_jj* j, vt_jj_stats* out) {
+    if (!j || !out) return;
+    *out = j->st;
+    out->live = j->ih ? j->ih->live : 0;
+}
+
+} // extern "C"
@@ -0,0 +1,105 @@
+// native/job_journal.h
+// Journal segmenté "write-ahead" pour la file de jobs (worker-jobs) : enregistrements
+// clé → valeur en ajout seul, snapshot périodique, index mmap des clés.
+//
+// API C exposée (ABI stable pour FFI):
+//   void     vt_jj_config_default(vt_jj_config* cfg);
+//   vt_jj*   vt_jj_open(const char* dir, const vt_jj_config* cfg, int* err);
+//   vt_jj*   vt_jj_open_readonly(const char* dir, int* err);
+//   void     vt_jj_close(vt_jj* j);
+//   int      vt_jj_put(vt_jj* j, const char* key, size_t klen, const void* val, size_t vlen);
+//   int      vt_jj_del(vt_jj* j, const char* key, size_t klen);
+//   int      vt_jj_get(vt_jj* j, const char* key, size_t klen, const void** val, size_t* vlen);
+//   int      vt_jj_iter_next(vt_jj* j, uint64_t* cursor, const char** key, size_t* klen,
+//                            const void** val, size_t* vlen);
+//   int      vt_jj_sync(vt_jj* j);
+//   int      vt_jj_snapshot(vt_jj* j);
+//   uint64_t vt_jj_count(const vt_jj* j);
+//   void     vt_jj_get_stats(const vt_jj* j, vt_jj_stats* out);
+//
+// Disposition du dossier :
+//   snapshot.vtj          — enregistrements vivants au moment du dernier snapshot
+//   seg-<n>.vtj           — segments de journal (préalloués, ajout seul), n croissant
+//   index.vtj             — table de hachage (clé → fichier + offset), mappée en mémoire
+//
+// Enregistrement (LE, aligné 8) : crc32c | longueur | lsn | type | klen | vlen | clé | valeur.
+// Le CRC couvre tout sauf lui-même ; la relecture s’arrête au premier enregistrement
+// invalide ou au LSN non consécutif (queue déchirée), et la fin du segment est remise à zéro.
+//
+// Démarrage :
+// - fermeture propre : l’index est réutilisé tel quel, seule la queue postérieure est rejouée ;
+// - sinon : index reconstruit depuis le snapshot (lecture séquentielle) + segments restants.
+//
+// Remarques :
+// - Les pointeurs rendus par vt_jj_get / vt_jj_iter_next pointent dans les fichiers mappés :
+//   valides jusqu’à la prochaine écriture (put/del/snapshot) ou la fermeture.
+// - Un verrou interne sérialise les appels ; un seul processus écrivain par dossier (flock).
+// - Lecteurs (vt_jj_open_readonly) : sans flock, donc possibles pendant qu’un écrivain tient le
+//   journal. Vue figée à l’ouverture (snapshot + segments relus dans un index en mémoire) ;
+//   l’index mmap n’est ni lu ni écrit. Les écritures y retournent -EROFS.
+
+#ifndef VITTE_NATIVE_JOB_JOURNAL_H
+#define VITTE_NATIVE_JOB_JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum {
+    VT_JJ_SYNC_NONE   = 0,   // page cache uniquement (durable à la fermeture / vt_jj_sync)
+    VT_JJ_SYNC_ALWAYS = 1,   // fdatasync après chaque put/del
+};
+
+typedef struct vt_jj_config {
+    uint64_t segment_bytes;    // taille d’un segment (0 = 64 MiB)
+    uint64_t snapshot_bytes;   // journal accumulé avant snapshot auto (0 = 256 MiB, ~0 = jamais)
+    uint32_t sync_mode;        // VT_JJ_SYNC_*
+    uint32_t index_slots;      // capacité initiale de l’index (0 = 65536, arrondi à 2^k)
+} vt_jj_config;
+
+typedef struct vt_jj_stats {
+    uint64_t live;             // clés vivantes
+    uint64_t appends;          // put + del depuis l’ouverture
+    uint64_t replayed;         // enregistrements rejoués à l’ouverture
+    uint64_t torn;             // 1 si une queue déchirée a été tronquée à l’ouverture
+    uint64_t segments;         // segments présents
+    uint64_t log_bytes;        // octets de journal depuis le dernier snapshot
+    uint64_t snapshots;        // snapshots écrits depuis l’ouverture
+    uint64_t index_slots;
+    uint8_t  clean_start;      // 1 si l’index a été réutilisé sans reconstruction
+} vt_jj_stats;
+
+typedef struct vt_jj vt_jj;
+
+VT_API void     vt_jj_config_default(vt_jj_config* cfg);
+// Crée le dossier si besoin. En cas d’échec retourne NULL et *err = -errno.
+VT_API vt_jj*   vt_jj_open(const char* dir, const vt_jj_config* cfg, int* err);
+// Vue en lecture seule, sans verrou ni écriture. NULL et *err = -errno en cas d’échec
+// (-ENOENT : pas de journal ; -EAGAIN : compactions concurrentes répétées).
+VT_API vt_jj*   vt_jj_open_readonly(const char* dir, int* err);
+VT_API void     vt_jj_close(vt_jj* j);
+
+// Insère ou remplace. Retourne 0 ou -errno.
+VT_API int      vt_jj_put(vt_jj* j, const char* key, size_t klen, const void* val, size_t vlen);
+// Supprime (tombstone). Retourne 0, -ENOENT ou -errno.
+VT_API int      vt_jj_del(vt_jj* j, const char* key, size_t klen);
+VT_API int      vt_jj_get(vt_jj* j, const char* key, size_t klen, const void** val, size_t* vlen);
+
+// Parcours des clés vivantes (ordre non spécifié). `*cursor` = 0 au départ.
+// Retourne 1 tant qu’il reste une entrée, 0 à la fin.
+VT_API int      vt_jj_iter_next(vt_jj* j, uint64_t* cursor, const char** key, size_t* klen,
+                                const void** val, size_t* vlen);
+
+VT_API int      vt_jj_sync(vt_jj* j);
+// Compacte : écrit les enregistrements vivants dans un nouveau snapshot et supprime
+// les segments couverts. Retourne 0 ou -errno.
+VT_API int      vt_jj_snapshot(vt_jj* j);
+VT_API uint64_t vt_jj_count(const vt_jj* j);
+VT_API void     vt_jj_get_stats(const vt_jj* j, vt_jj_stats* out);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_JOB_JOURNAL_H
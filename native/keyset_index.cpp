@@ -0,0 +1,225 @@
+// native/keyset_index.cpp
+// Index ordonné pour la pagination keyset (cf. keyset_index.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/keyset_index.cpp -o build/keyset_index.o
+//
+// Remarques :
+// - Chaque entrée porte les 8 premiers octets de sa clé en gros-boutiste (`prefix`) : la
+//   plupart des comparaisons se règlent sur un entier, sans toucher au stockage des clés.
+// - Le niveau haut (`fences`) ne garde que le préfixe de la première entrée de chaque bloc
+//   de 64 : ~n/8 octets, qui restent en cache. Comme l’ordre des préfixes est compatible
+//   avec l’ordre complet, la recherche y borne la plage à au plus quelques blocs, puis
+//   une recherche binaire complète se fait dans cette plage.
+// - vt_ki_erase laisse les octets de la clé dans `keys` (octets morts, comptés) : dès
+//   qu’ils dépassent la moitié du tampon, les clés vivantes sont recopiées dans l’ordre
+//   des entrées. Le tampon reste donc sous 2× les clés vivantes, quel que soit le nombre
+//   d’insertions/suppressions.
+
+#include "keyset_index.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace vt_keyset {
+
+constexpr size_t BLOCK = 64;
+
+struct Entry {
+    uint64_t prefix;
+    uint64_t id;
+    uint32_t koff;
+    uint32_t klen;
+    uint32_t row;
+    uint32_t pad;
+};
+
+static inline uint64_t make_prefix(const char* k, size_t n) {
+    uint64_t p = 0;
+    const size_t m = n < 8 ? n : 8;
+    for (size_t i = 0; i < m; ++i) p |= uint64_t(static_cast<uint8_t>(k[i])) << (56 - 8 * i);
+    return p;
+}
+
+struct Query {
+    const char* key;
+    size_t klen;
+    uint64_t prefix;
+    uint64_t id;
+};
+
+} // namespace vt_keyset
+
+struct vt_ki {
+    std::vector<vt_keyset::Entry> entries;
+    std::vector<uint64_t> fences;
+    std::string keys;           // clés concaténées (entries[i].koff / klen)
+    size_t dead = 0;            // octets de `keys` sans entrée (clés supprimées)
+    bool sorted = true;
+    bool fences_dirty = false;
+};
+
+namespace vt_keyset {
+
+// <0 si e < q, 0 si égal, >0 si e > q.
+static inline int cmp(const vt_ki* ix, const Entry& e, const Query& q) {
+    if (e.prefix != q.prefix) return e.prefix < q.prefix ? -1 : 1;
+    if (e.klen > 8 || q.klen > 8) {
+        const size_t m = e.klen < q.klen ? e.klen : q.klen;
+        if (m > 8) {
+            const int c = std::memcmp(ix->keys.data() + e.koff + 8, q.key + 8, m - 8);
+            if (c) return c;
+        }
+    }
+    if (e.klen != q.klen) return e.klen < q.klen ? -1 : 1;
+    if (e.id != q.id) return e.id < q.id ? -1 : 1;
+    return 0;
+}
+
+static inline bool less_entry(const vt_ki* ix, const Entry& a, const Entry& b) {
+    const Query q{ix->keys.data() + b.koff, b.klen, b.prefix, b.id};
+    return cmp(ix, a, q) < 0;
+}
+
+// Clés vivantes recopiées dans l’ordre des entrées (parcours séquentiel ensuite).
+static void compact_keys(vt_ki* ix) {
+    std::string keys;
+    keys.reserve(ix->keys.size() - ix->dead);
+    for (Entry& e : ix->entries) {
+        const uint32_t off = static_cast<uint32_t>(keys.size());
+        keys.append(ix->keys, e.koff, e.klen);
+        e.koff = off;
+    }
+    ix->keys.swap(keys);
+    ix->dead = 0;
+}
+
+static void sort_entries(vt_ki* ix) {
+    std::sort(ix->entries.begin(), ix->entries.end(),
+              [ix](const Entry& a, const Entry& b) { return less_entry(ix, a, b); });
+    compact_keys(ix);
+    ix->sorted = true;
+    ix->fences_dirty = true;
+}
+
+static void ensure_ready(vt_ki* ix) {
+    if (!ix->sorted) sort_entries(ix);
+    if (ix->fences_dirty) {
+        ix->fences.clear();
+        for (size_t i = 0; i < ix->entries.size(); i += BLOCK) ix->fences.push_back(ix->entries[i].prefix);
+        ix->fences_dirty = false;
+    }
+}
+
+// Première position p telle que cmp(entries[p], q) >= strict (0 : ≥, 1 : >).
+static size_t bound(vt_ki* ix, const Query& q, int strict) {
+    ensure_ready(ix);
+    const size_t n = ix->entries.size();
+    if (!n) return 0;
+    const auto& f = ix->fences;
+    // blocs dont le préfixe de tête encadre q.prefix
+    const size_t b_lo = static_cast<size_t>(std::lower_bound(f.begin(), f.end(), q.prefix) - f.begin());
+    const size_t b_hi = static_cast<size_t>(std::upper_bound(f.begin(), f.end(), q.prefix) - f.begin());
+    const size_t lo = b_lo ? (b_lo - 1) * BLOCK : 0;
+    const size_t hi = std::min(n, b_hi * BLOCK);
+    const Entry* base = ix->entries.data();
+    const Entry* it = std::partition_point(base + lo, base + hi,
+                                           [&](const Entry& e) { return cmp(ix, e, q) < strict; });
+    return static_cast<size_t>(it - base);
+}
+
+static int make_entry(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row, Entry* out) {
+    if (klen > UINT32_MAX) return -E2BIG;
+    if (ix->keys.size() + klen > UINT32_MAX && ix->dead) compact_keys(ix);
+    if (ix->keys.size() + klen > UINT32_MAX) return -E2BIG;
+    out->prefix = make_prefix(key, klen);
+    out->id = id;
+    out->koff = static_cast<uint32_t>(ix->keys.size());
+    out->klen = static_cast<uint32_t>(klen);
+    out->row = row;
+    out->pad = 0;
+    ix->keys.append(key, klen);
+    return 0;
+}
+
+} // namespace vt_keyset
+
+VT_EXTERN_C_BEGIN
+
+VT_API vt_ki* vt_ki_new(void) { return new (std::nothrow) vt_ki; }
+
+VT_API void vt_ki_free(vt_ki* ix) { delete ix; }
+
+VT_API int vt_ki_push(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row) {
+    vt_keyset::Entry e;
+    if (int rc = vt_keyset::make_entry(ix, key, klen, id, row, &e)) return rc;
+    ix->entries.push_back(e);
+    ix->sorted = false;
+    return 0;
+}
+
+VT_API int vt_ki_build(vt_ki* ix) {
+    vt_keyset::sort_entries(ix);
+    vt_keyset::ensure_ready(ix);
+    return 0;
+}
+
+VT_API int vt_ki_insert(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row) {
+    const vt_keyset::Query q{key, klen, vt_keyset::make_prefix(key, klen), id};
+    const size_t pos = vt_keyset::bound(ix, q, 1);
+    vt_keyset::Entry e;
+    if (int rc = vt_keyset::make_entry(ix, key, klen, id, row, &e)) return rc;
+    ix->entries.insert(ix->entries.begin() + static_cast<ptrdiff_t>(pos), e);
+    ix->fences_dirty = true;
+    return 0;
+}
+
+VT_API int vt_ki_erase(vt_ki* ix, const char* key, size_t klen, uint64_t id) {
+    const vt_keyset::Query q{key, klen, vt_keyset::make_prefix(key, klen), id};
+    const size_t pos = vt_keyset::bound(ix, q, 0);
+    if (pos == ix->entries.size() || vt_keyset::cmp(ix, ix->entries[pos], q) != 0) return -ENOENT;
+    ix->dead += ix->entries[pos].klen;
+    ix->entries.erase(ix->entries.begin() + static_cast<ptrdiff_t>(pos));
+    ix->fences_dirty = true;
+    if (ix->dead > ix->keys.size() / 2) vt_keyset::compact_keys(ix);
+    return 0;
+}
+
+VT_API uint64_t vt_ki_len(const vt_ki* ix) { return ix->entries.size(); }
+
+VT_API uint64_t vt_ki_lower_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id) {
+    return vt_keyset::bound(ix, {key, klen, vt_keyset::make_prefix(key, klen), id}, 0);
+}
+
+VT_API uint64_t vt_ki_upper_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id) {
+    return vt_keyset::bound(ix, {key, klen, vt_keyset::make_prefix(key, klen), id}, 1);
+}
+
+VT_API uint32_t vt_ki_row(vt_ki* ix, uint64_t pos) {
+    vt_keyset::ensure_ready(ix);
+    return pos < ix->entries.size() ? ix->entries[pos].row : UINT32_MAX;
+}
+
+VT_API uint64_t vt_ki_id(vt_ki* ix, uint64_t pos) {
+    vt_keyset::ensure_ready(ix);
+    return pos < ix->entries.size() ? ix->entries[pos].id : 0;
+}
+
+VT_API uint64_t vt_ki_rows(vt_ki* ix, uint64_t from, uint64_t count, int desc, uint32_t* out) {
+    vt_keyset::ensure_ready(ix);
+    const uint64_t n = ix->entries.size();
+    const vt_keyset::Entry* e = ix->entries.data();
+    uint64_t k = 0;
+    if (desc) {
+        for (uint64_t p = std::min(from, n); p > 0 && k < count; --p) out[k++] = e[p - 1].row;
+    } else {
+        for (uint64_t p = from; p < n && k < count; ++p) out[k++] = e[p].row;
+    }
+    return k;
+}
+
+VT_EXTERN_C_END
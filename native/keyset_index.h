@@ -0,0 +1,69 @@
+// native/keyset_index.h
+// Index ordonné (clé, id) → ligne pour la pagination keyset de `modules/pagination.vitte` :
+// tableau trié + niveau de « barrières » compact (un préfixe 8 octets par bloc de 64
+// entrées), soit un B+-arbre statique à deux niveaux.
+//
+// API C exposée (ABI stable pour FFI):
+//   vt_ki*   vt_ki_new(void);
+//   void     vt_ki_free(vt_ki* ix);
+//   int      vt_ki_push(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row);
+//   int      vt_ki_build(vt_ki* ix);
+//   int      vt_ki_insert(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row);
+//   int      vt_ki_erase(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+//   uint64_t vt_ki_len(const vt_ki* ix);
+//   uint64_t vt_ki_lower_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+//   uint64_t vt_ki_upper_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+//   uint32_t vt_ki_row(vt_ki* ix, uint64_t pos);
+//   uint64_t vt_ki_id(vt_ki* ix, uint64_t pos);
+//   uint64_t vt_ki_rows(vt_ki* ix, uint64_t from, uint64_t count, int desc, uint32_t* out);
+//
+// Ordre : clé (octets, memcmp puis longueur), puis id. Une page keyset est donc
+//   asc  : [upper_bound(après), lower_bound(avant))  parcouru vers le haut ;
+//   desc : [upper_bound(avant), lower_bound(après))  parcouru vers le bas ;
+// une recherche O(log n) suivie d’un parcours contigu.
+//
+// Remarques :
+// - Chargement en masse : vt_ki_push() puis vt_ki_build() (tri unique). Toute requête sur
+//   un index non trié le trie d’abord.
+// - vt_ki_insert / vt_ki_erase déplacent la queue du tableau (O(n) mémoire, sans
+//   allocation par entrée) ; les barrières sont reconstruites à la requête suivante.
+// - Pas de verrou : un index par thread, ou synchronisation côté appelant.
+
+#ifndef VITTE_NATIVE_KEYSET_INDEX_H
+#define VITTE_NATIVE_KEYSET_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef struct vt_ki vt_ki;
+
+VT_API vt_ki*   vt_ki_new(void);
+VT_API void     vt_ki_free(vt_ki* ix);
+
+// Ajout non trié (chargement en masse). 0 ou -E2BIG (clé > 4 Gio).
+VT_API int      vt_ki_push(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row);
+// Trie les entrées poussées et compacte le stockage des clés. 0.
+VT_API int      vt_ki_build(vt_ki* ix);
+// Insertion à sa place. 0 ou -E2BIG.
+VT_API int      vt_ki_insert(vt_ki* ix, const char* key, size_t klen, uint64_t id, uint32_t row);
+// Retire l’entrée (clé, id). 0 ou -ENOENT.
+VT_API int      vt_ki_erase(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+
+VT_API uint64_t vt_ki_len(const vt_ki* ix);
+// Première position ≥ (clé, id) / > (clé, id).
+VT_API uint64_t vt_ki_lower_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+VT_API uint64_t vt_ki_upper_bound(vt_ki* ix, const char* key, size_t klen, uint64_t id);
+// Ligne / id en position `pos` (UINT32_MAX / 0 hors bornes).
+VT_API uint32_t vt_ki_row(vt_ki* ix, uint64_t pos);
+VT_API uint64_t vt_ki_id(vt_ki* ix, uint64_t pos);
+// Copie jusqu’à `count` lignes dans `out` : asc = pos from, from+1, … ; desc = from-1,
+// from-2, … (from est alors une borne exclusive). Retourne le nombre copié.
+VT_API uint64_t vt_ki_rows(vt_ki* ix, uint64_t from, uint64_t count, int desc, uint32_t* out);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_KEYSET_INDEX_H
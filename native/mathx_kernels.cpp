@@ -0,0 +1,517 @@
+// native/mathx_kernels.cpp
+// Noyaux numériques vectorisés (cf. mathx_kernels.h pour l’API C et les conventions).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -mavx2 -mfma -fPIC -c native/mathx_kernels.cpp -o build/mathx_kernels.o
+//   g++ -std=c++20 -O2 -mavx512f -fPIC -c native/mathx_kernels.cpp -o build/mathx_kernels.o
+//
+// Remarques :
+// - Largeur choisie à la compilation (AVX-512 : 8 lanes, AVX : 4, SSE2 : 2, sinon scalaire)
+//   derrière un petit type `Vd` ; les noyaux sont écrits une seule fois.
+// - Somme : blocs de 256 valeurs accumulés sur 4 registres, blocs combinés par paires.
+// - Moments : blocs de 1024 valeurs (8 Kio, restent en L1) en deux passes — moyenne puis
+//   Σ(x - m)² — fusionnés par la formule de Chan ; pas de division par élément.
+// - Sélection : Floyd-Rivest (échantillonnage récursif au-delà de 600 éléments) avec garde
+//   introspective : au-delà d’un budget d’itérations, std::nth_element termine.
+
+#include "mathx_kernels.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__)
+// GCC 12 : les intrinsèques AVX-512 non masquées (min/max, rol, slli…) passent par
+// leur forme masquée avec _mm512_undefined_*() en valeur de repli, signalée
+// -W(maybe-)uninitialized une fois inlinées (-O2/-O3). Faux positif propre à l’en-tête,
+// ignoré pour lui seul.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+namespace vt_mx {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// --- Vecteur de doubles ---------------------------------------------------------------
+// min(a, b) / max(a, b) rendent b si l’un des deux est NaN (sémantique minpd/maxpd) :
+// avec b = accumulateur, les NaN de l’entrée sont ignorés.
+
+#if defined(__AVX512F__)
+struct Vd {
+    __m512d v;
+    static constexpr size_t W = 8;
+    static Vd zero() { return {_mm512_setzero_pd()}; }
+    static Vd set1(double x) { return {_mm512_set1_pd(x)}; }
+    static Vd load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+    friend Vd operator+(Vd a, Vd b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend Vd operator-(Vd a, Vd b) { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend Vd operator*(Vd a, Vd b) { return {_mm512_mul_pd(a.v, b.v)}; }
+    static Vd min(Vd a, Vd b) { return {_mm512_min_pd(a.v, b.v)}; }
+    static Vd max(Vd a, Vd b) { return {_mm512_max_pd(a.v, b.v)}; }
+};
+#elif defined(__AVX__)
+struct Vd {
+    __m256d v;
+    static constexpr size_t W = 4;
+    static Vd zero() { return {_mm256_setzero_pd()}; }
+    static Vd set1(double x) { return {_mm256_set1_pd(x)}; }
+    static Vd load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    friend Vd operator+(Vd a, Vd b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend Vd operator-(Vd a, Vd b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend Vd operator*(Vd a, Vd b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    static Vd min(Vd a, Vd b) { return {_mm256_min_pd(a.v, b.v)}; }
+    static Vd max(Vd a, Vd b) { return {_mm256_max_pd(a.v, b.v)}; }
+};
+#elif defined(__SSE2__)
+struct Vd {
+    __m128d v;
+    static constexpr size_t W = 2;
+    static Vd zero() { return {_mm_setzero_pd()}; }
+    static Vd set1(double x) { return {_mm_set1_pd(x)}; }
+    static Vd load(const double* p) { return {_mm_loadu_pd(p)}; }
+    void store(double* p) const { _mm_storeu_pd(p, v); }
+    friend Vd operator+(Vd a, Vd b) { return {_mm_add_pd(a.v, b.v)}; }
+    friend Vd operator-(Vd a, Vd b) { return {_mm_sub_pd(a.v, b.v)}; }
+    friend Vd operator*(Vd a, Vd b) { return {_mm_mul_pd(a.v, b.v)}; }
+    static Vd min(Vd a, Vd b) { return {_mm_min_pd(a.v, b.v)}; }
+    static Vd max(Vd a, Vd b) { return {_mm_max_pd(a.v, b.v)}; }
+};
+#else
+struct Vd {
+    double v;
+    static constexpr size_t W = 1;
+    static Vd zero() { return {0.0}; }
+    static Vd set1(double x) { return {x}; }
+    static Vd load(const double* p) { return {*p}; }
+    void store(double* p) const { *p = v; }
+    friend Vd operator+(Vd a, Vd b) { return {a.v + b.v}; }
+    friend Vd operator-(Vd a, Vd b) { return {a.v - b.v}; }
+    friend Vd operator*(Vd a, Vd b) { return {a.v * b.v}; }
+    static Vd min(Vd a, Vd b) { return {a.v < b.v ? a.v : b.v}; }
+    static Vd max(Vd a, Vd b) { return {a.v > b.v ? a.v : b.v}; }
+};
+#endif
+
+constexpr size_t W = Vd::W;
+
+static inline double smin(double a, double acc) { return a < acc ? a : acc; }
+static inline double smax(double a, double acc) { return a > acc ? a : acc; }
+
+static inline double hsum(Vd a) {
+    double t[W];
+    a.store(t);
+    double s = 0.0;
+    for (size_t i = 0; i < W; ++i) s += t[i];
+    return s;
+}
+
+static inline double hmin(Vd a) {
+    double t[W];
+    a.store(t);
+    double m = INF;
+    for (size_t i = 0; i < W; ++i) m = smin(t[i], m);
+    return m;
+}
+
+static inline double hmax(Vd a) {
+    double t[W];
+    a.store(t);
+    double m = -INF;
+    for (size_t i = 0; i < W; ++i) m = smax(t[i], m);
+    return m;
+}
+
+// --- Somme ---------------------------------------------------------------------------
+
+constexpr size_t PAIR_BLOCK = 256;
+
+static double sum_block(const double* x, size_t n) {
+    Vd a0 = Vd::zero(), a1 = Vd::zero(), a2 = Vd::zero(), a3 = Vd::zero();
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        a0 = a0 + Vd::load(x + i);
+        a1 = a1 + Vd::load(x + i + W);
+        a2 = a2 + Vd::load(x + i + 2 * W);
+        a3 = a3 + Vd::load(x + i + 3 * W);
+    }
+    for (; i + W <= n; i += W) a0 = a0 + Vd::load(x + i);
+    double s = hsum((a0 + a1) + (a2 + a3));
+    for (; i < n; ++i) s += x[i];
+    return s;
+}
+
+static double sum_pairwise(const double* x, size_t n) {
+    if (n <= PAIR_BLOCK) return sum_block(x, n);
+    const size_t h = (n / 2 + PAIR_BLOCK - 1) / PAIR_BLOCK * PAIR_BLOCK;
+    return sum_pairwise(x, h) + sum_pairwise(x + h, n - h);
+}
+
+// --- Moments -------------------------------------------------------------------------
+
+constexpr size_t MOMENT_BLOCK = 1024;
+
+static void merge(vt_mx_moments* acc, const vt_mx_moments& b) {
+    if (!b.n) return;
+    if (!acc->n) {
+        *acc = b;
+        return;
+    }
+    const double na = static_cast<double>(acc->n), nb = static_cast<double>(b.n);
+    const double n = na + nb;
+    const double delta = b.mean - acc->mean;
+    acc->mean += delta * (nb / n);
+    acc->m2 += b.m2 + delta * delta * (na * nb / n);
+    acc->n += b.n;
+    acc->min = smin(b.min, acc->min);
+    acc->max = smax(b.max, acc->max);
+}
+
+static void moments(const double* x, size_t n, vt_mx_moments* out) {
+    *out = vt_mx_moments{0, 0.0, 0.0, INF, -INF};
+    for (size_t off = 0; off < n; off += MOMENT_BLOCK) {
+        const double* p = x + off;
+        const size_t nb = std::min(MOMENT_BLOCK, n - off);
+        const double mean = sum_pairwise(p, nb) / static_cast<double>(nb);
+        const Vd m = Vd::set1(mean);
+        Vd s0 = Vd::zero(), s1 = Vd::zero();
+        Vd lo = Vd::set1(INF), hi = Vd::set1(-INF);
+        size_t i = 0;
+        for (; i + 2 * W <= nb; i += 2 * W) {
+            const Vd a = Vd::load(p + i), b = Vd::load(p + i + W);
+            const Vd da = a - m, db = b - m;
+            s0 = s0 + da * da;
+            s1 = s1 + db * db;
+            lo = Vd::min(b, Vd::min(a, lo));
+            hi = Vd::max(b, Vd::max(a, hi));
+        }
+        double m2 = hsum(s0 + s1), mn = hmin(lo), mx = hmax(hi);
+        for (; i < nb; ++i) {
+            const double d = p[i] - mean;
+            m2 += d * d;
+            mn = smin(p[i], mn);
+            mx = smax(p[i], mx);
+        }
+        merge(out, vt_mx_moments{nb, mean, m2, mn, mx});
+    }
+}
+
+// --- Sélection -----------------------------------------------------------------------
+
+static void floyd_rivest(double* a, ptrdiff_t left, ptrdiff_t right, ptrdiff_t k, int budget) {
+    while (right > left) {
+        if (--budget < 0) {
+            std::nth_element(a + left, a + k, a + right + 1);
+            return;
+        }
+        if (right - left > 600) {
+            // rétrécit [left, right] autour de k à partir d’un échantillon
+            const double n = static_cast<double>(right - left + 1);
+            const double i = static_cast<double>(k - left + 1);
+            const double z = std::log(n);
+            const double s = 0.5 * std::exp(2.0 * z / 3.0);
+            const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1.0 : 1.0);
+            const ptrdiff_t nl = std::max(left, static_cast<ptrdiff_t>(static_cast<double>(k) - i * s / n + sd));
+            const ptrdiff_t nr = std::min(right, static_cast<ptrdiff_t>(static_cast<double>(k) + (n - i) * s / n + sd));
+            floyd_rivest(a, nl, nr, k, budget);
+        }
+        const double t = a[k];
+        ptrdiff_t i = left, j = right;
+        std::swap(a[left], a[k]);
+        if (a[right] > t) std::swap(a[right], a[left]);
+        while (i < j) {
+            std::swap(a[i], a[j]);
+            ++i;
+            --j;
+            while (a[i] < t) ++i;
+            while (a[j] > t) --j;
+        }
+        if (a[left] == t) {
+            std::swap(a[left], a[j]);
+        } else {
+            ++j;
+            std::swap(a[j], a[right]);
+        }
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+static double select(double* a, size_t n, size_t k) {
+    int budget = 8;
+    for (size_t m = n; m > 1; m >>= 1) budget += 2;
+    floyd_rivest(a, 0, static_cast<ptrdiff_t>(n) - 1, static_cast<ptrdiff_t>(k), budget);
+    return a[k];
+}
+
+// Copie des valeurs non-NaN.
+static bool copy_finite(const double* xs, size_t n, std::vector<double>* out) {
+    try {
+        out->reserve(n);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i)
+        if (!std::isnan(xs[i])) out->push_back(xs[i]);
+    return true;
+}
+
+static double min_of(const double* x, size_t n) {
+    Vd lo = Vd::set1(INF);
+    size_t i = 0;
+    for (; i + W <= n; i += W) lo = Vd::min(Vd::load(x + i), lo);
+    double m = hmin(lo);
+    for (; i < n; ++i) m = smin(x[i], m);
+    return m;
+}
+
+// Cas rare (résultat ±inf) : distingue « que des NaN / vide » d’un vrai infini.
+static bool all_nan(const double* x, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        if (!std::isnan(x[i])) return false;
+    return true;
+}
+
+// Quantile dans `buf` (déjà sans NaN), en sélectionnant à partir de `from` (les éléments
+// avant `from` sont ≤ à tout le reste : quantiles demandés par rang croissant).
+static double quantile_in(std::vector<double>& buf, double q, size_t from) {
+    const size_t n = buf.size();
+    if (n == 1) return buf[0];
+    const double pos = q * static_cast<double>(n - 1);
+    const size_t k = static_cast<size_t>(std::floor(pos));
+    const double frac = pos - static_cast<double>(k);
+    const double a = select(buf.data() + from, n - from, k - from);
+    if (frac <= 1e-12 || k + 1 >= n) return a;
+    // après sélection, le rang k+1 est le minimum de la partie droite
+    const double b = min_of(buf.data() + k + 1, n - k - 1);
+    return a + (b - a) * frac;
+}
+
+// --- t-digest ------------------------------------------------------------------------
+
+struct Centroid {
+    double mean;
+    double w;
+};
+
+} // namespace vt_mx
+
+struct vt_tdigest {
+    double compression = 100.0;
+    std::vector<vt_mx::Centroid> cs;     // compactés, triés par moyenne
+    std::vector<vt_mx::Centroid> buf;    // ajouts en attente
+    size_t buf_cap = 0;
+    double total = 0.0;                  // poids de cs + buf
+    double min = vt_mx::INF;
+    double max = -vt_mx::INF;
+};
+
+namespace vt_mx {
+
+// Fonction d’échelle k1 : centroïdes fins aux extrémités, larges au centre.
+static inline double k_scale(double q, double d) { return d / (2.0 * M_PI) * std::asin(2.0 * q - 1.0); }
+static inline double k_inv(double k, double d) { return (std::sin(k * 2.0 * M_PI / d) + 1.0) / 2.0; }
+
+static void compress(vt_tdigest* td) {
+    if (td->buf.empty()) return;
+    auto& all = td->buf;
+    all.insert(all.end(), td->cs.begin(), td->cs.end());
+    std::sort(all.begin(), all.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    const double total = td->total;
+    const double d = td->compression;
+    td->cs.clear();
+    Centroid cur = all[0];
+    double q0 = 0.0;
+    double q_limit = k_inv(k_scale(q0, d) + 1.0, d) * total;
+    for (size_t i = 1; i < all.size(); ++i) {
+        const Centroid& c = all[i];
+        if (q0 * total + cur.w + c.w <= q_limit) {
+            cur.w += c.w;
+            cur.mean += (c.mean - cur.mean) * c.w / cur.w;
+        } else {
+            td->cs.push_back(cur);
+            q0 += cur.w / total;
+            q_limit = k_inv(k_scale(q0, d) + 1.0, d) * total;
+            cur = c;
+        }
+    }
+    td->cs.push_back(cur);
+    all.clear();
+}
+
+static void add(vt_tdigest* td, double x, double w) {
+    if (std::isnan(x) || !(w > 0.0)) return;
+    td->buf.push_back({x, w});
+    td->total += w;
+    td->min = smin(x, td->min);
+    td->max = smax(x, td->max);
+    if (td->buf.size() >= td->buf_cap) compress(td);
+}
+
+} // namespace vt_mx
+
+VT_EXTERN_C_BEGIN
+
+VT_API double vt_mx_sum_f64(const double* xs, size_t n) { return vt_mx::sum_pairwise(xs, n); }
+
+VT_API void vt_mx_moments_f64(const double* xs, size_t n, vt_mx_moments* out) {
+    vt_mx::moments(xs, n, out);
+}
+
+VT_API void vt_mx_moments_merge(const vt_mx_moments* a, const vt_mx_moments* b, vt_mx_moments* out) {
+    vt_mx_moments acc = *a;
+    vt_mx::merge(&acc, *b);
+    *out = acc;
+}
+
+VT_API double vt_mx_mean_f64(const double* xs, size_t n) {
+    return n ? vt_mx::sum_pairwise(xs, n) / static_cast<double>(n) : vt_mx::NaN;
+}
+
+VT_API double vt_mx_variance_f64(const double* xs, size_t n, int sample) {
+    if (n == 0 || (sample && n < 2)) return vt_mx::NaN;
+    vt_mx_moments m;
+    vt_mx::moments(xs, n, &m);
+    return m.m2 / (sample ? static_cast<double>(n) - 1.0 : static_cast<double>(n));
+}
+
+VT_API double vt_mx_min_f64(const double* xs, size_t n) {
+    const double m = vt_mx::min_of(xs, n);
+    return m == vt_mx::INF && vt_mx::all_nan(xs, n) ? NAN : m;
+}
+
+VT_API double vt_mx_max_f64(const double* xs, size_t n) {
+    using vt_mx::Vd;
+    Vd hi = Vd::set1(-vt_mx::INF);
+    size_t i = 0;
+    for (; i + vt_mx::W <= n; i += vt_mx::W) hi = Vd::max(Vd::load(xs + i), hi);
+    double m = vt_mx::hmax(hi);
+    for (; i < n; ++i) m = vt_mx::smax(xs[i], m);
+    return m == -vt_mx::INF && vt_mx::all_nan(xs, n) ? NAN : m;
+}
+
+VT_API void vt_mx_clamp_f64(const double* xs, size_t n, double lo, double hi, double* out) {
+    using vt_mx::Vd;
+    if (std::isnan(lo) || std::isnan(hi)) {
+        if (out != xs) std::copy(xs, xs + n, out);
+        return;
+    }
+    if (lo > hi) std::swap(lo, hi);
+    // max(l, x) puis min(h, y) : un x NaN traverse inchangé, comme clamp_f64
+    const Vd l = Vd::set1(lo), h = Vd::set1(hi);
+    size_t i = 0;
+    for (; i + vt_mx::W <= n; i += vt_mx::W) Vd::min(h, Vd::max(l, Vd::load(xs + i))).store(out + i);
+    for (; i < n; ++i) {
+        const double x = xs[i];
+        out[i] = x < lo ? lo : x > hi ? hi : x;
+    }
+}
+
+VT_API void vt_mx_lerp_f64(const double* a, const double* b, size_t n, double t, double* out) {
+    using vt_mx::Vd;
+    const Vd tv = Vd::set1(t);
+    size_t i = 0;
+    for (; i + vt_mx::W <= n; i += vt_mx::W) {
+        const Vd va = Vd::load(a + i);
+        (va + (Vd::load(b + i) - va) * tv).store(out + i);
+    }
+    for (; i < n; ++i) out[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+VT_API double vt_mx_quantile_f64(const double* xs, size_t n, double q) {
+    if (!(q >= 0.0 && q <= 1.0)) return vt_mx::NaN;
+    std::vector<double> buf;
+    if (!vt_mx::copy_finite(xs, n, &buf) || buf.empty()) return vt_mx::NaN;
+    return vt_mx::quantile_in(buf, q, 0);
+}
+
+VT_API int vt_mx_quantiles_f64(const double* xs, size_t n, const double* qs, size_t m, double* out) {
+    for (size_t j = 0; j < m; ++j)
+        if (!(qs[j] >= 0.0 && qs[j] <= 1.0)) return -EINVAL;
+    std::vector<double> buf;
+    if (!vt_mx::copy_finite(xs, n, &buf)) return -ENOMEM;
+    if (buf.empty()) {
+        std::fill(out, out + m, vt_mx::NaN);
+        return 0;
+    }
+    // rangs croissants : chaque sélection ne travaille que sur la partie droite restante
+    std::vector<size_t> order(m);
+    for (size_t j = 0; j < m; ++j) order[j] = j;
+    std::sort(order.begin(), order.end(), [qs](size_t a, size_t b) { return qs[a] < qs[b]; });
+    size_t from = 0;
+    for (size_t j : order) {
+        out[j] = vt_mx::quantile_in(buf, qs[j], from);
+        from = static_cast<size_t>(std::floor(qs[j] * static_cast<double>(buf.size() - 1)));
+    }
+    return 0;
+}
+
+VT_API double vt_mx_select_f64(double* xs, size_t n, size_t k) {
+    if (k >= n) return vt_mx::NaN;
+    return vt_mx::select(xs, n, k);
+}
+
+VT_API vt_tdigest* vt_td_new(double compression) {
+    vt_tdigest* td = new (std::nothrow) vt_tdigest;
+    if (!td) return nullptr;
+    if (compression > 0.0) td->compression = compression;
+    td->buf_cap = static_cast<size_t>(td->compression) * 5;
+    return td;
+}
+
+VT_API void vt_td_free(vt_tdigest* td) { delete td; }
+
+VT_API void vt_td_add(vt_tdigest* td, double x, double w) { vt_mx::add(td, x, w); }
+
+VT_API void vt_td_add_many(vt_tdigest* td, const double* xs, size_t n) {
+    for (size_t i = 0; i < n; ++i) vt_mx::add(td, xs[i], 1.0);
+}
+
+VT_API void vt_td_merge(vt_tdigest* dst, vt_tdigest* src) {
+    vt_mx::compress(src);
+    for (const vt_mx::Centroid& c : src->cs) vt_mx::add(dst, c.mean, c.w);
+    dst->min = vt_mx::smin(src->min, dst->min);
+    dst->max = vt_mx::smax(src->max, dst->max);
+}
+
+VT_API double vt_td_quantile(vt_tdigest* td, double q) {
+    vt_mx::compress(td);
+    const auto& cs = td->cs;
+    if (cs.empty() || !(q >= 0.0 && q <= 1.0)) return vt_mx::NaN;
+    if (cs.size() == 1) return cs[0].mean;
+    const double index = q * td->total;
+    // entre le minimum et le centre du premier centroïde
+    if (index < cs[0].w / 2.0)
+        return td->min + (cs[0].mean - td->min) * (index / (cs[0].w / 2.0));
+    double cum = cs[0].w / 2.0;
+    for (size_t i = 0; i + 1 < cs.size(); ++i) {
+        const double dw = (cs[i].w + cs[i + 1].w) / 2.0;
+        if (cum + dw > index) return cs[i].mean + (cs[i + 1].mean - cs[i].mean) * ((index - cum) / dw);
+        cum += dw;
+    }
+    const vt_mx::Centroid& last = cs.back();
+    const double z = std::min(index - cum, last.w / 2.0);
+    return last.mean + (td->max - last.mean) * (z / (last.w / 2.0));
+}
+
+VT_API double vt_td_count(const vt_tdigest* td) { return td->total; }
+
+VT_API size_t vt_td_centroids(vt_tdigest* td) {
+    vt_mx::compress(td);
+    return td->cs.size();
+}
+
+VT_EXTERN_C_END
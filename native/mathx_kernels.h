@@ -0,0 +1,92 @@
+// native/mathx_kernels.h
+// Noyaux numériques vectorisés pour `modules/mathx.vitte` : somme par paires, moments
+// (moyenne / variance par fusion de Welford), min/max, clamp/lerp sur tableaux, quantiles
+// par sélection (Floyd-Rivest), et t-digest pour les fenêtres non bornées.
+//
+// API C exposée (ABI stable pour FFI):
+//   double   vt_mx_sum_f64(const double* xs, size_t n);
+//   void     vt_mx_moments_f64(const double* xs, size_t n, vt_mx_moments* out);
+//   void     vt_mx_moments_merge(const vt_mx_moments* a, const vt_mx_moments* b, vt_mx_moments* out);
+//   double   vt_mx_mean_f64(const double* xs, size_t n);
+//   double   vt_mx_variance_f64(const double* xs, size_t n, int sample);
+//   double   vt_mx_min_f64(const double* xs, size_t n);
+//   double   vt_mx_max_f64(const double* xs, size_t n);
+//   void     vt_mx_clamp_f64(const double* xs, size_t n, double lo, double hi, double* out);
+//   void     vt_mx_lerp_f64(const double* a, const double* b, size_t n, double t, double* out);
+//   double   vt_mx_quantile_f64(const double* xs, size_t n, double q);
+//   int      vt_mx_quantiles_f64(const double* xs, size_t n, const double* qs, size_t m, double* out);
+//   double   vt_mx_select_f64(double* xs, size_t n, size_t k);
+//
+//   vt_tdigest* vt_td_new(double compression);
+//   void        vt_td_free(vt_tdigest* td);
+//   void        vt_td_add(vt_tdigest* td, double x, double w);
+//   void        vt_td_add_many(vt_tdigest* td, const double* xs, size_t n);
+//   void        vt_td_merge(vt_tdigest* dst, vt_tdigest* src);
+//   double      vt_td_quantile(vt_tdigest* td, double q);
+//   double      vt_td_count(const vt_tdigest* td);
+//   size_t      vt_td_centroids(vt_tdigest* td);
+//
+// Conventions (alignées sur mathx) :
+// - NaN : propagé par sum/mean/variance ; ignoré par min/max (comme min_f64/max_f64) et
+//   par les quantiles (sélection sur les valeurs non-NaN) ; NaN rendu si rien à calculer.
+// - clamp : bornes permutées si lo > hi, copie inchangée si une borne est NaN.
+// - quantile : position q·(n-1), interpolation linéaire entre les rangs k et k+1.
+
+#ifndef VITTE_NATIVE_MATHX_KERNELS_H
+#define VITTE_NATIVE_MATHX_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef struct vt_mx_moments {
+    uint64_t n;
+    double   mean;
+    double   m2;     // Σ (x - mean)²
+    double   min;    // +inf si aucune valeur non-NaN
+    double   max;    // -inf idem
+} vt_mx_moments;
+
+typedef struct vt_tdigest vt_tdigest;
+
+// Somme par paires (blocs vectorisés, erreur O(log n)).
+VT_API double   vt_mx_sum_f64(const double* xs, size_t n);
+// Moments par blocs (deux passes dans le cache) fusionnés par la formule de Chan.
+VT_API void     vt_mx_moments_f64(const double* xs, size_t n, vt_mx_moments* out);
+VT_API void     vt_mx_moments_merge(const vt_mx_moments* a, const vt_mx_moments* b, vt_mx_moments* out);
+// NaN si n == 0 (ou n < 2 pour la variance d’échantillon).
+VT_API double   vt_mx_mean_f64(const double* xs, size_t n);
+VT_API double   vt_mx_variance_f64(const double* xs, size_t n, int sample);
+// NaN si vide ou uniquement des NaN.
+VT_API double   vt_mx_min_f64(const double* xs, size_t n);
+VT_API double   vt_mx_max_f64(const double* xs, size_t n);
+// `out` peut être `xs` (en place).
+VT_API void     vt_mx_clamp_f64(const double* xs, size_t n, double lo, double hi, double* out);
+// out[i] = a[i] + (b[i] - a[i]) * t.
+VT_API void     vt_mx_lerp_f64(const double* a, const double* b, size_t n, double t, double* out);
+
+// Quantile sur une copie interne (l’entrée n’est pas modifiée). NaN si q ∉ [0,1] ou vide.
+VT_API double   vt_mx_quantile_f64(const double* xs, size_t n, double q);
+// Plusieurs quantiles pour une seule copie. 0, -EINVAL (q invalide) ou -ENOMEM.
+VT_API int      vt_mx_quantiles_f64(const double* xs, size_t n, const double* qs, size_t m, double* out);
+// k-ième plus petit (0-based) en place, sans NaN dans xs. Réordonne xs.
+VT_API double   vt_mx_select_f64(double* xs, size_t n, size_t k);
+
+// t-digest « fusionnant » (fonction d’échelle k1). compression ≤ 0 ⇒ 100.
+VT_API vt_tdigest* vt_td_new(double compression);
+VT_API void        vt_td_free(vt_tdigest* td);
+VT_API void        vt_td_add(vt_tdigest* td, double x, double w);
+VT_API void        vt_td_add_many(vt_tdigest* td, const double* xs, size_t n);
+// Ajoute le contenu de src à dst (src est compacté, inchangé sinon).
+VT_API void        vt_td_merge(vt_tdigest* dst, vt_tdigest* src);
+// NaN si vide.
+VT_API double      vt_td_quantile(vt_tdigest* td, double q);
+VT_API double      vt_td_count(const vt_tdigest* td);
+VT_API size_t      vt_td_centroids(vt_tdigest* td);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_MATHX_KERNELS_H
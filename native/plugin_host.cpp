@@ -0,0 +1,108 @@
+// native/plugin_host.cpp
+// Liaison des plugins SDK (cf. plugin_host.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/plugin_host.cpp -o build/plugin_host.o
+//
+// Remarques :
+// - Aucun état global hormis la dernière erreur (thread_local) : thread-safe par construction.
+// - Les fonctions vt_plugin_invoke_* sont de simples trampolines (un appel indirect) ; un
+//   hôte C/C++ peut aussi appeler directement le pointeur retourné par vt_plugin_resolve().
+
+#include "plugin_host.h"
+
+#include <cerrno>
+#include <cstring>
+
+namespace vt_plugin_host {
+
+thread_local int32_t g_last_error = 0;
+
+// Taille minimale acceptée : tout jusqu’à `reserved` inclus (version 1 de la table).
+constexpr size_t MIN_VTABLE_SIZE = offsetof(vt_plugin_vtable, reserved) + sizeof(uint32_t);
+
+static bool valid_sig(uint32_t sig) {
+    return sig == VT_SIG_I64_I64 || sig == VT_SIG_F64_F64 || sig == VT_SIG_BYTES;
+}
+
+static int32_t check(const vt_plugin_vtable* vt, uint32_t want_abi) {
+    if (!vt) return -EFAULT;
+    if (vt->abi != want_abi || vt->size < MIN_VTABLE_SIZE) return -ENOEXEC;
+    if (!vt->name || !vt->version) return -EINVAL;
+    if ((vt->caps & VT_PLUGIN_CAP_INIT) && !vt->init) return -EINVAL;
+    if ((vt->caps & VT_PLUGIN_CAP_REGISTER) && !vt->register_) return -EINVAL;
+    if ((vt->caps & VT_PLUGIN_CAP_DEINIT) && !vt->deinit) return -EINVAL;
+    if (vt->caps & VT_PLUGIN_CAP_FNS) {
+        if (!vt->fns && vt->fn_count) return -EINVAL;
+        for (uint32_t i = 0; i < vt->fn_count; ++i) {
+            const vt_plugin_fn& f = vt->fns[i];
+            if (!f.name || !*f.name || !valid_sig(f.sig) || !f.fn.i64) return -EINVAL;
+        }
+    }
+    return 0;
+}
+
+} // namespace vt_plugin_host
+
+using namespace vt_plugin_host;
+
+static inline const vt_plugin_vtable* as_vt(uint64_t vt) {
+    return reinterpret_cast<const vt_plugin_vtable*>(static_cast<uintptr_t>(vt));
+}
+
+extern "C" {
+
+VT_API uint64_t vt_plugin_bind(uint64_t getter, uint32_t want_abi) {
+    if (!getter) {
+        g_last_error = -EFAULT;
+        return 0;
+    }
+    auto get = reinterpret_cast<vt_plugin_vtable_getter>(static_cast<uintptr_t>(getter));
+    const vt_plugin_vtable* vt = get();
+    g_last_error = check(vt, want_abi ? want_abi : VT_PLUGIN_VTABLE_ABI);
+    return g_last_error == 0 ? reinterpret_cast<uintptr_t>(vt) : 0;
+}
+
+VT_API int32_t vt_plugin_last_error(void) { return g_last_error; }
+
+VT_API uint64_t vt_plugin_caps(uint64_t vt) {
+    return vt ? as_vt(vt)->caps : 0;
+}
+
+VT_API int32_t vt_plugin_hook(uint64_t vt, uint32_t cap) {
+    const vt_plugin_vtable* t = as_vt(vt);
+    if (!t || !(t->caps & cap)) return 0;
+    switch (cap) {
+        case VT_PLUGIN_CAP_INIT:     return t->init();
+        case VT_PLUGIN_CAP_REGISTER: return t->register_();
+        case VT_PLUGIN_CAP_DEINIT:   return t->deinit();
+        default:                     return -EINVAL;
+    }
+}
+
+VT_API uint64_t vt_plugin_resolve(uint64_t vt, const char* name, uint32_t sig) {
+    const vt_plugin_vtable* t = as_vt(vt);
+    if (!t || !name || !(t->caps & VT_PLUGIN_CAP_FNS)) return 0;
+    for (uint32_t i = 0; i < t->fn_count; ++i) {
+        const vt_plugin_fn& f = t->fns[i];
+        if (f.sig == sig && std::strcmp(f.name, name) == 0)
+            return reinterpret_cast<uintptr_t>(f.fn.i64);
+    }
+    return 0;
+}
+
+VT_API int64_t vt_plugin_invoke_i64(uint64_t fn, int64_t a, int64_t b) {
+    return reinterpret_cast<vt_plugin_i64_fn>(static_cast<uintptr_t>(fn))(a, b);
+}
+
+VT_API double vt_plugin_invoke_f64(uint64_t fn, double a, double b) {
+    return reinterpret_cast<vt_plugin_f64_fn>(static_cast<uintptr_t>(fn))(a, b);
+}
+
+VT_API int32_t vt_plugin_invoke_bytes(uint64_t fn, const uint8_t* in, size_t in_len,
+                                      uint8_t* out, size_t out_cap, size_t* out_len) {
+    return reinterpret_cast<vt_plugin_bytes_fn>(static_cast<uintptr_t>(fn))(in, in_len, out,
+                                                                              out_cap, out_len);
+}
+
+} // extern "C"
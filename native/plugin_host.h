@@ -0,0 +1,53 @@
+// native/plugin_host.h
+// Côté hôte des plugins SDK (cf. plugin_sdk.h) : validation de la vtable au chargement,
+// puis appels directs par pointeur de fonction.
+//
+// API C exposée (ABI stable pour FFI):
+//   uint64_t vt_plugin_bind(uint64_t getter, uint32_t want_abi);
+//   int32_t  vt_plugin_last_error(void);
+//   uint64_t vt_plugin_caps(uint64_t vt);
+//   int32_t  vt_plugin_hook(uint64_t vt, uint32_t cap);
+//   uint64_t vt_plugin_resolve(uint64_t vt, const char* name, uint32_t sig);
+//   int64_t  vt_plugin_invoke_i64(uint64_t fn, int64_t a, int64_t b);
+//   double   vt_plugin_invoke_f64(uint64_t fn, double a, double b);
+//   int32_t  vt_plugin_invoke_bytes(uint64_t fn, const uint8_t* in, size_t in_len,
+//                                   uint8_t* out, size_t out_cap, size_t* out_len);
+//
+// Modèle :
+// - `getter` = adresse de `vitte_plugin_vtable` obtenue par dlsym (une fois, au chargement).
+// - vt_plugin_bind() appelle le getter, vérifie version, taille et cohérence des capacités
+//   (un bit annoncé ⇒ pointeur non nul, noms et signatures valides) ; la table est ensuite
+//   de confiance et aucun appel chaud ne la revalide.
+// - vt_plugin_resolve() est à faire une fois par fonction : le pointeur retourné se garde.
+// - Les handles sont des adresses (u64) pour s’aligner sur __vitte_dlsym côté Vitte.
+
+#ifndef VITTE_NATIVE_PLUGIN_HOST_H
+#define VITTE_NATIVE_PLUGIN_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+#include "plugin_sdk.h"
+
+VT_EXTERN_C_BEGIN
+
+// Retourne l’adresse de la vtable validée, ou 0 (détail via vt_plugin_last_error :
+// -ENOEXEC version/ABI, -EINVAL table incohérente, -EFAULT getter nul ou table nulle).
+VT_API uint64_t vt_plugin_bind(uint64_t getter, uint32_t want_abi);
+VT_API int32_t  vt_plugin_last_error(void);
+
+VT_API uint64_t vt_plugin_caps(uint64_t vt);
+// Appelle init / register / deinit selon `cap` (VT_PLUGIN_CAP_*). 0 si le hook est absent.
+VT_API int32_t  vt_plugin_hook(uint64_t vt, uint32_t cap);
+// Pointeur de la fonction `name` de signature `sig`, ou 0.
+VT_API uint64_t vt_plugin_resolve(uint64_t vt, const char* name, uint32_t sig);
+
+VT_API int64_t  vt_plugin_invoke_i64(uint64_t fn, int64_t a, int64_t b);
+VT_API double   vt_plugin_invoke_f64(uint64_t fn, double a, double b);
+VT_API int32_t  vt_plugin_invoke_bytes(uint64_t fn, const uint8_t* in, size_t in_len,
+                                       uint8_t* out, size_t out_cap, size_t* out_len);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_PLUGIN_HOST_H
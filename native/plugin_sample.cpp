@@ -0,0 +1,82 @@
+// native/plugin_sample.cpp
+// Plugin d’exemple écrit avec le SDK (plugin_sdk.h) : quelques fonctions typées,
+// hooks init/deinit, table statique exportée par VT_PLUGIN_EXPORT.
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -shared native/plugin_sample.cpp -o plugins/libvitte_sample.so
+//
+// Utilisation côté Vitte :
+//   plugin::set_unsafe_allow(true)
+//   let p = plugin::load("./plugins/libvitte_sample.so", None).unwrap()
+//   let add = plugin::resolve_i64(p.name, "add").unwrap()
+//   let s = plugin::call_i64(&add, 40, 2)   // 42
+
+#include "plugin_sdk.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+
+namespace {
+
+std::atomic<int64_t> g_calls{0};
+
+int32_t sample_init() {
+    g_calls.store(0, std::memory_order_relaxed);
+    return 0;
+}
+
+int32_t sample_deinit() { return 0; }
+
+int64_t add(int64_t a, int64_t b) { return a + b; }
+
+// a^b mod 2^64 (exponentiation rapide) — b < 0 traité comme 0.
+int64_t ipow(int64_t a, int64_t b) {
+    uint64_t base = static_cast<uint64_t>(a), r = 1;
+    for (uint64_t e = b > 0 ? static_cast<uint64_t>(b) : 0; e; e >>= 1) {
+        if (e & 1) r *= base;
+        base *= base;
+    }
+    return static_cast<int64_t>(r);
+}
+
+int64_t calls(int64_t, int64_t) { return g_calls.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+double hypot2(double a, double b) { return std::hypot(a, b); }
+
+// ASCII → majuscules.
+int32_t upper(const uint8_t* in, size_t n, uint8_t* out, size_t cap, size_t* out_len) {
+    if (out_len) *out_len = n;
+    if (cap < n) return -ENOSPC;
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t c = in[i];
+        out[i] = (c >= 'a' && c <= 'z') ? static_cast<uint8_t>(c - 32) : c;
+    }
+    return 0;
+}
+
+const vt_plugin_fn FNS[] = {
+    { "add",   VT_SIG_I64_I64, 0, { .i64 = add } },
+    { "pow",   VT_SIG_I64_I64, 0, { .i64 = ipow } },
+    { "calls", VT_SIG_I64_I64, 0, { .i64 = calls } },
+    { "hypot", VT_SIG_F64_F64, 0, { .f64 = hypot2 } },
+    { "upper", VT_SIG_BYTES,   0, { .bytes = upper } },
+};
+
+const vt_plugin_vtable VT = {
+    VT_PLUGIN_VTABLE_ABI,
+    sizeof(vt_plugin_vtable),
+    VT_PLUGIN_CAP_INIT | VT_PLUGIN_CAP_DEINIT | VT_PLUGIN_CAP_FNS | VT_PLUGIN_CAP_THREAD_SAFE,
+    "vitte_sample",
+    "0.1.0",
+    sample_init,
+    nullptr,
+    sample_deinit,
+    FNS,
+    sizeof(FNS) / sizeof(FNS[0]),
+    0,
+};
+
+} // namespace
+
+VT_PLUGIN_EXPORT(VT)
@@ -0,0 +1,119 @@
+// native/plugin_sdk.h
+// SDK C/C++ des plugins natifs Vitte (cf. modules/plugin.vitte) — en-tête autonome,
+// à copier tel quel dans le projet du plugin.
+//
+// Le plugin exporte UNE table statique (vtable) : hooks de cycle de vie, fonctions typées
+// nommées et masque de capacités. L’hôte la résout une fois au chargement ; un appel
+// « chaud » est ensuite un simple appel indirect, sans dlsym ni marshalling générique.
+//
+// Exemple (C++20) :
+//   static int64_t add(int64_t a, int64_t b) { return a + b; }
+//   static const vt_plugin_fn FNS[] = {
+//       { "add", VT_SIG_I64_I64, 0, { .i64 = add } },
+//   };
+//   static const vt_plugin_vtable VT = {
+//       VT_PLUGIN_VTABLE_ABI, sizeof(vt_plugin_vtable),
+//       VT_PLUGIN_CAP_FNS | VT_PLUGIN_CAP_THREAD_SAFE,
+//       "hello", "0.1.0", nullptr, nullptr, nullptr, FNS, 1, 0,
+//   };
+//   VT_PLUGIN_EXPORT(VT)
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -shared -Inative my_plugin.cpp -o libmy_plugin.so
+//
+// Remarques :
+// - VT_PLUGIN_EXPORT exporte aussi les symboles historiques (vitte_plugin_abi/name/version,
+//   init/register/deinit) : un plugin SDK reste chargeable par un hôte plus ancien.
+// - La table et les chaînes doivent vivre aussi longtemps que la bibliothèque (statiques).
+// - Compatibilité : `size` permet d’ajouter des champs en fin de structure ; l’hôte ignore
+//   ce qu’il ne connaît pas et refuse une table plus courte que sa version minimale.
+
+#ifndef VITTE_NATIVE_PLUGIN_SDK_H
+#define VITTE_NATIVE_PLUGIN_SDK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define VT_PLUGIN_EXTERN_C extern "C"
+#else
+#define VT_PLUGIN_EXTERN_C
+#endif
+
+#if defined(_WIN32)
+#define VT_PLUGIN_API VT_PLUGIN_EXTERN_C __declspec(dllexport)
+#else
+#define VT_PLUGIN_API VT_PLUGIN_EXTERN_C __attribute__((visibility("default")))
+#endif
+
+#define VT_PLUGIN_ABI         1u   // == plugin::ABI_VERSION (symbole vitte_plugin_abi)
+#define VT_PLUGIN_VTABLE_ABI  1u   // version de la structure vt_plugin_vtable
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    VT_PLUGIN_CAP_INIT        = 1u << 0,   // vtable.init non nul
+    VT_PLUGIN_CAP_REGISTER    = 1u << 1,   // vtable.register_ non nul
+    VT_PLUGIN_CAP_DEINIT      = 1u << 2,   // vtable.deinit non nul
+    VT_PLUGIN_CAP_FNS         = 1u << 3,   // table de fonctions typées
+    VT_PLUGIN_CAP_THREAD_SAFE = 1u << 4,   // fonctions appelables depuis plusieurs threads
+};
+
+// Signatures des fonctions exportées (vt_plugin_fn.sig).
+enum {
+    VT_SIG_I64_I64   = 1,   // int64_t f(int64_t, int64_t)
+    VT_SIG_F64_F64   = 2,   // double  f(double, double)
+    VT_SIG_BYTES     = 3,   // int32_t f(in, in_len, out, out_cap, &out_len) — 0 ou -errno
+};
+
+typedef int64_t (*vt_plugin_i64_fn)(int64_t a, int64_t b);
+typedef double  (*vt_plugin_f64_fn)(double a, double b);
+typedef int32_t (*vt_plugin_bytes_fn)(const uint8_t* in, size_t in_len,
+                                      uint8_t* out, size_t out_cap, size_t* out_len);
+
+typedef struct vt_plugin_fn {
+    const char* name;
+    uint32_t    sig;        // VT_SIG_*
+    uint32_t    flags;      // réservé (0)
+    union {
+        vt_plugin_i64_fn   i64;
+        vt_plugin_f64_fn   f64;
+        vt_plugin_bytes_fn bytes;
+    } fn;
+} vt_plugin_fn;
+
+typedef struct vt_plugin_vtable {
+    uint32_t            abi;         // VT_PLUGIN_VTABLE_ABI
+    uint32_t            size;        // sizeof(vt_plugin_vtable) côté plugin
+    uint64_t            caps;        // VT_PLUGIN_CAP_*
+    const char*         name;
+    const char*         version;
+    int32_t           (*init)(void);       // 0 = OK
+    int32_t           (*register_)(void);  // 0 = OK
+    int32_t           (*deinit)(void);     // 0 = OK
+    const vt_plugin_fn* fns;
+    uint32_t            fn_count;
+    uint32_t            reserved;
+} vt_plugin_vtable;
+
+typedef const vt_plugin_vtable* (*vt_plugin_vtable_getter)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// Exporte la table `vt` (objet statique) et les symboles historiques équivalents.
+#define VT_PLUGIN_EXPORT(vt)                                                              \
+    VT_PLUGIN_API const vt_plugin_vtable* vitte_plugin_vtable(void) { return &(vt); }     \
+    VT_PLUGIN_API uint32_t    vitte_plugin_abi(void) { return VT_PLUGIN_ABI; }            \
+    VT_PLUGIN_API const char* vitte_plugin_name(void) { return (vt).name; }               \
+    VT_PLUGIN_API const char* vitte_plugin_version(void) { return (vt).version; }         \
+    VT_PLUGIN_API int32_t vitte_plugin_init(void) { return (vt).init ? (vt).init() : 0; } \
+    VT_PLUGIN_API int32_t vitte_plugin_register(void) {                                   \
+        return (vt).register_ ? (vt).register_() : 0;                                     \
+    }                                                                                     \
+    VT_PLUGIN_API int32_t vitte_plugin_deinit(void) { return (vt).deinit ? (vt).deinit() : 0; }
+
+#endif // VITTE_NATIVE_PLUGIN_SDK_H
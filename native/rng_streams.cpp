@@ -0,0 +1,444 @@
+// native/rng_streams.cpp
+// PRNG par lots xoshiro256++ × 8 lanes (cf. rng_streams.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -mavx2 -fPIC -c native/rng_streams.cpp -o build/rng_streams.o
+//   g++ -std=c++20 -O2 -mavx512f -fPIC -c native/rng_streams.cpp -o build/rng_streams.o
+//
+// Remarques :
+// - État en SoA (s0[8], s1[8], s2[8], s3[8]) : un pas avance les 8 lanes en un registre
+//   AVX-512, deux AVX2 ou quatre SSE2 (petit type `Vq`) ; l’état reste en registres
+//   pendant tout un remplissage.
+// - Les remplissages écrivent directement dans la sortie par blocs de 8 ; seuls les
+//   restes passent par le tampon interne (qui sert aussi aux tirages unitaires).
+// - f64 : 53 bits convertis exactement sans cvtepu64 (absent avant AVX-512DQ) — deux
+//   moitiés injectées dans la mantisse de 2^52 et 2^84 puis additionnées.
+// - Bornes : multiplication 64×64→128 de Lemire ; le modulo n’est calculé que lorsque la
+//   partie basse tombe sous `bound`, soit une probabilité bound / 2^64.
+
+#include "rng_streams.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__)
+// GCC 12 : les intrinsèques AVX-512 non masquées (min/max, rol, slli…) passent par
+// leur forme masquée avec _mm512_undefined_*() en valeur de repli, signalée
+// -W(maybe-)uninitialized une fois inlinées (-O2/-O3). Faux positif propre à l’en-tête,
+// ignoré pour lui seul.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+namespace vt_rng_impl {
+
+constexpr size_t LANES = 8;
+constexpr size_t BUF = 8 * LANES;   // 8 pas en réserve pour les tirages unitaires
+constexpr double INV_2POW53 = 1.0 / 9007199254740992.0;
+
+constexpr uint64_t JUMP[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                              0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+constexpr uint64_t LONG_JUMP[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                   0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+
+static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+static inline uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Un état xoshiro256++ scalaire (amorçage et sauts).
+struct One {
+    uint64_t s[4];
+
+    uint64_t next() {
+        const uint64_t r = rotl(s[0] + s[3], 23) + s[0];
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return r;
+    }
+
+    void jump(const uint64_t (&poly)[4]) {
+        uint64_t a[4] = {0, 0, 0, 0};
+        for (uint64_t w : poly)
+            for (int b = 0; b < 64; ++b) {
+                if (w & (uint64_t(1) << b))
+                    for (int i = 0; i < 4; ++i) a[i] ^= s[i];
+                next();
+            }
+        std::memcpy(s, a, sizeof a);
+    }
+};
+
+static inline uint64_t mulhi(uint64_t a, uint64_t b, uint64_t* lo) {
+    const unsigned __int128 m = static_cast<unsigned __int128>(a) * b;
+    *lo = static_cast<uint64_t>(m);
+    return static_cast<uint64_t>(m >> 64);
+}
+
+} // namespace vt_rng_impl
+
+struct vt_rng {
+    alignas(64) uint64_t s0[vt_rng_impl::LANES];
+    alignas(64) uint64_t s1[vt_rng_impl::LANES];
+    alignas(64) uint64_t s2[vt_rng_impl::LANES];
+    alignas(64) uint64_t s3[vt_rng_impl::LANES];
+    alignas(64) uint64_t buf[vt_rng_impl::BUF];
+    size_t pos = vt_rng_impl::BUF;   // buf[pos..BUF) encore disponibles
+};
+
+struct vt_alias {
+    std::vector<uint32_t> thresh;   // seuil de la pièce (proba de garder la colonne × 2^32)
+    std::vector<uint32_t> alias;
+};
+
+namespace vt_rng_impl {
+
+static void seed_lanes(vt_rng* r, const One& base) {
+    One o = base;
+    for (size_t k = 0; k < LANES; ++k) {
+        r->s0[k] = o.s[0];
+        r->s1[k] = o.s[1];
+        r->s2[k] = o.s[2];
+        r->s3[k] = o.s[3];
+        o.jump(JUMP);
+    }
+    r->pos = BUF;
+}
+
+// --- Vecteur de u64 ---------------------------------------------------------------------
+
+#if defined(__AVX512F__)
+struct Vq {
+    __m512i v;
+    static constexpr size_t W = 8;
+    static Vq load(const uint64_t* p) { return {_mm512_load_si512(p)}; }
+    void store(uint64_t* p) const { _mm512_store_si512(p, v); }
+    void storeu(uint64_t* p) const { _mm512_storeu_si512(p, v); }
+    friend Vq operator+(Vq a, Vq b) { return {_mm512_add_epi64(a.v, b.v)}; }
+    friend Vq operator^(Vq a, Vq b) { return {_mm512_xor_si512(a.v, b.v)}; }
+    template <int K> Vq shl() const { return {_mm512_slli_epi64(v, K)}; }
+    template <int K> Vq rotl() const { return {_mm512_rol_epi64(v, K)}; }
+};
+#elif defined(__AVX2__)
+struct Vq {
+    __m256i v;
+    static constexpr size_t W = 4;
+    static Vq load(const uint64_t* p) { return {_mm256_load_si256(reinterpret_cast<const __m256i*>(p))}; }
+    void store(uint64_t* p) const { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    void storeu(uint64_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    friend Vq operator+(Vq a, Vq b) { return {_mm256_add_epi64(a.v, b.v)}; }
+    friend Vq operator^(Vq a, Vq b) { return {_mm256_xor_si256(a.v, b.v)}; }
+    template <int K> Vq shl() const { return {_mm256_slli_epi64(v, K)}; }
+    template <int K> Vq rotl() const { return {_mm256_or_si256(_mm256_slli_epi64(v, K), _mm256_srli_epi64(v, 64 - K))}; }
+};
+#elif defined(__SSE2__)
+struct Vq {
+    __m128i v;
+    static constexpr size_t W = 2;
+    static Vq load(const uint64_t* p) { return {_mm_load_si128(reinterpret_cast<const __m128i*>(p))}; }
+    void store(uint64_t* p) const { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    void storeu(uint64_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    friend Vq operator+(Vq a, Vq b) { return {_mm_add_epi64(a.v, b.v)}; }
+    friend Vq operator^(Vq a, Vq b) { return {_mm_xor_si128(a.v, b.v)}; }
+    template <int K> Vq shl() const { return {_mm_slli_epi64(v, K)}; }
+    template <int K> Vq rotl() const { return {_mm_or_si128(_mm_slli_epi64(v, K), _mm_srli_epi64(v, 64 - K))}; }
+};
+#else
+struct Vq {
+    uint64_t v;
+    static constexpr size_t W = 1;
+    static Vq load(const uint64_t* p) { return {*p}; }
+    void store(uint64_t* p) const { *p = v; }
+    void storeu(uint64_t* p) const { *p = v; }
+    friend Vq operator+(Vq a, Vq b) { return {a.v + b.v}; }
+    friend Vq operator^(Vq a, Vq b) { return {a.v ^ b.v}; }
+    template <int K> Vq shl() const { return {v << K}; }
+    template <int K> Vq rotl() const { return {vt_rng_impl::rotl(v, K)}; }
+};
+#endif
+
+// `steps` pas des 8 lanes → out[0 .. 8·steps) ; l’état reste en registres entre les pas.
+static void gen(vt_rng* r, uint64_t* out, size_t steps) {
+    constexpr size_t G = LANES / Vq::W;
+    Vq a[G], b[G], c[G], d[G];
+    for (size_t g = 0; g < G; ++g) {
+        a[g] = Vq::load(r->s0 + g * Vq::W);
+        b[g] = Vq::load(r->s1 + g * Vq::W);
+        c[g] = Vq::load(r->s2 + g * Vq::W);
+        d[g] = Vq::load(r->s3 + g * Vq::W);
+    }
+    for (size_t k = 0; k < steps; ++k, out += LANES)
+#if defined(__GNUC__)
+#pragma GCC unroll 8
+#endif
+        for (size_t g = 0; g < G; ++g) {
+            ((a[g] + d[g]).template rotl<23>() + a[g]).storeu(out + g * Vq::W);
+            const Vq t = b[g].template shl<17>();
+            c[g] = c[g] ^ a[g];
+            d[g] = d[g] ^ b[g];
+            b[g] = b[g] ^ c[g];
+            a[g] = a[g] ^ d[g];
+            c[g] = c[g] ^ t;
+            d[g] = d[g].template rotl<45>();
+        }
+    for (size_t g = 0; g < G; ++g) {
+        a[g].store(r->s0 + g * Vq::W);
+        b[g].store(r->s1 + g * Vq::W);
+        c[g].store(r->s2 + g * Vq::W);
+        d[g].store(r->s3 + g * Vq::W);
+    }
+}
+
+static inline uint64_t next(vt_rng* r) {
+    if (r->pos == BUF) {
+        gen(r, r->buf, BUF / LANES);
+        r->pos = 0;
+    }
+    return r->buf[r->pos++];
+}
+
+static void fill(vt_rng* r, uint64_t* out, size_t n) {
+    size_t i = 0;
+    while (i < n && r->pos != BUF) out[i++] = r->buf[r->pos++];
+    const size_t steps = (n - i) / LANES;
+    gen(r, out + i, steps);
+    i += steps * LANES;
+    while (i < n) out[i++] = next(r);
+}
+
+// u64 → double dans [0, 1) : (x >> 11) · 2^-53, exact.
+static void to_unit_f64(const uint64_t* bits, double* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i lo_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i lo_exp = _mm256_set1_epi64x(0x4330000000000000LL);   // 2^52
+    const __m256i hi_exp = _mm256_set1_epi64x(0x4530000000000000LL);   // 2^84
+    const __m256d bias = _mm256_set1_pd(19342813118337666422669312.0);  // 2^84 + 2^52
+    const __m256d scale = _mm256_set1_pd(INV_2POW53);
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_srli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i)), 11);
+        const __m256d lo = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(v, lo_mask), lo_exp));
+        const __m256d hi = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 32), hi_exp));
+        const __m256d x = _mm256_add_pd(_mm256_sub_pd(hi, bias), lo);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(x, scale));
+    }
+#elif defined(__SSE2__)
+    const __m128i lo_mask = _mm_set1_epi64x(0xFFFFFFFF);
+    const __m128i lo_exp = _mm_set1_epi64x(0x4330000000000000LL);
+    const __m128i hi_exp = _mm_set1_epi64x(0x4530000000000000LL);
+    const __m128d bias = _mm_set1_pd(19342813118337666422669312.0);
+    const __m128d scale = _mm_set1_pd(INV_2POW53);
+    for (; i + 2 <= n; i += 2) {
+        const __m128i v = _mm_srli_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i)), 11);
+        const __m128d lo = _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(v, lo_mask), lo_exp));
+        const __m128d hi = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(v, 32), hi_exp));
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_add_pd(_mm_sub_pd(hi, bias), lo), scale));
+    }
+#endif
+    for (; i < n; ++i) out[i] = static_cast<double>(bits[i] >> 11) * INV_2POW53;
+}
+
+static inline uint64_t below(vt_rng* r, uint64_t bound) {
+    uint64_t lo;
+    uint64_t hi = mulhi(next(r), bound, &lo);
+    if (lo < bound) {
+        const uint64_t t = (0 - bound) % bound;
+        while (lo < t) hi = mulhi(next(r), bound, &lo);
+    }
+    return hi;
+}
+
+// Variante 32 bits (bornes < 2^32) : deux tirages par u64.
+struct Below32 {
+    vt_rng* r;
+    uint64_t word = 0;
+    bool half = false;
+
+    uint32_t draw() {
+        if (half) { half = false; return static_cast<uint32_t>(word >> 32); }
+        word = next(r);
+        half = true;
+        return static_cast<uint32_t>(word);
+    }
+
+    uint32_t operator()(uint32_t bound) {
+        uint64_t m = uint64_t(draw()) * bound;
+        uint32_t lo = static_cast<uint32_t>(m);
+        if (lo < bound) {
+            const uint32_t t = (0u - bound) % bound;
+            while (lo < t) {
+                m = uint64_t(draw()) * bound;
+                lo = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+};
+
+} // namespace vt_rng_impl
+
+VT_EXTERN_C_BEGIN
+
+VT_API vt_rng* vt_rng_new(uint64_t seed, uint64_t stream) {
+    using namespace vt_rng_impl;
+    vt_rng* r = new (std::nothrow) vt_rng;
+    if (!r) return nullptr;
+    One o;
+    uint64_t x = seed;
+    for (uint64_t& w : o.s) w = splitmix64(x);
+    // splitmix64 est une bijection : 4 sorties nulles sont impossibles
+    for (uint64_t k = 0; k < stream; ++k) o.jump(LONG_JUMP);
+    seed_lanes(r, o);
+    return r;
+}
+
+VT_API vt_rng* vt_rng_split(vt_rng* r) {
+    using namespace vt_rng_impl;
+    vt_rng* c = new (std::nothrow) vt_rng(*r);
+    if (!c) return nullptr;
+    // l’enfant continue le flux ; chaque lane du parent saute de 2^192 pas
+    for (size_t k = 0; k < LANES; ++k) {
+        One o{{r->s0[k], r->s1[k], r->s2[k], r->s3[k]}};
+        o.jump(LONG_JUMP);
+        r->s0[k] = o.s[0];
+        r->s1[k] = o.s[1];
+        r->s2[k] = o.s[2];
+        r->s3[k] = o.s[3];
+    }
+    r->pos = BUF;
+    return c;
+}
+
+VT_API void vt_rng_free(vt_rng* r) { delete r; }
+
+VT_API uint64_t vt_rng_next_u64(vt_rng* r) { return vt_rng_impl::next(r); }
+
+VT_API double vt_rng_next_f64(vt_rng* r) {
+    return static_cast<double>(vt_rng_impl::next(r) >> 11) * vt_rng_impl::INV_2POW53;
+}
+
+VT_API uint64_t vt_rng_below(vt_rng* r, uint64_t bound) {
+    return bound ? vt_rng_impl::below(r, bound) : 0;
+}
+
+VT_API void vt_rng_fill_u64(vt_rng* r, uint64_t* out, size_t n) { vt_rng_impl::fill(r, out, n); }
+
+VT_API void vt_rng_fill_f64(vt_rng* r, double* out, size_t n) {
+    // par blocs de 4 Kio : la conversion relit des données encore en L1
+    uint64_t tmp[512];
+    for (size_t i = 0; i < n; i += 512) {
+        const size_t m = n - i < 512 ? n - i : 512;
+        vt_rng_impl::fill(r, tmp, m);
+        vt_rng_impl::to_unit_f64(tmp, out + i, m);
+    }
+}
+
+VT_API void vt_rng_fill_below(vt_rng* r, uint64_t bound, uint64_t* out, size_t n) {
+    if (!bound) {
+        std::memset(out, 0, n * sizeof *out);
+        return;
+    }
+    // génération en masse puis réduction ; les rares rejets retirent à l’unité
+    vt_rng_impl::fill(r, out, n);
+    const uint64_t t = (0 - bound) % bound;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t lo;
+        uint64_t hi = vt_rng_impl::mulhi(out[i], bound, &lo);
+        while (lo < t) hi = vt_rng_impl::mulhi(vt_rng_impl::next(r), bound, &lo);
+        out[i] = hi;
+    }
+}
+
+VT_API int vt_rng_fy_indices(vt_rng* r, uint64_t top, size_t count, uint32_t* out) {
+    // top - k + 1 doit tenir dans la borne u32 de Below32 : top = 2^32 - 1 donnerait 2^32,
+    // tronqué à 0
+    if (top >= UINT32_MAX || count > top) return -EINVAL;
+    vt_rng_impl::Below32 b{r};
+    for (size_t k = 0; k < count; ++k) out[k] = b(static_cast<uint32_t>(top - k + 1));
+    return 0;
+}
+
+VT_API vt_alias* vt_alias_new(const double* weights, size_t n) {
+    if (n == 0 || n >= (uint64_t(1) << 32)) return nullptr;
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!(weights[i] >= 0.0) || std::isinf(weights[i])) return nullptr;
+        sum += weights[i];
+    }
+    if (!(sum > 0.0)) return nullptr;
+    vt_alias* t = new (std::nothrow) vt_alias;
+    if (!t) return nullptr;
+    try {
+        t->thresh.resize(n);
+        t->alias.resize(n);
+        std::vector<double> p(n);
+        std::vector<uint32_t> small, large;
+        small.reserve(n);
+        large.reserve(n);
+        const double scale = static_cast<double>(n) / sum;
+        for (size_t i = 0; i < n; ++i) {
+            p[i] = weights[i] * scale;
+            (p[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+        }
+        // Vose : chaque colonne « petite » est complétée par une « grande »
+        while (!small.empty() && !large.empty()) {
+            const uint32_t s = small.back(), l = large.back();
+            small.pop_back();
+            t->thresh[s] = static_cast<uint32_t>(std::ldexp(p[s], 32));
+            t->alias[s] = l;
+            p[l] = (p[l] + p[s]) - 1.0;
+            if (p[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // restes (proba 1 à l’arrondi près) : la colonne se garde toujours
+        for (uint32_t i : large) { t->thresh[i] = UINT32_MAX; t->alias[i] = i; }
+        for (uint32_t i : small) { t->thresh[i] = UINT32_MAX; t->alias[i] = i; }
+    } catch (const std::bad_alloc&) {
+        delete t;
+        return nullptr;
+    }
+    return t;
+}
+
+VT_API void vt_alias_free(vt_alias* t) { delete t; }
+
+VT_API uint32_t vt_alias_pick(const vt_alias* t, uint64_t r) {
+    const uint64_t n = t->thresh.size();
+    const uint32_t col = static_cast<uint32_t>(((r >> 32) * n) >> 32);
+    const uint32_t coin = static_cast<uint32_t>(r);
+    // sans branche : sélection par masque
+    const uint32_t keep = 0u - static_cast<uint32_t>(coin < t->thresh[col]);
+    return (col & keep) | (t->alias[col] & ~keep);
+}
+
+VT_API void vt_alias_fill(const vt_alias* t, vt_rng* r, uint32_t* out, size_t n) {
+    uint64_t tmp[vt_rng_impl::BUF];
+    for (size_t i = 0; i < n; i += vt_rng_impl::BUF) {
+        const size_t m = n - i < vt_rng_impl::BUF ? n - i : vt_rng_impl::BUF;
+        vt_rng_impl::fill(r, tmp, m);
+        for (size_t k = 0; k < m; ++k) out[i + k] = vt_alias_pick(t, tmp[k]);
+    }
+}
+
+VT_EXTERN_C_END
@@ -0,0 +1,76 @@
+// native/rng_streams.h
+// Générateurs pseudo-aléatoires par lots pour `modules/random.vitte` : xoshiro256++ sur
+// 8 lanes indépendantes (SIMD), flux par thread via jump-ahead, remplissages en masse,
+// tirages bornés par multiplication-décalage, indices Fisher-Yates et table d’alias.
+//
+// API C exposée (ABI stable pour FFI):
+//   vt_rng*   vt_rng_new(uint64_t seed, uint64_t stream);
+//   vt_rng*   vt_rng_split(vt_rng* r);
+//   void      vt_rng_free(vt_rng* r);
+//   uint64_t  vt_rng_next_u64(vt_rng* r);
+//   double    vt_rng_next_f64(vt_rng* r);
+//   uint64_t  vt_rng_below(vt_rng* r, uint64_t bound);
+//   void      vt_rng_fill_u64(vt_rng* r, uint64_t* out, size_t n);
+//   void      vt_rng_fill_f64(vt_rng* r, double* out, size_t n);
+//   void      vt_rng_fill_below(vt_rng* r, uint64_t bound, uint64_t* out, size_t n);
+//   int       vt_rng_fy_indices(vt_rng* r, uint64_t top, size_t count, uint32_t* out);
+//
+//   vt_alias* vt_alias_new(const double* weights, size_t n);
+//   void      vt_alias_free(vt_alias* t);
+//   uint32_t  vt_alias_pick(const vt_alias* t, uint64_t r);
+//   void      vt_alias_fill(const vt_alias* t, vt_rng* r, uint32_t* out, size_t n);
+//
+// Flux :
+// - Un `vt_rng` porte 8 états xoshiro256++ distants de 2^128 pas (jump) ; les sorties sont
+//   entrelacées lane par lane, donc identiques quelle que soit la largeur SIMD compilée.
+// - `stream` applique `stream` long-jumps (2^192 pas) : flux 0, 1, 2… disjoints pour un
+//   même seed (un par thread). vt_rng_split() rend une copie qui poursuit le flux courant
+//   et fait sauter le parent de 2^192 pas (ne pas mélanger split et indices `stream` pour
+//   un même seed : les flux se recouvriraient).
+// - Pas de verrou : un `vt_rng` par thread. Une `vt_alias` est en lecture seule, partageable.
+//
+// ⚠️ Non cryptographique.
+
+#ifndef VITTE_NATIVE_RNG_STREAMS_H
+#define VITTE_NATIVE_RNG_STREAMS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef struct vt_rng vt_rng;
+typedef struct vt_alias vt_alias;
+
+// NULL si l’allocation échoue.
+VT_API vt_rng*   vt_rng_new(uint64_t seed, uint64_t stream);
+VT_API vt_rng*   vt_rng_split(vt_rng* r);
+VT_API void      vt_rng_free(vt_rng* r);
+
+VT_API uint64_t  vt_rng_next_u64(vt_rng* r);
+// 53 bits → [0, 1).
+VT_API double    vt_rng_next_f64(vt_rng* r);
+// Uniforme sur [0, bound) sans biais (Lemire) ; 0 si bound == 0.
+VT_API uint64_t  vt_rng_below(vt_rng* r, uint64_t bound);
+
+VT_API void      vt_rng_fill_u64(vt_rng* r, uint64_t* out, size_t n);
+VT_API void      vt_rng_fill_f64(vt_rng* r, double* out, size_t n);
+VT_API void      vt_rng_fill_below(vt_rng* r, uint64_t bound, uint64_t* out, size_t n);
+
+// Indices d’un Fisher-Yates descendant : out[k] ∈ [0, top - k] pour k < count
+// (échanger i = top - k avec out[k]). 0, ou -EINVAL si top ≥ 2^32 - 1 ou count > top.
+VT_API int       vt_rng_fy_indices(vt_rng* r, uint64_t top, size_t count, uint32_t* out);
+
+// Table d’alias (Vose). NULL si n == 0, n ≥ 2^32, poids négatif/NaN ou somme nulle.
+VT_API vt_alias* vt_alias_new(const double* weights, size_t n);
+VT_API void      vt_alias_free(vt_alias* t);
+// Index tiré à partir d’un seul u64 uniforme (32 bits pour la colonne, 32 pour la pièce) :
+// utilisable avec n’importe quel générateur.
+VT_API uint32_t  vt_alias_pick(const vt_alias* t, uint64_t r);
+VT_API void      vt_alias_fill(const vt_alias* t, vt_rng* r, uint32_t* out, size_t n);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_RNG_STREAMS_H
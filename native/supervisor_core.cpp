@@ -0,0 +1,630 @@
+// native/supervisor_core.cpp
+// Noyau de supervision (cf. supervisor_core.h pour l’API C et le modèle de threads).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/supervisor_core.cpp -o build/supervisor_core.o
+//
+// Remarques :
+// - Toutes les structures sont dimensionnées à la création (capacity, ring_capacity,
+//   max_restarts + 1 horodatages) : aucune allocation sur le chemin sortie → redémarrage.
+// - Anneau MPSC borné à numéros de séquence (Vyukov) ; un seul consommateur (superviseur).
+// - Slots recyclés (pile de slots libres) : l’ordre d’ajout est porté par `order`, pas par
+//   l’index du slot. La génération survit au recyclage, donc le signalement tardif d’un
+//   ancien occupant reste périmé.
+
+#include "supervisor_core.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace vt_sup {
+
+constexpr size_t REASON_BYTES = 120;
+
+static inline uint64_t make_word(uint32_t state, uint32_t abnormal, uint32_t gen, uint32_t restarts) {
+    return uint64_t(state & 0xF) | (uint64_t(abnormal & 1) << 4) | (uint64_t(gen & 0xFFFFFF) << 8) |
+           (uint64_t(restarts) << 32);
+}
+
+static inline uint64_t with_state(uint64_t w, uint32_t state) {
+    return (w & ~uint64_t(0xF)) | (state & 0xF);
+}
+
+struct Event {
+    uint32_t slot;
+    uint32_t gen;
+};
+
+struct Cell {
+    std::atomic<uint64_t> seq;
+    Event ev;
+};
+
+// File MPSC bornée : push depuis n’importe quel thread, pop par le seul superviseur.
+class Ring {
+public:
+    explicit Ring(size_t cap) : mask_(cap - 1), cells_(new Cell[cap]) {
+        for (size_t i = 0; i < cap; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    bool push(const Event& e) {
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells_[pos & mask_];
+            const uint64_t seq = c.seq.load(std::memory_order_acquire);
+            const int64_t dif = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (dif == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.ev = e;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;   // plein
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(Event& e) {
+        Cell& c = cells_[head_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        e = c.ev;
+        c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    bool empty() const {
+        const Cell& c = cells_[head_ & mask_];
+        return c.seq.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) uint64_t head_ = 0;
+};
+
+// Fenêtre glissante exacte : les max_restarts + 1 derniers horodatages. L’intensité est
+// dépassée quand le plus ancien d’entre eux est encore dans la période.
+class Intensity {
+public:
+    Intensity(uint32_t max_restarts, uint32_t period_ms)
+        : n_(size_t(max_restarts) + 1), period_(period_ms), ts_(new uint64_t[n_]()) {}
+
+    // Enregistre un redémarrage ; retourne false si l’intensité est dépassée.
+    bool record(uint64_t now) {
+        ts_[i_] = now;
+        i_ = (i_ + 1) % n_;
+        if (count_ < n_) ++count_;
+        return !(count_ == n_ && now - ts_[i_] <= period_);
+    }
+
+    uint32_t in_window(uint64_t now) const {
+        uint32_t k = 0;
+        for (size_t j = 0; j < count_; ++j)
+            if (now - ts_[j] <= period_) ++k;
+        return k;
+    }
+
+private:
+    size_t n_;
+    uint64_t period_;
+    std::unique_ptr<uint64_t[]> ts_;
+    size_t i_ = 0;
+    size_t count_ = 0;
+};
+
+struct Timer {
+    uint64_t due;
+    uint64_t order;   // départage des échéances égales : ordre d’ajout
+    uint32_t slot;
+};
+
+static inline bool before(const Timer& a, const Timer& b) {
+    return a.due < b.due || (a.due == b.due && a.order < b.order);
+}
+
+} // namespace vt_sup
+
+using namespace vt_sup;
+
+struct vt_sup_core {
+    vt_sup_config cfg{};
+
+    // Par enfant (index = slot, recyclé après vt_sup_child_remove).
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    std::unique_ptr<uint8_t[]>               policy;
+    std::unique_ptr<uint32_t[]>              backoff;
+    std::unique_ptr<uint8_t[]>               scheduled;
+    std::unique_ptr<uint8_t[]>               fresh;     // 1 = jamais démarré depuis l’ajout
+    std::unique_ptr<uint64_t[]>              order;     // rang d’ajout (rest_for_one, minuteurs)
+    std::unique_ptr<char[]>                  reasons;   // capacity × REASON_BYTES
+    std::unique_ptr<std::atomic<uint64_t>[]> dirty;     // bitmap des sorties hors anneau
+    std::unique_ptr<uint32_t[]>              free_slots;
+    uint32_t                                 n_free = 0;
+    uint32_t                                 count = 0;   // slots déjà utilisés (haut de pile)
+    uint64_t                                 next_order = 0;
+
+    Ring                 ring;
+    std::atomic<bool>    overflow{false};
+    Intensity            intensity;
+    std::unique_ptr<Timer[]> heap;
+    uint32_t             heap_len = 0;
+    uint64_t             rng;
+    bool                 closed = false;
+    std::atomic<uint32_t> refs{1};   // créateur + retain (boucle, threads enfants)
+
+    std::mutex              mu;
+    std::condition_variable cv;
+    std::atomic<uint32_t>   sleepers{0};
+    std::atomic<uint32_t>   kicked{0};
+
+    // Plan interne (vt_sup_step).
+    std::unique_ptr<uint32_t[]> step_buf;
+    vt_sup_plan                 step{};
+
+    std::atomic<uint64_t> exits{0}, stale{0}, ring_overflows{0};
+    uint64_t restarts = 0, plans = 0, escalations = 0, last_now = 0;
+
+    vt_sup_core(const vt_sup_config& c, size_t ring_cap)
+        : cfg(c),
+          words(new std::atomic<uint64_t>[c.capacity]),
+          policy(new uint8_t[c.capacity]()),
+          backoff(new uint32_t[c.capacity]()),
+          scheduled(new uint8_t[c.capacity]()),
+          fresh(new uint8_t[c.capacity]()),
+          order(new uint64_t[c.capacity]()),
+          reasons(new char[size_t(c.capacity) * REASON_BYTES]()),
+          dirty(new std::atomic<uint64_t>[(c.capacity + 63) / 64]),
+          free_slots(new uint32_t[c.capacity]),
+          ring(ring_cap),
+          intensity(c.max_restarts, c.period_ms),
+          heap(new Timer[c.capacity]),
+          rng(0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(
+                  std::chrono::steady_clock::now().time_since_epoch().count())) {
+        for (uint32_t i = 0; i < c.capacity; ++i) words[i].store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < (c.capacity + 63) / 64; ++i) dirty[i].store(0, std::memory_order_relaxed);
+        step_buf.reset(new uint32_t[size_t(c.capacity) * 3]);
+        step.stop = step_buf.get();
+        step.start = step_buf.get() + c.capacity;
+        step.exited = step_buf.get() + 2 * size_t(c.capacity);
+        step.cap = c.capacity;
+    }
+
+    void wake() {
+        kicked.store(1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // publication ↔ sleepers (Dekker)
+        if (sleepers.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lk(mu);
+            cv.notify_one();
+        }
+    }
+
+    bool pending() const {
+        return !ring.empty() || overflow.load(std::memory_order_acquire) ||
+               kicked.load(std::memory_order_acquire);
+    }
+
+    /* ——— Minuteurs (tas binaire préalloué, un slot au plus une fois) ——— */
+
+    void heap_push(Timer t) {
+        uint32_t i = heap_len++;
+        while (i > 0) {
+            uint32_t p = (i - 1) / 2;
+            if (!before(t, heap[p])) break;
+            heap[i] = heap[p];
+            i = p;
+        }
+        heap[i] = t;
+    }
+
+    Timer heap_pop() {
+        Timer top = heap[0];
+        Timer last = heap[--heap_len];
+        uint32_t i = 0;
+        for (;;) {
+            uint32_t l = 2 * i + 1;
+            if (l >= heap_len) break;
+            uint32_t m = (l + 1 < heap_len && before(heap[l + 1], heap[l])) ? l + 1 : l;
+            if (!before(heap[m], last)) break;
+            heap[i] = heap[m];
+            i = m;
+        }
+        if (heap_len) heap[i] = last;
+        return top;
+    }
+
+    // Retire le minuteur de `slot` (retrait d’enfant, rare) : filtrage puis reconstruction.
+    void heap_erase(uint32_t slot) {
+        if (!scheduled[slot]) return;
+        scheduled[slot] = 0;
+        const uint32_t n = heap_len;
+        heap_len = 0;
+        for (uint32_t i = 0; i < n; ++i)
+            if (heap[i].slot != slot) heap_push(heap[i]);
+    }
+
+    /* ——— Stratégies ——— */
+
+    static bool wants_restart(uint8_t pol, bool abnormal) {
+        return pol == VT_SUP_PERMANENT || (pol == VT_SUP_TRANSIENT && abnormal);
+    }
+
+    uint32_t next_backoff(uint32_t slot) {
+        uint32_t d = backoff[slot] * 2;
+        if (d > cfg.backoff_max_ms) d = cfg.backoff_max_ms;
+        if (d == 0) d = 1;
+        if (cfg.jitter) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            d = static_cast<uint32_t>(rng % (uint64_t(d) + 1));
+        }
+        backoff[slot] = d ? d : 1;
+        return d;
+    }
+
+    void schedule(uint32_t slot, uint64_t now) {
+        if (scheduled[slot] || closed) return;
+        const uint64_t w = words[slot].load(std::memory_order_acquire);
+        if (VT_SUP_WORD_STATE(w) == VT_SUP_CANCELED) return;
+        scheduled[slot] = 1;
+        heap_push(Timer{now + next_backoff(slot), order[slot], slot});
+    }
+
+    // Demande l’arrêt d’un enfant en cours d’exécution (RUNNING → STOPPING).
+    bool request_stop(uint32_t slot, vt_sup_plan* plan) {
+        uint64_t w = words[slot].load(std::memory_order_acquire);
+        while (VT_SUP_WORD_STATE(w) == VT_SUP_RUNNING) {
+            if (words[slot].compare_exchange_weak(w, with_state(w, VT_SUP_STOPPING),
+                                                  std::memory_order_acq_rel)) {
+                plan->stop[plan->n_stop++] = slot;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void escalate(vt_sup_plan* plan) {
+        closed = true;
+        ++escalations;
+        plan->escalate = 1;
+        for (uint32_t s = 0; s < count; ++s) request_stop(s, plan);
+        heap_len = 0;
+        std::memset(scheduled.get(), 0, count);
+    }
+
+    // EXITED → STOPPED ; retourne false si l’événement est périmé / déjà traité.
+    bool take_exit(uint32_t slot, uint32_t gen, bool& abnormal) {
+        uint64_t w = words[slot].load(std::memory_order_acquire);
+        for (;;) {
+            if (VT_SUP_WORD_STATE(w) != VT_SUP_EXITED || VT_SUP_WORD_GEN(w) != gen) return false;
+            if (words[slot].compare_exchange_weak(w, with_state(w, VT_SUP_STOPPED),
+                                                  std::memory_order_acq_rel)) {
+                abnormal = VT_SUP_WORD_ABNORMAL(w) != 0;
+                return true;
+            }
+        }
+    }
+
+    int drain(uint64_t now, vt_sup_plan* plan) {
+        if (!plan || plan->cap < count) return -EINVAL;
+        plan->n_stop = plan->n_start = plan->n_exited = 0;
+        plan->escalate = 0;
+        plan->next_due_ms = 0;
+        kicked.store(0, std::memory_order_relaxed);
+        last_now = now;
+
+        // 1) Sorties en attente : anneau, puis bitmap si débordement.
+        uint64_t trig_min = UINT64_MAX;   // rest_for_one : rang d’ajout du premier enfant fautif
+        uint32_t trig_count = 0;
+        bool trig_abnormal = false;
+
+        auto handle = [&](uint32_t slot, uint32_t gen) {
+            bool abnormal = false;
+            if (slot >= count || !take_exit(slot, gen, abnormal)) return;
+            plan->exited[plan->n_exited++] = slot;
+            if (closed) return;
+            if (cfg.strategy == VT_SUP_ONE_FOR_ONE) {
+                if (!wants_restart(policy[slot], abnormal)) return;
+                if (!intensity.record(now)) { escalate(plan); return; }
+                schedule(slot, now);
+            } else {
+                ++trig_count;
+                trig_abnormal |= abnormal;
+                if (order[slot] < trig_min) trig_min = order[slot];
+            }
+        };
+
+        Event e;
+        while (ring.pop(e)) handle(e.slot, e.gen);
+        if (overflow.exchange(false, std::memory_order_acq_rel)) {
+            for (uint32_t k = 0; k < (count + 63) / 64; ++k) {
+                uint64_t bits = dirty[k].exchange(0, std::memory_order_acq_rel);
+                while (bits) {
+                    const uint32_t slot = k * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+                    bits &= bits - 1;
+                    handle(slot, VT_SUP_WORD_GEN(words[slot].load(std::memory_order_acquire)));
+                }
+            }
+        }
+
+        // 2) one_for_all / rest_for_one : un seul plan pour toutes les pannes du lot.
+        if (trig_count && !closed) {
+            ++plans;
+            // Un plan = un redémarrage du groupe, quel que soit le nombre de pannes agrégées.
+            if (!intensity.record(now)) {
+                escalate(plan);
+            } else {
+                // slots vides : état EMPTY, ni arrêtés ni reprogrammés
+                const uint64_t from = cfg.strategy == VT_SUP_ONE_FOR_ALL ? 0 : trig_min;
+                for (uint32_t s = 0; s < count; ++s)
+                    if (order[s] >= from) request_stop(s, plan);
+                for (uint32_t s = 0; s < count; ++s) {
+                    if (order[s] < from) continue;
+                    const uint32_t st = VT_SUP_WORD_STATE(words[s].load(std::memory_order_acquire));
+                    if ((st == VT_SUP_STOPPED || st == VT_SUP_STOPPING) &&
+                        wants_restart(policy[s], trig_abnormal))
+                        schedule(s, now);
+                }
+            }
+        }
+
+        // 3) Redémarrages échus.
+        while (heap_len && heap[0].due <= now) {
+            const uint32_t slot = heap_pop().slot;
+            scheduled[slot] = 0;
+            const uint32_t st = VT_SUP_WORD_STATE(words[slot].load(std::memory_order_acquire));
+            if (st == VT_SUP_STOPPED || st == VT_SUP_STOPPING) {
+                plan->start[plan->n_start++] = slot;
+                ++restarts;
+            }
+        }
+        plan->next_due_ms = heap_len ? heap[0].due : 0;
+        return 0;
+    }
+};
+
+extern "C" {
+
+VT_API void vt_sup_config_default(vt_sup_config* cfg) {
+    if (!cfg) return;
+    cfg->capacity = 4096;
+    cfg->ring_capacity = 4096;
+    cfg->strategy = VT_SUP_ONE_FOR_ONE;
+    cfg->max_restarts = 3;
+    cfg->period_ms = 10000;
+    cfg->backoff_base_ms = 80;
+    cfg->backoff_max_ms = 5000;
+    cfg->jitter = 1;
+}
+
+VT_API vt_sup_core* vt_sup_core_new(const vt_sup_config* cfg) {
+    vt_sup_config c;
+    vt_sup_config_default(&c);
+    if (cfg) {
+        c = *cfg;
+        if (!c.capacity) c.capacity = 4096;
+        if (!c.ring_capacity) c.ring_capacity = 4096;
+        if (c.strategy > VT_SUP_REST_FOR_ONE) return nullptr;
+    }
+    size_t ring_cap = 2;
+    while (ring_cap < c.ring_capacity) ring_cap <<= 1;
+    return new vt_sup_core(c, ring_cap);
+}
+
+VT_API vt_sup_core* vt_sup_core_new_with(uint32_t capacity, uint32_t strategy, uint32_t max_restarts,
+                                         uint32_t period_ms, uint32_t backoff_base_ms,
+                                         uint32_t backoff_max_ms, uint32_t jitter) {
+    vt_sup_config c;
+    vt_sup_config_default(&c);
+    c.capacity = capacity;
+    c.ring_capacity = capacity;
+    c.strategy = strategy;
+    c.max_restarts = max_restarts;
+    c.period_ms = period_ms;
+    c.backoff_base_ms = backoff_base_ms;
+    c.backoff_max_ms = backoff_max_ms;
+    c.jitter = jitter;
+    return vt_sup_core_new(&c);
+}
+
+VT_API void vt_sup_core_retain(vt_sup_core* c) {
+    if (c) c->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+VT_API void vt_sup_core_release(vt_sup_core* c) {
+    if (c && c->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete c;
+}
+
+VT_API void vt_sup_core_free(vt_sup_core* c) { vt_sup_core_release(c); }
+
+VT_API int64_t vt_sup_child_add(vt_sup_core* c, uint32_t restart) {
+    if (!c || restart > VT_SUP_TEMPORARY) return -EINVAL;
+    uint32_t slot;
+    if (c->n_free) slot = c->free_slots[--c->n_free];
+    else if (c->count < c->cfg.capacity) slot = c->count++;
+    else return -ENOSPC;
+    c->policy[slot] = static_cast<uint8_t>(restart);
+    c->backoff[slot] = c->cfg.backoff_base_ms;
+    c->fresh[slot] = 1;
+    c->order[slot] = c->next_order++;
+    // La génération de l’ancien occupant est conservée : ses signalements restent périmés.
+    const uint32_t gen = VT_SUP_WORD_GEN(c->words[slot].load(std::memory_order_relaxed));
+    c->words[slot].store(make_word(VT_SUP_STOPPED, 0, gen, 0), std::memory_order_release);
+    return slot;
+}
+
+VT_API uint32_t vt_sup_child_started(vt_sup_core* c, uint32_t slot) {
+    if (!c || slot >= c->count) return 0;
+    uint64_t w = c->words[slot].load(std::memory_order_acquire);
+    if (VT_SUP_WORD_STATE(w) == VT_SUP_EMPTY) return 0;
+    // Le premier démarrage après l’ajout ne compte pas comme un redémarrage.
+    const uint32_t bump = c->fresh[slot] ? 0 : 1;
+    c->fresh[slot] = 0;
+    uint64_t nw;
+    do {
+        uint32_t gen = (VT_SUP_WORD_GEN(w) + 1) & 0xFFFFFF;
+        if (gen == 0) gen = 1;   // 0 = jamais démarré
+        nw = make_word(VT_SUP_RUNNING, 0, gen, VT_SUP_WORD_RESTARTS(w) + bump);
+    } while (!c->words[slot].compare_exchange_weak(w, nw, std::memory_order_acq_rel));
+    return VT_SUP_WORD_GEN(nw);
+}
+
+VT_API int vt_sup_child_cancel(vt_sup_core* c, uint32_t slot) {
+    if (!c || slot >= c->count) return 0;
+    uint64_t w = c->words[slot].load(std::memory_order_acquire);
+    do {
+        if (VT_SUP_WORD_STATE(w) == VT_SUP_EMPTY) return 0;
+    } while (!c->words[slot].compare_exchange_weak(w, with_state(w, VT_SUP_CANCELED),
+                                                   std::memory_order_acq_rel));
+    return VT_SUP_WORD_STATE(w) == VT_SUP_RUNNING;
+}
+
+VT_API int vt_sup_child_remove(vt_sup_core* c, uint32_t slot) {
+    if (!c || slot >= c->count) return -EINVAL;
+    uint64_t w = c->words[slot].load(std::memory_order_acquire);
+    uint64_t nw;
+    do {
+        if (VT_SUP_WORD_STATE(w) == VT_SUP_EMPTY) return -EINVAL;
+        nw = make_word(VT_SUP_EMPTY, 0, VT_SUP_WORD_GEN(w), 0);
+    } while (!c->words[slot].compare_exchange_weak(w, nw, std::memory_order_acq_rel));
+    c->heap_erase(slot);
+    c->reasons[size_t(slot) * REASON_BYTES] = '\0';
+    c->free_slots[c->n_free++] = slot;
+    return VT_SUP_WORD_STATE(w) == VT_SUP_RUNNING;
+}
+
+VT_API uint64_t vt_sup_child_word(const vt_sup_core* c, uint32_t slot) {
+    if (!c || slot >= c->count) return 0;
+    return c->words[slot].load(std::memory_order_acquire);
+}
+
+VT_API size_t vt_sup_child_reason(const vt_sup_core* c, uint32_t slot, char* out, size_t cap) {
+    if (!c || slot >= c->count || !out || !cap) return 0;
+    const char* r = &c->reasons[size_t(slot) * REASON_BYTES];
+    size_t n = strnlen(r, REASON_BYTES - 1);
+    if (n >= cap) n = cap - 1;
+    std::memcpy(out, r, n);
+    out[n] = '\0';
+    return n;
+}
+
+VT_API int vt_sup_report_exit(vt_sup_core* c, uint32_t slot, uint32_t gen, int abnormal,
+                              const char* reason) {
+    if (!c || slot >= c->cfg.capacity) return -EINVAL;
+    c->exits.fetch_add(1, std::memory_order_relaxed);
+    uint64_t w = c->words[slot].load(std::memory_order_acquire);
+    if (VT_SUP_WORD_GEN(w) != (gen & 0xFFFFFF)) {
+        c->stale.fetch_add(1, std::memory_order_relaxed);
+        return -ESTALE;
+    }
+    // Raison écrite avant la publication (CAS release) ; un seul writer par génération.
+    if (VT_SUP_WORD_STATE(w) == VT_SUP_RUNNING) {
+        char* dst = &c->reasons[size_t(slot) * REASON_BYTES];
+        size_t n = reason ? strnlen(reason, REASON_BYTES - 1) : 0;
+        if (n) std::memcpy(dst, reason, n);
+        dst[n] = '\0';
+    }
+    for (;;) {
+        const uint32_t st = VT_SUP_WORD_STATE(w);
+        if (VT_SUP_WORD_GEN(w) != (gen & 0xFFFFFF) || st == VT_SUP_CANCELED || st == VT_SUP_EMPTY) {
+            c->stale.fetch_add(1, std::memory_order_relaxed);
+            return -ESTALE;
+        }
+        if (st == VT_SUP_STOPPING) {
+            // Arrêt demandé par le superviseur : sortie attendue, rien à planifier.
+            if (c->words[slot].compare_exchange_weak(w, with_state(w, VT_SUP_STOPPED),
+                                                     std::memory_order_acq_rel))
+                return 0;
+            continue;
+        }
+        if (st != VT_SUP_RUNNING) return 0;   // déjà signalé
+        const uint64_t nw = make_word(VT_SUP_EXITED, abnormal ? 1 : 0, VT_SUP_WORD_GEN(w),
+                                      VT_SUP_WORD_RESTARTS(w));
+        if (c->words[slot].compare_exchange_weak(w, nw, std::memory_order_acq_rel)) break;
+    }
+    if (!c->ring.push(Event{slot, gen & 0xFFFFFF})) {
+        c->dirty[slot / 64].fetch_or(uint64_t(1) << (slot % 64), std::memory_order_acq_rel);
+        c->overflow.store(true, std::memory_order_release);
+        c->ring_overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+    c->wake();
+    return 0;
+}
+
+VT_API void vt_sup_kick(vt_sup_core* c) {
+    if (c) c->wake();
+}
+
+VT_API int vt_sup_wait(vt_sup_core* c, uint32_t timeout_ms) {
+    if (!c) return 0;
+    if (c->pending()) return 1;
+    c->sleepers.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lk(c->mu);
+        c->cv.wait_for(lk, std::chrono::milliseconds(timeout_ms), [c] { return c->pending(); });
+    }
+    c->sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    return c->pending() ? 1 : 0;
+}
+
+VT_API int vt_sup_drain(vt_sup_core* c, uint64_t now_ms, vt_sup_plan* plan) {
+    if (!c) return -EINVAL;
+    return c->drain(now_ms, plan);
+}
+
+VT_API void vt_sup_get_stats(const vt_sup_core* c, vt_sup_stats* out) {
+    if (!c || !out) return;
+    out->exits = c->exits.load(std::memory_order_relaxed);
+    out->stale = c->stale.load(std::memory_order_relaxed);
+    out->restarts = c->restarts;
+    out->plans = c->plans;
+    out->ring_overflows = c->ring_overflows.load(std::memory_order_relaxed);
+    out->escalations = c->escalations;
+    out->window_restarts = c->intensity.in_window(c->last_now);
+    out->children = c->count - c->n_free;
+}
+
+VT_API int vt_sup_step(vt_sup_core* c, uint64_t now_ms) {
+    if (!c) return -EINVAL;
+    int rc = c->drain(now_ms, &c->step);
+    return rc < 0 ? rc : static_cast<int>(c->step.escalate);
+}
+
+VT_API uint32_t vt_sup_step_len(const vt_sup_core* c, uint32_t list) {
+    if (!c) return 0;
+    switch (list) {
+        case VT_SUP_LIST_STOP:   return c->step.n_stop;
+        case VT_SUP_LIST_START:  return c->step.n_start;
+        case VT_SUP_LIST_EXITED: return c->step.n_exited;
+        default:                 return 0;
+    }
+}
+
+VT_API uint32_t vt_sup_step_at(const vt_sup_core* c, uint32_t list, uint32_t i) {
+    if (!c || i >= vt_sup_step_len(c, list)) return UINT32_MAX;
+    const uint32_t* v = list == VT_SUP_LIST_STOP ? c->step.stop
+                      : list == VT_SUP_LIST_START ? c->step.start : c->step.exited;
+    return v[i];
+}
+
+VT_API uint64_t vt_sup_step_next_due(const vt_sup_core* c) {
+    return c ? c->step.next_due_ms : 0;
+}
+
+VT_API const char* vt_sup_child_reason_cstr(const vt_sup_core* c, uint32_t slot) {
+    if (!c || slot >= c->count) return "";
+    return &c->reasons[size_t(slot) * REASON_BYTES];
+}
+
+} // extern "C"
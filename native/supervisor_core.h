@@ -0,0 +1,170 @@
+// native/supervisor_core.h
+// Noyau de supervision sans verrou pour `modules/supervisor.vitte` : un mot d’état atomique
+// par enfant, un anneau MPSC d’événements de sortie, une intensité de redémarrage à fenêtre
+// glissante sans allocation, et des plans de redémarrage calculés par lots.
+//
+// API C exposée (ABI stable pour FFI):
+//   void         vt_sup_config_default(vt_sup_config* cfg);
+//   vt_sup_core* vt_sup_core_new(const vt_sup_config* cfg);
+//   vt_sup_core* vt_sup_core_new_with(uint32_t capacity, uint32_t strategy, uint32_t max_restarts,
+//                                     uint32_t period_ms, uint32_t backoff_base_ms,
+//                                     uint32_t backoff_max_ms, uint32_t jitter);
+//   void         vt_sup_core_free(vt_sup_core* c);
+//   void         vt_sup_core_retain(vt_sup_core* c);
+//   void         vt_sup_core_release(vt_sup_core* c);
+//   int64_t      vt_sup_child_add(vt_sup_core* c, uint32_t restart);
+//   uint32_t     vt_sup_child_started(vt_sup_core* c, uint32_t slot);
+//   int          vt_sup_child_cancel(vt_sup_core* c, uint32_t slot);
+//   int          vt_sup_child_remove(vt_sup_core* c, uint32_t slot);
+//   uint64_t     vt_sup_child_word(const vt_sup_core* c, uint32_t slot);
+//   size_t       vt_sup_child_reason(const vt_sup_core* c, uint32_t slot, char* out, size_t cap);
+//   int          vt_sup_report_exit(vt_sup_core* c, uint32_t slot, uint32_t gen,
+//                                   int abnormal, const char* reason);
+//   void         vt_sup_kick(vt_sup_core* c);
+//   int          vt_sup_wait(vt_sup_core* c, uint32_t timeout_ms);
+//   int          vt_sup_drain(vt_sup_core* c, uint64_t now_ms, vt_sup_plan* plan);
+//   void         vt_sup_get_stats(const vt_sup_core* c, vt_sup_stats* out);
+//
+//   // Variante « scalaires seulement » pour le FFI Vitte (plan interne au noyau) :
+//   int          vt_sup_step(vt_sup_core* c, uint64_t now_ms);
+//   uint32_t     vt_sup_step_len(const vt_sup_core* c, uint32_t list);
+//   uint32_t     vt_sup_step_at(const vt_sup_core* c, uint32_t list, uint32_t i);
+//   uint64_t     vt_sup_step_next_due(const vt_sup_core* c);
+//   const char*  vt_sup_child_reason_cstr(const vt_sup_core* c, uint32_t slot);
+//
+// Threads :
+// - vt_sup_report_exit() est appelé par les workers (n’importe quel thread) : un CAS sur le
+//   mot d’état + un push dans l’anneau. Si l’anneau est plein, l’enfant est marqué dans un
+//   bitmap « sale » que le superviseur balaie : aucun événement n’est perdu.
+// - Tout le reste (add/started/cancel/remove/wait/drain) appartient au thread superviseur.
+// - Durée de vie : compteur de références atomique (1 à la création). Chaque thread qui
+//   garde le handle (boucle, worker qui signalera sa sortie) prend une référence avant
+//   d’être lancé et la rend en dernier ; le noyau est libéré au dernier release. Un worker
+//   qui ignore la demande d’arrêt et sort après la fermeture du superviseur reste valide.
+//
+// Plan de redémarrage (vt_sup_drain) :
+// - Toutes les sorties en attente sont traitées en une passe ; en one_for_all / rest_for_one,
+//   plusieurs pannes simultanées produisent UN seul plan (arrêts puis redémarrages).
+// - L’intensité compte un redémarrage par enfant en one_for_one, un par plan de groupe
+//   sinon ; dépassement ⇒ `escalate` = 1 et plan = « tout arrêter ».
+// - Les redémarrages sont différés (backoff exponentiel + jitter) dans un tas de minuteurs
+//   préalloué : `start` ne contient que les enfants échus, par échéance puis ordre d’ajout ;
+//   `next_due_ms` donne le réveil.
+// - « Ordre d’ajout » = rang attribué par vt_sup_child_add, pas l’index du slot : un slot
+//   libéré par vt_sup_child_remove est réutilisé par l’ajout suivant.
+
+#ifndef VITTE_NATIVE_SUPERVISOR_CORE_H
+#define VITTE_NATIVE_SUPERVISOR_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum { VT_SUP_ONE_FOR_ONE = 0, VT_SUP_ONE_FOR_ALL = 1, VT_SUP_REST_FOR_ONE = 2 };
+enum { VT_SUP_PERMANENT = 0, VT_SUP_TRANSIENT = 1, VT_SUP_TEMPORARY = 2 };
+
+// États (bits 0..3 du mot d’état).
+enum {
+    VT_SUP_EMPTY    = 0,   // slot libre
+    VT_SUP_RUNNING  = 1,
+    VT_SUP_EXITED   = 2,   // sortie signalée, pas encore traitée par vt_sup_drain
+    VT_SUP_STOPPING = 3,   // arrêt demandé par le superviseur (stratégie / escalade)
+    VT_SUP_STOPPED  = 4,   // à l’arrêt (redémarrage éventuellement programmé)
+    VT_SUP_CANCELED = 5,   // retiré (stop_child / shutdown) : jamais redémarré
+};
+
+// Mot d’état : état | anormal<<4 | génération(24 bits)<<8 | redémarrages(32 bits)<<32.
+#define VT_SUP_WORD_STATE(w)    ((uint32_t)((w) & 0xFu))
+#define VT_SUP_WORD_ABNORMAL(w) ((uint32_t)(((w) >> 4) & 1u))
+#define VT_SUP_WORD_GEN(w)      ((uint32_t)(((w) >> 8) & 0xFFFFFFu))
+#define VT_SUP_WORD_RESTARTS(w) ((uint32_t)((w) >> 32))
+
+typedef struct vt_sup_config {
+    uint32_t capacity;          // enfants max (0 = 4096)
+    uint32_t ring_capacity;     // événements en vol (0 = 4096, arrondi à 2^k)
+    uint32_t strategy;          // VT_SUP_ONE_FOR_*
+    uint32_t max_restarts;      // intensité : redémarrages…
+    uint32_t period_ms;         // …par fenêtre glissante
+    uint32_t backoff_base_ms;
+    uint32_t backoff_max_ms;
+    uint32_t jitter;            // 1 = jitter « full » sur le backoff
+} vt_sup_config;
+
+// Tableaux fournis par l’appelant, chacun de `cap` ≥ capacity entrées.
+typedef struct vt_sup_plan {
+    uint32_t* stop;     uint32_t n_stop;     // enfants à qui envoyer la demande d’arrêt
+    uint32_t* start;    uint32_t n_start;    // enfants à (re)lancer maintenant
+    uint32_t* exited;   uint32_t n_exited;   // sorties traitées (raison lisible)
+    uint32_t  cap;
+    uint32_t  escalate;                      // 1 = intensité dépassée : tout arrêter
+    uint64_t  next_due_ms;                   // prochain redémarrage programmé (0 = aucun)
+} vt_sup_plan;
+
+typedef struct vt_sup_stats {
+    uint64_t exits;             // sorties signalées
+    uint64_t stale;             // signalements d’une génération périmée
+    uint64_t restarts;          // enfants relancés
+    uint64_t plans;             // plans one_for_all / rest_for_one
+    uint64_t ring_overflows;    // sorties passées par le bitmap
+    uint64_t escalations;
+    uint32_t window_restarts;   // redémarrages dans la fenêtre courante
+    uint32_t children;          // slots occupés
+} vt_sup_stats;
+
+typedef struct vt_sup_core vt_sup_core;
+
+VT_API void         vt_sup_config_default(vt_sup_config* cfg);
+VT_API vt_sup_core* vt_sup_core_new(const vt_sup_config* cfg);
+// Variante scalaire (FFI Vitte) ; ring_capacity = capacity.
+VT_API vt_sup_core* vt_sup_core_new_with(uint32_t capacity, uint32_t strategy, uint32_t max_restarts,
+                                         uint32_t period_ms, uint32_t backoff_base_ms,
+                                         uint32_t backoff_max_ms, uint32_t jitter);
+// Rend la référence du créateur (= vt_sup_core_release).
+VT_API void         vt_sup_core_free(vt_sup_core* c);
+VT_API void         vt_sup_core_retain(vt_sup_core* c);
+// Rend une référence ; la dernière libère le noyau.
+VT_API void         vt_sup_core_release(vt_sup_core* c);
+
+// Enregistre un enfant (rang = ordre d’ajout), dans un slot libéré s’il y en a. Retourne son
+// slot, ou -ENOSPC si `capacity` enfants sont enregistrés.
+VT_API int64_t      vt_sup_child_add(vt_sup_core* c, uint32_t restart);
+// Passe l’enfant à RUNNING avec une nouvelle génération (à transmettre au worker).
+VT_API uint32_t     vt_sup_child_started(vt_sup_core* c, uint32_t slot);
+// Retire l’enfant (plus de redémarrage). Retourne 1 s’il tournait, 0 sinon.
+VT_API int          vt_sup_child_cancel(vt_sup_core* c, uint32_t slot);
+// Annule l’enfant et rend son slot (minuteur éventuel supprimé). Retourne 1 s’il tournait,
+// 0 sinon, -EINVAL si le slot est libre. Une sortie signalée ensuite est périmée.
+VT_API int          vt_sup_child_remove(vt_sup_core* c, uint32_t slot);
+VT_API uint64_t     vt_sup_child_word(const vt_sup_core* c, uint32_t slot);
+// Copie la dernière raison de sortie (tronquée, terminée par NUL). Retourne sa longueur.
+VT_API size_t       vt_sup_child_reason(const vt_sup_core* c, uint32_t slot, char* out, size_t cap);
+
+// Worker : signale la sortie de la génération `gen`. Retourne 0, ou -ESTALE si l’enfant a
+// été relancé / retiré entre-temps.
+VT_API int          vt_sup_report_exit(vt_sup_core* c, uint32_t slot, uint32_t gen,
+                                       int abnormal, const char* reason);
+
+// Réveille vt_sup_wait (ex. commande de contrôle postée par un autre thread).
+VT_API void         vt_sup_kick(vt_sup_core* c);
+// Attend un événement ou `timeout_ms`. Retourne 1 si du travail est en attente.
+VT_API int          vt_sup_wait(vt_sup_core* c, uint32_t timeout_ms);
+// Traite les sorties en attente et les minuteurs échus. Retourne 0 ou -EINVAL (plan trop petit).
+VT_API int          vt_sup_drain(vt_sup_core* c, uint64_t now_ms, vt_sup_plan* plan);
+VT_API void         vt_sup_get_stats(const vt_sup_core* c, vt_sup_stats* out);
+
+enum { VT_SUP_LIST_STOP = 0, VT_SUP_LIST_START = 1, VT_SUP_LIST_EXITED = 2 };
+
+// vt_sup_drain() dans un plan interne. Retourne 1 si escalade, 0 sinon.
+VT_API int          vt_sup_step(vt_sup_core* c, uint64_t now_ms);
+VT_API uint32_t     vt_sup_step_len(const vt_sup_core* c, uint32_t list);
+VT_API uint32_t     vt_sup_step_at(const vt_sup_core* c, uint32_t list, uint32_t i);
+VT_API uint64_t     vt_sup_step_next_due(const vt_sup_core* c);
+// Raison de sortie en place (valide jusqu’à la prochaine sortie de cet enfant).
+VT_API const char*  vt_sup_child_reason_cstr(const vt_sup_core* c, uint32_t slot);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_SUPERVISOR_CORE_H
@@ -0,0 +1,170 @@
+// native/uring.hpp
+// Enveloppe io_uring minimale (appels système bruts, sans liburing).
+//
+// Usage :
+//   vt::Uring ring;
+//   if (!ring.init(256)) { /* repli epoll */ }
+//   io_uring_sqe* sqe = ring.sqe();   // soumet automatiquement si la SQ est pleine
+//   sqe->opcode = IORING_OP_RECV; …
+//   ring.submit_and_wait(1);
+//   ring.for_each_cqe([](const io_uring_cqe& c) { … });
+//
+// Remarques :
+// - init() échoue proprement (false) si le noyau ou le seccomp refuse io_uring :
+//   l’appelant bascule alors sur son chemin epoll/bloquant.
+// - Un anneau appartient à UN thread (pas de verrou).
+
+#ifndef VITTE_NATIVE_URING_HPP
+#define VITTE_NATIVE_URING_HPP
+
+#if defined(__linux__)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+namespace vt {
+
+class Uring {
+public:
+    Uring() = default;
+    Uring(const Uring&) = delete;
+    Uring& operator=(const Uring&) = delete;
+    ~Uring() { close(); }
+
+    bool init(unsigned entries) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+        if (fd < 0) return false;
+        fd_ = fd;
+
+        sq_sz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_sz_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            if (cq_sz_ > sq_sz_) sq_sz_ = cq_sz_;
+            cq_sz_ = sq_sz_;
+        }
+        sq_ptr_ = ::mmap(nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; close(); return false; }
+        if (single) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = ::mmap(nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             fd_, IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; close(); return false; }
+        }
+        sqes_sz_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { close(); return false; }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(sq_ptr_);
+        sq_head_  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sq_tail_  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_  = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        sq_entries_ = p.sq_entries;
+
+        char* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    bool ok() const { return fd_ >= 0; }
+
+    // Réserve une SQE remise à zéro. Soumet d’abord si la file est pleine.
+    io_uring_sqe* sqe() {
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (local_tail_ - head >= sq_entries_) {
+            submit_and_wait(0);
+            head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+            if (local_tail_ - head >= sq_entries_) return nullptr;
+        }
+        unsigned idx = local_tail_ & sq_mask_;
+        io_uring_sqe* s = &sqes_[idx];
+        std::memset(s, 0, sizeof(*s));
+        sq_array_[idx] = idx;
+        ++local_tail_;
+        ++pending_;
+        return s;
+    }
+
+    // Publie les SQE préparées et attend `wait_nr` complétions. Retourne -errno en cas d’échec.
+    int submit_and_wait(unsigned wait_nr) {
+        __atomic_store_n(sq_tail_, local_tail_, __ATOMIC_RELEASE);
+        unsigned flags = wait_nr ? IORING_ENTER_GETEVENTS : 0u;
+        for (;;) {
+            long r = ::syscall(__NR_io_uring_enter, fd_, pending_, wait_nr, flags, nullptr, 0);
+            if (r >= 0) {
+                pending_ -= static_cast<unsigned>(r) <= pending_ ? static_cast<unsigned>(r) : pending_;
+                return static_cast<int>(r);
+            }
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+    }
+
+    // Consomme toutes les CQE disponibles. `fn(const io_uring_cqe&)`.
+    template <class Fn>
+    unsigned for_each_cqe(Fn&& fn) {
+        unsigned head = *cq_head_;
+        unsigned n = 0;
+        for (;;) {
+            unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            if (head == tail) break;
+            // Copie : le callback peut soumettre de nouvelles SQE.
+            io_uring_cqe c = cqes_[head & cq_mask_];
+            ++head;
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+            fn(c);
+            ++n;
+        }
+        return n;
+    }
+
+    void close() {
+        if (sqes_) { ::munmap(sqes_, sqes_sz_); sqes_ = nullptr; }
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_sz_);
+        cq_ptr_ = nullptr;
+        if (sq_ptr_) { ::munmap(sq_ptr_, sq_sz_); sq_ptr_ = nullptr; }
+        if (fd_ >= 0) { ::close(fd_); fd_ = -1; }
+    }
+
+private:
+    int fd_ = -1;
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_sz_ = 0, cq_sz_ = 0, sqes_sz_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned  sq_mask_ = 0;
+    unsigned  sq_entries_ = 0;
+    unsigned  local_tail_ = 0;
+    unsigned  pending_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned  cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+} // namespace vt
+
+#endif // __linux__
+
+#endif // VITTE_NATIVE_URING_HPP
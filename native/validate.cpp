@@ -0,0 +1,444 @@
+// native/validate.cpp
+// Validateurs vectorisés (cf. validate.h pour l’API C).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -mavx2 -fPIC -c native/validate.cpp -o build/validate.o
+//   g++ -std=c++20 -O2 -mssse3 -fPIC -c native/validate.cpp -o build/validate.o   # SSE
+//
+// Remarques :
+// - Classes d’octets : un octet b appartient aux classes LO[b & 15] & HI[b >> 4] ; chaque
+//   bit de classe est un produit (lignes × colonnes) de la table ASCII, d’où deux bits pour
+//   A-Z et a-z. Deux pshufb + un AND classent 32 (AVX2) ou 16 (SSSE3) octets à la fois.
+// - Chemins AVX2 / SSSE3 choisis à la compilation, repli scalaire sur les mêmes tables.
+// - Email : automate à 7 états sur 6 classes d’octets, une transition par octet, longueurs
+//   vérifiées au vol ; pas de découpage ni de copie.
+// - Glob : le motif est découpé une fois sur `*` ; le premier et le dernier morceau sont
+//   ancrés, les autres cherchés de gauche à droite (placement au plus tôt, optimal pour
+//   `*`/`?`), via memmem quand le morceau n’a ni `?` ni repli de casse.
+
+#include "validate.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace vt_val {
+
+// Bits internes (cf. VT_VAL_* : A-Z = bits 1|2, a-z = bits 3|4).
+//   bit0 chiffres     ligne 3, colonnes 0-9
+//   bit1 A-O          ligne 4, colonnes 1-F      bit2 P-Z   ligne 5, colonnes 0-A
+//   bit3 a-o          ligne 6, colonnes 1-F      bit4 p-z   ligne 7, colonnes 0-A
+//   bit5 '-'          ligne 2, colonne D
+//   bit6 '%' '+' '.'  ligne 2, colonnes 5, B, E
+//   bit7 '_'          ligne 5, colonne F
+struct Luts {
+    alignas(32) uint8_t lo[32];
+    alignas(32) uint8_t hi[32];
+};
+
+constexpr Luts make_luts() {
+    Luts t{};
+    for (int c = 0; c < 16; ++c) {
+        uint8_t m = 0;
+        if (c <= 9) m |= 0x01;
+        if (c >= 1) m |= 0x02 | 0x08;
+        if (c <= 0xA) m |= 0x04 | 0x10;
+        if (c == 0xD) m |= 0x20;
+        if (c == 0x5 || c == 0xB || c == 0xE) m |= 0x40;
+        if (c == 0xF) m |= 0x80;
+        t.lo[c] = t.lo[c + 16] = m;
+    }
+    const uint8_t rows[8] = {0, 0, 0x60, 0x01, 0x02, 0x04 | 0x80, 0x08, 0x10};
+    for (int r = 0; r < 8; ++r) t.hi[r] = t.hi[r + 16] = rows[r];
+    return t;
+}
+
+alignas(32) constexpr Luts LUT = make_luts();
+
+static inline uint8_t cls(uint8_t b) { return LUT.lo[b & 15] & LUT.hi[b >> 4]; }
+
+static inline size_t class_span_scalar(const uint8_t* p, size_t i, size_t n, uint8_t mask) {
+    for (; i < n; ++i)
+        if (!(cls(p[i]) & mask)) return i;
+    return n;
+}
+
+static inline uint32_t ctz32(uint32_t x) { return static_cast<uint32_t>(__builtin_ctz(x)); }
+
+static inline bool is_hex(uint8_t b) {
+    return static_cast<uint8_t>(b - '0') < 10 || static_cast<uint8_t>((b | 0x20) - 'a') < 6;
+}
+
+// Masques « hexa » et « tiret » des 32 premiers octets de p (bit i = octet i).
+static inline void hex_dash_masks32(const uint8_t* p, uint32_t* hex, uint32_t* dash) {
+#if defined(__AVX2__)
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    const __m256i a = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i dig = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const __m256i af = _mm256_cmpeq_epi8(_mm256_min_epu8(a, _mm256_set1_epi8(5)), a);
+    *hex = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(dig, af)));
+    *dash = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('-'))));
+#elif defined(__SSSE3__)
+    uint32_t h = 0, m = 0;
+    for (int k = 0; k < 2; ++k) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+        const __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+        const __m128i a = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i dig = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+        const __m128i af = _mm_cmpeq_epi8(_mm_min_epu8(a, _mm_set1_epi8(5)), a);
+        h |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(dig, af))) << (16 * k);
+        m |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')))) << (16 * k);
+    }
+    *hex = h;
+    *dash = m;
+#else
+    uint32_t h = 0, m = 0;
+    for (int i = 0; i < 32; ++i) {
+        if (is_hex(p[i])) h |= 1u << i;
+        if (p[i] == '-') m |= 1u << i;
+    }
+    *hex = h;
+    *dash = m;
+#endif
+}
+
+static inline int hex_val(uint8_t b) {
+    return b <= '9' ? b - '0' : (b | 0x20) - 'a' + 10;
+}
+
+// Version (quartet) et variante (2 bits de poids fort du quartet suivant) comme uuid::parse.
+static inline bool uuid_fields_ok(uint8_t ver_ch, uint8_t var_ch) {
+    const int ver = hex_val(ver_ch);
+    return ver != 0 && ver != 2 && ver <= 8 && (hex_val(var_ch) & 0xC) == 0x8;
+}
+
+// --- Email : automate -------------------------------------------------------------------
+
+enum : uint8_t { C_OTHER, C_ALNUM, C_DOT, C_DASH, C_EXTRA, C_AT, C_COUNT };
+enum : uint8_t { L_START, L_CHAR, L_DOT, D_START, D_ALNUM, D_DASH, FAIL, S_COUNT };
+
+struct EmailDfa {
+    uint8_t cls[256];
+    uint8_t next[S_COUNT][C_COUNT];
+};
+
+constexpr EmailDfa make_email_dfa() {
+    EmailDfa d{};
+    for (int b = 0; b < 256; ++b) {
+        const bool alnum = (b >= '0' && b <= '9') || (b >= 'A' && b <= 'Z') || (b >= 'a' && b <= 'z');
+        d.cls[b] = alnum ? C_ALNUM : b == '.' ? C_DOT : b == '-' ? C_DASH
+                 : (b == '_' || b == '%' || b == '+') ? C_EXTRA : b == '@' ? C_AT : C_OTHER;
+    }
+    for (int s = 0; s < S_COUNT; ++s)
+        for (int c = 0; c < C_COUNT; ++c) d.next[s][c] = FAIL;
+    // partie locale : [A-Za-z0-9._%+-], ni début ni fin par '.', pas de ".."
+    for (uint8_t c : {C_ALNUM, C_DASH, C_EXTRA}) {
+        d.next[L_START][c] = L_CHAR;
+        d.next[L_CHAR][c] = L_CHAR;
+        d.next[L_DOT][c] = L_CHAR;
+    }
+    d.next[L_CHAR][C_DOT] = L_DOT;
+    d.next[L_CHAR][C_AT] = D_START;
+    // domaine : labels [a-z0-9-] (casse indifférente), ni début ni fin par '-'
+    d.next[D_START][C_ALNUM] = D_ALNUM;
+    d.next[D_ALNUM][C_ALNUM] = D_ALNUM;
+    d.next[D_ALNUM][C_DASH] = D_DASH;
+    d.next[D_ALNUM][C_DOT] = D_START;
+    d.next[D_DASH][C_ALNUM] = D_ALNUM;
+    d.next[D_DASH][C_DASH] = D_DASH;
+    return d;
+}
+
+constexpr EmailDfa EMAIL = make_email_dfa();
+
+// --- Glob ---------------------------------------------------------------------------------
+
+struct Seg {
+    uint32_t off;
+    uint32_t len;
+    bool wild;      // contient '?'
+};
+
+} // namespace vt_val
+
+struct vt_glob {
+    std::string pat;                 // motif (replié en minuscules si ci)
+    std::vector<vt_val::Seg> segs;   // morceaux entre les '*'
+    bool star = false;               // au moins un '*'
+    bool ci = false;
+    size_t min_len = 0;              // somme des longueurs des morceaux
+};
+
+namespace vt_val {
+
+static inline uint8_t fold(uint8_t b) { return static_cast<uint8_t>(b - 'A') < 26 ? b | 0x20 : b; }
+
+static inline bool seg_eq(const vt_glob* g, const Seg& sg, const uint8_t* s) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(g->pat.data()) + sg.off;
+    if (!sg.wild && !g->ci) return std::memcmp(p, s, sg.len) == 0;
+    for (uint32_t k = 0; k < sg.len; ++k) {
+        const uint8_t c = g->ci ? fold(s[k]) : s[k];
+        if (p[k] != '?' && p[k] != c) return false;
+    }
+    return true;
+}
+
+// Premier placement de `sg` dans s[from, to) ; -1 si absent.
+static inline long seg_find(const vt_glob* g, const Seg& sg, const uint8_t* s, size_t from, size_t to) {
+    if (to < from || to - from < sg.len) return -1;
+    if (!sg.wild && !g->ci) {
+        const void* hit = memmem(s + from, to - from, g->pat.data() + sg.off, sg.len);
+        return hit ? static_cast<const uint8_t*>(hit) - s : -1;
+    }
+    for (size_t i = from; i + sg.len <= to; ++i)
+        if (seg_eq(g, sg, s + i)) return static_cast<long>(i);
+    return -1;
+}
+
+static bool glob_match(const vt_glob* g, const uint8_t* s, size_t n) {
+    if (n < g->min_len) return false;
+    if (!g->star) return n == g->segs[0].len && seg_eq(g, g->segs[0], s);
+    const Seg& head = g->segs.front();
+    const Seg& tail = g->segs.back();
+    if (!seg_eq(g, head, s) || !seg_eq(g, tail, s + n - tail.len)) return false;
+    size_t pos = head.len;
+    const size_t end = n - tail.len;
+    for (size_t k = 1; k + 1 < g->segs.size(); ++k) {
+        const Seg& sg = g->segs[k];
+        if (!sg.len) continue;
+        const long at = seg_find(g, sg, s, pos, end);
+        if (at < 0) return false;
+        pos = static_cast<size_t>(at) + sg.len;
+    }
+    return true;
+}
+
+static bool slug(const uint8_t* s, size_t n);
+static int email(const uint8_t* s, size_t n);
+static int uuid(const uint8_t* s, size_t n);
+
+} // namespace vt_val
+
+VT_EXTERN_C_BEGIN
+
+VT_API size_t vt_val_ascii_span(const char* s, size_t n) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(s);
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+        const uint32_t m = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i))));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#elif defined(__SSSE3__)
+    for (; i + 16 <= n; i += 16) {
+        const uint32_t m = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#endif
+    for (; i < n; ++i)
+        if (p[i] & 0x80) return i;
+    return n;
+}
+
+VT_API size_t vt_val_printable_span(const char* s, size_t n) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(s);
+    size_t i = 0;
+    // En signé, les octets ≥ 0x80 sont négatifs : « < 0x20 » les refuse aussi.
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v),
+                                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F)));
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(bad));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#elif defined(__SSSE3__)
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i bad = _mm_or_si128(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20)),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+        const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(bad));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#endif
+    for (; i < n; ++i)
+        if (p[i] < 0x20 || p[i] > 0x7E) return i;
+    return n;
+}
+
+VT_API size_t vt_val_class_span(const char* s, size_t n, uint32_t mask) {
+    using vt_val::LUT;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(s);
+    const uint8_t m8 = static_cast<uint8_t>(mask);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(LUT.lo));
+    const __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(LUT.hi));
+    const __m256i nib = _mm256_set1_epi8(0x0F);
+    const __m256i want = _mm256_set1_epi8(static_cast<char>(m8));
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i c = _mm256_and_si256(
+            _mm256_shuffle_epi8(lo, _mm256_and_si256(v, nib)),
+            _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(v, 4), nib)));
+        const __m256i miss = _mm256_cmpeq_epi8(_mm256_and_si256(c, want), _mm256_setzero_si256());
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(miss));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#elif defined(__SSSE3__)
+    const __m128i lo = _mm_load_si128(reinterpret_cast<const __m128i*>(LUT.lo));
+    const __m128i hi = _mm_load_si128(reinterpret_cast<const __m128i*>(LUT.hi));
+    const __m128i nib = _mm_set1_epi8(0x0F);
+    const __m128i want = _mm_set1_epi8(static_cast<char>(m8));
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i c = _mm_and_si128(
+            _mm_shuffle_epi8(lo, _mm_and_si128(v, nib)),
+            _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v, 4), nib)));
+        const __m128i miss = _mm_cmpeq_epi8(_mm_and_si128(c, want), _mm_setzero_si128());
+        const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(miss));
+        if (m) return i + vt_val::ctz32(m);
+    }
+#endif
+    return vt_val::class_span_scalar(p, i, n, m8);
+}
+
+VT_API int vt_val_slug(const char* s, size_t n) {
+    return vt_val::slug(reinterpret_cast<const uint8_t*>(s), n) ? 1 : 0;
+}
+
+VT_API int vt_val_email(const char* s, size_t n) {
+    return vt_val::email(reinterpret_cast<const uint8_t*>(s), n);
+}
+
+VT_API int vt_val_uuid(const char* s, size_t n) {
+    return vt_val::uuid(reinterpret_cast<const uint8_t*>(s), n);
+}
+
+VT_API vt_glob* vt_val_glob_compile(const char* pat, size_t n, int case_insensitive) {
+    vt_glob* g = new (std::nothrow) vt_glob;
+    if (!g) return nullptr;
+    g->ci = case_insensitive != 0;
+    g->pat.assign(pat, n);
+    if (g->ci)
+        for (char& ch : g->pat) ch = static_cast<char>(vt_val::fold(static_cast<uint8_t>(ch)));
+    vt_val::Seg cur{0, 0, false};
+    for (size_t i = 0; i < n; ++i) {
+        if (g->pat[i] == '*') {
+            g->star = true;
+            g->segs.push_back(cur);
+            g->min_len += cur.len;
+            cur = vt_val::Seg{static_cast<uint32_t>(i + 1), 0, false};
+        } else {
+            cur.len++;
+            if (g->pat[i] == '?') cur.wild = true;
+        }
+    }
+    g->segs.push_back(cur);
+    g->min_len += cur.len;
+    return g;
+}
+
+VT_API void vt_val_glob_free(vt_glob* g) { delete g; }
+
+VT_API int vt_val_glob_match(const vt_glob* g, const char* s, size_t n) {
+    if (!g) return 0;
+    return vt_val::glob_match(g, reinterpret_cast<const uint8_t*>(s), n) ? 1 : 0;
+}
+
+VT_API uint64_t vt_val_column(uint32_t kind, const vt_glob* g, const char* data,
+                              const uint32_t* offsets, size_t count, uint64_t* out_bits) {
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(data);
+    uint64_t valid = 0;
+    for (size_t w = 0; w * 64 < count; ++w) {
+        uint64_t bits = 0;
+        const size_t lim = count - w * 64 < 64 ? count - w * 64 : 64;
+        for (size_t k = 0; k < lim; ++k) {
+            const size_t i = w * 64 + k;
+            const char* v = data + offsets[i];
+            const size_t n = offsets[i + 1] - offsets[i];
+            bool ok;
+            switch (kind) {
+            case VT_VAL_K_NON_EMPTY: ok = n > 0; break;
+            case VT_VAL_K_ASCII:     ok = vt_val_ascii_span(v, n) == n; break;
+            case VT_VAL_K_PRINTABLE: ok = vt_val_printable_span(v, n) == n; break;
+            case VT_VAL_K_ALNUM:     ok = n > 0 && vt_val_class_span(v, n, VT_VAL_ALNUM) == n; break;
+            case VT_VAL_K_SLUG:      ok = vt_val::slug(base + offsets[i], n); break;
+            case VT_VAL_K_EMAIL:     ok = vt_val::email(base + offsets[i], n) == VT_VAL_OK; break;
+            case VT_VAL_K_UUID:      ok = vt_val::uuid(base + offsets[i], n) == 1; break;
+            case VT_VAL_K_GLOB:      ok = g && vt_val::glob_match(g, base + offsets[i], n); break;
+            default:                 ok = false; break;
+            }
+            bits |= static_cast<uint64_t>(ok) << k;
+        }
+        out_bits[w] = bits;
+        valid += static_cast<uint64_t>(__builtin_popcountll(bits));
+    }
+    return valid;
+}
+
+VT_EXTERN_C_END
+
+namespace vt_val {
+
+// [a-z0-9]+(-[a-z0-9]+)* : classe vectorisée, puis seuls les tirets sont inspectés.
+static bool slug(const uint8_t* s, size_t n) {
+    if (!n || s[0] == '-' || s[n - 1] == '-') return false;
+    const char* c = reinterpret_cast<const char*>(s);
+    if (vt_val_class_span(c, n, VT_VAL_DIGIT | VT_VAL_LOWER | VT_VAL_DASH) != n) return false;
+    return memmem(c, n, "--", 2) == nullptr;
+}
+
+static int email(const uint8_t* s, size_t n) {
+    if (!n) return VT_VAL_E_REQUIRED;
+    uint8_t st = L_START;
+    size_t at = 0, label_start = 0, labels = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t prev = st;
+        st = EMAIL.next[st][EMAIL.cls[s[i]]];
+        if (st == D_START) {
+            if (prev == L_CHAR) {
+                at = i;
+            } else {
+                if (i - label_start > 63) return VT_VAL_E_INVALID;
+                ++labels;
+            }
+            label_start = i + 1;
+        } else if (st == FAIL) {
+            return VT_VAL_E_INVALID;
+        }
+    }
+    if (st != D_ALNUM) return VT_VAL_E_INVALID;
+    if (n - label_start > 63 || labels + 1 < 2) return VT_VAL_E_INVALID;
+    if (at > 64 || n > 254) return VT_VAL_E_TOO_LONG;
+    return VT_VAL_OK;
+}
+
+// Bords qui relèvent de la normalisation de uuid::parse (trim, `urn:uuid:`, accolades).
+static inline bool uuid_edge(uint8_t b) {
+    return b == ' ' || (b >= '\t' && b <= '\r') || b == '{' || b == '}' || (b | 0x20) == 'u';
+}
+
+static int uuid(const uint8_t* s, size_t n) {
+    if ((n != 36 && n != 32) || uuid_edge(s[0]) || uuid_edge(s[n - 1])) return -1;
+    uint32_t hex = 0, dash = 0;
+    hex_dash_masks32(s, &hex, &dash);
+    if (n == 32) return hex == 0xFFFFFFFFu && uuid_fields_ok(s[12], s[16]) ? 1 : 0;
+    constexpr uint32_t DASHES = (1u << 8) | (1u << 13) | (1u << 18) | (1u << 23);
+    if (dash != DASHES || (hex | DASHES) != 0xFFFFFFFFu) return 0;
+    if (!is_hex(s[32]) || !is_hex(s[33]) || !is_hex(s[34]) || !is_hex(s[35])) return 0;
+    return uuid_fields_ok(s[14], s[19]) ? 1 : 0;
+}
+
+} // namespace vt_val
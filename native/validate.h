@@ -0,0 +1,90 @@
+// native/validate.h
+// Validateurs vectorisés pour `modules/validate.vitte` : classes ASCII par tables de
+// quartets (pshufb), forme UUID en une comparaison de 32 octets, grammaires email / slug
+// compilées en automates, motifs glob compilés, et validation d’une colonne entière
+// vers un bitmap.
+//
+// API C exposée (ABI stable pour FFI):
+//   size_t   vt_val_ascii_span(const char* s, size_t n);
+//   size_t   vt_val_printable_span(const char* s, size_t n);
+//   size_t   vt_val_class_span(const char* s, size_t n, uint32_t mask);
+//   int      vt_val_slug(const char* s, size_t n);
+//   int      vt_val_email(const char* s, size_t n);
+//   int      vt_val_uuid(const char* s, size_t n);
+//   vt_glob* vt_val_glob_compile(const char* pat, size_t n, int case_insensitive);
+//   void     vt_val_glob_free(vt_glob* g);
+//   int      vt_val_glob_match(const vt_glob* g, const char* s, size_t n);
+//   uint64_t vt_val_column(uint32_t kind, const vt_glob* g, const char* data,
+//                          const uint32_t* offsets, size_t count, uint64_t* out_bits);
+//
+// Les fonctions *_span retournent l’offset du premier octet refusé (n si tout est accepté),
+// ce qui permet de signaler le caractère fautif sans second passage.
+//
+// Colonne (vt_val_column) : valeurs concaténées dans `data`, valeur i = [offsets[i],
+// offsets[i+1]) (disposition « Arrow », count + 1 offsets). Le bit i de `out_bits`
+// (mot i/64, bit i%64) vaut 1 si la valeur est valide ; retourne le nombre de valides.
+
+#ifndef VITTE_NATIVE_VALIDATE_H
+#define VITTE_NATIVE_VALIDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+// Classes d’octets (combinables) pour vt_val_class_span.
+enum {
+    VT_VAL_DIGIT      = 0x01,   // 0-9
+    VT_VAL_UPPER      = 0x06,   // A-Z
+    VT_VAL_LOWER      = 0x18,   // a-z
+    VT_VAL_DASH       = 0x20,   // -
+    VT_VAL_PUNCT      = 0x40,   // . + %
+    VT_VAL_UNDERSCORE = 0x80,   // _
+    VT_VAL_ALNUM      = VT_VAL_DIGIT | VT_VAL_UPPER | VT_VAL_LOWER,
+};
+
+// Résultat de vt_val_email (mêmes cas que ensure_email côté Vitte).
+enum { VT_VAL_OK = 0, VT_VAL_E_REQUIRED = 1, VT_VAL_E_TOO_LONG = 2, VT_VAL_E_INVALID = 3 };
+
+// Types de valeurs pour vt_val_column.
+enum {
+    VT_VAL_K_NON_EMPTY = 0,
+    VT_VAL_K_ASCII     = 1,
+    VT_VAL_K_PRINTABLE = 2,
+    VT_VAL_K_ALNUM     = 3,
+    VT_VAL_K_SLUG      = 4,
+    VT_VAL_K_EMAIL     = 5,
+    VT_VAL_K_UUID      = 6,
+    VT_VAL_K_GLOB      = 7,
+};
+
+typedef struct vt_glob vt_glob;
+
+VT_API size_t   vt_val_ascii_span(const char* s, size_t n);
+// Imprimable = 0x20..0x7E.
+VT_API size_t   vt_val_printable_span(const char* s, size_t n);
+VT_API size_t   vt_val_class_span(const char* s, size_t n, uint32_t mask);
+
+// 1 si valide, 0 sinon.
+VT_API int      vt_val_slug(const char* s, size_t n);
+// VT_VAL_OK ou VT_VAL_E_*.
+VT_API int      vt_val_email(const char* s, size_t n);
+// Formes canonique (36) et simple (32), version ∈ {1,3..8}, variante RFC 4122.
+// 1 valide, 0 invalide, -1 forme non gérée (urn:, accolades, espaces en bord) : à confier à
+// uuid::parse.
+VT_API int      vt_val_uuid(const char* s, size_t n);
+
+// Glob `*` / `?` ; insensibilité à la casse ASCII. NULL si allocation impossible.
+VT_API vt_glob* vt_val_glob_compile(const char* pat, size_t n, int case_insensitive);
+VT_API void     vt_val_glob_free(vt_glob* g);
+VT_API int      vt_val_glob_match(const vt_glob* g, const char* s, size_t n);
+
+// `g` n’est lu que pour VT_VAL_K_GLOB. `out_bits` : (count + 63) / 64 mots.
+VT_API uint64_t vt_val_column(uint32_t kind, const vt_glob* g, const char* data,
+                              const uint32_t* offsets, size_t count, uint64_t* out_bits);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_VALIDATE_H
@@ -0,0 +1,634 @@
+// native/vitbc_image.hpp
+// Lecteur « zéro copie » des images VITBC v2 (cf. crates/vitte-core/src/loader.rs) pour
+// les hôtes C++ (desktop/qt_real.cpp…) : le fichier est projeté en mémoire et les sections
+// sont exposées comme vues (std::span / std::string_view) sur la projection.
+//
+// Usage :
+//   vt::VitbcImage img;
+//   if (auto e = img.open("app.vitbc"); e != vt::VitbcError::Ok) { /* vt::vitbc_strerror(e) */ }
+//   for (const auto& c : img.strings()) use(c.name, c.value);   // string_view sur la projection
+//   for (const vt::VitbcOp& op : img.code()) dispatch(op);
+//   if (img.verify() != vt::VitbcError::Ok) { /* image corrompue */ }
+//
+// Format (LE) : MAGIC "VITBC\0" | version u32, flags u32, entry_pc i64, 5 × u32 compteurs |
+//   sections INT, FLOAT, STR, DATA, CODE | crc32 u32 | "VEND\0\0".
+//
+// Remarques :
+// - open() ne lit que l’en-tête et le trailer : O(1), quelques microsecondes quelle que
+//   soit la taille. Les frontières de sections (noms de longueur variable) sont calculées
+//   au premier accès, en sautant les blobs sans les lire ; la section CODE est validée
+//   à son premier accès.
+// - CRC32 (IEEE) paresseux : verify() à la demande, ou `VitbcImage::VerifyCrc` à l’ouverture.
+//   Le résultat est mémorisé. Repliement PCLMULQDQ si compilé avec -mpclmul -msse4.1,
+//   tables par tranches de 8 octets sinon.
+// - Les images compressées (flag zstd) ne sont pas projetables : CompressionUnsupported
+//   (passer par le chargeur Rust ou décompresser d’abord).
+// - Les noms et chaînes ne sont pas revalidés en UTF-8 (le chargeur Rust le fait) : ce sont
+//   les octets du fichier.
+// - open_memory() lit une image déjà en mémoire (ressource embarquée), sans la copier.
+// - Un objet par thread : les caches paresseux ne sont pas synchronisés.
+
+#ifndef VITTE_NATIVE_VITBC_IMAGE_HPP
+#define VITTE_NATIVE_VITBC_IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+namespace vt {
+
+// Miroir de `LoaderError` (loader.rs).
+enum class VitbcError {
+    Ok = 0,
+    Io,
+    BadMagic,
+    BadTrailer,
+    BadVersion,
+    BadFormat,
+    TooBig,
+    ChecksumMismatch,
+    CompressionUnsupported,
+};
+
+inline const char* vitbc_strerror(VitbcError e) {
+    switch (e) {
+    case VitbcError::Ok: return "ok";
+    case VitbcError::Io: return "I/O";
+    case VitbcError::BadMagic: return "Mauvaise empreinte (MAGIC) — pas un fichier VITBC";
+    case VitbcError::BadTrailer: return "Trailer manquant/corrompu";
+    case VitbcError::BadVersion: return "Version non supportée";
+    case VitbcError::BadFormat: return "Format invalide";
+    case VitbcError::TooBig: return "Taille excessive";
+    case VitbcError::ChecksumMismatch: return "CRC32 invalide";
+    case VitbcError::CompressionUnsupported: return "Image compressée (zstd) : projection impossible";
+    }
+    return "?";
+}
+
+struct VitbcIntConst {
+    std::string_view name;
+    int64_t value;
+};
+
+struct VitbcFloatConst {
+    std::string_view name;
+    double value;
+};
+
+struct VitbcStrConst {
+    std::string_view name;
+    std::string_view value;
+};
+
+struct VitbcDataBlob {
+    std::optional<std::string_view> name;
+    std::optional<uint32_t> addr;
+    std::span<const uint8_t> bytes;
+};
+
+// Miroir de `RawOp` (asm.rs) : args[argc..3) valent 0.
+struct VitbcOp {
+    uint16_t opcode;
+    uint8_t argc;
+    uint64_t args[3];
+};
+
+namespace vitbc_detail {
+
+inline constexpr char MAGIC[6] = {'V', 'I', 'T', 'B', 'C', '\0'};
+inline constexpr char TRAILER_MAGIC[6] = {'V', 'E', 'N', 'D', '\0', '\0'};
+inline constexpr uint32_t FILE_VERSION = 2;
+inline constexpr uint32_t FLAG_COMPRESSED_ZSTD = 0x1;
+inline constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 5 * 4;   // après MAGIC
+inline constexpr size_t TRAILER_SIZE = 4 + 6;
+
+// Garde-fous identiques à loader.rs.
+inline constexpr size_t MAX_STR_LEN = 64u * 1024 * 1024;
+inline constexpr size_t MAX_BLOB_LEN = 256u * 1024 * 1024;
+inline constexpr uint32_t MAX_CONSTS = 1000000;
+inline constexpr uint32_t MAX_DATA = 1000000;
+inline constexpr uint32_t MAX_CODE = 10000000;
+
+template <class T>
+inline T load_le(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof v);   // hôtes little-endian (x86-64, arm64)
+    return v;
+}
+
+// CRC32/IEEE par tranches de 8 octets (tables générées à la compilation).
+struct CrcTables {
+    uint32_t t[8][256];
+};
+
+inline constexpr CrcTables make_crc_tables() {
+    CrcTables c{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t v = i;
+        for (int k = 0; k < 8; ++k) v = (v & 1) ? 0xEDB88320u ^ (v >> 1) : v >> 1;
+        c.t[0][i] = v;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+        for (int s = 1; s < 8; ++s) c.t[s][i] = (c.t[s - 1][i] >> 8) ^ c.t[0][c.t[s - 1][i] & 0xFF];
+    return c;
+}
+
+inline constexpr CrcTables CRC = make_crc_tables();
+
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+// Repliement par multiplication sans retenue (Intel, « Fast CRC Computation Using PCLMULQDQ »),
+// sur le registre brut (non complémenté) : n ≥ 64, multiple de 16.
+inline uint32_t crc32_ieee_clmul(const uint8_t* p, size_t n, uint32_t c) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);   // P'(x), µ'
+    const __m128i lo32 = _mm_setr_epi32(-1, 0, -1, 0);
+    auto load = [](const uint8_t* q) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(q)); };
+    auto fold = [](__m128i x, __m128i k, __m128i next) {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11)), next);
+    };
+
+    __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(c)));
+    __m128i x2 = load(p + 16), x3 = load(p + 32), x4 = load(p + 48);
+    for (p += 64, n -= 64; n >= 64; p += 64, n -= 64) {
+        x1 = fold(x1, k1k2, load(p));
+        x2 = fold(x2, k1k2, load(p + 16));
+        x3 = fold(x3, k1k2, load(p + 32));
+        x4 = fold(x4, k1k2, load(p + 48));
+    }
+    x1 = fold(fold(fold(x1, k3k4, x2), k3k4, x3), k3k4, x4);
+    for (; n >= 16; p += 16, n -= 16) x1 = fold(x1, k3k4, load(p));
+
+    // 128 → 64 bits, puis réduction de Barrett.
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, lo32), k5, 0x00), x2);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, lo32), poly, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, lo32), poly, 0x00);
+    return static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(x1, x2), 1));
+}
+#endif
+
+// crc : CRC des octets précédents (chaînage, comme zlib.crc32).
+inline uint32_t crc32_ieee(const uint8_t* p, size_t n, uint32_t crc = 0) {
+    uint32_t c = ~crc;
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+    if (n >= 64) {
+        const size_t m = n & ~size_t{15};
+        c = crc32_ieee_clmul(p, m, c);
+        p += m;
+        n -= m;
+    }
+#endif
+    for (; n >= 8; p += 8, n -= 8) {
+        const uint32_t a = load_le<uint32_t>(p) ^ c;
+        const uint32_t b = load_le<uint32_t>(p + 4);
+        c = CRC.t[7][a & 0xFF] ^ CRC.t[6][(a >> 8) & 0xFF] ^ CRC.t[5][(a >> 16) & 0xFF] ^ CRC.t[4][a >> 24] ^
+            CRC.t[3][b & 0xFF] ^ CRC.t[2][(b >> 8) & 0xFF] ^ CRC.t[1][(b >> 16) & 0xFF] ^ CRC.t[0][b >> 24];
+    }
+    while (n--) c = CRC.t[0][(c ^ *p++) & 0xFF] ^ (c >> 8);
+    return ~c;
+}
+
+// Lecteur borné : chaque lecture vérifie le reste disponible.
+struct Cursor {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool take(size_t n, const uint8_t** out) {
+        if (static_cast<size_t>(end - p) < n) return false;
+        *out = p;
+        p += n;
+        return true;
+    }
+    template <class T>
+    bool read(T* v) {
+        const uint8_t* q;
+        if (!take(sizeof(T), &q)) return false;
+        *v = load_le<T>(q);
+        return true;
+    }
+    bool name(std::string_view* s) {
+        uint16_t n;
+        const uint8_t* q;
+        if (!read(&n) || !take(n, &q)) return false;
+        *s = {reinterpret_cast<const char*>(q), n};
+        return true;
+    }
+};
+
+// Décodeurs d’une entrée ; les sections sont validées avant toute itération, ces
+// fonctions ne revérifient donc pas les bornes.
+inline const uint8_t* skip_name(const uint8_t* p, std::string_view* s) {
+    const uint16_t n = load_le<uint16_t>(p);
+    *s = {reinterpret_cast<const char*>(p + 2), n};
+    return p + 2 + n;
+}
+
+inline const uint8_t* decode(const uint8_t* p, VitbcIntConst* e) {
+    p = skip_name(p, &e->name);
+    e->value = load_le<int64_t>(p);
+    return p + 8;
+}
+
+inline const uint8_t* decode(const uint8_t* p, VitbcFloatConst* e) {
+    p = skip_name(p, &e->name);
+    e->value = load_le<double>(p);
+    return p + 8;
+}
+
+inline const uint8_t* decode(const uint8_t* p, VitbcStrConst* e) {
+    p = skip_name(p, &e->name);
+    const uint32_t n = load_le<uint32_t>(p);
+    e->value = {reinterpret_cast<const char*>(p + 4), n};
+    return p + 4 + n;
+}
+
+inline const uint8_t* decode(const uint8_t* p, VitbcDataBlob* e) {
+    e->name.reset();
+    e->addr.reset();
+    if (*p++) {
+        std::string_view s;
+        p = skip_name(p, &s);
+        e->name = s;
+    }
+    if (*p++) {
+        e->addr = load_le<uint32_t>(p);
+        p += 4;
+    }
+    const uint32_t n = load_le<uint32_t>(p);
+    e->bytes = {p + 4, n};
+    return p + 4 + n;
+}
+
+inline const uint8_t* decode(const uint8_t* p, VitbcOp* e) {
+    e->opcode = load_le<uint16_t>(p);
+    e->argc = p[2];
+    p += 4;
+    for (int i = 0; i < 3; ++i) e->args[i] = i < e->argc ? load_le<uint64_t>(p + 8 * i) : 0;
+    return p + 8 * e->argc;
+}
+
+} // namespace vitbc_detail
+
+// Vue itérable sur une section (entrées décodées à la volée, sans allocation).
+template <class T>
+class VitbcSection {
+public:
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        iterator() = default;
+        iterator(const uint8_t* p, uint32_t left) : p_(p), left_(left) { load(); }
+        const T& operator*() const { return cur_; }
+        const T* operator->() const { return &cur_; }
+        iterator& operator++() {
+            p_ = next_;
+            --left_;
+            load();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator t = *this;
+            ++*this;
+            return t;
+        }
+        bool operator==(const iterator& o) const { return left_ == o.left_; }
+
+    private:
+        void load() {
+            if (left_) next_ = vitbc_detail::decode(p_, &cur_);
+        }
+        const uint8_t* p_ = nullptr;
+        const uint8_t* next_ = nullptr;
+        uint32_t left_ = 0;
+        T cur_{};
+    };
+
+    VitbcSection() = default;
+    VitbcSection(std::span<const uint8_t> bytes, uint32_t count) : bytes_(bytes), count_(count) {}
+
+    iterator begin() const { return {bytes_.data(), count_}; }
+    iterator end() const { return {}; }
+    uint32_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    // Octets bruts de la section (dans la projection).
+    std::span<const uint8_t> bytes() const { return bytes_; }
+
+private:
+    std::span<const uint8_t> bytes_;
+    uint32_t count_ = 0;
+};
+
+class VitbcImage {
+public:
+    enum Options : unsigned {
+        None = 0,
+        VerifyCrc = 1u << 0,   // vérifie le CRC dès open()
+        Populate = 1u << 1,    // pré-charge les pages (MAP_POPULATE) : utile si tout sera lu
+    };
+
+    VitbcImage() = default;
+    VitbcImage(const VitbcImage&) = delete;
+    VitbcImage& operator=(const VitbcImage&) = delete;
+    VitbcImage(VitbcImage&& o) noexcept { *this = static_cast<VitbcImage&&>(o); }
+    VitbcImage& operator=(VitbcImage&& o) noexcept {
+        if (this != &o) {
+            close();
+            map_ = o.map_;
+            map_len_ = o.map_len_;
+#if defined(_WIN32)
+            mapping_ = o.mapping_;
+            o.mapping_ = nullptr;
+#endif
+            base_ = o.base_;
+            len_ = o.len_;
+            version_ = o.version_;
+            flags_ = o.flags_;
+            entry_raw_ = o.entry_raw_;
+            std::memcpy(counts_, o.counts_, sizeof counts_);
+            sect_end_ = o.sect_end_;
+            std::memcpy(sect_, o.sect_, sizeof sect_);
+            layout_err_ = o.layout_err_;
+            layout_ = o.layout_;
+            code_ok_ = o.code_ok_;
+            crc_state_ = o.crc_state_;
+            o.map_ = nullptr;
+            o.close();
+        }
+        return *this;
+    }
+    ~VitbcImage() { close(); }
+
+    VitbcError open(const char* path, unsigned opts = None) {
+        close();
+#if defined(_WIN32)
+        HANDLE f = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) return VitbcError::Io;
+        LARGE_INTEGER sz;
+        if (!::GetFileSizeEx(f, &sz) || sz.QuadPart == 0) {
+            ::CloseHandle(f);
+            return sz.QuadPart == 0 ? VitbcError::BadMagic : VitbcError::Io;
+        }
+        mapping_ = ::CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(f);
+        if (!mapping_) return VitbcError::Io;
+        map_ = ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (!map_) {
+            close();
+            return VitbcError::Io;
+        }
+        map_len_ = static_cast<size_t>(sz.QuadPart);
+        (void)opts;
+#else
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return VitbcError::Io;
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return VitbcError::Io;
+        }
+        if (st.st_size == 0) {
+            ::close(fd);
+            return VitbcError::BadMagic;
+        }
+        int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        if (opts & Populate) flags |= MAP_POPULATE;
+#endif
+        void* m = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, flags, fd, 0);
+        ::close(fd);
+        if (m == MAP_FAILED) return VitbcError::Io;
+        map_ = m;
+        map_len_ = static_cast<size_t>(st.st_size);
+#endif
+        const VitbcError e = attach(static_cast<const uint8_t*>(map_), map_len_, opts);
+        if (e != VitbcError::Ok) close();
+        return e;
+    }
+
+    // Image déjà en mémoire (non possédée : doit survivre à l’objet).
+    VitbcError open_memory(const void* data, size_t len, unsigned opts = None) {
+        close();
+        const VitbcError e = attach(static_cast<const uint8_t*>(data), len, opts);
+        if (e != VitbcError::Ok) close();
+        return e;
+    }
+
+    void close() {
+        if (map_) {
+#if defined(_WIN32)
+            ::UnmapViewOfFile(map_);
+#else
+            ::munmap(map_, map_len_);
+#endif
+        }
+#if defined(_WIN32)
+        if (mapping_) ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+#endif
+        map_ = nullptr;
+        map_len_ = 0;
+        base_ = nullptr;
+        len_ = 0;
+        crc_state_ = CrcState::Unknown;
+        layout_ = LayoutState::Unknown;
+        code_ok_ = LayoutState::Unknown;
+    }
+
+    bool is_open() const { return base_ != nullptr; }
+
+    // --- En-tête (FileImageHeader) ---
+    uint32_t version() const { return version_; }
+    uint32_t flags() const { return flags_; }
+    std::optional<size_t> entry_pc() const {
+        if (entry_raw_ < 0) return std::nullopt;
+        return static_cast<size_t>(entry_raw_);
+    }
+    uint32_t n_ints() const { return counts_[0]; }
+    uint32_t n_floats() const { return counts_[1]; }
+    uint32_t n_strings() const { return counts_[2]; }
+    uint32_t n_data() const { return counts_[3]; }
+    uint32_t n_code() const { return counts_[4]; }
+
+    // Image complète et corps couvert par le CRC (après MAGIC, avant le trailer).
+    std::span<const uint8_t> bytes() const { return {base_, len_}; }
+    std::span<const uint8_t> body() const { return {base_ + 6, len_ - 6 - vitbc_detail::TRAILER_SIZE}; }
+    uint32_t stored_crc() const { return vitbc_detail::load_le<uint32_t>(base_ + len_ - vitbc_detail::TRAILER_SIZE); }
+
+    // Calcule le CRC au premier appel (résultat mémorisé).
+    VitbcError verify() const {
+        if (crc_state_ == CrcState::Unknown) {
+            const auto b = body();
+            crc_state_ = vitbc_detail::crc32_ieee(b.data(), b.size()) == stored_crc() ? CrcState::Good : CrcState::Bad;
+        }
+        return crc_state_ == CrcState::Good ? VitbcError::Ok : VitbcError::ChecksumMismatch;
+    }
+
+    // --- Sections (vides si la mise en page est invalide : voir layout_error()) ---
+    VitbcSection<VitbcIntConst> ints() const { return section<VitbcIntConst>(0); }
+    VitbcSection<VitbcFloatConst> floats() const { return section<VitbcFloatConst>(1); }
+    VitbcSection<VitbcStrConst> strings() const { return section<VitbcStrConst>(2); }
+    VitbcSection<VitbcDataBlob> data() const { return section<VitbcDataBlob>(3); }
+    VitbcSection<VitbcOp> code() const {
+        if (code_error() != VitbcError::Ok) return {};
+        return {{sect_[4], static_cast<size_t>(sect_end_ - sect_[4])}, counts_[4]};
+    }
+
+    // Ok, ou BadFormat / TooBig si les sections INT..DATA débordent ou sont incohérentes.
+    VitbcError layout_error() const {
+        if (layout_ == LayoutState::Unknown) layout_ = compute_layout() ? LayoutState::Good : LayoutState::Bad;
+        return layout_ == LayoutState::Good ? VitbcError::Ok : layout_err_;
+    }
+
+    // Ok, ou BadFormat si la section CODE ne contient pas exactement n_code instructions.
+    VitbcError code_error() const {
+        if (const VitbcError e = layout_error(); e != VitbcError::Ok) return e;
+        if (code_ok_ == LayoutState::Unknown) {
+            vitbc_detail::Cursor c{sect_[4], sect_end_};
+            bool ok = true;
+            for (uint32_t i = 0; ok && i < counts_[4]; ++i) {
+                const uint8_t* h;
+                ok = c.take(4, &h) && h[2] <= 3 && c.take(8u * h[2], &h);
+            }
+            code_ok_ = ok && c.p == c.end ? LayoutState::Good : LayoutState::Bad;
+        }
+        return code_ok_ == LayoutState::Good ? VitbcError::Ok : VitbcError::BadFormat;
+    }
+
+    // Recherches linéaires par nom (sans allocation).
+    std::optional<int64_t> find_int(std::string_view name) const {
+        for (const auto& e : ints())
+            if (e.name == name) return e.value;
+        return std::nullopt;
+    }
+    std::optional<double> find_float(std::string_view name) const {
+        for (const auto& e : floats())
+            if (e.name == name) return e.value;
+        return std::nullopt;
+    }
+    std::optional<std::string_view> find_string(std::string_view name) const {
+        for (const auto& e : strings())
+            if (e.name == name) return e.value;
+        return std::nullopt;
+    }
+
+private:
+    enum class CrcState : uint8_t { Unknown, Good, Bad };
+    enum class LayoutState : uint8_t { Unknown, Good, Bad };
+
+    VitbcError attach(const uint8_t* p, size_t n, unsigned opts) {
+        using namespace vitbc_detail;
+        if (n < sizeof MAGIC || std::memcmp(p, MAGIC, sizeof MAGIC) != 0) return VitbcError::BadMagic;
+        if (n < sizeof MAGIC + TRAILER_SIZE ||
+            std::memcmp(p + n - sizeof TRAILER_MAGIC, TRAILER_MAGIC, sizeof TRAILER_MAGIC) != 0)
+            return VitbcError::BadTrailer;
+        base_ = p;
+        len_ = n;
+        if (opts & VerifyCrc) {
+            if (const VitbcError e = verify(); e != VitbcError::Ok) return e;
+        }
+        // comme loader.rs : CRC (si demandé) avant l’interprétation de l’en-tête
+        if (n < sizeof MAGIC + HEADER_SIZE + TRAILER_SIZE) return VitbcError::BadFormat;
+        const uint8_t* h = p + sizeof MAGIC;
+        version_ = load_le<uint32_t>(h);
+        if (version_ != FILE_VERSION) return VitbcError::BadVersion;
+        flags_ = load_le<uint32_t>(h + 4);
+        if (flags_ & FLAG_COMPRESSED_ZSTD) return VitbcError::CompressionUnsupported;
+        entry_raw_ = load_le<int64_t>(h + 8);
+        for (int i = 0; i < 5; ++i) counts_[i] = load_le<uint32_t>(h + 16 + 4 * i);
+        if (counts_[0] > MAX_CONSTS || counts_[1] > MAX_CONSTS || counts_[2] > MAX_CONSTS ||
+            counts_[3] > MAX_DATA || counts_[4] > MAX_CODE)
+            return VitbcError::TooBig;
+        sect_[0] = h + HEADER_SIZE;
+        sect_end_ = p + n - TRAILER_SIZE;
+        return VitbcError::Ok;
+    }
+
+    // Parcourt INT..DATA en sautant noms et blobs ; fixe sect_[1..4].
+    bool compute_layout() const {
+        using namespace vitbc_detail;
+        Cursor c{sect_[0], sect_end_};
+        const uint8_t* q;
+        std::string_view s;
+        layout_err_ = VitbcError::BadFormat;
+        for (uint32_t i = 0; i < counts_[0]; ++i)
+            if (!c.name(&s) || !c.take(8, &q)) return false;
+        sect_[1] = c.p;
+        for (uint32_t i = 0; i < counts_[1]; ++i)
+            if (!c.name(&s) || !c.take(8, &q)) return false;
+        sect_[2] = c.p;
+        for (uint32_t i = 0; i < counts_[2]; ++i) {
+            uint32_t n;
+            if (!c.name(&s) || !c.read(&n)) return false;
+            if (n > MAX_STR_LEN) { layout_err_ = VitbcError::TooBig; return false; }
+            if (!c.take(n, &q)) return false;
+        }
+        sect_[3] = c.p;
+        for (uint32_t i = 0; i < counts_[3]; ++i) {
+            uint8_t has;
+            uint32_t n;
+            if (!c.read(&has) || (has && !c.name(&s))) return false;
+            if (!c.read(&has) || (has && !c.take(4, &q))) return false;
+            if (!c.read(&n)) return false;
+            if (n > MAX_BLOB_LEN) { layout_err_ = VitbcError::TooBig; return false; }
+            if (!c.take(n, &q)) return false;
+        }
+        sect_[4] = c.p;
+        return true;
+    }
+
+    template <class T>
+    VitbcSection<T> section(int i) const {
+        if (layout_error() != VitbcError::Ok) return {};
+        return {{sect_[i], static_cast<size_t>(sect_[i + 1] - sect_[i])}, counts_[i]};
+    }
+
+    void* map_ = nullptr;
+    size_t map_len_ = 0;
+#if defined(_WIN32)
+    HANDLE mapping_ = nullptr;
+#endif
+    const uint8_t* base_ = nullptr;
+    size_t len_ = 0;
+
+    uint32_t version_ = 0;
+    uint32_t flags_ = 0;
+    int64_t entry_raw_ = -1;
+    uint32_t counts_[5] = {0, 0, 0, 0, 0};
+
+    const uint8_t* sect_end_ = nullptr;
+    mutable const uint8_t* sect_[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+    mutable VitbcError layout_err_ = VitbcError::Ok;
+    mutable LayoutState layout_ = LayoutState::Unknown;
+    mutable LayoutState code_ok_ = LayoutState::Unknown;
+    mutable CrcState crc_state_ = CrcState::Unknown;
+};
+
+} // namespace vt
+
+#endif // VITTE_NATIVE_VITBC_IMAGE_HPP
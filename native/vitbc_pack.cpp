@@ -0,0 +1,665 @@
+// native/vitbc_pack.cpp
+// vitbc-pack : (dé)compression des images VITBC, remplaçant natif de
+// scripts/compress_bytecode.py et scripts/decompress_bytecode.py (mêmes options, mêmes
+// messages, mêmes fichiers produits), sur autant de fichiers que voulu en parallèle.
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -msse4.1 -mpclmul -Inative native/vitbc_pack.cpp native/vitbc_zstd.cpp
+//       -pthread -ldl -o bin/vitbc-pack
+//
+// Usage :
+//   vitbc-pack in.vitbc out.vitbc                    # compresse (→ v2), niveau 10
+//   vitbc-pack --level 9 in.vitbc out.vitbc          # niveau zstd
+//   vitbc-pack --decompress in.vitbc out.vitbc       # → v2 non compressé
+//   vitbc-pack --verify a.vitbc [b.vitbc …]          # CRC + structure (+ flux zstd)
+//   vitbc-pack --show a.vitbc [b.vitbc …]            # en-tête
+//   vitbc-pack -j 16 --out-dir dist/ a.vitbc b.vitbc …   # lot : sorties dist/<nom>
+//   vitbc-pack --frames [--block 65536] in out       # trames indépendantes (vitbc_zstd.h)
+//   vitbc-pack --train mods.dict [--dict-size 112640] [--dict-id N] corpus/*.vitbc
+//   vitbc-pack --dict mods.dict -j 16 --out-dir dist/ a.vitbc b.vitbc …
+//
+// Remarques :
+// - Flux : les sections sont lues par blocs de 1 Mio, CRC d’entrée et de sortie calculés au
+//   fil de l’eau (PCLMULQDQ avec -mpclmul -msse4.1, cf. vitbc_image.hpp), zstd en flux
+//   (ZSTD_compressStream2 / ZSTD_decompressStream) : mémoire bornée quelle que soit la taille.
+// - Parallélisme par fichier : un thread par cœur (-j), chacun garde ses contextes zstd
+//   (tables de correspondance et fenêtres réutilisées d’un fichier à l’autre, pas de
+//   réallocation par fichier).
+// - Sortie écrite dans "<out>.tmp.<n>" puis renommée : jamais de fichier à moitié écrit,
+//   même en cas d’erreur (CRC d’entrée faux détecté en fin de lecture) ; out == in permis.
+// - Sortie compressée : une seule trame zstd comme compress_bytecode.py et loader.rs ;
+//   --frames : trames indépendantes + table de saut (fichier chargé en mémoire).
+// - --dict (répétable) : compression avec le premier dictionnaire (flag DICT + identifiant,
+//   cf. vitbc_zstd.h) ; les autres servent seulement à relire des images. Chargés une fois,
+//   partagés entre threads (ZSTD_CDict / ZSTD_DDict en lecture seule). Une image avec
+//   dictionnaire absent de la ligne de commande est refusée.
+// - --train : dictionnaire entraîné sur les sections des images données (vt_vitbc_dict_train).
+// - Code de sortie : 0 si tout va bien, 1 si un fichier échoue, 2 pour une erreur d’usage.
+
+#include "vitbc_image.hpp"
+#include "vitbc_zstd.h"
+#include "zstd_dl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+using vt::vitbc_detail::crc32_ieee;
+using vt::vitbc_detail::HEADER_SIZE;
+using vt::vitbc_detail::MAGIC;
+using vt::vitbc_detail::TRAILER_MAGIC;
+using vt::vitbc_detail::TRAILER_SIZE;
+using vt::zstd_dl::InBuf;
+using vt::zstd_dl::OutBuf;
+
+constexpr size_t IO_CHUNK = 1u << 20;
+constexpr uint32_t FLAG_ZSTD = VT_VITBC_FLAG_ZSTD;
+constexpr uint32_t FLAG_FRAMES = VT_VITBC_FLAG_FRAMES;
+constexpr uint32_t FLAG_DICT = VT_VITBC_FLAG_DICT;
+constexpr uint32_t DICT_FLAGS = FLAG_DICT | (0xFFFFu << VT_VITBC_DICT_SHIFT);
+
+enum class Mode { Compress, Decompress, Verify, Show, Train };
+
+struct Options {
+    Mode mode = Mode::Compress;
+    bool compress_flag = false, decompress_flag = false, frames = false;
+    int level = 10;
+    uint32_t block = 64u * 1024;
+    unsigned threads = 0;
+    std::string out_dir;
+    std::vector<std::string> dicts;   // --dict, le premier sert à compresser
+    std::string train_out;            // --train
+    size_t dict_size = 0;             // 0 : défaut de vt_vitbc_dict_train
+    uint16_t dict_id = 0;
+    std::vector<std::string> inputs;
+    std::string out;   // un seul fichier, sans --out-dir
+};
+
+struct Task {
+    std::string in, out;
+};
+
+// Échec d’un fichier : message au format des scripts Python.
+struct Failure {
+    bool write = false;   // « Échec écriture » plutôt que « Fichier invalide »
+    std::string what;
+};
+
+struct Header {
+    uint32_t version = 0, flags = 0;
+    int64_t entry = -1;
+    uint32_t counts[5] = {};
+    bool trailer = false;
+    uint64_t body_end = 0;   // fin des sections dans le fichier
+    uint32_t crc = 0;        // CRC attendu (trailer)
+};
+
+struct Stats {
+    uint64_t in_bytes = 0, out_bytes = 0, raw_bytes = 0;
+};
+
+// Dictionnaires --dict, préparés avant le lancement des threads puis en lecture seule.
+class Dicts {
+public:
+    Dicts() = default;
+    ~Dicts() {
+        for (const Entry& e : v_) {
+            if (e.cdict) z_->freeCDict(e.cdict);
+            if (e.ddict) z_->freeDDict(e.ddict);
+        }
+    }
+    Dicts(const Dicts&) = delete;
+    Dicts& operator=(const Dicts&) = delete;
+
+    // Enregistre aussi le dictionnaire auprès de vitbc_zstd.cpp (--frames).
+    bool load(const vt::zstd_dl::Api* z, const std::vector<uint8_t>& bytes, int level, std::string& err) {
+        z_ = z;
+        const int id = vt_vitbc_dict_register(bytes.data(), bytes.size());
+        if (id < 0) {
+            err = vt_vitbc_strerror(id);
+            return false;
+        }
+        Entry e{static_cast<uint16_t>(id), z->createCDict(bytes.data(), bytes.size(), level),
+                z->createDDict(bytes.data(), bytes.size())};
+        v_.push_back(e);
+        if (!e.cdict || !e.ddict) {
+            err = "tables zstd illisibles";
+            return false;
+        }
+        return true;
+    }
+    uint16_t first() const { return v_.empty() ? 0 : v_.front().id; }
+    const void* cdict(uint16_t id) const { return find(id) ? find(id)->cdict : nullptr; }
+    const void* ddict(uint16_t id) const { return find(id) ? find(id)->ddict : nullptr; }
+
+private:
+    struct Entry {
+        uint16_t id;
+        void* cdict;
+        void* ddict;
+    };
+    const Entry* find(uint16_t id) const {
+        for (const Entry& e : v_) {
+            if (id && e.id == id) return &e;
+        }
+        return nullptr;
+    }
+
+    const vt::zstd_dl::Api* z_ = nullptr;
+    std::vector<Entry> v_;
+};
+
+// Identifiant du dictionnaire d’une image compressée (0 : aucun).
+uint16_t image_dict(uint32_t flags) {
+    return (flags & FLAG_ZSTD) && (flags & FLAG_DICT) ? VT_VITBC_DICT_ID(flags) : 0;
+}
+
+// Contextes d’un thread, réutilisés d’un fichier à l’autre.
+class Worker {
+public:
+    Worker(const vt::zstd_dl::Api* z, int level, const Dicts& dicts) : z_(z), dicts_(dicts) {
+        in_.resize(IO_CHUNK);
+        if (!z_) return;
+        cctx_ = z_->createCCtx();
+        dctx_ = z_->createDCtx();
+        if (cctx_) z_->CCtx_setParameter(cctx_, vt::zstd_dl::kCompressionLevel, level);
+        raw_.resize(z_->DStreamOutSize());
+        zout_.resize(z_->CStreamOutSize());
+    }
+    ~Worker() {
+        if (cctx_) z_->freeCCtx(cctx_);
+        if (dctx_) z_->freeDCtx(dctx_);
+    }
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    bool run(const Options& o, const Task& t, unsigned id, Stats& st, Failure& f, std::string& report);
+
+private:
+    bool read_header(std::FILE* in, uint64_t size, Header& h, Failure& f);
+    bool stream(std::FILE* in, const Header& h, bool out_zstd, uint16_t out_dict, std::FILE* out, uint32_t& crc_out,
+                Stats& st, Failure& f);
+    bool emit(const uint8_t* p, size_t n, bool out_zstd, int end, std::FILE* out, uint32_t& crc_out, Stats& st,
+              Failure& f);
+    bool pack_frames(const Options& o, unsigned threads, std::FILE* in, uint64_t size, std::FILE* out, Stats& st,
+                     Failure& f);
+
+    const vt::zstd_dl::Api* z_;
+    const Dicts& dicts_;
+    void* cctx_ = nullptr;
+    void* dctx_ = nullptr;
+    std::vector<uint8_t> in_, raw_, zout_;
+};
+
+bool fail(Failure& f, std::string what, bool write = false) {
+    f.what = std::move(what);
+    f.write = write;
+    return false;
+}
+
+std::string zstd_error(const vt::zstd_dl::Api* z, size_t r) { return std::string("zstd: ") + z->getErrorName(r); }
+
+bool Worker::read_header(std::FILE* in, uint64_t size, Header& h, Failure& f) {
+    uint8_t head[sizeof MAGIC + HEADER_SIZE];
+    const size_t got = std::fread(head, 1, sizeof head, in);
+    if (got < sizeof MAGIC || std::memcmp(head, MAGIC, sizeof MAGIC) != 0)
+        return fail(f, "MAGIC invalide (pas un fichier VITBC)");
+    uint8_t tail[TRAILER_SIZE];
+    const uint64_t body = size - sizeof MAGIC;
+    if (body >= TRAILER_SIZE && std::fseek(in, static_cast<long>(size - TRAILER_SIZE), SEEK_SET) == 0 &&
+        std::fread(tail, 1, sizeof tail, in) == sizeof tail) {
+        h.trailer = std::memcmp(tail + 4, TRAILER_MAGIC, sizeof TRAILER_MAGIC) == 0;
+    }
+    h.body_end = h.trailer ? size - TRAILER_SIZE : size;
+    if (got < sizeof head || h.body_end < sizeof head) return fail(f, "En-tête tronqué");
+    const uint8_t* p = head + sizeof MAGIC;
+    h.version = vt::vitbc_detail::load_le<uint32_t>(p);
+    h.flags = vt::vitbc_detail::load_le<uint32_t>(p + 4);
+    h.entry = vt::vitbc_detail::load_le<int64_t>(p + 8);
+    for (int i = 0; i < 5; ++i) h.counts[i] = vt::vitbc_detail::load_le<uint32_t>(p + 16 + 4 * i);
+    if (h.trailer) {
+        h.crc = vt::vitbc_detail::load_le<uint32_t>(tail);
+        if (h.version != vt::vitbc_detail::FILE_VERSION)
+            return fail(f, "Version non supportée (got " + std::to_string(h.version) + ", expected 2)");
+    } else if (h.version != 1 && h.version != vt::vitbc_detail::FILE_VERSION) {
+        return fail(f, "Version inconnue (got " + std::to_string(h.version) + ")");
+    }
+    if ((h.flags & FLAG_ZSTD) && !z_) return fail(f, "libzstd introuvable");
+    if (const uint16_t id = image_dict(h.flags); id && !dicts_.ddict(id))
+        return fail(f, "dictionnaire " + std::to_string(id) + " requis (--dict)");
+    return true;
+}
+
+// Sections brutes → sortie (recompressées ou non), CRC de sortie au fil de l’eau.
+bool Worker::emit(const uint8_t* p, size_t n, bool out_zstd, int end, std::FILE* out, uint32_t& crc_out, Stats& st,
+                  Failure& f) {
+    st.raw_bytes += n;
+    if (!out_zstd) {
+        if (!out) return true;
+        crc_out = crc32_ieee(p, n, crc_out);
+        st.out_bytes += n;
+        return std::fwrite(p, 1, n, out) == n || fail(f, "écriture des sections", true);
+    }
+    InBuf ib{p, n, 0};
+    for (;;) {
+        OutBuf ob{zout_.data(), zout_.size(), 0};
+        const size_t r = z_->compressStream2(cctx_, &ob, &ib, end);
+        if (z_->isError(r)) return fail(f, zstd_error(z_, r), true);
+        crc_out = crc32_ieee(zout_.data(), ob.pos, crc_out);
+        st.out_bytes += ob.pos;
+        if (ob.pos && std::fwrite(zout_.data(), 1, ob.pos, out) != ob.pos) return fail(f, "écriture des sections", true);
+        if (end == vt::zstd_dl::kEndFrame ? r == 0 : ib.pos == ib.size) return true;
+    }
+}
+
+bool Worker::stream(std::FILE* in, const Header& h, bool out_zstd, uint16_t out_dict, std::FILE* out,
+                    uint32_t& crc_out, Stats& st, Failure& f) {
+    const bool in_zstd = h.flags & FLAG_ZSTD;
+    uint32_t crc_in = crc32_ieee(nullptr, 0);
+    {
+        // L’en-tête entre aussi dans le CRC d’entrée (version..sections).
+        uint8_t head[HEADER_SIZE];
+        if (std::fseek(in, static_cast<long>(sizeof MAGIC), SEEK_SET) != 0 ||
+            std::fread(head, 1, sizeof head, in) != sizeof head)
+            return fail(f, "Lecture impossible");
+        crc_in = crc32_ieee(head, sizeof head);
+    }
+    // Dictionnaire (ou aucun) repris à chaque fichier : les contextes servent d’un fichier à l’autre.
+    if (in_zstd) {
+        z_->DCtx_reset(dctx_, vt::zstd_dl::kResetSession);
+        z_->DCtx_refDDict(dctx_, dicts_.ddict(image_dict(h.flags)));
+    }
+    if (out_zstd) {
+        z_->CCtx_reset(cctx_, vt::zstd_dl::kResetSession);
+        z_->CCtx_refCDict(cctx_, dicts_.cdict(out_dict));
+    }
+
+    uint64_t left = h.body_end - sizeof MAGIC - HEADER_SIZE;
+    size_t last = 0;     // dernier retour de ZSTD_decompressStream : 0 ⇒ trame complète
+    Failure pending;     // erreur de décodage : le CRC (s’il est faux) l’emporte, comme en Python
+    bool broken = false;
+    while (left) {
+        const size_t n = std::fread(in_.data(), 1, static_cast<size_t>(std::min<uint64_t>(left, in_.size())), in);
+        if (n == 0) return fail(f, "Lecture impossible");
+        left -= n;
+        crc_in = crc32_ieee(in_.data(), n, crc_in);
+        if (broken) continue;
+        if (!in_zstd) {
+            if (!emit(in_.data(), n, out_zstd, vt::zstd_dl::kEndContinue, out, crc_out, st, pending)) broken = true;
+            continue;
+        }
+        InBuf ib{in_.data(), n, 0};
+        for (;;) {
+            OutBuf ob{raw_.data(), raw_.size(), 0};
+            last = z_->decompressStream(dctx_, &ob, &ib);
+            if (z_->isError(last)) {
+                broken = !fail(pending, zstd_error(z_, last));
+                break;
+            }
+            if (!emit(raw_.data(), ob.pos, out_zstd, vt::zstd_dl::kEndContinue, out, crc_out, st, pending)) {
+                broken = true;
+                break;
+            }
+            if (ib.pos == ib.size && ob.pos < ob.size) break;
+        }
+    }
+    if (h.trailer && crc_in != h.crc) {
+        char msg[64];
+        std::snprintf(msg, sizeof msg, "CRC invalide (expected=0x%08X, got=0x%08X)", crc_in, h.crc);
+        return fail(f, msg);
+    }
+    if (broken) {
+        f = std::move(pending);
+        return false;
+    }
+    if (in_zstd && last != 0) return fail(f, "zstd: flux tronqué");
+    return !out_zstd || emit(nullptr, 0, true, vt::zstd_dl::kEndFrame, out, crc_out, st, f);
+}
+
+// --frames : image entière en mémoire, vt_vitbc_compress.
+bool Worker::pack_frames(const Options& o, unsigned threads, std::FILE* in, uint64_t size, std::FILE* out,
+                         Stats& st, Failure& f) {
+    std::vector<uint8_t> img(static_cast<size_t>(size));
+    if (std::fseek(in, 0, SEEK_SET) != 0 || std::fread(img.data(), 1, img.size(), in) != img.size())
+        return fail(f, "Lecture impossible");
+    vt_vitbc_zopts zo;
+    vt_vitbc_zopts_default(&zo);
+    zo.level = o.level;
+    zo.block_size = o.block;
+    zo.threads = threads;
+    zo.dict_id = dicts_.first();
+    vt_vitbc_buf b{};
+    if (const int e = vt_vitbc_compress(img.data(), img.size(), &zo, &b); e != VT_VITBC_OK)
+        return fail(f, vt_vitbc_strerror(e));
+    vt_vitbc_sections* s = nullptr;
+    if (vt_vitbc_sections_open(b.data, b.len, &s) == VT_VITBC_OK) st.raw_bytes = vt_vitbc_sections_size(s);
+    vt_vitbc_sections_free(s);
+    st.out_bytes = b.len;
+    const bool ok = std::fwrite(b.data, 1, b.len, out) == b.len;
+    vt_vitbc_buf_free(&b);
+    return ok || fail(f, "écriture", true);
+}
+
+bool Worker::run(const Options& o, const Task& t, unsigned id, Stats& st, Failure& f, std::string& report) {
+    std::error_code ec;
+    const uint64_t size = fs::file_size(t.in, ec);
+    if (ec) return fail(f, ec.message());
+    std::FILE* in = std::fopen(t.in.c_str(), "rb");
+    if (!in) return fail(f, std::strerror(errno));
+    struct Closer {
+        std::FILE*& f;
+        ~Closer() {
+            if (f) std::fclose(f);
+        }
+    } close_in{in};
+
+    Header h;
+    if (!read_header(in, size, h, f)) return false;
+    st.in_bytes = size;
+    if ((h.flags & FLAG_ZSTD) && (!cctx_ || !dctx_)) return fail(f, "contexte zstd");
+
+    if (o.mode == Mode::Verify || o.mode == Mode::Show) {
+        uint32_t crc_out = 0;
+        if (!stream(in, h, false, 0, nullptr, crc_out, st, f)) return false;
+        if (o.mode == Mode::Verify) {
+            report = h.trailer ? "✅ VITBC v2 OK — CRC valide.\n" : "✅ VITBC v1 (sans trailer) — pas de CRC à vérifier.\n";
+            return true;
+        }
+        char buf[512];
+        std::string entry = h.entry < 0 ? "None" : std::to_string(h.entry);
+        std::snprintf(buf, sizeof buf,
+                      "VITBC header :\n"
+                      "  version        : %u (%s)\n"
+                      "  compressed(zstd): %s\n"
+                      "  entry_pc       : %s\n"
+                      "  counts         : ints=%u, floats=%u, strings=%u, data=%u, code=%u\n"
+                      "  sections bytes : %" PRIu64 " (décompressées)\n",
+                      h.version, h.trailer ? "v2" : "v1", (h.flags & FLAG_ZSTD) ? "True" : "False", entry.c_str(),
+                      h.counts[0], h.counts[1], h.counts[2], h.counts[3], h.counts[4], st.raw_bytes);
+        report = buf;
+        if (const uint16_t id = image_dict(h.flags)) report += "  dictionnaire   : " + std::to_string(id) + "\n";
+        return true;
+    }
+
+    const bool out_zstd = o.mode == Mode::Compress;
+    if (out_zstd && !z_) return fail(f, "libzstd introuvable", true);
+    const std::string tmp = t.out + ".tmp." + std::to_string(id);
+    std::FILE* out = std::fopen(tmp.c_str(), "wb");
+    if (!out) return fail(f, tmp + ": " + std::strerror(errno), true);
+    bool ok;
+    if (out_zstd && o.frames) {
+        ok = pack_frames(o, o.inputs.size() > 1 ? 1 : o.threads, in, size, out, st, f);
+    } else {
+        // En-tête v2 : version et flags réécrits, reste recopié.
+        uint8_t head[sizeof MAGIC + HEADER_SIZE];
+        ok = std::fseek(in, 0, SEEK_SET) == 0 && std::fread(head, 1, sizeof head, in) == sizeof head;
+        if (!ok) fail(f, "Lecture impossible");
+        const uint32_t version = vt::vitbc_detail::FILE_VERSION;
+        const uint16_t out_dict = out_zstd ? dicts_.first() : 0;
+        uint32_t flags = h.flags & ~(FLAG_ZSTD | FLAG_FRAMES | DICT_FLAGS);
+        if (out_zstd) flags |= FLAG_ZSTD;
+        if (out_dict) flags |= FLAG_DICT | uint32_t{out_dict} << VT_VITBC_DICT_SHIFT;
+        std::memcpy(head + sizeof MAGIC, &version, 4);
+        std::memcpy(head + sizeof MAGIC + 4, &flags, 4);
+        uint32_t crc_out = crc32_ieee(head + sizeof MAGIC, HEADER_SIZE);
+        if (ok && std::fwrite(head, 1, sizeof head, out) != sizeof head) ok = fail(f, "écriture de l’en-tête", true);
+        st.out_bytes = sizeof head;
+        ok = ok && stream(in, h, out_zstd, out_dict, out, crc_out, st, f);
+        if (ok) {
+            uint8_t trailer[TRAILER_SIZE];
+            std::memcpy(trailer, &crc_out, 4);
+            std::memcpy(trailer + 4, TRAILER_MAGIC, sizeof TRAILER_MAGIC);
+            if (std::fwrite(trailer, 1, sizeof trailer, out) != sizeof trailer) ok = fail(f, "écriture du trailer", true);
+            st.out_bytes += sizeof trailer;
+        }
+    }
+    if (std::fclose(out) != 0 && ok) ok = fail(f, tmp + ": " + std::strerror(errno), true);
+    if (ok) {
+        fs::rename(tmp, t.out, ec);
+        if (ec) ok = fail(f, t.out + ": " + ec.message(), true);
+    }
+    if (!ok) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    report = "✅ Écrit '" + t.out + "' (" + (out_zstd ? "compressé" : "décompressé") + ", v2, CRC ok)\n";
+    return true;
+}
+
+void usage(std::FILE* to) {
+    std::fputs("usage: vitbc-pack [--level N] [--compress | --decompress] [--verify] [--show]\n"
+               "                  [--frames] [--block OCTETS] [--dict FICHIER…] [-j N] [--out-dir DIR]\n"
+               "                  inp [out | inp…]\n"
+               "       vitbc-pack --train OUT [--dict-size OCTETS] [--dict-id N] inp…\n",
+               to);
+}
+
+int parse_args(int argc, char** argv, Options& o) {
+    std::vector<std::string> pos;
+    bool verify = false, show = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        if (a == "-h" || a == "--help") {
+            usage(stdout);
+            std::exit(0);
+        } else if (a == "--level" || a == "--block" || a == "-j" || a == "--jobs" || a == "--out-dir" ||
+                   a == "--dict" || a == "--train" || a == "--dict-size" || a == "--dict-id") {
+            const char* v = value();
+            if (!v) {
+                std::fprintf(stderr, "✖ %s : valeur manquante\n", a.c_str());
+                return 2;
+            }
+            if (a == "--level") o.level = std::atoi(v);
+            else if (a == "--block") o.block = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+            else if (a == "--out-dir") o.out_dir = v;
+            else if (a == "--dict") o.dicts.emplace_back(v);
+            else if (a == "--train") o.train_out = v;
+            else if (a == "--dict-size") o.dict_size = std::strtoull(v, nullptr, 10);
+            else if (a == "--dict-id") {
+                const unsigned long id = std::strtoul(v, nullptr, 10);
+                if (id > 0xFFFF) {
+                    std::fprintf(stderr, "✖ --dict-id : %s hors de [%u, 65535]\n", v, VT_VITBC_DICT_MIN_ID);
+                    return 2;
+                }
+                o.dict_id = static_cast<uint16_t>(id);
+            }
+            else o.threads = static_cast<unsigned>(std::max(0, std::atoi(v)));
+        } else if (a == "--compress") {
+            o.compress_flag = true;
+        } else if (a == "--decompress") {
+            o.decompress_flag = true;
+        } else if (a == "--verify") {
+            verify = true;
+        } else if (a == "--show") {
+            show = true;
+        } else if (a == "--frames") {
+            o.frames = true;
+        } else if (a.size() > 1 && a[0] == '-') {
+            std::fprintf(stderr, "✖ Option inconnue : %s\n", a.c_str());
+            usage(stderr);
+            return 2;
+        } else {
+            pos.push_back(a);
+        }
+    }
+    if (o.compress_flag && o.decompress_flag) {
+        std::fputs("✖ --compress et --decompress sont exclusifs.\n", stderr);
+        return 2;
+    }
+    if (pos.empty()) {
+        usage(stderr);
+        return 2;
+    }
+    if (!o.train_out.empty()) {
+        o.mode = Mode::Train;
+        o.inputs = pos;
+        return 0;
+    }
+    if (verify || show) {
+        // Comme les scripts : --verify l’emporte sur --show ; « out » éventuel ignoré.
+        o.mode = verify ? Mode::Verify : Mode::Show;
+        o.inputs = o.out_dir.empty() && pos.size() == 2 ? std::vector<std::string>{pos[0]} : pos;
+        return 0;
+    }
+    o.mode = o.decompress_flag ? Mode::Decompress : Mode::Compress;
+    if (o.out_dir.empty()) {
+        if (pos.size() != 2) {
+            std::fputs(pos.size() < 2 ? "✖ Spécifie un fichier de sortie (ou utilise --verify/--show).\n"
+                                      : "✖ Plusieurs entrées : utilise --out-dir DIR.\n",
+                       stderr);
+            return 2;
+        }
+        o.inputs = {pos[0]};
+        o.out = pos[1];
+    } else {
+        o.inputs = pos;
+    }
+    return 0;
+}
+
+bool read_file(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return !f.bad();
+}
+
+// --train : toutes les images en mémoire, un seul dictionnaire.
+int train(const Options& o) {
+    std::vector<std::vector<uint8_t>> images(o.inputs.size());
+    std::vector<const uint8_t*> ptrs;
+    std::vector<size_t> lens;
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!read_file(o.inputs[i], images[i])) {
+            std::fprintf(stderr, "✖ %s: %s\n", o.inputs[i].c_str(), std::strerror(errno));
+            return 1;
+        }
+        ptrs.push_back(images[i].data());
+        lens.push_back(images[i].size());
+    }
+    vt_vitbc_buf d{};
+    if (const int e = vt_vitbc_dict_train(ptrs.data(), lens.data(), ptrs.size(), o.dict_size, o.dict_id, &d);
+        e != VT_VITBC_OK) {
+        std::fprintf(stderr, "✖ Entraînement impossible: %s\n", vt_vitbc_strerror(e));
+        return 1;
+    }
+    const std::string tmp = o.train_out + ".tmp.0";
+    std::FILE* out = std::fopen(tmp.c_str(), "wb");
+    bool ok = out && std::fwrite(d.data, 1, d.len, out) == d.len;
+    if (out && std::fclose(out) != 0) ok = false;
+    std::error_code ec;
+    if (ok) fs::rename(tmp, o.train_out, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        std::fprintf(stderr, "✖ Échec écriture: %s\n", o.train_out.c_str());
+        vt_vitbc_buf_free(&d);
+        return 1;
+    }
+    std::printf("✅ Écrit '%s' (dictionnaire %zu octets, id %u, %zu images)\n", o.train_out.c_str(), d.len,
+                vt::vitbc_detail::load_le<uint32_t>(d.data + 4), images.size());
+    vt_vitbc_buf_free(&d);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (const int rc = parse_args(argc, argv, o); rc != 0) return rc;
+    if (o.mode == Mode::Train) return train(o);
+
+    std::vector<Task> tasks;
+    std::set<std::string> outs;
+    for (const std::string& in : o.inputs) {
+        Task t{in, o.out};
+        if (!o.out_dir.empty() && o.mode != Mode::Verify && o.mode != Mode::Show) {
+            t.out = (fs::path(o.out_dir) / fs::path(in).filename()).string();
+            if (!outs.insert(t.out).second) {
+                std::fprintf(stderr, "✖ Deux entrées produiraient '%s'.\n", t.out.c_str());
+                return 2;
+            }
+        }
+        tasks.push_back(std::move(t));
+    }
+    if (!o.out_dir.empty() && o.mode != Mode::Verify && o.mode != Mode::Show) {
+        std::error_code ec;
+        fs::create_directories(o.out_dir, ec);
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const vt::zstd_dl::Api* z = vt::zstd_dl::api();
+    Dicts dicts;
+    for (const std::string& path : o.dicts) {
+        std::vector<uint8_t> bytes;
+        std::string err = z ? "" : "libzstd introuvable";
+        if (!read_file(path, bytes)) err = std::strerror(errno);
+        if (!err.empty() || !dicts.load(z, bytes, o.level, err)) {
+            std::fprintf(stderr, "✖ Dictionnaire invalide: %s: %s\n", path.c_str(), err.c_str());
+            return 1;
+        }
+    }
+    const size_t nt = std::min<size_t>(o.threads ? o.threads : std::max(1u, std::thread::hardware_concurrency()),
+                                       tasks.size());
+    const bool batch = tasks.size() > 1;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> failed{0};
+    std::mutex out_mu;
+    Stats total;
+    auto worker = [&](unsigned id) {
+        Worker w(z, o.level, dicts);
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < tasks.size();) {
+            Stats st;
+            Failure f;
+            std::string report;
+            const bool ok = w.run(o, tasks[i], id, st, f, report);
+            std::lock_guard<std::mutex> lk(out_mu);
+            total.in_bytes += st.in_bytes;
+            total.out_bytes += st.out_bytes;
+            total.raw_bytes += st.raw_bytes;
+            if (ok) {
+                if (batch && o.mode == Mode::Show) std::printf("%s:\n", tasks[i].in.c_str());
+                std::fputs(report.c_str(), stdout);
+            } else {
+                failed.fetch_add(1, std::memory_order_relaxed);
+                std::fprintf(stderr, "✖ %s%s%s: %s\n", batch ? tasks[i].in.c_str() : "", batch ? " — " : "",
+                             f.write ? "Échec écriture" : "Fichier invalide", f.what.c_str());
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < nt; ++t) {
+        try {
+            pool.emplace_back(worker, static_cast<unsigned>(t));
+        } catch (const std::system_error&) {
+            break;   // moins de threads que demandé : le reste sur le thread principal
+        }
+    }
+    worker(0);
+    for (std::thread& t : pool) t.join();
+
+    if (batch) {
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::printf("%zu fichiers (%zu échecs) : %.1f Mo → %.1f Mo, sections %.1f Mo, %.2f s, %zu threads\n",
+                    tasks.size(), failed.load(), total.in_bytes / 1e6, total.out_bytes / 1e6, total.raw_bytes / 1e6,
+                    s, pool.size() + 1);
+    }
+    return failed.load() ? 1 : 0;
+}
@@ -0,0 +1,663 @@
+// native/vitbc_zstd.cpp
+// Compression zstd des sections VITBC en trames indépendantes (cf. vitbc_zstd.h pour l’API C
+// et le format).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vitbc_zstd.cpp -o build/vitbc_zstd.o
+//   g++ build/app.o build/vitbc_zstd.o -pthread -ldl -o bin/app
+//
+// Remarques :
+// - libzstd résolue au premier appel (zstd_dl.hpp) : pas besoin de zstd.h.
+// - Un contexte zstd par thread du pool (compression et décompression) ; à la demande, un
+//   contexte de décompression par thread appelant, réutilisé.
+// - Dictionnaires : registre global (mutex, consulté une fois par image) de dictionnaires
+//   partagés ; CDict créé par niveau au premier usage, DDict à l’enregistrement. Lecture
+//   seule ensuite : partagés entre les threads du pool sans verrou.
+// - Trames et table de saut validées à l’ouverture (tailles cohérentes, somme exacte) :
+//   une trame corrompue n’est détectée qu’à sa décompression (CRC du trailer mis à part).
+
+#include "vitbc_zstd.h"
+#include "vitbc_image.hpp"
+#include "zstd_dl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vt_vitbcz {
+
+using vt::vitbc_detail::crc32_ieee;
+using vt::vitbc_detail::HEADER_SIZE;
+using vt::vitbc_detail::MAGIC;
+using vt::vitbc_detail::TRAILER_MAGIC;
+using vt::vitbc_detail::TRAILER_SIZE;
+
+constexpr uint32_t SKIPPABLE_MAGIC = 0x184D2A5E;
+constexpr char SEEK_MAGIC[4] = {'V', 'Z', 'S', 'K'};
+constexpr size_t SEEK_HEAD = 4 + 4 + 4 + 4 + 8;   // après le magic skippable et sa taille
+constexpr uint32_t DEFAULT_BLOCK = 64u * 1024;
+constexpr uint32_t MIN_BLOCK = 4u * 1024;
+constexpr uint64_t MAX_RAW = uint64_t{1} << 32;   // sections décompressées (garde-fou)
+
+using Zstd = vt::zstd_dl::Api;
+using vt::zstd_dl::InBuf;
+using vt::zstd_dl::OutBuf;
+
+inline const Zstd* zstd() { return vt::zstd_dl::api(); }
+
+// Contexte de décompression du thread courant (à la demande).
+struct DctxSlot {
+    void* ctx = nullptr;
+    ~DctxSlot() {
+        if (ctx) zstd()->freeDCtx(ctx);
+    }
+};
+
+void* thread_dctx(const Zstd* z) {
+    thread_local DctxSlot slot;
+    if (!slot.ctx) slot.ctx = z->createDCtx();
+    return slot.ctx;
+}
+
+// ---- Dictionnaires ----
+
+constexpr uint32_t DICT_MAGIC = 0xEC30A437;              // dictionnaire zstd complet (entropie + contenu)
+constexpr size_t DEFAULT_DICT_CAPACITY = 110u * 1024;    // défaut de `zstd --train`
+constexpr uint32_t DICT_FLAGS = VT_VITBC_FLAG_DICT | (0xFFFFu << VT_VITBC_DICT_SHIFT);
+
+class Dict {
+public:
+    Dict(const Zstd* z, uint16_t id, std::vector<uint8_t> bytes) : z_(z), id_(id), bytes_(std::move(bytes)) {
+        ddict_ = z_->createDDict(bytes_.data(), bytes_.size());
+    }
+    ~Dict() {
+        if (ddict_) z_->freeDDict(ddict_);
+        for (auto& c : cdicts_) z_->freeCDict(c.second);
+    }
+    Dict(const Dict&) = delete;
+    Dict& operator=(const Dict&) = delete;
+
+    uint16_t id() const { return id_; }
+    const void* ddict() const { return ddict_; }
+
+    // CDict du niveau demandé (niveau figé dans le CDict), créé au premier usage.
+    const void* cdict(int level) const {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (const auto& c : cdicts_) {
+            if (c.first == level) return c.second;
+        }
+        void* c = z_->createCDict(bytes_.data(), bytes_.size(), level);
+        if (c) cdicts_.emplace_back(level, c);
+        return c;
+    }
+
+private:
+    const Zstd* z_;
+    uint16_t id_;
+    std::vector<uint8_t> bytes_;
+    void* ddict_ = nullptr;
+    mutable std::mutex mu_;
+    mutable std::vector<std::pair<int, void*>> cdicts_;
+};
+
+using DictRef = std::shared_ptr<const Dict>;
+
+struct DictRegistry {
+    std::mutex mu;
+    std::unordered_map<uint16_t, DictRef> by_id;
+};
+
+DictRegistry& registry() {
+    static DictRegistry* r = new DictRegistry;   // jamais détruit : pas d’ordre de destruction à gérer
+    return *r;
+}
+
+DictRef find_dict(uint16_t id) {
+    DictRegistry& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    auto it = r.by_id.find(id);
+    return it == r.by_id.end() ? nullptr : it->second;
+}
+
+// ---- Image VITBC ----
+
+template <class T>
+T le(const uint8_t* p) {
+    return vt::vitbc_detail::load_le<T>(p);
+}
+
+template <class T>
+void put(std::vector<uint8_t>& v, T x) {
+    uint8_t b[sizeof(T)];
+    std::memcpy(b, &x, sizeof(T));
+    v.insert(v.end(), b, b + sizeof(T));
+}
+
+struct Image {
+    const uint8_t* header = nullptr;   // HEADER_SIZE octets après MAGIC
+    uint32_t version = 0;
+    uint32_t flags = 0;
+    const uint8_t* sect = nullptr;     // sections telles qu’écrites (éventuellement compressées)
+    size_t sect_len = 0;
+};
+
+// v2 : trailer et CRC vérifiés ; v1 : sans trailer (comme compress_bytecode.py).
+int parse_image(const uint8_t* p, size_t n, Image& img) {
+    if (!p || n < sizeof MAGIC + HEADER_SIZE || std::memcmp(p, MAGIC, sizeof MAGIC) != 0) return VT_VITBC_E_FORMAT;
+    const uint8_t* body = p + sizeof MAGIC;
+    size_t body_len = n - sizeof MAGIC;
+    const bool trailer =
+        body_len >= HEADER_SIZE + TRAILER_SIZE && std::memcmp(p + n - sizeof TRAILER_MAGIC, TRAILER_MAGIC, sizeof TRAILER_MAGIC) == 0;
+    img.version = le<uint32_t>(body);
+    if (trailer) {
+        body_len -= TRAILER_SIZE;
+        if (img.version != vt::vitbc_detail::FILE_VERSION) return VT_VITBC_E_FORMAT;
+        if (crc32_ieee(body, body_len) != le<uint32_t>(body + body_len)) return VT_VITBC_E_CRC;
+    } else if (img.version != 1) {   // v2 : trailer obligatoire (loader.rs)
+        return VT_VITBC_E_FORMAT;
+    }
+    img.header = body;
+    img.flags = le<uint32_t>(body + 4);
+    if ((img.flags & (VT_VITBC_FLAG_FRAMES | VT_VITBC_FLAG_DICT)) && !(img.flags & VT_VITBC_FLAG_ZSTD))
+        return VT_VITBC_E_FORMAT;
+    if ((img.flags & VT_VITBC_FLAG_DICT) && VT_VITBC_DICT_ID(img.flags) < VT_VITBC_DICT_MIN_ID) return VT_VITBC_E_FORMAT;
+    img.sect = body + HEADER_SIZE;
+    img.sect_len = body_len - HEADER_SIZE;
+    return VT_VITBC_OK;
+}
+
+struct Frame {
+    const uint8_t* src;
+    uint32_t csize;
+    uint32_t rsize;
+    uint64_t raw_off;
+};
+
+// Table de saut en tête des sections (VT_VITBC_FLAG_FRAMES).
+int parse_frames(const Image& img, std::vector<Frame>& frames, uint64_t& raw_size) {
+    const uint8_t* p = img.sect;
+    const size_t n = img.sect_len;
+    if (n < 8 + SEEK_HEAD || le<uint32_t>(p) != SKIPPABLE_MAGIC) return VT_VITBC_E_FORMAT;
+    const uint32_t skip = le<uint32_t>(p + 4);
+    if (skip < SEEK_HEAD || skip > n - 8) return VT_VITBC_E_FORMAT;
+    const uint8_t* t = p + 8;
+    if (std::memcmp(t, SEEK_MAGIC, 4) != 0) return VT_VITBC_E_FORMAT;
+    const uint32_t nframes = le<uint32_t>(t + 4);
+    const uint32_t block = le<uint32_t>(t + 8);
+    raw_size = le<uint64_t>(t + 16);
+    if (block < MIN_BLOCK || raw_size > MAX_RAW) return VT_VITBC_E_FORMAT;
+    if (nframes != (raw_size + block - 1) / block) return VT_VITBC_E_FORMAT;
+    if (skip != SEEK_HEAD + uint64_t{nframes} * 8) return VT_VITBC_E_FORMAT;
+    frames.resize(nframes);
+    const uint8_t* src = p + 8 + skip;
+    size_t left = n - 8 - skip;
+    for (uint32_t i = 0; i < nframes; ++i) {
+        Frame& f = frames[i];
+        f.csize = le<uint32_t>(t + SEEK_HEAD + 8 * size_t{i});
+        f.rsize = le<uint32_t>(t + SEEK_HEAD + 8 * size_t{i} + 4);
+        f.raw_off = uint64_t{i} * block;
+        const uint64_t want = std::min<uint64_t>(block, raw_size - f.raw_off);
+        if (f.rsize != want || f.csize > left) return VT_VITBC_E_FORMAT;
+        f.src = src;
+        src += f.csize;
+        left -= f.csize;
+    }
+    return left == 0 ? VT_VITBC_OK : VT_VITBC_E_FORMAT;
+}
+
+// Dictionnaire requis par une image (nullptr si aucun).
+int image_dict(const Image& img, DictRef& d) {
+    d = nullptr;
+    if (!(img.flags & VT_VITBC_FLAG_DICT)) return VT_VITBC_OK;
+    d = find_dict(VT_VITBC_DICT_ID(img.flags));
+    return d ? VT_VITBC_OK : VT_VITBC_E_DICT;
+}
+
+const void* ddict_of(const DictRef& d) { return d ? d->ddict() : nullptr; }
+
+// ddict explicite (nullptr : sans dictionnaire) : un DDict référencé plus tôt par le
+// contexte du thread ne doit pas servir.
+int decode_frame(const Zstd* z, void* dctx, const void* ddict, const Frame& f, uint8_t* dst) {
+    const size_t r = z->decompress_usingDDict(dctx, dst, f.rsize, f.src, f.csize, ddict);
+    return z->isError(r) || r != f.rsize ? VT_VITBC_E_ZSTD : VT_VITBC_OK;
+}
+
+// zstd en flux (une ou plusieurs trames, skippables comprises) : chargeurs existants.
+int decode_stream(const Zstd* z, const void* ddict, const uint8_t* src, size_t n, std::vector<uint8_t>& out) {
+    void* d = thread_dctx(z);
+    if (!d) return VT_VITBC_E_NOMEM;
+    z->DCtx_reset(d, vt::zstd_dl::kResetSession);
+    z->DCtx_refDDict(d, ddict);
+    // Taille exacte si la première trame la porte (modules courts : une seule allocation).
+    const unsigned long long cs = z->getFrameContentSize(src, n);
+    const bool known = cs != 0 && cs != vt::zstd_dl::kContentSizeUnknown && cs != vt::zstd_dl::kContentSizeError;
+    out.resize(known && cs <= MAX_RAW ? static_cast<size_t>(cs) : 256 * 1024);
+    InBuf in{src, n, 0};
+    size_t last = 0;
+    for (;;) {
+        if (last == out.size()) {
+            if (out.size() >= MAX_RAW) return VT_VITBC_E_FORMAT;
+            out.resize(std::max<size_t>(out.size() * 2, 64 * 1024));
+        }
+        OutBuf o{out.data() + last, out.size() - last, 0};
+        const size_t r = z->decompressStream(d, &o, &in);
+        if (z->isError(r)) return VT_VITBC_E_ZSTD;
+        last += o.pos;
+        if (r == 0 && in.pos == in.size) break;               // dernière trame complète
+        if (in.pos < in.size || o.pos == o.size) continue;   // entrée restante ou sortie pleine
+        return VT_VITBC_E_ZSTD;                               // trame tronquée
+    }
+    out.resize(last);
+    return VT_VITBC_OK;
+}
+
+// Exécute job(i, ctx) pour i < n sur `threads` threads ; ctx créé/libéré par thread.
+template <class Make, class Free, class Job>
+int parallel(size_t n, unsigned threads, Make make, Free release, Job job) {
+    std::atomic<size_t> next{0};
+    std::atomic<int> err{VT_VITBC_OK};
+    auto worker = [&] {
+        void* ctx = make();
+        if (!ctx) {
+            err.store(VT_VITBC_E_NOMEM);
+            return;
+        }
+        for (size_t i; err.load(std::memory_order_relaxed) == VT_VITBC_OK &&
+                       (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+            if (const int e = job(i, ctx); e != VT_VITBC_OK) err.store(e);
+        }
+        release(ctx);
+    };
+    size_t nt = std::min<size_t>(threads ? threads : std::max(1u, std::thread::hardware_concurrency()), n);
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < nt; ++t) {
+        try {
+            pool.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;   // moins de threads que demandé : le reste sur l’appelant
+        }
+    }
+    if (n) worker();
+    for (std::thread& t : pool) t.join();
+    return err.load();
+}
+
+// Sections décompressées d’une image (tous formats), trames en parallèle.
+int raw_sections(const Image& img, unsigned threads, std::vector<uint8_t>& raw) {
+    if (!(img.flags & VT_VITBC_FLAG_ZSTD)) {
+        raw.assign(img.sect, img.sect + img.sect_len);
+        return VT_VITBC_OK;
+    }
+    const Zstd* z = zstd();
+    if (!z) return VT_VITBC_E_NO_ZSTD;
+    DictRef dict;
+    if (const int e = image_dict(img, dict); e != VT_VITBC_OK) return e;
+    const void* ddict = ddict_of(dict);
+    if (!(img.flags & VT_VITBC_FLAG_FRAMES)) return decode_stream(z, ddict, img.sect, img.sect_len, raw);
+    std::vector<Frame> frames;
+    uint64_t raw_size = 0;
+    if (const int e = parse_frames(img, frames, raw_size); e != VT_VITBC_OK) return e;
+    raw.resize(static_cast<size_t>(raw_size));
+    return parallel(
+        frames.size(), threads, [z] { return z->createDCtx(); }, [z](void* c) { z->freeDCtx(c); },
+        [&](size_t i, void* d) { return decode_frame(z, d, ddict, frames[i], raw.data() + frames[i].raw_off); });
+}
+
+// Table de saut + trames compressées en parallèle ; un seul bloc : une trame, sans table
+// (`framed` faux). cdict : nullptr ou dictionnaire au niveau voulu.
+int compress_sections(const std::vector<uint8_t>& raw, const vt_vitbc_zopts& o, const void* cdict,
+                      std::vector<uint8_t>& out, bool& framed) {
+    const Zstd* z = zstd();
+    if (!z) return VT_VITBC_E_NO_ZSTD;
+    const uint32_t block = std::max(o.block_size ? o.block_size : DEFAULT_BLOCK, MIN_BLOCK);
+    const size_t nframes = (raw.size() + block - 1) / block;
+    if (raw.size() > MAX_RAW) return VT_VITBC_E_ARG;
+    auto compress_one = [&](void* c, const uint8_t* src, size_t n, std::vector<uint8_t>& f) {
+        f.resize(z->compressBound(n));
+        const size_t r = cdict ? z->compress_usingCDict(c, f.data(), f.size(), src, n, cdict)
+                               : z->compressCCtx(c, f.data(), f.size(), src, n, o.level);
+        if (z->isError(r)) return VT_VITBC_E_ZSTD;
+        f.resize(r);
+        return VT_VITBC_OK;
+    };
+    framed = nframes > 1;
+    if (!framed) {
+        void* c = z->createCCtx();
+        if (!c) return VT_VITBC_E_NOMEM;
+        const int e = compress_one(c, raw.data(), raw.size(), out);
+        z->freeCCtx(c);
+        return e;
+    }
+    std::vector<std::vector<uint8_t>> frames(nframes);
+    const int e = parallel(
+        nframes, o.threads, [z] { return z->createCCtx(); }, [z](void* c) { z->freeCCtx(c); },
+        [&](size_t i, void* c) {
+            const size_t off = i * block;
+            return compress_one(c, raw.data() + off, std::min<size_t>(block, raw.size() - off), frames[i]);
+        });
+    if (e != VT_VITBC_OK) return e;
+
+    const size_t skip = SEEK_HEAD + nframes * 8;
+    size_t total = 8 + skip;
+    for (const auto& f : frames) total += f.size();
+    out.clear();
+    out.reserve(total);
+    put<uint32_t>(out, SKIPPABLE_MAGIC);
+    put<uint32_t>(out, static_cast<uint32_t>(skip));
+    out.insert(out.end(), SEEK_MAGIC, SEEK_MAGIC + 4);
+    put<uint32_t>(out, static_cast<uint32_t>(nframes));
+    put<uint32_t>(out, block);
+    put<uint32_t>(out, 0);
+    put<uint64_t>(out, raw.size());
+    for (size_t i = 0; i < nframes; ++i) {
+        put<uint32_t>(out, static_cast<uint32_t>(frames[i].size()));
+        put<uint32_t>(out, static_cast<uint32_t>(std::min<size_t>(block, raw.size() - i * block)));
+    }
+    for (const auto& f : frames) out.insert(out.end(), f.begin(), f.end());
+    return VT_VITBC_OK;
+}
+
+// Image v2 : en-tête repris de `img` (version et flags réécrits), sections, CRC, trailer.
+int write_image(const Image& img, uint32_t flags, const std::vector<uint8_t>& sect, vt_vitbc_buf* out) {
+    const size_t n = sizeof MAGIC + HEADER_SIZE + sect.size() + TRAILER_SIZE;
+    auto* b = static_cast<uint8_t*>(std::malloc(n));
+    if (!b) return VT_VITBC_E_NOMEM;
+    std::memcpy(b, MAGIC, sizeof MAGIC);
+    uint8_t* body = b + sizeof MAGIC;
+    std::memcpy(body, img.header, HEADER_SIZE);
+    const uint32_t version = vt::vitbc_detail::FILE_VERSION;
+    std::memcpy(body, &version, 4);
+    std::memcpy(body + 4, &flags, 4);
+    if (!sect.empty()) std::memcpy(body + HEADER_SIZE, sect.data(), sect.size());
+    const size_t body_len = HEADER_SIZE + sect.size();
+    const uint32_t crc = crc32_ieee(body, body_len);
+    std::memcpy(body + body_len, &crc, 4);
+    std::memcpy(body + body_len + 4, TRAILER_MAGIC, sizeof TRAILER_MAGIC);
+    out->data = b;
+    out->len = n;
+    return VT_VITBC_OK;
+}
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+} // namespace vt_vitbcz
+
+using namespace vt_vitbcz;
+
+struct vt_vitbc_sections {
+    Image img;
+    std::vector<Frame> frames;             // VT_VITBC_FLAG_FRAMES
+    uint64_t raw_size = 0;
+    std::unique_ptr<uint8_t[]> raw;        // trames : non initialisé, rempli trame par trame
+    std::vector<uint8_t> stream;           // zstd en une trame : tout d’un coup
+    std::unique_ptr<std::once_flag[]> once;
+    std::unique_ptr<std::atomic<int>[]> state;   // 0 : à faire, 1 : ok, < 0 : erreur
+    DictRef dict;                          // gardé même si désenregistré entre-temps
+    std::atomic<uint32_t> decoded{0};
+    std::atomic<uint64_t> decoded_ns{0};
+
+    bool plain() const { return !(img.flags & VT_VITBC_FLAG_ZSTD); }
+    bool framed() const { return (img.flags & VT_VITBC_FLAG_FRAMES) != 0; }
+    size_t units() const { return plain() ? 0 : framed() ? frames.size() : 1; }
+    const uint8_t* base() const { return plain() ? img.sect : framed() ? raw.get() : stream.data(); }
+
+    // Décompresse l’unité i (trame, ou le flux entier) une seule fois.
+    int ensure(size_t i, void* dctx = nullptr) {
+        std::call_once(once[i], [&] {
+            const uint64_t t0 = now_ns();
+            const Zstd* z = zstd();
+            int e;
+            if (!z) {
+                e = VT_VITBC_E_NO_ZSTD;
+            } else if (framed()) {
+                void* d = dctx ? dctx : thread_dctx(z);
+                e = d ? decode_frame(z, d, ddict_of(dict), frames[i], raw.get() + frames[i].raw_off) : VT_VITBC_E_NOMEM;
+            } else {
+                try {
+                    e = decode_stream(z, ddict_of(dict), img.sect, img.sect_len, stream);
+                } catch (const std::bad_alloc&) {
+                    e = VT_VITBC_E_NOMEM;
+                }
+                if (e == VT_VITBC_OK) raw_size = stream.size();
+            }
+            decoded_ns.fetch_add(now_ns() - t0, std::memory_order_relaxed);
+            if (e == VT_VITBC_OK) decoded.fetch_add(1, std::memory_order_relaxed);
+            state[i].store(e == VT_VITBC_OK ? 1 : e, std::memory_order_release);
+        });
+        const int s = state[i].load(std::memory_order_acquire);
+        return s == 1 ? VT_VITBC_OK : s;
+    }
+};
+
+VT_EXTERN_C_BEGIN
+
+VT_API int vt_vitbc_zstd_available(void) { return zstd() != nullptr; }
+
+VT_API void vt_vitbc_zopts_default(vt_vitbc_zopts* o) {
+    if (!o) return;
+    o->level = 10;
+    o->block_size = DEFAULT_BLOCK;
+    o->threads = 0;
+    o->dict_id = 0;
+}
+
+VT_API int vt_vitbc_compress(const uint8_t* in, size_t len, const vt_vitbc_zopts* o, vt_vitbc_buf* out) {
+    if (!out) return VT_VITBC_E_ARG;
+    *out = vt_vitbc_buf{};
+    vt_vitbc_zopts opts;
+    vt_vitbc_zopts_default(&opts);
+    if (o) opts = *o;
+    Image img;
+    if (const int e = parse_image(in, len, img); e != VT_VITBC_OK) return e;
+    if (opts.dict_id && opts.dict_id < VT_VITBC_DICT_MIN_ID) return VT_VITBC_E_ARG;
+    try {
+        DictRef dict = opts.dict_id ? find_dict(opts.dict_id) : nullptr;
+        if (opts.dict_id && !dict) return VT_VITBC_E_DICT;
+        const void* cdict = dict ? dict->cdict(opts.level) : nullptr;
+        if (dict && !cdict) return VT_VITBC_E_DICT;
+        std::vector<uint8_t> raw, sect;
+        bool framed = false;
+        if (int e = raw_sections(img, opts.threads, raw); e != VT_VITBC_OK) return e;
+        if (int e = compress_sections(raw, opts, cdict, sect, framed); e != VT_VITBC_OK) return e;
+        uint32_t flags = (img.flags & ~(VT_VITBC_FLAG_FRAMES | DICT_FLAGS)) | VT_VITBC_FLAG_ZSTD;
+        if (framed) flags |= VT_VITBC_FLAG_FRAMES;
+        if (dict) flags |= VT_VITBC_FLAG_DICT | (uint32_t{dict->id()} << VT_VITBC_DICT_SHIFT);
+        return write_image(img, flags, sect, out);
+    } catch (const std::bad_alloc&) {
+        return VT_VITBC_E_NOMEM;
+    }
+}
+
+VT_API int vt_vitbc_decompress(const uint8_t* in, size_t len, unsigned threads, vt_vitbc_buf* out) {
+    if (!out) return VT_VITBC_E_ARG;
+    *out = vt_vitbc_buf{};
+    Image img;
+    if (const int e = parse_image(in, len, img); e != VT_VITBC_OK) return e;
+    try {
+        std::vector<uint8_t> raw;
+        if (int e = raw_sections(img, threads, raw); e != VT_VITBC_OK) return e;
+        return write_image(img, img.flags & ~(VT_VITBC_FLAG_ZSTD | VT_VITBC_FLAG_FRAMES | DICT_FLAGS), raw, out);
+    } catch (const std::bad_alloc&) {
+        return VT_VITBC_E_NOMEM;
+    }
+}
+
+VT_API void vt_vitbc_buf_free(vt_vitbc_buf* b) {
+    if (!b) return;
+    std::free(b->data);
+    *b = vt_vitbc_buf{};
+}
+
+VT_API int vt_vitbc_sections_open(const uint8_t* image, size_t len, vt_vitbc_sections** out) {
+    if (!out) return VT_VITBC_E_ARG;
+    *out = nullptr;
+    auto s = std::unique_ptr<vt_vitbc_sections>(new (std::nothrow) vt_vitbc_sections);
+    if (!s) return VT_VITBC_E_NOMEM;
+    if (const int e = parse_image(image, len, s->img); e != VT_VITBC_OK) return e;
+    try {
+        if (s->plain()) {
+            s->raw_size = s->img.sect_len;
+        } else if (!zstd()) {
+            return VT_VITBC_E_NO_ZSTD;
+        } else if (const int e = image_dict(s->img, s->dict); e != VT_VITBC_OK) {
+            return e;
+        } else if (s->framed()) {
+            if (const int e = parse_frames(s->img, s->frames, s->raw_size); e != VT_VITBC_OK) return e;
+            s->raw.reset(new uint8_t[std::max<uint64_t>(s->raw_size, 1)]);
+        }
+        const size_t n = std::max<size_t>(s->units(), 1);
+        s->once.reset(new std::once_flag[n]);
+        s->state.reset(new std::atomic<int>[n]);
+        for (size_t i = 0; i < n; ++i) s->state[i].store(0, std::memory_order_relaxed);
+    } catch (const std::bad_alloc&) {
+        return VT_VITBC_E_NOMEM;
+    }
+    *out = s.release();
+    return VT_VITBC_OK;
+}
+
+VT_API uint64_t vt_vitbc_sections_size(const vt_vitbc_sections* s) {
+    if (!s) return 0;
+    // zstd en une trame : taille connue seulement après décompression.
+    if (!s->plain() && !s->framed() && const_cast<vt_vitbc_sections*>(s)->ensure(0) != VT_VITBC_OK) return 0;
+    return s->raw_size;
+}
+
+VT_API int vt_vitbc_sections_get(vt_vitbc_sections* s, uint64_t off, uint64_t len, const uint8_t** out) {
+    if (!s || !out) return VT_VITBC_E_ARG;
+    *out = nullptr;
+    if (s->framed()) {
+        if (off > s->raw_size || len > s->raw_size - off) return VT_VITBC_E_ARG;
+        if (len) {
+            const uint64_t block = s->frames.size() > 1 ? s->frames[1].raw_off : s->raw_size;
+            for (uint64_t i = off / block; i <= (off + len - 1) / block; ++i) {
+                if (const int e = s->ensure(static_cast<size_t>(i)); e != VT_VITBC_OK) return e;
+            }
+        }
+    } else {
+        if (!s->plain()) {
+            if (const int e = s->ensure(0); e != VT_VITBC_OK) return e;
+        }
+        if (off > s->raw_size || len > s->raw_size - off) return VT_VITBC_E_ARG;
+    }
+    *out = s->base() + off;
+    return VT_VITBC_OK;
+}
+
+VT_API int vt_vitbc_sections_load_all(vt_vitbc_sections* s, unsigned threads) {
+    if (!s) return VT_VITBC_E_ARG;
+    if (s->plain()) return VT_VITBC_OK;
+    if (!s->framed()) return s->ensure(0);
+    const Zstd* z = zstd();
+    return parallel(
+        s->frames.size(), threads, [z] { return z->createDCtx(); }, [z](void* c) { z->freeDCtx(c); },
+        [s](size_t i, void* d) { return s->ensure(i, d); });
+}
+
+VT_API void vt_vitbc_sections_get_stats(const vt_vitbc_sections* s, vt_vitbc_sections_stats* out) {
+    if (!out) return;
+    *out = vt_vitbc_sections_stats{};
+    if (!s) return;
+    out->raw_size = s->raw_size;
+    out->frames = static_cast<uint32_t>(s->units());
+    out->decoded = s->decoded.load(std::memory_order_relaxed);
+    out->decoded_ns = s->decoded_ns.load(std::memory_order_relaxed);
+}
+
+VT_API void vt_vitbc_sections_free(vt_vitbc_sections* s) { delete s; }
+
+VT_API int vt_vitbc_dict_train(const uint8_t* const* images, const size_t* lens, size_t n, size_t capacity,
+                               uint16_t id, vt_vitbc_buf* out) {
+    if (!out || (n && (!images || !lens)) || (id && id < VT_VITBC_DICT_MIN_ID) || n > UINT32_MAX) return VT_VITBC_E_ARG;
+    *out = vt_vitbc_buf{};
+    const Zstd* z = zstd();
+    if (!z || !z->ZDICT_trainFromBuffer) return VT_VITBC_E_NO_ZSTD;
+    try {
+        // Échantillons : sections décompressées, bout à bout.
+        std::vector<uint8_t> samples, raw;
+        std::vector<size_t> sizes;
+        for (size_t i = 0; i < n; ++i) {
+            Image img;
+            if (int e = parse_image(images[i], lens[i], img); e != VT_VITBC_OK) return e;
+            if (int e = raw_sections(img, 1, raw); e != VT_VITBC_OK) return e;
+            if (raw.empty()) continue;
+            samples.insert(samples.end(), raw.begin(), raw.end());
+            sizes.push_back(raw.size());
+        }
+        std::vector<uint8_t> dict(capacity ? capacity : DEFAULT_DICT_CAPACITY);
+        const size_t r = z->ZDICT_trainFromBuffer(dict.data(), dict.size(), samples.data(), sizes.data(),
+                                                  static_cast<unsigned>(sizes.size()));
+        if (z->ZDICT_isError(r) || r < 8 || le<uint32_t>(dict.data()) != DICT_MAGIC) return VT_VITBC_E_DICT;
+        dict.resize(r);
+        // Identifiant imposé (ou dérivé du contenu) dans l’en-tête du dictionnaire : il se
+        // retrouve dans chaque trame compressée avec lui.
+        if (!id) {
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (uint8_t b : dict) h = (h ^ b) * 0x100000001b3ull;
+            id = static_cast<uint16_t>(VT_VITBC_DICT_MIN_ID + h % (65536 - VT_VITBC_DICT_MIN_ID));
+        }
+        const uint32_t id32 = id;
+        std::memcpy(dict.data() + 4, &id32, 4);
+        auto* b = static_cast<uint8_t*>(std::malloc(dict.size()));
+        if (!b) return VT_VITBC_E_NOMEM;
+        std::memcpy(b, dict.data(), dict.size());
+        out->data = b;
+        out->len = dict.size();
+        return VT_VITBC_OK;
+    } catch (const std::bad_alloc&) {
+        return VT_VITBC_E_NOMEM;
+    }
+}
+
+VT_API int vt_vitbc_dict_register(const uint8_t* dict, size_t len) {
+    if (!dict || len < 8 || le<uint32_t>(dict) != DICT_MAGIC) return VT_VITBC_E_DICT;
+    const uint32_t id = le<uint32_t>(dict + 4);
+    if (id < VT_VITBC_DICT_MIN_ID || id > 0xFFFF) return VT_VITBC_E_DICT;
+    const Zstd* z = zstd();
+    if (!z) return VT_VITBC_E_NO_ZSTD;
+    try {
+        auto d = std::make_shared<const Dict>(z, static_cast<uint16_t>(id), std::vector<uint8_t>(dict, dict + len));
+        if (!d->ddict()) return VT_VITBC_E_DICT;   // tables d’entropie illisibles
+        DictRegistry& r = registry();
+        std::lock_guard<std::mutex> lk(r.mu);
+        r.by_id[static_cast<uint16_t>(id)] = std::move(d);
+    } catch (const std::bad_alloc&) {
+        return VT_VITBC_E_NOMEM;
+    }
+    return static_cast<int>(id);
+}
+
+VT_API int vt_vitbc_dict_unregister(uint16_t id) {
+    DictRegistry& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    return r.by_id.erase(id) ? VT_VITBC_OK : VT_VITBC_E_DICT;
+}
+
+VT_API const char* vt_vitbc_strerror(int code) {
+    switch (code) {
+    case VT_VITBC_OK: return "ok";
+    case VT_VITBC_E_FORMAT: return "Image VITBC invalide (magic, trailer, version ou table de saut)";
+    case VT_VITBC_E_CRC: return "CRC32 invalide";
+    case VT_VITBC_E_ZSTD: return "Trame zstd invalide";
+    case VT_VITBC_E_NO_ZSTD: return "libzstd introuvable";
+    case VT_VITBC_E_NOMEM: return "Mémoire insuffisante";
+    case VT_VITBC_E_ARG: return "Argument invalide";
+    case VT_VITBC_E_DICT: return "Dictionnaire non enregistré, invalide ou non entraînable";
+    }
+    return "?";
+}
+
+VT_EXTERN_C_END
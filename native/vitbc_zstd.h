@@ -0,0 +1,139 @@
+// native/vitbc_zstd.h
+// Compression zstd des images VITBC v2 (cf. crates/vitte-core/src/loader.rs) en trames
+// indépendantes avec table de saut : compression et décompression réparties sur un pool de
+// threads, ou décompression à la demande des seuls blocs touchés.
+//
+// API C exposée (ABI stable pour FFI):
+//   int   vt_vitbc_zstd_available(void);
+//   void  vt_vitbc_zopts_default(vt_vitbc_zopts* o);
+//   int   vt_vitbc_compress(const uint8_t* in, size_t len, const vt_vitbc_zopts* o, vt_vitbc_buf* out);
+//   int   vt_vitbc_decompress(const uint8_t* in, size_t len, unsigned threads, vt_vitbc_buf* out);
+//   void  vt_vitbc_buf_free(vt_vitbc_buf* b);
+//   int   vt_vitbc_sections_open(const uint8_t* image, size_t len, vt_vitbc_sections** out);
+//   uint64_t vt_vitbc_sections_size(const vt_vitbc_sections* s);
+//   int   vt_vitbc_sections_get(vt_vitbc_sections* s, uint64_t off, uint64_t len, const uint8_t** out);
+//   int   vt_vitbc_sections_load_all(vt_vitbc_sections* s, unsigned threads);
+//   void  vt_vitbc_sections_get_stats(const vt_vitbc_sections* s, vt_vitbc_sections_stats* out);
+//   void  vt_vitbc_sections_free(vt_vitbc_sections* s);
+//   int   vt_vitbc_dict_train(const uint8_t* const* images, const size_t* lens, size_t n,
+//                             size_t capacity, uint16_t id, vt_vitbc_buf* out);
+//   int   vt_vitbc_dict_register(const uint8_t* dict, size_t len);
+//   int   vt_vitbc_dict_unregister(uint16_t id);
+//   const char* vt_vitbc_strerror(int code);
+//
+// Format (flags : bit 0 zstd + bit 1 VT_VITBC_FLAG_FRAMES) : en-tête VITBC inchangé, puis
+//   SECTIONS = trame « skippable » zstd (magic 0x184D2A5E) portant la table de saut
+//     { "VZSK", nframes u32, block u32, 0 u32, raw_size u64, nframes × { csize u32, rsize u32 } }
+//   suivie de nframes trames zstd indépendantes : la trame i décompresse les octets
+//   [i × block, i × block + rsize) des sections. CRC32 et trailer comme loader.rs (CRC sur
+//   les octets écrits). Un décodeur zstd en flux (zstd::stream::read::Decoder côté Rust)
+//   ignore la trame skippable et enchaîne les trames : l’image reste lisible par les
+//   chargeurs existants. Sections tenant en un bloc : une seule trame zstd (taille de contenu
+//   dans l’en-tête de trame), sans table de saut ni bit 1.
+//
+// Dictionnaires (modules courts : motifs répétés d’un fichier à l’autre, pas dans un même
+// fichier) : bit 2 VT_VITBC_FLAG_DICT et identifiant du dictionnaire dans les bits 16..31
+// des flags ; trames zstd compressées avec ce dictionnaire (même identifiant dans leur
+// en-tête). Identifiants dans [32768, 65535] (0..32767 réservés par le format zstd).
+// vt_vitbc_dict_train() entraîne un dictionnaire (ZDICT) sur les sections décompressées
+// d’un corpus d’images et y écrit l’identifiant demandé (0 : dérivé du contenu) ; le
+// chargeur le retrouve dans un registre global (vt_vitbc_dict_register, sûr entre threads).
+//
+// Remarques :
+// - libzstd est chargée à l’exécution (dlopen "libzstd.so.1", LoadLibrary "zstd.dll") : pas de
+//   dépendance à la compilation ; sans elle, VT_VITBC_E_NO_ZSTD.
+// - Entrées acceptées : VITBC v1 (sans trailer, converti en v2), v2 non compressé, v2 zstd en
+//   une seule trame (loader.rs, compress_bytecode.py) ou en trames.
+// - vt_vitbc_sections_get() : décompresse les trames qui recouvrent [off, off + len) au
+//   premier accès (une fois chacune, sûr entre threads) ; le pointeur rendu vit autant que
+//   l’objet. Image non compressée : vue directe ; zstd en une trame : tout au premier accès.
+// - L’image passée à vt_vitbc_sections_open() n’est pas copiée : elle doit lui survivre.
+// - Image avec dictionnaire non enregistré : VT_VITBC_E_DICT à l’ouverture. Un objet ouvert
+//   garde son dictionnaire même après vt_vitbc_dict_unregister().
+// - Les chargeurs existants (loader.rs) ne connaissent pas le bit 2 : n’y passer que des
+//   images sans dictionnaire.
+
+#ifndef VITTE_NATIVE_VITBC_ZSTD_H
+#define VITTE_NATIVE_VITBC_ZSTD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+enum {
+    VT_VITBC_OK = 0,
+    VT_VITBC_E_FORMAT = -1,    // magic, trailer, version ou structure
+    VT_VITBC_E_CRC = -2,       // CRC32 du trailer
+    VT_VITBC_E_ZSTD = -3,      // trame zstd invalide (ou échec de compression)
+    VT_VITBC_E_NO_ZSTD = -4,   // libzstd introuvable
+    VT_VITBC_E_NOMEM = -5,
+    VT_VITBC_E_ARG = -6,
+    VT_VITBC_E_DICT = -7,      // dictionnaire non enregistré, invalide ou non entraînable
+};
+
+enum {
+    VT_VITBC_FLAG_ZSTD = 1u << 0,     // == FLAG_COMPRESSED_ZSTD (loader.rs)
+    VT_VITBC_FLAG_FRAMES = 1u << 1,   // trames indépendantes + table de saut
+    VT_VITBC_FLAG_DICT = 1u << 2,     // trames compressées avec le dictionnaire VT_VITBC_DICT_ID
+};
+
+#define VT_VITBC_DICT_SHIFT 16
+#define VT_VITBC_DICT_ID(flags) ((uint16_t)((flags) >> VT_VITBC_DICT_SHIFT))
+#define VT_VITBC_DICT_MIN_ID 32768u
+
+typedef struct vt_vitbc_zopts {
+    int level;            // niveau zstd (défaut 10, comme compress_bytecode.py)
+    uint32_t block_size;  // octets de sections par trame (défaut 64 Kio, min 4 Kio)
+    unsigned threads;     // 0 : std::thread::hardware_concurrency()
+    uint16_t dict_id;     // 0 : sans dictionnaire ; sinon enregistré (vt_vitbc_dict_register)
+} vt_vitbc_zopts;
+
+typedef struct vt_vitbc_buf {
+    uint8_t* data;   // libérer avec vt_vitbc_buf_free
+    size_t len;
+} vt_vitbc_buf;
+
+typedef struct vt_vitbc_sections vt_vitbc_sections;
+
+typedef struct vt_vitbc_sections_stats {
+    uint64_t raw_size;      // octets de sections décompressés
+    uint32_t frames;        // trames (0 : image non compressée, 1 : zstd en une trame)
+    uint32_t decoded;       // trames déjà décompressées
+    uint64_t decoded_ns;    // temps cumulé de décompression (tous threads)
+} vt_vitbc_sections_stats;
+
+// 1 si libzstd est chargeable.
+VT_API int   vt_vitbc_zstd_available(void);
+VT_API void  vt_vitbc_zopts_default(vt_vitbc_zopts* o);
+// Image VITBC quelconque → v2 en trames (o NULL : défauts).
+VT_API int   vt_vitbc_compress(const uint8_t* in, size_t len, const vt_vitbc_zopts* o, vt_vitbc_buf* out);
+// Image VITBC quelconque → v2 non compressée (threads : 0 = tous les cœurs).
+VT_API int   vt_vitbc_decompress(const uint8_t* in, size_t len, unsigned threads, vt_vitbc_buf* out);
+VT_API void  vt_vitbc_buf_free(vt_vitbc_buf* b);
+
+// Vérifie magic, trailer, CRC et table de saut ; ne décompresse rien.
+VT_API int   vt_vitbc_sections_open(const uint8_t* image, size_t len, vt_vitbc_sections** out);
+VT_API uint64_t vt_vitbc_sections_size(const vt_vitbc_sections* s);
+VT_API int   vt_vitbc_sections_get(vt_vitbc_sections* s, uint64_t off, uint64_t len, const uint8_t** out);
+// Décompresse toutes les trames restantes en parallèle.
+VT_API int   vt_vitbc_sections_load_all(vt_vitbc_sections* s, unsigned threads);
+VT_API void  vt_vitbc_sections_get_stats(const vt_vitbc_sections* s, vt_vitbc_sections_stats* out);
+VT_API void  vt_vitbc_sections_free(vt_vitbc_sections* s);
+
+// Dictionnaire entraîné sur les sections des `n` images (au plus `capacity` octets, 0 :
+// 110 Kio). id : 0 ou [VT_VITBC_DICT_MIN_ID, 65535].
+VT_API int   vt_vitbc_dict_train(const uint8_t* const* images, const size_t* lens, size_t n, size_t capacity,
+                                 uint16_t id, vt_vitbc_buf* out);
+// Copie le dictionnaire ; rend son identifiant (> 0) ou un code d’erreur. Remplace un
+// dictionnaire de même identifiant.
+VT_API int   vt_vitbc_dict_register(const uint8_t* dict, size_t len);
+VT_API int   vt_vitbc_dict_unregister(uint16_t id);
+
+VT_API const char* vt_vitbc_strerror(int code);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_VITBC_ZSTD_H
@@ -0,0 +1,805 @@
+// native/vm_chunk.hpp
+// Décodeur (et encodeur minimal) du format `Chunk` de vitte-core (crates/vitte-core/src/
+// bytecode/chunk.rs, bincode 1 fixint LE) pour le moteur natif `native/vm_interp.cpp`
+// et les outils C++. Header-only.
+//
+// Usage :
+//   vt::Chunk c;
+//   if (auto e = vt::decode_chunk(std::move(bytes), c); e != vt::ChunkError::Ok) {
+//       /* vt::chunk_strerror(e) */
+//   }
+//   for (const vt::ChunkOp& op : c.ops) dispatch(op);
+//
+// Format 1 (bincode) : header { magic "VITC", version u16, flags { stripped u8 }, created u64,
+//   hash u64 } | ops: u64 n, n × (tag u32 + opérande) | consts: u64 n, n × (tag u32 + valeur)
+//   | lines: u64 n, n × { start_pc, line, len } u32 | debug { main_file: Option<String>,
+//   files: Vec<String>, symbols: Vec<(String, u32)> }.
+//
+// Format 2 (à plat, projetable, LE) : header { magic "VITC", version u16 = 2, flags u16
+//   (bit 0 : stripped), created u64, hash u64, nsections u32, dir_offset u32 } (32 octets)
+//   | répertoire : nsections × { id u32, count u32, offset u64, size u64, fnv1a u64 }
+//   | sections alignées sur kChunkSectionAlign, taille fixe par élément :
+//     Ops       count × ChunkOp (8 octets : tag u8, n u8, 0 u16, a u32) — pc → décalage O(1)
+//     Consts    count × { kind u32, ix u32 } (Bool : 0/1 ; I64/F64 : pool ; Str/Bytes : chaîne)
+//     Ints      count × i64          Floats    count × f64
+//     StrOffs   (count + 1) × u32, croissants, dans StrHeap ; StrHeap : octets des chaînes
+//     Symbols   count × { nom u32 (chaîne), pc u32 }
+//     Lines     count × { start_pc, line, len } u32
+//     Files     count × u32 (chaînes) ; [0] = main_file ou kChunkNoString
+//   L’empreinte de l’en-tête couvre le répertoire ; chaque entrée porte celle de sa section :
+//   vérification section par section, dans n’importe quel ordre (Lines : au premier
+//   décodage avec lazy_debug). Ids inconnus ignorés, sections absentes vides ; debug en
+//   dernier (strip = troncature + répertoire réécrit).
+//
+// Remarques :
+// - Les tags d’opcodes suivent l’ordre de `enum Op` (ops.rs) : ne pas réordonner ChunkOpCode.
+// - Les chaînes (constantes, fichiers, symboles) sont des vues sur `Chunk::bytes` : le Chunk
+//   n’est que déplaçable (pas de copie qui laisserait des vues pendantes).
+// - L’empreinte FNV-1a est recalculée sur les plages déjà en mémoire, dans l’ordre de
+//   `Chunk::compute_hash` (ops, consts, lines, puis files, symbols, main_file), sans
+//   re-sérialiser.
+// - encode_chunk() produit un fichier relisible par `Chunk::from_bytes` (benchs, tests
+//   croisés avec la VM Rust) ; les vues d’entrée peuvent pointer n’importe où.
+//   encode_chunk_v2() écrit le format 2 (chaînes dédoublonnées dans StrHeap).
+// - decode_chunk() lit les deux formats (aiguillage sur la version).
+// - lazy_debug : lignes, main_file et files ne sont pas décodés, seulement bornés (les runs
+//   font 12 octets : saut en O(1)) ; Chunk::debug_raw garde leurs plages dans le stockage,
+//   à décoder au premier besoin (vm_debug.hpp). Les symboles restent décodés (table des
+//   fonctions).
+// - decode_chunk_mapped() : stockage externe (fichier projeté), gardé en vie par `keep`.
+
+#ifndef VITTE_NATIVE_VM_CHUNK_HPP
+#define VITTE_NATIVE_VM_CHUNK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vt {
+
+// Miroir de `enum Op` (ops.rs), même ordre que les tags bincode.
+enum class ChunkOpCode : uint8_t {
+    Nop, Return, ReturnVoid,
+    LoadConst, LoadTrue, LoadFalse, LoadNull,
+    LoadLocal, StoreLocal,
+    Add, Sub, Mul, Div, Mod, Neg, Not,
+    Eq, Ne, Lt, Le, Gt, Ge,
+    Jump, JumpIfFalse, Pop,
+    Call, TailCall,
+    Print,
+    MakeClosure, LoadUpvalue, StoreUpvalue,
+};
+inline constexpr uint32_t kChunkOpCount = static_cast<uint32_t>(ChunkOpCode::StoreUpvalue) + 1;
+
+// 8 octets. `a` : ConstIx / LocalIx / UpvalueIx / FuncIx, ou offset i32 (Jump*) ;
+// `n` : argc (Call*) ou nombre d’upvalues (MakeClosure).
+struct ChunkOp {
+    ChunkOpCode code = ChunkOpCode::Nop;
+    uint8_t n = 0;
+    uint16_t pad = 0;
+    uint32_t a = 0;
+
+    int32_t offset() const { return static_cast<int32_t>(a); }
+    // pc + 1 + off (cf. Op::jump_target), en i64 pour la validation.
+    int64_t jump_target(uint32_t pc) const { return int64_t(pc) + 1 + offset(); }
+};
+static_assert(sizeof(ChunkOp) == 8);
+
+enum class ChunkConstKind : uint8_t { Null, Bool, I64, F64, Str, Bytes };
+
+struct ChunkConst {
+    ChunkConstKind kind = ChunkConstKind::Null;
+    bool b = false;
+    int64_t i = 0;
+    double f = 0.0;
+    std::string_view s;   // Str / Bytes
+};
+
+struct ChunkLineRun {
+    uint32_t start_pc = 0;
+    uint32_t line = 0;
+    uint32_t len = 0;
+};
+
+struct ChunkSymbol {
+    std::string_view name;
+    uint32_t pc = 0;
+};
+
+// Sections de debug laissées dans le stockage (lazy_debug). Format 1 : lignes puis
+// main_file et files bincode. Format 2 : section Lines seule (files déjà décodés, petits),
+// empreinte à vérifier au décodage si lines_fnv.
+struct ChunkDebugRaw {
+    bool lazy = false;
+    const uint8_t* lines = nullptr;   // nlines × { start_pc, line, len } u32
+    uint32_t nlines = 0;
+    const uint8_t* main_file = nullptr;   // Option<String> (nullptr en format 2)
+    const uint8_t* files = nullptr;       // Vec<String> (longueur comprise)
+    const uint8_t* end = nullptr;         // fin de files (format 2 : fin des lignes)
+    bool check_lines = false;             // format 2 : empreinte de Lines pas encore vérifiée
+    uint64_t lines_fnv = 0;
+};
+
+enum class ChunkError {
+    Ok = 0,
+    Truncated,
+    BadMagic,
+    BadVersion,
+    BadTag,
+    BadHash,
+    TooBig,
+    BadSection,
+};
+
+inline const char* chunk_strerror(ChunkError e) {
+    switch (e) {
+    case ChunkError::Ok: return "ok";
+    case ChunkError::Truncated: return "Chunk tronqué";
+    case ChunkError::BadMagic: return "Mauvaise empreinte (MAGIC) — pas un chunk VITC";
+    case ChunkError::BadVersion: return "Version de chunk non supportée";
+    case ChunkError::BadTag: return "Tag d’opcode ou de constante invalide";
+    case ChunkError::BadHash: return "Empreinte FNV-1a invalide";
+    case ChunkError::TooBig: return "Taille excessive";
+    case ChunkError::BadSection: return "Section de chunk invalide (bornes, alignement ou taille)";
+    }
+    return "?";
+}
+
+inline constexpr uint16_t kChunkVersion = 1;   // == CHUNK_VERSION
+inline constexpr uint16_t kChunkVersionV2 = 2;   // format à plat (encode_chunk_v2)
+inline constexpr uint32_t kChunkSectionAlign = 64;
+inline constexpr uint32_t kChunkNoString = UINT32_MAX;
+
+// Ids des sections du format 2 (ordre d’écriture).
+enum class ChunkSection : uint32_t {
+    Ops = 1, Consts, Ints, Floats, StrOffs, StrHeap, Symbols, Lines, Files,
+};
+inline constexpr uint32_t kChunkSectionMax = static_cast<uint32_t>(ChunkSection::Files);
+
+struct Chunk {
+    std::vector<uint8_t> bytes;   // stockage des vues (vide si projeté ou construit à la main)
+    std::shared_ptr<const void> keep;   // stockage externe (decode_chunk_mapped)
+    uint16_t version = kChunkVersion;
+    bool stripped = false;
+    uint64_t created_unix_secs = 0;
+    uint64_t hash_fnv1a_64 = 0;
+
+    std::vector<ChunkOp> ops;
+    std::vector<ChunkConst> consts;
+    std::vector<ChunkLineRun> lines;
+    bool has_main_file = false;
+    std::string_view main_file;
+    std::vector<std::string_view> files;
+    std::vector<ChunkSymbol> symbols;
+    ChunkDebugRaw debug_raw;   // lazy_debug : lines/main_file/files vides ci-dessus
+
+    Chunk() = default;
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+    Chunk(Chunk&&) = default;
+    Chunk& operator=(Chunk&&) = default;
+
+    // 0 si pc n’est couvert par aucune entrée. Recherche linéaire, runs décodés seulement
+    // (table compacte et sections paresseuses : vm::DebugInfo).
+    uint32_t line_for_pc(uint32_t pc) const {
+        for (const ChunkLineRun& r : lines) {
+            if (pc >= r.start_pc && pc - r.start_pc < r.len) return r.line;
+        }
+        return 0;
+    }
+};
+
+namespace chunk_detail {
+
+struct Fnv1a64 {
+    uint64_t h = 0xcbf29ce484222325ull;
+    void write(const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            h ^= p[i];
+            h *= 0x100000001b3ull;
+        }
+    }
+};
+
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    size_t pos(const uint8_t* base) const { return static_cast<size_t>(p - base); }
+
+    bool need(size_t n) {
+        if (!ok || static_cast<size_t>(end - p) < n) ok = false;
+        return ok;
+    }
+    template <class T> T get() {
+        T v{};
+        if (need(sizeof(T))) {
+            std::memcpy(&v, p, sizeof(T));   // hôtes little-endian
+            p += sizeof(T);
+        }
+        return v;
+    }
+    // Longueur de séquence bornée par les octets restants (chaque élément ≥ `min_elem`).
+    bool len(size_t min_elem, size_t& n) {
+        const uint64_t v = get<uint64_t>();
+        if (!ok) return false;
+        if (min_elem && v > static_cast<uint64_t>(end - p) / min_elem) {
+            ok = false;
+            return false;
+        }
+        n = static_cast<size_t>(v);
+        return true;
+    }
+    std::string_view str() {
+        size_t n = 0;
+        if (!len(1, n)) return {};
+        std::string_view s(reinterpret_cast<const char*>(p), n);
+        p += n;
+        return s;
+    }
+};
+
+class Writer {
+public:
+    std::vector<uint8_t> out;
+
+    template <class T> void put(T v) {
+        uint8_t b[sizeof(T)];
+        std::memcpy(b, &v, sizeof(T));
+        out.insert(out.end(), b, b + sizeof(T));
+    }
+    void str(std::string_view s) {
+        put<uint64_t>(s.size());
+        out.insert(out.end(), s.begin(), s.end());
+    }
+};
+
+// Opérande bincode par opcode : 0 (aucun), 'c' u32, 'l' u16, 'j' i32, 'n' u8, 'k' u32 + u8.
+inline char operand_kind(ChunkOpCode c) {
+    switch (c) {
+    case ChunkOpCode::LoadConst: return 'c';
+    case ChunkOpCode::LoadLocal:
+    case ChunkOpCode::StoreLocal:
+    case ChunkOpCode::LoadUpvalue:
+    case ChunkOpCode::StoreUpvalue: return 'l';
+    case ChunkOpCode::Jump:
+    case ChunkOpCode::JumpIfFalse: return 'j';
+    case ChunkOpCode::Call:
+    case ChunkOpCode::TailCall: return 'n';
+    case ChunkOpCode::MakeClosure: return 'k';
+    default: return 0;
+    }
+}
+
+// Format 2 : répertoire lu, sections bornées puis décodées par éléments de taille fixe.
+inline ChunkError decode_v2(const uint8_t* base, size_t len, Chunk& out, bool verify_hash, bool lazy_debug) {
+    Reader r{base + 6, base + len};   // après magic et version
+    const uint16_t flags = r.get<uint16_t>();
+    out.created_unix_secs = r.get<uint64_t>();
+    out.hash_fnv1a_64 = r.get<uint64_t>();
+    const uint32_t nsect = r.get<uint32_t>();
+    const uint32_t dir = r.get<uint32_t>();
+    if (!r.ok) return ChunkError::Truncated;
+    if (flags > 1) return ChunkError::BadTag;
+    out.stripped = (flags & 1) != 0;
+    if (dir < 32 || dir > len || nsect > (len - dir) / 32) return ChunkError::Truncated;
+    if (verify_hash) {
+        Fnv1a64 h;
+        h.write(base + dir, size_t{nsect} * 32);
+        if (h.h != out.hash_fnv1a_64) return ChunkError::BadHash;
+    }
+
+    struct Sec {
+        const uint8_t* p = nullptr;
+        uint32_t count = 0;
+        uint64_t size = 0;
+        uint64_t fnv = 0;
+    } sec[kChunkSectionMax + 1];
+    static constexpr uint8_t elem[kChunkSectionMax + 1] = {0, 8, 8, 8, 8, 4, 1, 8, 12, 4};
+    r = Reader{base + dir, base + dir + size_t{nsect} * 32};
+    for (uint32_t i = 0; i < nsect; ++i) {
+        const uint32_t id = r.get<uint32_t>();
+        const uint32_t count = r.get<uint32_t>();
+        const uint64_t off = r.get<uint64_t>();
+        const uint64_t size = r.get<uint64_t>();
+        const uint64_t fnv = r.get<uint64_t>();
+        if (id == 0 || id > kChunkSectionMax) continue;   // section inconnue : ignorée
+        Sec& s = sec[id];
+        if (s.p) return ChunkError::BadSection;   // doublon
+        if (off % 8 || off > len || size > len - off) return ChunkError::BadSection;
+        // StrOffs : count + 1 bornes (aucune si vide) ; StrHeap : octets ; autres : fixe.
+        const auto e = static_cast<ChunkSection>(id);
+        const uint64_t want = e == ChunkSection::StrHeap   ? size
+                              : e == ChunkSection::StrOffs ? (count ? (uint64_t{count} + 1) * 4 : 0)
+                                                           : uint64_t{count} * elem[id];
+        if (size != want) return ChunkError::BadSection;
+        s = Sec{base + off, count, size, fnv};
+    }
+    auto section = [&](ChunkSection id) -> const Sec& { return sec[static_cast<uint32_t>(id)]; };
+    if (verify_hash) {
+        for (uint32_t id = 1; id <= kChunkSectionMax; ++id) {
+            if (!sec[id].p || (lazy_debug && id == static_cast<uint32_t>(ChunkSection::Lines))) continue;
+            Fnv1a64 h;
+            h.write(sec[id].p, static_cast<size_t>(sec[id].size));
+            if (h.h != sec[id].fnv) return ChunkError::BadHash;
+        }
+    }
+    auto u32 = [](const uint8_t* p, size_t i) {
+        uint32_t v;
+        std::memcpy(&v, p + i * 4, 4);
+        return v;
+    };
+
+    // Chaînes : vues sur StrHeap, bornes croissantes.
+    const Sec& so = section(ChunkSection::StrOffs);
+    const Sec& heap = section(ChunkSection::StrHeap);
+    const uint32_t nstr = so.count;
+    if (nstr) {
+        if (u32(so.p, 0) != 0 || u32(so.p, nstr) > heap.size) return ChunkError::BadSection;
+        for (uint32_t i = 0; i < nstr; ++i) {
+            if (u32(so.p, i + 1) < u32(so.p, i)) return ChunkError::BadSection;
+        }
+    }
+    auto str = [&](uint32_t ix, std::string_view& sv) {
+        if (ix >= nstr) return false;
+        const uint32_t b = u32(so.p, ix);
+        sv = std::string_view(reinterpret_cast<const char*>(heap.p + b), u32(so.p, ix + 1) - b);
+        return true;
+    };
+
+    const Sec& ops = section(ChunkSection::Ops);
+    out.ops.resize(ops.count);
+    if (ops.count) std::memcpy(out.ops.data(), ops.p, size_t{ops.count} * 8);
+    for (ChunkOp& op : out.ops) {   // mêmes domaines d’opérandes qu’en format 1
+        if (static_cast<uint32_t>(op.code) >= kChunkOpCount) return ChunkError::BadTag;
+        op.pad = 0;
+        switch (operand_kind(op.code)) {
+        case 'l':
+            if (op.a > 0xFFFF) return ChunkError::BadSection;
+            op.n = 0;
+            break;
+        case 'c': case 'j': op.n = 0; break;
+        case 'n': op.a = 0; break;
+        case 'k': break;
+        default: op.a = 0; op.n = 0; break;
+        }
+    }
+
+    const Sec& ints = section(ChunkSection::Ints);
+    const Sec& floats = section(ChunkSection::Floats);
+    const Sec& ks = section(ChunkSection::Consts);
+    out.consts.resize(ks.count);
+    for (uint32_t i = 0; i < ks.count; ++i) {
+        const uint32_t kind = u32(ks.p, size_t{i} * 2);
+        const uint32_t ix = u32(ks.p, size_t{i} * 2 + 1);
+        ChunkConst& c = out.consts[i];
+        switch (kind) {
+        case 0: c.kind = ChunkConstKind::Null; break;
+        case 1:
+            if (ix > 1) return ChunkError::BadTag;
+            c.kind = ChunkConstKind::Bool;
+            c.b = ix != 0;
+            break;
+        case 2:
+            if (ix >= ints.count) return ChunkError::BadSection;
+            c.kind = ChunkConstKind::I64;
+            std::memcpy(&c.i, ints.p + size_t{ix} * 8, 8);
+            break;
+        case 3:
+            if (ix >= floats.count) return ChunkError::BadSection;
+            c.kind = ChunkConstKind::F64;
+            std::memcpy(&c.f, floats.p + size_t{ix} * 8, 8);
+            break;
+        case 4:
+        case 5:
+            c.kind = kind == 4 ? ChunkConstKind::Str : ChunkConstKind::Bytes;
+            if (!str(ix, c.s)) return ChunkError::BadSection;
+            break;
+        default: return ChunkError::BadTag;
+        }
+    }
+
+    const Sec& syms = section(ChunkSection::Symbols);
+    out.symbols.resize(syms.count);
+    for (uint32_t i = 0; i < syms.count; ++i) {
+        if (!str(u32(syms.p, size_t{i} * 2), out.symbols[i].name)) return ChunkError::BadSection;
+        out.symbols[i].pc = u32(syms.p, size_t{i} * 2 + 1);
+    }
+
+    const Sec& files = section(ChunkSection::Files);
+    if (files.count) {
+        const uint32_t m = u32(files.p, 0);
+        out.has_main_file = m != kChunkNoString;
+        if (out.has_main_file && !str(m, out.main_file)) return ChunkError::BadSection;
+        out.files.resize(files.count - 1);
+        for (uint32_t i = 1; i < files.count; ++i) {
+            if (!str(u32(files.p, i), out.files[i - 1])) return ChunkError::BadSection;
+        }
+    }
+
+    const Sec& lines = section(ChunkSection::Lines);
+    if (lazy_debug) {
+        out.debug_raw.lazy = true;
+        out.debug_raw.lines = lines.p;
+        out.debug_raw.nlines = lines.count;
+        out.debug_raw.end = lines.p ? lines.p + lines.size : nullptr;
+        out.debug_raw.check_lines = verify_hash && lines.p;
+        out.debug_raw.lines_fnv = lines.fnv;
+    } else {
+        out.lines.resize(lines.count);
+        if (lines.count) std::memcpy(out.lines.data(), lines.p, size_t{lines.count} * 12);
+    }
+    return ChunkError::Ok;
+}
+
+// Décode [base, base + len) dans `out` (stockage déjà attaché).
+inline ChunkError decode_into(const uint8_t* base, size_t len, Chunk& out, bool verify_hash, bool lazy_debug) {
+    Reader r{base, base + len};
+
+    if (!r.need(4)) return ChunkError::Truncated;
+    if (std::memcmp(r.p, "VITC", 4) != 0) return ChunkError::BadMagic;
+    r.p += 4;
+    out.version = r.get<uint16_t>();
+    if (r.ok && out.version == kChunkVersionV2) return decode_v2(base, len, out, verify_hash, lazy_debug);
+    const uint8_t stripped = r.get<uint8_t>();
+    out.created_unix_secs = r.get<uint64_t>();
+    out.hash_fnv1a_64 = r.get<uint64_t>();
+    if (!r.ok) return ChunkError::Truncated;
+    if (out.version != kChunkVersion) return ChunkError::BadVersion;
+    if (stripped > 1) return ChunkError::BadTag;
+    out.stripped = stripped != 0;
+
+    // Plages hachées : [ops, consts, lines] contiguës, puis files, symbols, main_file.
+    const uint8_t* body_begin = r.p;
+
+    size_t n = 0;
+    if (!r.len(4, n)) return ChunkError::Truncated;
+    if (n > UINT32_MAX) return ChunkError::TooBig;
+    out.ops.resize(n);
+    for (ChunkOp& op : out.ops) {
+        const uint32_t tag = r.get<uint32_t>();
+        if (!r.ok) return ChunkError::Truncated;
+        if (tag >= kChunkOpCount) return ChunkError::BadTag;
+        op.code = static_cast<ChunkOpCode>(tag);
+        switch (operand_kind(op.code)) {
+        case 'c': op.a = r.get<uint32_t>(); break;
+        case 'l': op.a = r.get<uint16_t>(); break;
+        case 'j': op.a = static_cast<uint32_t>(r.get<int32_t>()); break;
+        case 'n': op.n = r.get<uint8_t>(); break;
+        case 'k': op.a = r.get<uint32_t>(); op.n = r.get<uint8_t>(); break;
+        default: break;
+        }
+    }
+
+    if (!r.len(4, n)) return ChunkError::Truncated;
+    if (n > UINT32_MAX) return ChunkError::TooBig;
+    out.consts.resize(n);
+    for (ChunkConst& c : out.consts) {
+        const uint32_t tag = r.get<uint32_t>();
+        if (!r.ok) return ChunkError::Truncated;
+        switch (tag) {
+        case 0: c.kind = ChunkConstKind::Null; break;
+        case 1: {
+            c.kind = ChunkConstKind::Bool;
+            const uint8_t b = r.get<uint8_t>();
+            if (b > 1) return ChunkError::BadTag;
+            c.b = b != 0;
+            break;
+        }
+        case 2: c.kind = ChunkConstKind::I64; c.i = r.get<int64_t>(); break;
+        case 3: c.kind = ChunkConstKind::F64; c.f = r.get<double>(); break;
+        case 4: c.kind = ChunkConstKind::Str; c.s = r.str(); break;
+        case 5: c.kind = ChunkConstKind::Bytes; c.s = r.str(); break;
+        default: return ChunkError::BadTag;
+        }
+    }
+
+    if (!r.len(12, n)) return ChunkError::Truncated;
+    if (n > UINT32_MAX) return ChunkError::TooBig;
+    if (lazy_debug) {
+        out.debug_raw.lazy = true;
+        out.debug_raw.lines = r.p;
+        out.debug_raw.nlines = static_cast<uint32_t>(n);
+        r.p += n * 12;
+    } else {
+        out.lines.resize(n);
+        for (ChunkLineRun& l : out.lines) {
+            l.start_pc = r.get<uint32_t>();
+            l.line = r.get<uint32_t>();
+            l.len = r.get<uint32_t>();
+        }
+    }
+    const uint8_t* body_end = r.p;
+
+    const uint8_t* main_begin = r.p;
+    const uint8_t opt = r.get<uint8_t>();
+    if (!r.ok) return ChunkError::Truncated;
+    if (opt > 1) return ChunkError::BadTag;
+    if (opt == 1) {
+        const std::string_view m = r.str();
+        if (!lazy_debug) {
+            out.has_main_file = true;
+            out.main_file = m;
+        }
+    }
+    const uint8_t* main_end = r.p;
+
+    const uint8_t* files_begin = r.p;
+    if (!r.len(8, n)) return ChunkError::Truncated;
+    if (!lazy_debug) out.files.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const std::string_view f = r.str();   // bornée même en lazy_debug
+        if (!lazy_debug) out.files[i] = f;
+    }
+    const uint8_t* files_end = r.p;
+    if (lazy_debug) {
+        out.debug_raw.main_file = main_begin;
+        out.debug_raw.files = files_begin;
+        out.debug_raw.end = files_end;
+    }
+
+    if (!r.len(12, n)) return ChunkError::Truncated;
+    out.symbols.resize(n);
+    for (ChunkSymbol& s : out.symbols) {
+        s.name = r.str();
+        s.pc = r.get<uint32_t>();
+    }
+    const uint8_t* syms_end = r.p;
+    if (!r.ok) return ChunkError::Truncated;
+
+    if (verify_hash) {
+        Fnv1a64 h;
+        h.write(body_begin, static_cast<size_t>(body_end - body_begin));
+        h.write(files_begin, static_cast<size_t>(files_end - files_begin));
+        h.write(files_end, static_cast<size_t>(syms_end - files_end));
+        h.write(main_begin, static_cast<size_t>(main_end - main_begin));
+        if (h.h != out.hash_fnv1a_64) return ChunkError::BadHash;
+    }
+    return ChunkError::Ok;
+}
+
+} // namespace chunk_detail
+
+// Décode `bytes` (repris par `out`). verify_hash : compare l’empreinte de l’en-tête.
+inline ChunkError decode_chunk(std::vector<uint8_t> bytes, Chunk& out, bool verify_hash = true,
+                               bool lazy_debug = false) {
+    out = Chunk{};
+    out.bytes = std::move(bytes);
+    return chunk_detail::decode_into(out.bytes.data(), out.bytes.size(), out, verify_hash, lazy_debug);
+}
+
+// Décode un stockage externe (projection de fichier…) sans copie ; `keep` le garde en vie
+// autant que `out` (les vues pointent dedans).
+inline ChunkError decode_chunk_mapped(std::shared_ptr<const void> keep, const uint8_t* data, size_t len,
+                                      Chunk& out, bool verify_hash = true, bool lazy_debug = false) {
+    out = Chunk{};
+    out.keep = std::move(keep);
+    return chunk_detail::decode_into(data, len, out, verify_hash, lazy_debug);
+}
+
+// Décodage différé de debug_raw (plages déjà bornées par decode_chunk) ; false si `c` n’est
+// pas paresseux. Format 2 : lignes ignorées si l’empreinte de leur section est fausse.
+inline bool decode_debug(const Chunk& c, std::vector<ChunkLineRun>& lines, std::string_view& main_file,
+                         bool& has_main_file, std::vector<std::string_view>& files) {
+    using namespace chunk_detail;
+    const ChunkDebugRaw& d = c.debug_raw;
+    if (!d.lazy) return false;
+    if (!d.main_file) {   // format 2
+        lines.clear();
+        bool ok = true;
+        if (d.check_lines) {
+            Fnv1a64 h;
+            h.write(d.lines, static_cast<size_t>(d.end - d.lines));
+            ok = h.h == d.lines_fnv;
+        }
+        if (ok && d.nlines) {
+            lines.resize(d.nlines);
+            std::memcpy(lines.data(), d.lines, size_t{d.nlines} * 12);
+        }
+        has_main_file = c.has_main_file;
+        main_file = c.main_file;
+        files = c.files;
+        return true;
+    }
+    Reader r{d.lines, d.end};
+    lines.resize(d.nlines);
+    for (ChunkLineRun& l : lines) {
+        l.start_pc = r.get<uint32_t>();
+        l.line = r.get<uint32_t>();
+        l.len = r.get<uint32_t>();
+    }
+    has_main_file = r.get<uint8_t>() == 1;
+    if (has_main_file) main_file = r.str();
+    size_t n = 0;
+    r.len(8, n);
+    files.resize(n);
+    for (std::string_view& f : files) f = r.str();
+    return r.ok;
+}
+
+// Sérialise `c` (en-tête recalculé : magic, version, empreinte ; `created` fourni).
+inline std::vector<uint8_t> encode_chunk(const Chunk& c, uint64_t created_unix_secs = 0) {
+    using namespace chunk_detail;
+    Writer body;
+    body.put<uint64_t>(c.ops.size());
+    for (const ChunkOp& op : c.ops) {
+        body.put<uint32_t>(static_cast<uint32_t>(op.code));
+        switch (operand_kind(op.code)) {
+        case 'c': body.put<uint32_t>(op.a); break;
+        case 'l': body.put<uint16_t>(static_cast<uint16_t>(op.a)); break;
+        case 'j': body.put<int32_t>(op.offset()); break;
+        case 'n': body.put<uint8_t>(op.n); break;
+        case 'k': body.put<uint32_t>(op.a); body.put<uint8_t>(op.n); break;
+        default: break;
+        }
+    }
+    body.put<uint64_t>(c.consts.size());
+    for (const ChunkConst& k : c.consts) {
+        body.put<uint32_t>(static_cast<uint32_t>(k.kind));
+        switch (k.kind) {
+        case ChunkConstKind::Null: break;
+        case ChunkConstKind::Bool: body.put<uint8_t>(k.b ? 1 : 0); break;
+        case ChunkConstKind::I64: body.put<int64_t>(k.i); break;
+        case ChunkConstKind::F64: body.put<double>(k.f); break;
+        case ChunkConstKind::Str:
+        case ChunkConstKind::Bytes: body.str(k.s); break;
+        }
+    }
+    body.put<uint64_t>(c.lines.size());
+    for (const ChunkLineRun& l : c.lines) {
+        body.put<uint32_t>(l.start_pc);
+        body.put<uint32_t>(l.line);
+        body.put<uint32_t>(l.len);
+    }
+    Writer main_file, files, syms;
+    main_file.put<uint8_t>(c.has_main_file ? 1 : 0);
+    if (c.has_main_file) main_file.str(c.main_file);
+    files.put<uint64_t>(c.files.size());
+    for (std::string_view f : c.files) files.str(f);
+    syms.put<uint64_t>(c.symbols.size());
+    for (const ChunkSymbol& s : c.symbols) {
+        syms.str(s.name);
+        syms.put<uint32_t>(s.pc);
+    }
+
+    Fnv1a64 h;
+    h.write(body.out.data(), body.out.size());
+    h.write(files.out.data(), files.out.size());
+    h.write(syms.out.data(), syms.out.size());
+    h.write(main_file.out.data(), main_file.out.size());
+
+    Writer w;
+    w.out.reserve(23 + body.out.size() + main_file.out.size() + files.out.size() + syms.out.size());
+    w.out.insert(w.out.end(), {'V', 'I', 'T', 'C'});
+    w.put<uint16_t>(kChunkVersion);
+    w.put<uint8_t>(c.stripped ? 1 : 0);
+    w.put<uint64_t>(created_unix_secs);
+    w.put<uint64_t>(h.h);
+    for (const Writer* part : {&body, &main_file, &files, &syms}) {
+        w.out.insert(w.out.end(), part->out.begin(), part->out.end());
+    }
+    return std::move(w.out);
+}
+
+// Sérialise `c` au format 2 (sections alignées, empreinte par section).
+inline std::vector<uint8_t> encode_chunk_v2(const Chunk& c, uint64_t created_unix_secs = 0) {
+    using namespace chunk_detail;
+    // Table des chaînes, dédoublonnées.
+    std::vector<std::string_view> strs;
+    std::unordered_map<std::string_view, uint32_t> str_ix;
+    auto intern = [&](std::string_view s) {
+        auto [it, fresh] = str_ix.try_emplace(s, static_cast<uint32_t>(strs.size()));
+        if (fresh) strs.push_back(s);
+        return it->second;
+    };
+
+    Writer ops, consts, ints, floats, offs, heap, syms, lines, files;
+    for (const ChunkOp& op : c.ops) {
+        ChunkOp o = op;
+        o.pad = 0;
+        uint8_t b[8];
+        std::memcpy(b, &o, 8);
+        ops.out.insert(ops.out.end(), b, b + 8);
+    }
+    uint32_t nints = 0, nfloats = 0;
+    for (const ChunkConst& k : c.consts) {
+        uint32_t ix = 0;
+        switch (k.kind) {
+        case ChunkConstKind::Null: break;
+        case ChunkConstKind::Bool: ix = k.b ? 1 : 0; break;
+        case ChunkConstKind::I64: ints.put<int64_t>(k.i); ix = nints++; break;
+        case ChunkConstKind::F64: floats.put<double>(k.f); ix = nfloats++; break;
+        case ChunkConstKind::Str:
+        case ChunkConstKind::Bytes: ix = intern(k.s); break;
+        }
+        consts.put<uint32_t>(static_cast<uint32_t>(k.kind));
+        consts.put<uint32_t>(ix);
+    }
+    for (const ChunkSymbol& s : c.symbols) {
+        syms.put<uint32_t>(intern(s.name));
+        syms.put<uint32_t>(s.pc);
+    }
+    for (const ChunkLineRun& l : c.lines) {
+        lines.put<uint32_t>(l.start_pc);
+        lines.put<uint32_t>(l.line);
+        lines.put<uint32_t>(l.len);
+    }
+    if (c.has_main_file || !c.files.empty()) {
+        files.put<uint32_t>(c.has_main_file ? intern(c.main_file) : kChunkNoString);
+        for (std::string_view f : c.files) files.put<uint32_t>(intern(f));
+    }
+    if (!strs.empty()) {
+        uint32_t at = 0;
+        offs.put<uint32_t>(0);
+        for (std::string_view s : strs) {
+            heap.out.insert(heap.out.end(), s.begin(), s.end());
+            at += static_cast<uint32_t>(s.size());
+            offs.put<uint32_t>(at);
+        }
+    }
+
+    struct Part {
+        ChunkSection id;
+        const Writer* w;
+        size_t count;
+    };
+    const Part parts[] = {
+        {ChunkSection::Ops, &ops, c.ops.size()},
+        {ChunkSection::Consts, &consts, c.consts.size()},
+        {ChunkSection::Ints, &ints, nints},
+        {ChunkSection::Floats, &floats, nfloats},
+        {ChunkSection::StrOffs, &offs, strs.size()},
+        {ChunkSection::StrHeap, &heap, heap.out.size()},
+        {ChunkSection::Symbols, &syms, c.symbols.size()},
+        {ChunkSection::Lines, &lines, c.lines.size()},
+        {ChunkSection::Files, &files, files.out.size() / 4},
+    };
+    constexpr uint32_t nsect = sizeof(parts) / sizeof(parts[0]);
+    auto align = [](size_t v) { return (v + kChunkSectionAlign - 1) & ~size_t{kChunkSectionAlign - 1}; };
+
+    // Sections vides : décalage 0, sans bourrage ; le fichier finit avec la dernière section
+    // non vide (aucun octet hors empreintes en queue).
+    Writer dir;
+    size_t end = 32 + nsect * 32;
+    for (const Part& s : parts) {
+        const size_t size = s.w->out.size();
+        const size_t at = size ? align(end) : 0;
+        Fnv1a64 h;
+        h.write(s.w->out.data(), size);
+        dir.put<uint32_t>(static_cast<uint32_t>(s.id));
+        dir.put<uint32_t>(static_cast<uint32_t>(s.count));
+        dir.put<uint64_t>(at);
+        dir.put<uint64_t>(size);
+        dir.put<uint64_t>(h.h);
+        if (size) end = at + size;
+    }
+    Fnv1a64 h;
+    h.write(dir.out.data(), dir.out.size());
+
+    Writer w;
+    w.out.reserve(end);
+    w.out.insert(w.out.end(), {'V', 'I', 'T', 'C'});
+    w.put<uint16_t>(kChunkVersionV2);
+    w.put<uint16_t>(c.stripped ? 1 : 0);
+    w.put<uint64_t>(created_unix_secs);
+    w.put<uint64_t>(h.h);
+    w.put<uint32_t>(nsect);
+    w.put<uint32_t>(32);
+    w.out.insert(w.out.end(), dir.out.begin(), dir.out.end());
+    for (const Part& s : parts) {
+        if (s.w->out.empty()) continue;
+        w.out.resize(align(w.out.size()), 0);
+        w.out.insert(w.out.end(), s.w->out.begin(), s.w->out.end());
+    }
+    return std::move(w.out);
+}
+
+} // namespace vt
+
+#endif // VITTE_NATIVE_VM_CHUNK_HPP
@@ -0,0 +1,172 @@
+// native/vm_debug.hpp
+// Infos de debug du moteur natif : table des lignes compacte et chargement paresseux des
+// sections de debug d’un Chunk (cf. vm_chunk.hpp, lazy_debug).
+//
+// Table des lignes (LineTable) :
+//   - runs triés par start_pc, disjoints, codés en varints : écart depuis la fin du run
+//     précédent, longueur, delta de ligne zigzag ; 2 à 4 octets par run en pratique (12
+//     dans le chunk) ;
+//   - un échantillon tous les kLineSample runs (pc de début, décalage, ligne et fin
+//     précédentes) : recherche dichotomique sur les pcs échantillonnés puis au plus
+//     kLineSample runs décodés.
+//
+// DebugInfo : construit la table (et décode main_file / files) au premier appel, puis
+// réutilise le résultat ; sûr entre threads (std::call_once). Le programme n’en paie rien
+// tant qu’aucune erreur ni trace ne demande de ligne.
+//
+// Remarques :
+// - Runs qui se chevauchent (le compilateur n’en produit pas) : le plus petit start_pc
+//   l’emporte, les suivants sont rognés. Runs vides ignorés.
+// - Le Chunk doit survivre au DebugInfo (vues sur son stockage).
+
+#ifndef VITTE_NATIVE_VM_DEBUG_HPP
+#define VITTE_NATIVE_VM_DEBUG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "vm_chunk.hpp"
+
+namespace vt::vm {
+
+inline constexpr uint32_t kLineSample = 16;
+
+class LineTable {
+public:
+    LineTable() = default;
+
+    explicit LineTable(std::vector<ChunkLineRun> runs) {
+        std::stable_sort(runs.begin(), runs.end(),
+                         [](const ChunkLineRun& a, const ChunkLineRun& b) { return a.start_pc < b.start_pc; });
+        uint64_t end = 0;    // fin du run précédent (exclue)
+        uint32_t line = 0;   // ligne du run précédent
+        for (const ChunkLineRun& r : runs) {
+            uint64_t start = r.start_pc;
+            const uint64_t stop = std::min<uint64_t>(static_cast<uint64_t>(r.start_pc) + r.len, UINT32_MAX);
+            start = std::max(start, end);   // chevauchement : rogné
+            if (stop <= start) continue;
+            if (nruns_ % kLineSample == 0) {
+                samples_.push_back(Sample{static_cast<uint32_t>(start), static_cast<uint32_t>(bytes_.size()),
+                                          line, static_cast<uint32_t>(end)});
+            }
+            put(start - end);
+            put(stop - start);
+            const int64_t d = static_cast<int64_t>(r.line) - static_cast<int64_t>(line);
+            put((static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63));
+            end = stop;
+            line = r.line;
+            ++nruns_;
+        }
+        bytes_.shrink_to_fit();
+        samples_.shrink_to_fit();
+    }
+
+    // 0 si pc n’est couvert par aucun run.
+    uint32_t line_for_pc(uint32_t pc) const {
+        auto it = std::upper_bound(samples_.begin(), samples_.end(), pc,
+                                   [](uint32_t v, const Sample& s) { return v < s.pc; });
+        if (it == samples_.begin()) return 0;
+        --it;
+        const uint8_t* p = bytes_.data() + it->off;
+        const uint8_t* const e = bytes_.data() + bytes_.size();
+        uint64_t end = it->end;
+        uint32_t line = it->line;
+        for (uint32_t i = 0; i < kLineSample && p < e; ++i) {
+            const uint64_t start = end + get(p);
+            const uint64_t len = get(p);
+            const uint64_t z = get(p);
+            line = static_cast<uint32_t>(line + static_cast<uint32_t>((z >> 1) ^ (0 - (z & 1))));
+            if (pc < start) return 0;
+            if (pc - start < len) return line;
+            end = start + len;
+        }
+        return 0;
+    }
+
+    size_t runs() const { return nruns_; }
+    // Octets occupés (runs codés + échantillons).
+    size_t bytes() const { return bytes_.size() + samples_.size() * sizeof(Sample); }
+
+private:
+    struct Sample {
+        uint32_t pc;     // début du run échantillonné
+        uint32_t off;    // son décalage dans bytes_
+        uint32_t line;   // ligne du run précédent
+        uint32_t end;    // fin du run précédent
+    };
+
+    void put(uint64_t v) {
+        while (v >= 0x80) {
+            bytes_.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        bytes_.push_back(static_cast<uint8_t>(v));
+    }
+    static uint64_t get(const uint8_t*& p) {
+        uint64_t v = 0;
+        for (unsigned s = 0;; s += 7) {
+            const uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << s;
+            if (!(b & 0x80)) return v;
+        }
+    }
+
+    std::vector<uint8_t> bytes_;
+    std::vector<Sample> samples_;
+    size_t nruns_ = 0;
+};
+
+class DebugInfo {
+public:
+    explicit DebugInfo(const Chunk* c = nullptr) : chunk_(c) {}
+    DebugInfo(const DebugInfo&) = delete;
+    DebugInfo& operator=(const DebugInfo&) = delete;
+
+    void attach(const Chunk* c) { chunk_ = c; }
+
+    uint32_t line_for_pc(uint32_t pc) const { return get().lines.line_for_pc(pc); }
+    const std::vector<std::string_view>& files() const { return get().files; }
+    // Vide si le chunk n’en a pas.
+    std::string_view main_file() const { return get().main_file; }
+
+    bool loaded() const { return loaded_.load(std::memory_order_acquire); }
+    size_t line_bytes() const { return loaded() ? data_.lines.bytes() : 0; }
+
+private:
+    struct Data {
+        LineTable lines;
+        std::string_view main_file;
+        std::vector<std::string_view> files;
+    };
+
+    const Data& get() const {
+        std::call_once(once_, [this] {
+            if (!chunk_) return;
+            std::vector<ChunkLineRun> runs;
+            bool has_main = false;
+            if (decode_debug(*chunk_, runs, data_.main_file, has_main, data_.files)) {
+                data_.lines = LineTable(std::move(runs));
+            } else {
+                data_.lines = LineTable(chunk_->lines);
+                data_.main_file = chunk_->has_main_file ? chunk_->main_file : std::string_view{};
+                data_.files = chunk_->files;
+            }
+            loaded_.store(true, std::memory_order_release);
+        });
+        return data_;
+    }
+
+    const Chunk* chunk_;
+    mutable std::once_flag once_;
+    mutable std::atomic<bool> loaded_{false};
+    mutable Data data_;
+};
+
+} // namespace vt::vm
+
+#endif // VITTE_NATIVE_VM_DEBUG_HPP
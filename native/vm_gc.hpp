@@ -0,0 +1,483 @@
+// native/vm_gc.hpp
+// Tas générationnel du moteur natif (objets créés à l’exécution : fermetures). Header-only,
+// inclus par vm_interp.cpp.
+//
+// - Nursery : une zone contiguë, allocation par incrément de pointeur (chemin rapide en
+//   ligne dans les handlers). Pleine : collecte mineure par copie — les survivants sont
+//   promus dans l’ancienne génération, un pointeur de renvoi reste à leur ancienne place.
+// - Ancienne génération : mark-region (à la Immix) — blocs de 32 Kio alignés, lignes de
+//   128 o. Une collecte majeure marque les objets et les lignes qu’ils couvrent ; les
+//   lignes libres des blocs forment les trous où reprend l’allocation par incrément, les
+//   blocs vides retournent à la réserve. Pas de déplacement : seuls les objets jeunes bougent.
+//   Objets > 8 Kio : liste à part (marquage/balayage).
+// - Racines exactes, fournies par la VM à chaque collecte (foncteur roots(visit)) : pile de
+//   registres jusqu’au sommet courant, fermetures des frames, valeurs possédées. Depuis le
+//   code JIT, le sommet est la profondeur statique de l’op (carte de pile issue des deltas
+//   de pile de l’Op, cf. vm_jit.hpp) ; l’interpréteur a son sp exact.
+// - Barrière d’écriture : une ancienne fermeture qui reçoit une valeur non ancienne (objet
+//   jeune, tableau hôte) entre dans l’ensemble mémorisé, racine de la collecte mineure.
+//
+// Remarques :
+// - Bits de vt_obj.flags : F_HEAP (objet du tas), F_OLD, F_REM, F_FWD, F_MARK, F_LARGE. Les
+//   objets statiques (constantes, hôtes) ont flags = 0 et ne sont jamais déplacés ; les
+//   tableaux hôtes sont parcourus (ils peuvent contenir des fermetures).
+// - Un objet déplacé change d’adresse : la VM invalide les clés objet des caches d’appel.
+// - reset() (début de run) libère tout : les fermetures vivent au plus jusqu’au run suivant.
+
+#ifndef VITTE_NATIVE_VM_GC_HPP
+#define VITTE_NATIVE_VM_GC_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "vm_value.hpp"
+
+namespace vt::vm::gc {
+
+enum : uint8_t {
+    F_HEAP = 1u << 0,
+    F_OLD = 1u << 1,
+    F_REM = 1u << 2,    // dans l’ensemble mémorisé
+    F_FWD = 1u << 3,    // déplacé : nouvelle adresse à l’offset 8
+    F_MARK = 1u << 4,   // sens alterné à chaque collecte majeure
+    F_LARGE = 1u << 5,
+};
+
+constexpr size_t kLine = 128;
+constexpr size_t kBlock = 32 * 1024;
+constexpr size_t kLines = kBlock / kLine;
+constexpr size_t kMetaLines = (kLines + kLine - 1) / kLine;   // marques de lignes en tête de bloc
+constexpr size_t kMaxSmall = 8 * 1024;
+
+enum EventKind : int { Minor = 0, Major = 1 };
+
+struct Event {
+    int kind;
+    uint64_t pause_ns;
+    uint64_t live_bytes;    // mineure : promus ; majeure : ancienne génération vivante
+    uint64_t freed_bytes;
+};
+
+struct Stats {
+    uint64_t minor = 0;
+    uint64_t major = 0;
+    uint64_t pause_ns = 0;
+    uint64_t max_pause_ns = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t promoted_bytes = 0;
+    uint64_t old_bytes = 0;
+    uint64_t heap_bytes = 0;
+};
+
+using EventFn = void (*)(void* user, const Event& e);
+
+// Taille d’un objet du tas (seules les fermetures y vivent).
+inline size_t obj_size(const Obj* o) {
+    return sizeof(Closure) + sizeof(Value) * static_cast<const Closure*>(o)->n;
+}
+
+// Champs valeur d’un objet : upvalues d’une fermeture, éléments d’un tableau hôte.
+template <class F> inline void visit_children(Obj* o, F& f) {
+    if (o->kind == ObjKind::Closure) {
+        auto* c = static_cast<Closure*>(o);
+        for (uint32_t i = 0; i < c->n; ++i) f(c->upv()[i]);
+    } else if (static_cast<int>(o->kind) == VT_OBJ_ARRAY && o->rc != VT_OBJ_STATIC) {
+        auto* a = reinterpret_cast<vt_array*>(o);
+        auto* items = const_cast<Value*>(a->items);   // mis à jour en place si une fermeture bouge
+        for (size_t i = 0; i < a->len; ++i) f(items[i]);
+    }
+}
+
+template <class F> inline void visit_closure(F& f, Closure*& c) {
+    if (!c) return;
+    Value v = from_obj(c);
+    f(v);
+    c = static_cast<Closure*>(as_obj(v));
+}
+
+class Heap {
+public:
+    Heap() = default;
+    Heap(const Heap&) = delete;
+    Heap& operator=(const Heap&) = delete;
+    ~Heap() {
+        reset();
+        for (uint8_t* b : free_) std::free(b);
+        std::free(nbase_);
+    }
+
+    bool init(size_t nursery_bytes, size_t major_bytes) {
+        nursery_bytes = std::max<size_t>(nursery_bytes, 64 * 1024) & ~size_t(7);
+        nbase_ = static_cast<uint8_t*>(std::malloc(nursery_bytes));
+        if (!nbase_) return false;
+        ncur_ = nbase_;
+        nend_ = nbase_ + nursery_bytes;
+        major_min_ = trigger_ = std::max<size_t>(major_bytes, kBlock);
+        stats_.heap_bytes = nursery_bytes;
+        return true;
+    }
+
+    void set_hook(EventFn fn, void* user) {
+        hook_ = fn;
+        hook_user_ = user;
+    }
+
+    Stats stats() const {
+        Stats s = stats_;
+        s.allocated_bytes += static_cast<uint64_t>(ncur_ - nbase_);
+        return s;
+    }
+
+    // Chemin rapide : nullptr si la nursery est pleine.
+    VT_VM_INLINE void* alloc_fast(size_t n) {
+        n = (n + 7) & ~size_t(7);
+        if (n <= static_cast<size_t>(nend_ - ncur_)) {
+            void* p = ncur_;
+            ncur_ += n;
+            return p;
+        }
+        return nullptr;
+    }
+
+    // Collecte mineure (et majeure au seuil), puis allocation. nullptr : mémoire épuisée ;
+    // std::bad_alloc possible (la VM abandonne alors le run, le tas repart au reset()).
+    // *flags : bits à poser dans l’en-tête du nouvel objet (F_HEAP, F_OLD…), le reste de
+    // l’en-tête est à initialiser par l’appelant.
+    template <class R> void* alloc_slow(size_t n, R&& roots, uint8_t* flags) {
+        n = (n + 7) & ~size_t(7);
+        if (n > static_cast<size_t>(nend_ - nbase_) / 4) {
+            if (promoted_since_major_ >= trigger_) {
+                if (!minor(roots)) return nullptr;
+                major(roots);
+            }
+            return alloc_direct(n, flags);
+        }
+        if (!minor(roots)) return nullptr;
+        if (promoted_since_major_ >= trigger_) major(roots);
+        *flags = F_HEAP;
+        return alloc_fast(n);
+    }
+
+    // Vrai si l’écriture de v dans un champ de o doit passer par remember(o).
+    static VT_VM_INLINE bool needs_barrier(const Obj* o, Value v) {
+        if (!(o->flags & F_OLD) || (o->flags & F_REM) || !is_obj(v)) return false;
+        const Obj* t = as_obj(v);
+        return (t->flags & F_HEAP) ? (t->flags & F_OLD) == 0 : t->rc != VT_OBJ_STATIC;
+    }
+
+    void remember(Obj* o) {   // std::bad_alloc possible
+        remembered_.push_back(o);
+        o->flags |= F_REM;
+    }
+
+    // Fin de vie de tous les objets (début de run).
+    void reset() {
+        stats_.allocated_bytes += static_cast<uint64_t>(ncur_ - nbase_);
+        ncur_ = nbase_;
+        for (Obj* o : large_) std::free(o);
+        large_.clear();
+        for (uint8_t* b : blocks_) {
+            if (free_.size() < kKeepBlocks) {
+                free_.push_back(b);
+            } else {
+                std::free(b);
+            }
+        }
+        blocks_.clear();
+        recycle_.clear();
+        next_recycle_ = 0;
+        ocur_ = oend_ = nullptr;
+        oblock_ = nullptr;
+        remembered_.clear();
+        promoted_since_major_ = 0;
+        trigger_ = major_min_;
+        stats_.old_bytes = 0;
+        stats_.heap_bytes = static_cast<uint64_t>(nend_ - nbase_) + free_.size() * kBlock;
+    }
+
+private:
+    static constexpr size_t kKeepBlocks = 64;
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    static uint8_t* block_of(const void* p) {
+        return reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t(kBlock) - 1));
+    }
+
+    bool marked(const Obj* o) const { return ((o->flags & F_MARK) != 0) == sense_; }
+    void set_mark(Obj* o) const { o->flags = static_cast<uint8_t>(sense_ ? (o->flags | F_MARK) : (o->flags & ~F_MARK)); }
+
+    void report(int kind, uint64_t t0, uint64_t live, uint64_t freed) {
+        const uint64_t dt = now_ns() - t0;
+        stats_.pause_ns += dt;
+        stats_.max_pause_ns = std::max(stats_.max_pause_ns, dt);
+        if (hook_) hook_(hook_user_, Event{kind, dt, live, freed});
+    }
+
+    // --- Ancienne génération ----------------------------------------------------------
+
+    uint8_t* new_block() {
+        uint8_t* b;
+        if (!free_.empty()) {
+            b = free_.back();
+            free_.pop_back();
+        } else {
+            b = static_cast<uint8_t*>(std::aligned_alloc(kBlock, kBlock));
+            if (!b) return nullptr;
+            stats_.heap_bytes += kBlock;
+        }
+        std::memset(b, 0, kMetaLines * kLine);   // aucune ligne marquée
+        blocks_.push_back(b);
+        return b;
+    }
+
+    // Prochain trou (lignes libres contiguës) du bloc courant ou des blocs recyclables.
+    bool next_hole() {
+        for (;;) {
+            if (oblock_) {
+                const uint8_t* marks = oblock_;
+                size_t l = static_cast<size_t>(oend_ - oblock_) / kLine;
+                while (l < kLines && marks[l] == epoch_) ++l;
+                if (l < kLines) {
+                    size_t e = l;
+                    while (e < kLines && marks[e] != epoch_) ++e;
+                    ocur_ = oblock_ + l * kLine;
+                    oend_ = oblock_ + e * kLine;
+                    return true;
+                }
+            }
+            if (next_recycle_ >= recycle_.size()) return false;
+            oblock_ = recycle_[next_recycle_++];
+            ocur_ = oend_ = oblock_ + kMetaLines * kLine;
+        }
+    }
+
+    void* alloc_old(size_t n) {
+        if (n > static_cast<size_t>(oend_ - ocur_)) {
+            while (next_hole()) {
+                if (n <= static_cast<size_t>(oend_ - ocur_)) break;
+            }
+            if (n > static_cast<size_t>(oend_ - ocur_)) {
+                uint8_t* b = new_block();
+                if (!b) return nullptr;
+                oblock_ = b;
+                ocur_ = b + kMetaLines * kLine;
+                oend_ = b + kBlock;
+            }
+        }
+        void* p = ocur_;
+        ocur_ += n;
+        return p;
+    }
+
+    // Allocation directement en ancienne génération (objets gros pour la nursery).
+    void* alloc_direct(size_t n, uint8_t* flags) {
+        remembered_.reserve(remembered_.size() + 1);
+        Obj* o;
+        if (n > kMaxSmall) {
+            o = static_cast<Obj*>(std::malloc(n));
+            if (!o) return nullptr;
+            large_.push_back(o);
+            stats_.heap_bytes += n;
+            o->flags = F_HEAP | F_OLD | F_LARGE;
+        } else {
+            o = static_cast<Obj*>(alloc_old(n));
+            if (!o) return nullptr;
+            o->flags = F_HEAP | F_OLD;
+        }
+        set_mark(o);
+        o->flags |= F_REM;   // ses champs seront remplis sans barrière
+        remembered_.push_back(o);
+        *flags = o->flags;
+        stats_.allocated_bytes += n;
+        promoted_since_major_ += n;
+        stats_.old_bytes += n;
+        return o;
+    }
+
+    // --- Collecte mineure -------------------------------------------------------------
+
+    Obj* evacuate(Obj* o) {
+        if (o->flags & F_FWD) {
+            Obj* to;
+            std::memcpy(&to, reinterpret_cast<uint8_t*>(o) + 8, sizeof(to));
+            return to;
+        }
+        const size_t n = (obj_size(o) + 7) & ~size_t(7);
+        auto* to = static_cast<Obj*>(alloc_old(n));   // capacité réservée par minor()
+        std::memcpy(to, o, n);
+        to->flags = static_cast<uint8_t>((to->flags | F_OLD) & ~(F_REM | F_FWD));
+        set_mark(to);
+        o->flags |= F_FWD;
+        std::memcpy(reinterpret_cast<uint8_t*>(o) + 8, &to, sizeof(to));
+        work_.push_back(to);
+        promoted_ += n;
+        return to;
+    }
+
+    template <class R> bool minor(R& roots) {
+        const uint64_t t0 = now_ns();
+        const size_t used = static_cast<size_t>(ncur_ - nbase_);
+        // Réserve : de quoi promouvoir toute la nursery sans échec en cours de copie.
+        const size_t need = used / (kBlock - kMetaLines * kLine - kMaxSmall) + 1;
+        blocks_.reserve(blocks_.size() + need);
+        if (free_.size() < need) {
+            free_.reserve(need);
+            while (free_.size() < need) {
+                auto* b = static_cast<uint8_t*>(std::aligned_alloc(kBlock, kBlock));
+                if (!b) return false;
+                free_.push_back(b);
+                stats_.heap_bytes += kBlock;
+            }
+        }
+        promoted_ = 0;
+        auto fwd = [this](Value& v) {
+            if (!is_obj(v)) return;
+            Obj* o = as_obj(v);
+            if (o->flags & F_HEAP) {
+                if (!(o->flags & F_OLD)) v = from_obj(evacuate(o));
+            } else if (static_cast<int>(o->kind) == VT_OBJ_ARRAY) {
+                work_.push_back(o);
+            }
+        };
+        roots(fwd);
+        for (Obj* o : remembered_) {
+            o->flags &= static_cast<uint8_t>(~F_REM);
+            visit_children(o, fwd);
+        }
+        remembered_.clear();
+        while (!work_.empty()) {
+            Obj* o = work_.back();
+            work_.pop_back();
+            visit_children(o, fwd);
+        }
+        stats_.allocated_bytes += used;
+        ncur_ = nbase_;
+        stats_.minor++;
+        stats_.promoted_bytes += promoted_;
+        stats_.old_bytes += promoted_;
+        promoted_since_major_ += promoted_;
+        report(Minor, t0, promoted_, used - std::min(used, promoted_));
+        return true;
+    }
+
+    // --- Collecte majeure (nursery vide) ----------------------------------------------
+
+    void mark_lines(Obj* o) {
+        if (o->flags & F_LARGE) return;
+        uint8_t* b = block_of(o);
+        const size_t off = static_cast<size_t>(reinterpret_cast<uint8_t*>(o) - b);
+        const size_t last = (off + obj_size(o) - 1) / kLine;
+        for (size_t l = off / kLine; l <= last; ++l) b[l] = epoch_;
+    }
+
+    template <class R> void major(R& roots) {
+        const uint64_t t0 = now_ns();
+        const uint64_t before = stats_.old_bytes;
+        sense_ = !sense_;
+        if (++epoch_ == 0) {   // tour complet des époques : remise à zéro des marques
+            for (uint8_t* b : blocks_) std::memset(b, 0, kMetaLines * kLine);
+            epoch_ = 1;
+        }
+        auto mark = [this](Value& v) {
+            if (!is_obj(v)) return;
+            Obj* o = as_obj(v);
+            if (o->flags & F_HEAP) {
+                if (marked(o)) return;
+                set_mark(o);
+                mark_lines(o);
+                work_.push_back(o);
+            } else if (static_cast<int>(o->kind) == VT_OBJ_ARRAY) {
+                work_.push_back(o);
+            }
+        };
+        roots(mark);
+        for (Obj* o : remembered_) o->flags &= static_cast<uint8_t>(~F_REM);
+        remembered_.clear();   // nursery vide : plus aucun pointeur ancien → jeune
+        while (!work_.empty()) {
+            Obj* o = work_.back();
+            work_.pop_back();
+            visit_children(o, mark);
+        }
+
+        uint64_t live = 0;
+        size_t keep = 0;
+        recycle_.clear();
+        for (uint8_t* b : blocks_) {
+            size_t used = 0;
+            for (size_t l = kMetaLines; l < kLines; ++l) used += b[l] == epoch_;
+            if (used == 0) {
+                free_.push_back(b);
+            } else {
+                blocks_[keep++] = b;
+                recycle_.push_back(b);
+                live += used * kLine;
+            }
+        }
+        blocks_.resize(keep);
+        size_t lkeep = 0;
+        for (Obj* o : large_) {
+            if (marked(o)) {
+                large_[lkeep++] = o;
+                live += obj_size(o);
+            } else {
+                stats_.heap_bytes -= obj_size(o);
+                std::free(o);
+            }
+        }
+        large_.resize(lkeep);
+        while (free_.size() > kKeepBlocks) {
+            std::free(free_.back());
+            free_.pop_back();
+            stats_.heap_bytes -= kBlock;
+        }
+        next_recycle_ = 0;
+        oblock_ = nullptr;
+        ocur_ = oend_ = nullptr;
+
+        stats_.major++;
+        stats_.old_bytes = live;
+        promoted_since_major_ = 0;
+        trigger_ = std::max<size_t>(major_min_, 2 * live);
+        report(Major, t0, live, before - std::min(before, live));
+    }
+
+    uint8_t* nbase_ = nullptr;
+    uint8_t* ncur_ = nullptr;
+    uint8_t* nend_ = nullptr;
+
+    std::vector<uint8_t*> blocks_;    // ancienne génération
+    std::vector<uint8_t*> free_;      // réserve de blocs vides
+    std::vector<uint8_t*> recycle_;   // blocs à trous après la dernière majeure
+    size_t next_recycle_ = 0;
+    uint8_t* oblock_ = nullptr;
+    uint8_t* ocur_ = nullptr;
+    uint8_t* oend_ = nullptr;
+    std::vector<Obj*> large_;
+
+    std::vector<Obj*> remembered_;
+    std::vector<Obj*> work_;
+    uint8_t epoch_ = 1;
+    bool sense_ = false;
+    size_t promoted_ = 0;
+    size_t promoted_since_major_ = 0;
+    size_t trigger_ = 0;
+    size_t major_min_ = 0;
+
+    Stats stats_;
+    EventFn hook_ = nullptr;
+    void* hook_user_ = nullptr;
+};
+
+} // namespace vt::vm::gc
+
+#endif // VITTE_NATIVE_VM_GC_HPP
@@ -0,0 +1,1347 @@
+// native/vm_interp.cpp
+// Interpréteur à threading direct du jeu `Op` (cf. vm_interp.h pour l’API C et la sémantique).
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vm_interp.cpp -o build/vm_interp.o
+//   (à lier avec vt_value.o et vt_native.o)
+//
+// Remarques :
+// - Au chargement, le chunk est traduit en flux pré-décodé (vm_stream.hpp) : mot d’adresse
+//   du handler suivi de ses opérandes (index décodés, constante boxée en immédiat, cible de
+//   saut absolue) ; chaque handler se termine par `goto *ip->h` (une branche indirecte par
+//   handler, prédite séparément, sans test de borne ni table de saut commune).
+// - Superinstructions : les séquences du menu de vm_stream.hpp (ldl+ldc+add+stl,
+//   ldl+ldc+lt+jz, …) s’exécutent en un seul dispatch, sans passer par la pile d’opérandes.
+//   Le masque est choisi au chargement (vt_vm_program_load_ex) ; VT_VM_LOAD_PROFILE
+//   compte les blocs de base pour mesurer le poids de chaque motif.
+// - Valeurs NaN-boxées et opérations : vm_value.hpp. Les NaN à charge utile des constantes
+//   sont canonisés au chargement ; les NaN produits par le matériel restent sous les étiquettes.
+// - Pile de registres : [callee | locaux | opérandes] par frame ; les arguments d’un Call
+//   restent en place et deviennent les locaux de l’appelé (aucune copie). Nombre de locaux
+//   par frame = plus grand LocalIx du chunk + 1 (le format n’a pas de table de fonctions).
+// - Cache d’appel par site, polymorphe à 4 voies : (bits du callee → mot d’entrée, FuncIx).
+//   Les fonctions sans capture sont des immédiats : un site monomorphe ne refait jamais la
+//   résolution. Voie 0 en ligne ; au-delà de 4 cibles, éviction en tourniquet des voies
+//   1..3. Invalidation globale par numéro de version (vt_vm::ic_version, avancé à chaque
+//   collecte) : aucun parcours des sites. Compteurs hits/misses par site (vt_vm_ic_sites).
+// - Bornes : ConstIx, FuncIx et cibles de saut validés au chargement. Programme vérifié
+//   (vm_verify.hpp) : exec<true>, sans test de profondeur par op ; la place de la frame
+//   (locaux + profondeur maximale prouvée) est réservée une fois par Call. Sinon
+//   exec<false> teste la pile à chaque op (au pic de chaque superinstruction).
+// - JIT (vm_jit.hpp) : compteur d’appels par fonction dans Call/TailCall ; au seuil, la
+//   fonction est compilée et les appels suivants entrent dans le code natif. Une sortie
+//   sur Call mémorise la reprise native dans la frame : le Return correspondant y retourne.
+//   Trop de désoptimisations rendent la fonction à l’interpréteur pour le reste de la vie
+//   du vt_vm.
+// - Natives : FuncIx importé ⇒ entrée de cache nulle ; le cache d’appel garde donc aussi le
+//   résultat de la résolution, et l’appel chaud reste test de clé + appel indirect.
+// - Debug : lignes et fichiers sont bornés et hachés au chargement, pas décodés ; la table
+//   compacte (vm_debug.hpp) est construite à la première erreur. Chargement depuis un
+//   fichier : projection mmap (POSIX), pages de debug rendues au noyau après vérification.
+
+#include "vm_interp.h"
+#include "vm_chunk.hpp"
+#include "vm_debug.hpp"
+#include "vm_gc.hpp"
+#include "vm_jit.hpp"
+#include "vm_stream.hpp"
+#include "vm_value.hpp"
+#include "vm_verify.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VT_VM_THREADED 1
+#define VT_LIKELY(x) __builtin_expect(!!(x), 1)
+#define VT_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define VT_VM_THREADED 0
+#define VT_LIKELY(x) (x)
+#define VT_UNLIKELY(x) (x)
+#endif
+
+namespace vt_vmi {
+
+using namespace vt::vm;
+using Op = vt::ChunkOpCode;
+
+static_assert(kSuperopCount <= VT_VM_SUPEROP_MAX);
+static_assert(VT_VM_SUPEROPS_ALL == kSuperopsAll);
+
+// --- Programme --------------------------------------------------------------------------
+
+struct Func {
+    uint32_t entry;   // mot d’entrée dans le flux
+    std::string_view name;
+    int32_t native = -1;   // import : indice dans vt_vm_program::natives
+};
+
+// Native résolue au chargement (copie de l’entrée du registre).
+struct NativeSlot {
+    vt_native_fn fn;
+    void* user;
+    int32_t arity;
+};
+
+struct Frame {
+    const Word* ret;
+    Value* lp;
+    Value* sbase;
+    Closure* clo;
+    const void* jcont;   // reprise native de l’appelant (Call sorti du JIT), sinon nullptr
+};
+
+constexpr Value IC_EMPTY = TAG_FUNC | PAYLOAD;   // jamais produit (FuncIx sur 32 bits)
+constexpr uint32_t kIcWays = 4;
+
+struct IcWay {
+    Value key = IC_EMPTY;          // bits du callee
+    const Word* entry = nullptr;   // nullptr : native
+    uint32_t func = 0;
+};
+
+// Cache d’appel polymorphe d’un site : voie 0 testée en ligne, les suivantes par
+// ic_resolve(). Une ligne de cache pour le chemin chaud (version, hits, voie 0).
+struct alignas(64) CallIC {
+    uint32_t version = 0;   // ≠ vt_vm::ic_version : toutes les voies sont périmées
+    uint8_t n = 0;          // voies remplies
+    uint8_t mega = 0;       // plus de kIcWays cibles vues (éviction en tourniquet)
+    uint16_t next = 0;      // prochaine victime parmi les voies 1..kIcWays-1
+    uint64_t hits = 0;
+    IcWay ways[kIcWays];
+    uint64_t misses = 0;
+    uint32_t pc = 0;        // Call/TailCall d’origine (vt_vm_ic_sites)
+};
+
+// État JIT d’une fonction (par vt_vm, pour le programme courant).
+struct JitFunc {
+    const void* code = nullptr;
+    uint32_t calls = 0;
+    uint32_t deopts = 0;
+    bool dead = false;   // non compilable ou rendue à l’interpréteur
+};
+
+thread_local std::string g_load_error;
+std::atomic<uint64_t> g_program_ids{1};
+
+} // namespace vt_vmi
+
+struct vt_vm_program {
+    vt::Chunk chunk;                      // sections de debug non décodées (lazy_debug)
+    vt::vm::DebugInfo debug{&chunk};      // lignes/fichiers, décodés à la première demande
+    vt::vm::Stream stream;                // flux pré-décodé + Halt
+    std::vector<vt::vm::StrObj> strs;     // Str/Bytes des constantes (vues sur chunk.bytes)
+    std::vector<vt::vm::Value> kvals;     // constantes boxées, indexées par ConstIx
+    std::vector<vt_vmi::Func> funcs;      // FuncIx → debug.symbols
+    std::vector<vt_vmi::NativeSlot> natives;   // imports résolus (Func::native)
+    uint32_t nlocals = 0;
+    uint32_t max_stack = 0;               // profondeur d’opérandes prouvée (0 : non vérifié)
+    bool verified = false;
+    uint64_t superops = 0;
+    uint64_t id = 0;                      // identité pour le cache JIT du vt_vm
+    mutable std::vector<uint64_t> prof;   // compteurs de blocs (VT_VM_LOAD_PROFILE)
+};
+
+struct vt_vm {
+    vt_vm_config cfg{};
+    std::unique_ptr<vt::vm::Value[]> regs;
+    std::unique_ptr<vt_vmi::Frame[]> frames;
+    std::vector<vt_vmi::CallIC> ic;
+    uint32_t ic_version = 1;                      // incrémenté par chaque collecte
+    vt::vm::gc::Heap heap;                        // fermetures (nursery + ancienne génération)
+    vt_vm_print_fn print_fn = nullptr;
+    void* print_user = nullptr;
+    std::string out;   // tampon de formatage (Print)
+    std::string err;
+    vt_vm_stats stats{};
+    std::unique_ptr<vt::vm::jit::CodeCache> jit;   // null : interpréteur seul
+    std::vector<vt_vmi::JitFunc> jfuncs;          // par FuncIx
+    uint64_t jit_prog = 0;                        // programme du code compilé
+    const vt_vm_program* cur = nullptr;           // programme en cours (hooks du JIT)
+    std::vector<vt::vm::Value> owned;             // objets comptés rendus par les natives
+    std::string native_err;
+    vt_vmi::Frame* jit_fp = nullptr;              // frames vivantes pendant le code JIT (racines)
+    vt_vm_gc_fn gc_fn = nullptr;
+    void* gc_user = nullptr;
+
+    vt_vm() = default;
+    vt_vm(const vt_vm&) = delete;
+    vt_vm& operator=(const vt_vm&) = delete;
+    ~vt_vm() { release_owned(); }
+
+    void release_owned() {
+        for (vt::vm::Value v : owned) vt_value_release(v);
+        owned.clear();
+    }
+};
+
+namespace vt_vmi {
+
+void format_value(std::string& s, const vt_vm_program* p, Value v) {
+    char buf[400];
+    if (is_int(v)) {
+        auto r = std::to_chars(buf, buf + sizeof(buf), as_int(v));
+        s.append(buf, r.ptr);
+    } else if (is_f64(v)) {
+        const double d = as_f64(v);
+        if (std::isnan(d)) {
+            s += "NaN";
+        } else if (std::isinf(d)) {
+            s += d > 0 ? "inf" : "-inf";
+        } else {
+            // Plus courte représentation exacte, sans exposant (comme `{}` de Rust).
+            auto r = std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::fixed);
+            s.append(buf, r.ptr);
+        }
+    } else if (v == V_NULL) {
+        s += "null";
+    } else if (is_bool(v)) {
+        s += v == V_TRUE ? "true" : "false";
+    } else if (is_func(v)) {
+        s += "<fn ";
+        s += p->funcs[v & PAYLOAD].name;
+        s += '>';
+    } else {
+        const Obj* o = as_obj(v);
+        if (o->kind == ObjKind::Str) {
+            const auto* str = static_cast<const StrObj*>(o);
+            s.append(str->data, str->len);
+        } else if (o->kind == ObjKind::Bytes) {
+            s += "bytes[" + std::to_string(static_cast<const StrObj*>(o)->len) + "]";
+        } else if (const vt_array* a = vt_value_as_array(v)) {
+            s += '[';
+            for (size_t i = 0; i < a->len; ++i) {
+                if (i) s += ", ";
+                format_value(s, p, a->items[i]);
+            }
+            s += ']';
+        } else if (static_cast<int>(o->kind) == VT_OBJ_FOREIGN) {
+            s += "<foreign>";
+        } else {
+            s += "<closure ";
+            s += p->funcs[static_cast<const Closure*>(o)->func].name;
+            s += '>';
+        }
+    }
+}
+
+void to_result(Value v, vt_vm_result* out) {
+    if (!out) return;
+    *out = vt_vm_result{};
+    out->v = v;
+    if (is_int(v)) {
+        out->kind = VT_VM_INT;
+        out->i = as_int(v);
+    } else if (is_f64(v)) {
+        // Entier hors 48 bits représenté en double : rendu comme l’entier qu’il est.
+        const double d = as_f64(v);
+        if (std::trunc(d) == d && std::fabs(d) < 9223372036854775807.0 && !fits48(static_cast<int64_t>(d))) {
+            out->kind = VT_VM_INT;
+            out->i = static_cast<int64_t>(d);
+        } else {
+            out->kind = VT_VM_FLOAT;
+            out->f = d;
+        }
+    } else if (v == V_NULL) {
+        out->kind = VT_VM_NULL;
+    } else if (is_bool(v)) {
+        out->kind = VT_VM_BOOL;
+        out->i = v == V_TRUE;
+    } else if (is_func(v)) {
+        out->kind = VT_VM_FUNC;
+        out->i = static_cast<int64_t>(v & PAYLOAD);
+    } else {
+        const Obj* o = as_obj(v);
+        if (o->kind == ObjKind::Closure) {
+            out->kind = VT_VM_FUNC;
+            out->i = static_cast<const Closure*>(o)->func;
+        } else if (const vt_array* a = vt_value_as_array(v)) {
+            out->kind = VT_VM_ARRAY;
+            out->n = a->len;
+        } else if (static_cast<int>(o->kind) == VT_OBJ_FOREIGN) {
+            out->kind = VT_VM_FOREIGN;
+        } else {
+            const auto* str = static_cast<const StrObj*>(o);
+            out->kind = o->kind == ObjKind::Str ? VT_VM_STR : VT_VM_BYTES;
+            out->s = str->data;
+            out->n = str->len;
+        }
+    }
+}
+
+void emit_print(vt_vm* vm, const vt_vm_program* p, Value v) {
+    vm->out.clear();
+    format_value(vm->out, p, v);
+    if (vm->print_fn) {
+        vm->print_fn(vm->print_user, vm->out.data(), vm->out.size());
+    } else {
+        vm->out += '\n';
+        std::fwrite(vm->out.data(), 1, vm->out.size(), stdout);
+    }
+}
+
+// Erreur rapportée au pc de la première op de l’instruction (superinstruction comprise).
+int fail(vt_vm* vm, const vt_vm_program* p, const Word* ip, int code, const char* what) {
+    const StreamTile& t = p->stream.tile_at(ip);
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), " : `%s` (pc %u, ligne %u)", sop_name(t.op), t.pc,
+                  p->debug.line_for_pc(t.pc));
+    vm->err = what;
+    vm->err += buf;
+    return code;
+}
+
+// --- GC -------------------------------------------------------------------------------
+
+// Racines exactes : pile [regs, sp), fermetures des frames et du frame courant, valeurs
+// possédées (tableaux hôtes).
+struct Roots {
+    vt_vm* vm;
+    Value* sp;
+    Frame* fp;
+    Closure** clo;
+
+    template <class F> void operator()(F& f) const {
+        for (Value* q = vm->regs.get(); q < sp; ++q) f(*q);
+        for (Frame* x = vm->frames.get(); x < fp; ++x) gc::visit_closure(f, x->clo);
+        if (clo) gc::visit_closure(f, *clo);
+        for (Value& v : vm->owned) f(v);
+    }
+};
+
+// Fermeture non initialisée (upvalues à remplir), ou nullptr. Une collecte peut déplacer
+// les fermetures jeunes (et libérer des adresses) : la version des caches d’appel avance.
+inline Closure* alloc_closure(vt_vm* vm, uint32_t func, uint32_t n, Value* sp, Frame* fp, Closure** clo) {
+    const size_t bytes = sizeof(Closure) + n * sizeof(Value);
+    uint8_t flags = gc::F_HEAP;
+    void* m = vm->heap.alloc_fast(bytes);
+    if (VT_UNLIKELY(!m)) {
+        try {
+            m = vm->heap.alloc_slow(bytes, Roots{vm, sp, fp, clo}, &flags);
+        } catch (const std::bad_alloc&) {
+            m = nullptr;
+        }
+        ++vm->ic_version;
+        if (!m) return nullptr;
+    }
+    vm->stats.closures++;
+    return new_closure(m, func, n, flags);
+}
+
+bool remember(vt_vm* vm, Closure* c) {
+    try {
+        vm->heap.remember(c);
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+void gc_event(void* user, const gc::Event& e) {
+    auto* vm = static_cast<vt_vm*>(user);
+    if (!vm->gc_fn) return;
+    const vt_vm_gc_event ev{static_cast<uint32_t>(e.kind), e.pause_ns, e.live_bytes, e.freed_bytes};
+    vm->gc_fn(vm->gc_user, &ev);
+}
+
+// Échec de la voie 0 : autres voies, sinon résolution et insertion. nullptr : non appelable.
+const IcWay* ic_resolve(vt_vm* vm, const vt_vm_program* p, CallIC& ic, Value callee) {
+    if (ic.version != vm->ic_version) {
+        ic.version = vm->ic_version;
+        ic.n = 0;
+        ic.ways[0].key = IC_EMPTY;
+    } else {
+        for (uint32_t i = 1; i < ic.n; ++i) {
+            if (ic.ways[i].key == callee) {
+                ++ic.hits;
+                return &ic.ways[i];
+            }
+        }
+    }
+    uint32_t fi;
+    if (is_func(callee)) {
+        fi = static_cast<uint32_t>(callee & PAYLOAD);
+    } else if (const Closure* c = as_closure(callee)) {
+        fi = c->func;
+    } else {
+        return nullptr;
+    }
+    ++ic.misses;
+    IcWay* w;
+    if (ic.n < kIcWays) {
+        w = &ic.ways[ic.n++];
+    } else {   // la voie 0 garde la première cible (souvent la dominante)
+        ic.mega = 1;
+        w = &ic.ways[1 + ic.next++ % (kIcWays - 1)];
+    }
+    const Func& f = p->funcs[fi];
+    *w = IcWay{callee, f.native < 0 ? p->stream.words.data() + f.entry : nullptr, fi};
+    return w;
+}
+
+// Appel d’une native sur la tranche d’arguments en place ; résultat dans args[-1].
+int call_native(vt_vm* vm, const vt_vm_program* p, uint32_t fi, Value* args, uint32_t argc) {
+    const Func& f = p->funcs[fi];
+    const NativeSlot& n = p->natives[static_cast<size_t>(f.native)];
+    if (n.arity != VT_NATIVE_VARIADIC && static_cast<uint32_t>(n.arity) != argc) {
+        vm->native_err = "Arité de la native `" + std::string(f.name) + "` : " + std::to_string(n.arity) +
+                         " attendu(s), " + std::to_string(argc) + " reçu(s)";
+        return VT_VM_E_CALL;
+    }
+    vm->stats.native_calls++;
+    Value r = V_NULL;
+    const int e = n.fn(n.user, args, argc, &r);
+    if (e != 0) {
+        vt_value_release(r);
+        vm->native_err = "Échec de la native `" + std::string(f.name) + "` (code " + std::to_string(e) + ")";
+        return VT_VM_E_NATIVE;
+    }
+    const vt_obj* o = vt_value_as_obj(r);
+    if (o && o->rc != VT_OBJ_STATIC) {
+        try {
+            vm->owned.push_back(r);
+        } catch (const std::bad_alloc&) {
+            vt_value_release(r);
+            vm->native_err = "Mémoire insuffisante";
+            return VT_VM_E_NOMEM;
+        }
+    }
+    args[-1] = r;
+    return VT_VM_OK;
+}
+
+// --- JIT ------------------------------------------------------------------------------
+
+void jit_print(jit::State* st, Value v) {
+    auto* vm = static_cast<vt_vm*>(st->ctx);
+    emit_print(vm, vm->cur, v);
+}
+
+Value jit_make_closure(jit::State* st, uint32_t func, uint32_t n) {
+    auto* vm = static_cast<vt_vm*>(st->ctx);
+    Closure* c = alloc_closure(vm, func, n, st->sp, vm->jit_fp, &st->clo);
+    if (!c) return 0;
+    const size_t have = static_cast<size_t>(st->sbase - st->lp);
+    for (uint32_t i = 0; i < n; ++i) c->upv()[i] = i < have ? st->lp[i] : V_NULL;
+    return from_obj(c);
+}
+
+uint64_t jit_barrier(jit::State* st, Closure* c, Value v) {
+    return !gc::Heap::needs_barrier(c, v) || remember(static_cast<vt_vm*>(st->ctx), c);
+}
+
+// Code natif de la fonction, ou nullptr (compte l’appel, compile au seuil).
+const void* jit_lookup(vt_vm* vm, const vt_vm_program* p, uint32_t fi) {
+    JitFunc& f = vm->jfuncs[fi];
+    if (f.code) return f.code;
+    if (f.dead || ++f.calls < vm->cfg.jit_threshold) return nullptr;
+    jit::Input in{&p->chunk, &p->stream, p->kvals.data(), fi, p->chunk.symbols[fi].pc,
+                  jit::Hooks{&jit_print, &jit_make_closure, &jit_barrier}};
+    try {
+        f.code = vm->jit->compile(in);
+    } catch (const std::bad_alloc&) {
+        f.code = nullptr;
+    }
+    if (f.code) {
+        vm->stats.jit_compiled++;
+    } else {
+        f.dead = true;
+        vm->stats.jit_failed++;
+    }
+    return f.code;
+}
+
+void jit_deopt(vt_vm* vm, uint32_t fi) {
+    vm->stats.jit_deopts++;
+    JitFunc& f = vm->jfuncs[fi];
+    if (f.code && ++f.deopts >= vm->cfg.jit_max_deopts) {
+        // Le code reste projeté : des frames peuvent encore y reprendre.
+        f.code = nullptr;
+        f.dead = true;
+        vm->stats.jit_discarded++;
+    }
+}
+
+// Boucle d’exécution. Appelée avec vm == nullptr, rend seulement la table des handlers
+// (adresses des labels, propres à cette fonction) via `labels`.
+// Verified : programme prouvé par vm_verify.hpp (ni sous-dépassement, ni débordement au-delà
+// de la place réservée par frame).
+template <bool Verified>
+int exec(vt_vm* vm, const vt_vm_program* p, const Word* start, vt_vm_result* out,
+         const void* const** labels) {
+#if VT_VM_THREADED
+    static const void* const table[] = {
+        &&L_Nop, &&L_Return, &&L_ReturnVoid,
+        &&L_LoadConst, &&L_LoadTrue, &&L_LoadFalse, &&L_LoadNull,
+        &&L_LoadLocal, &&L_StoreLocal,
+        &&L_Add, &&L_Sub, &&L_Mul, &&L_Div, &&L_Mod, &&L_Neg, &&L_Not,
+        &&L_Eq, &&L_Ne, &&L_Lt, &&L_Le, &&L_Gt, &&L_Ge,
+        &&L_Jump, &&L_JumpIfFalse, &&L_Pop,
+        &&L_Call, &&L_TailCall,
+        &&L_Print,
+        &&L_MakeClosure, &&L_LoadUpvalue, &&L_StoreUpvalue,
+        &&L_Halt, &&L_Prof,
+        &&L_LdLd, &&L_LdAddK, &&L_LdSubK, &&L_LdAddKSt, &&L_LdSubKSt,
+        &&L_JLtLdK, &&L_JLeLdK, &&L_JGtLdK, &&L_JGeLdK,
+        &&L_JLtLdLd, &&L_JLeLdLd, &&L_JGtLdLd, &&L_JGeLdLd,
+        &&L_JLt, &&L_JLe, &&L_JGt, &&L_JGe,
+        &&L_AddSt, &&L_RetLd, &&L_StLd,
+    };
+    static_assert(sizeof(table) / sizeof(table[0]) == kSOpCount);
+    if (!vm) {
+        *labels = table;
+        return 0;
+    }
+#define CASE(x) L_##x:
+#define SCASE(x) L_##x:
+#define NEXT() goto *ip->h
+#else
+    if (!vm) {
+        *labels = nullptr;
+        return 0;
+    }
+#define CASE(x) case static_cast<uint32_t>(Op::x):
+#define SCASE(x) case static_cast<uint32_t>(SOp::x):
+#define NEXT() goto dispatch
+#endif
+
+    const size_t nlocals = p->nlocals;
+    const size_t room = p->max_stack;   // réservé à chaque frame (programme vérifié)
+    uint64_t* const prof = p->prof.data();
+    CallIC* const ics = vm->ic.data();
+    const bool jit_on = vm->jit != nullptr;
+    const void* nat = nullptr;       // cible native (jit_enter)
+    const void* pending = nullptr;   // reprise native du prochain Call (sortie JIT sur Call)
+
+    Value* const regs = vm->regs.get();
+    Value* const send = regs + vm->cfg.stack_slots;
+    Frame* const frames = vm->frames.get();
+    Frame* const fend = frames + vm->cfg.max_frames;
+
+    // Frame de plus haut niveau : regs[0] tient lieu de callee.
+    if (1 + nlocals + room > vm->cfg.stack_slots) {
+        vm->err = "Pile de registres trop petite pour les locaux";
+        return VT_VM_E_STACK;
+    }
+    regs[0] = V_NULL;
+    Value* lp = regs + 1;
+    for (size_t i = 0; i < nlocals; ++i) lp[i] = V_NULL;
+    Value* sbase = lp + nlocals;
+    Value* sp = sbase;
+    Closure* clo = nullptr;
+    Frame* fp = frames;
+    const Word* ip = start;
+    uint64_t calls = 0;
+    Value ret = V_NULL;
+    int rc = VT_VM_OK;
+
+#define PUSH(v)                                             \
+    do {                                                    \
+        if (!Verified && VT_UNLIKELY(sp >= send)) goto e_overflow; \
+        *sp++ = (v);                                        \
+    } while (0)
+#define NEED(k)                                             \
+    do {                                                    \
+        if (!Verified && VT_UNLIKELY(sp - sbase < (k))) goto e_underflow; \
+    } while (0)
+#define ROOM(k)                                             \
+    do {                                                    \
+        if (!Verified && VT_UNLIKELY(send - sp < (k))) goto e_overflow; \
+    } while (0)
+
+#if VT_VM_THREADED
+    NEXT();
+#else
+dispatch:
+    switch (ip->u) {
+#endif
+
+    CASE(Nop) {
+        ++ip;
+        NEXT();
+    }
+    CASE(LoadConst) {
+        PUSH(ip[1].v);
+        ip += 2;
+        NEXT();
+    }
+    CASE(LoadTrue) {
+        PUSH(V_TRUE);
+        ++ip;
+        NEXT();
+    }
+    CASE(LoadFalse) {
+        PUSH(V_FALSE);
+        ++ip;
+        NEXT();
+    }
+    CASE(LoadNull) {
+        PUSH(V_NULL);
+        ++ip;
+        NEXT();
+    }
+    CASE(LoadLocal) {
+        PUSH(lp[ip[1].u]);
+        ip += 2;
+        NEXT();
+    }
+    CASE(StoreLocal) {
+        NEED(1);
+        lp[ip[1].u] = *--sp;
+        ip += 2;
+        NEXT();
+    }
+    CASE(Pop) {
+        NEED(1);
+        --sp;
+        ++ip;
+        NEXT();
+    }
+
+#define VT_VM_ARITH(name, fn)                                       \
+    CASE(name) {                                                    \
+        NEED(2);                                                    \
+        if (VT_UNLIKELY(!fn(sp[-2], sp[-1], sp[-2]))) goto e_type;  \
+        --sp;                                                       \
+        ++ip;                                                       \
+        NEXT();                                                     \
+    }
+    VT_VM_ARITH(Add, op_add)
+    VT_VM_ARITH(Sub, op_sub)
+    VT_VM_ARITH(Mul, op_mul)
+    VT_VM_ARITH(Div, op_div)
+    VT_VM_ARITH(Mod, op_mod)
+#undef VT_VM_ARITH
+    CASE(Neg) {
+        NEED(1);
+        if (VT_UNLIKELY(!op_neg(sp[-1], sp[-1]))) goto e_type;
+        ++ip;
+        NEXT();
+    }
+    CASE(Not) {
+        NEED(1);
+        sp[-1] = from_bool(falsy(sp[-1]));
+        ++ip;
+        NEXT();
+    }
+
+    CASE(Eq) {
+        NEED(2);
+        sp[-2] = from_bool(values_eq(sp[-2], sp[-1]));
+        --sp;
+        ++ip;
+        NEXT();
+    }
+    CASE(Ne) {
+        NEED(2);
+        sp[-2] = from_bool(!values_eq(sp[-2], sp[-1]));
+        --sp;
+        ++ip;
+        NEXT();
+    }
+
+#define VT_VM_CMP(C)                                                          \
+    CASE(C) {                                                                 \
+        NEED(2);                                                              \
+        bool r;                                                               \
+        if (VT_UNLIKELY(!op_cmp<Cmp::C>(sp[-2], sp[-1], r))) goto e_type;     \
+        sp[-2] = from_bool(r);                                                \
+        --sp;                                                                 \
+        ++ip;                                                                 \
+        NEXT();                                                               \
+    }
+    VT_VM_CMP(Lt)
+    VT_VM_CMP(Le)
+    VT_VM_CMP(Gt)
+    VT_VM_CMP(Ge)
+#undef VT_VM_CMP
+
+    CASE(Jump) {
+        ip = ip[1].t;
+        NEXT();
+    }
+    CASE(JumpIfFalse) {
+        NEED(1);
+        ip = falsy(*--sp) ? ip[1].t : ip + 2;
+        NEXT();
+    }
+
+    CASE(Call) {
+        const auto argc = static_cast<uint32_t>(ip[1].u);
+        NEED(static_cast<ptrdiff_t>(argc) + 1);
+        Value* args = sp - argc;
+        const Value callee = args[-1];
+        CallIC& ic = ics[ip[1].u >> 32];
+        const IcWay* w = &ic.ways[0];
+        if (VT_LIKELY(w->key == callee && ic.version == vm->ic_version)) {
+            ++ic.hits;
+        } else if (VT_UNLIKELY(!(w = ic_resolve(vm, p, ic, callee)))) {
+            goto e_not_callable;
+        }
+        const Word* const entry = w->entry;
+        const uint32_t fi = w->func;
+        if (VT_UNLIKELY(!entry)) {   // native : pas de frame, résultat à la place du callee
+            if (VT_UNLIKELY((rc = call_native(vm, p, fi, args, argc)) != VT_VM_OK)) goto e_native;
+            sp = args;
+            if (pending) {   // Call sorti du JIT : reprise dans le code natif
+                nat = pending;
+                pending = nullptr;
+                goto jit_enter;
+            }
+            ip += 2;
+            NEXT();
+        }
+        if (VT_UNLIKELY(fp == fend)) goto e_depth;
+        const size_t width = std::max<size_t>(nlocals, argc);
+        if (VT_UNLIKELY(static_cast<size_t>(send - args) < width + room)) goto e_overflow;
+        for (Value* q = args + argc; q < args + nlocals; ++q) *q = V_NULL;
+        *fp++ = Frame{ip + 2, lp, sbase, clo, pending};
+        pending = nullptr;
+        ++calls;
+        lp = args;
+        sbase = sp = args + width;
+        clo = as_closure(callee);
+        if (VT_UNLIKELY(jit_on) && (nat = jit_lookup(vm, p, fi)) != nullptr) goto jit_enter;
+        ip = entry;
+        NEXT();
+    }
+    CASE(TailCall) {
+        const auto argc = static_cast<uint32_t>(ip[1].u);
+        NEED(static_cast<ptrdiff_t>(argc) + 1);
+        Value* args = sp - argc;
+        const Value callee = args[-1];
+        CallIC& ic = ics[ip[1].u >> 32];
+        const IcWay* w = &ic.ways[0];
+        if (VT_LIKELY(w->key == callee && ic.version == vm->ic_version)) {
+            ++ic.hits;
+        } else if (VT_UNLIKELY(!(w = ic_resolve(vm, p, ic, callee)))) {
+            goto e_not_callable;
+        }
+        const Word* const entry = w->entry;
+        const uint32_t fi = w->func;
+        if (VT_UNLIKELY(!entry)) {
+            if (VT_UNLIKELY((rc = call_native(vm, p, fi, args, argc)) != VT_VM_OK)) goto e_native;
+            ret = args[-1];
+            goto do_return;
+        }
+        // Le frame courant est réutilisé : callee et arguments descendent sur [lp-1, lp+argc).
+        std::memmove(lp - 1, args - 1, (static_cast<size_t>(argc) + 1) * sizeof(Value));
+        const size_t width = std::max<size_t>(nlocals, argc);
+        if (VT_UNLIKELY(static_cast<size_t>(send - lp) < width + room)) goto e_overflow;
+        for (Value* q = lp + argc; q < lp + nlocals; ++q) *q = V_NULL;
+        ++calls;
+        sbase = sp = lp + width;
+        clo = as_closure(callee);
+        if (VT_UNLIKELY(jit_on) && (nat = jit_lookup(vm, p, fi)) != nullptr) goto jit_enter;
+        ip = entry;
+        NEXT();
+    }
+
+    CASE(Return) {
+        NEED(1);
+        ret = sp[-1];
+        goto do_return;
+    }
+    CASE(ReturnVoid) {
+        ret = V_NULL;
+        goto do_return;
+    }
+
+    CASE(Print) {
+        NEED(1);
+        emit_print(vm, p, *--sp);
+        ++ip;
+        NEXT();
+    }
+
+    CASE(MakeClosure) {
+        const auto f = static_cast<uint32_t>(ip[1].u);
+        const auto n = static_cast<uint32_t>(ip[1].u >> 32);
+        if (n == 0) {
+            PUSH(TAG_FUNC | f);
+        } else {
+            ROOM(1);
+            Closure* c = alloc_closure(vm, f, n, sp, fp, &clo);
+            if (VT_UNLIKELY(!c)) goto e_nomem;
+            const size_t have = static_cast<size_t>(sbase - lp);
+            for (uint32_t i = 0; i < n; ++i) c->upv()[i] = i < have ? lp[i] : V_NULL;
+            *sp++ = from_obj(c);
+        }
+        ip += 2;
+        NEXT();
+    }
+    CASE(LoadUpvalue) {
+        if (VT_UNLIKELY(!clo || ip[1].u >= clo->n)) goto e_upvalue;
+        PUSH(clo->upv()[ip[1].u]);
+        ip += 2;
+        NEXT();
+    }
+    CASE(StoreUpvalue) {
+        NEED(1);
+        if (VT_UNLIKELY(!clo || ip[1].u >= clo->n)) goto e_upvalue;
+        const Value v = *--sp;
+        clo->upv()[ip[1].u] = v;
+        if (VT_UNLIKELY(gc::Heap::needs_barrier(clo, v)) && !remember(vm, clo)) goto e_nomem;
+        ip += 2;
+        NEXT();
+    }
+
+    SCASE(Halt) {
+        ret = sp > sbase ? sp[-1] : V_NULL;
+        goto done;
+    }
+    SCASE(Prof) {
+        ++prof[ip[1].u];
+        ip += 2;
+        NEXT();
+    }
+
+    // --- Superinstructions (opérandes : cf. vm_stream.hpp) ---------------------------------
+
+    SCASE(LdLd) {
+        ROOM(2);
+        const uint64_t x = ip[1].u;
+        sp[0] = lp[x & 0xFFFF];
+        sp[1] = lp[x >> 16];
+        sp += 2;
+        ip += 2;
+        NEXT();
+    }
+
+#define VT_VM_LDK(name, fn)                                         \
+    SCASE(name) {                                                   \
+        ROOM(2);                                                    \
+        Value r;                                                    \
+        if (VT_UNLIKELY(!fn(lp[ip[1].u], ip[2].v, r))) goto e_type; \
+        *sp++ = r;                                                  \
+        ip += 3;                                                    \
+        NEXT();                                                     \
+    }
+#define VT_VM_LDKST(name, fn)                                          \
+    SCASE(name) {                                                      \
+        ROOM(2);                                                       \
+        const uint64_t x = ip[1].u;                                    \
+        Value r;                                                       \
+        if (VT_UNLIKELY(!fn(lp[x & 0xFFFF], ip[2].v, r))) goto e_type; \
+        lp[x >> 16] = r;                                               \
+        ip += 3;                                                       \
+        NEXT();                                                        \
+    }
+    VT_VM_LDK(LdAddK, op_add)
+    VT_VM_LDK(LdSubK, op_sub)
+    VT_VM_LDKST(LdAddKSt, op_add)
+    VT_VM_LDKST(LdSubKSt, op_sub)
+#undef VT_VM_LDK
+#undef VT_VM_LDKST
+
+    // cmp + jz : saut si la comparaison est fausse.
+#define VT_VM_JCMP(C)                                                                   \
+    SCASE(J##C##LdK) {                                                                  \
+        ROOM(2);                                                                        \
+        bool r;                                                                         \
+        if (VT_UNLIKELY(!op_cmp<Cmp::C>(lp[ip[1].u], ip[2].v, r))) goto e_type;         \
+        ip = r ? ip + 4 : ip[3].t;                                                      \
+        NEXT();                                                                         \
+    }                                                                                   \
+    SCASE(J##C##LdLd) {                                                                 \
+        ROOM(2);                                                                        \
+        const uint64_t x = ip[1].u;                                                     \
+        bool r;                                                                         \
+        if (VT_UNLIKELY(!op_cmp<Cmp::C>(lp[x & 0xFFFF], lp[x >> 16], r))) goto e_type;  \
+        ip = r ? ip + 3 : ip[2].t;                                                      \
+        NEXT();                                                                         \
+    }                                                                                   \
+    SCASE(J##C) {                                                                       \
+        NEED(2);                                                                        \
+        bool r;                                                                         \
+        if (VT_UNLIKELY(!op_cmp<Cmp::C>(sp[-2], sp[-1], r))) goto e_type;               \
+        sp -= 2;                                                                        \
+        ip = r ? ip + 2 : ip[1].t;                                                      \
+        NEXT();                                                                         \
+    }
+    VT_VM_JCMP(Lt)
+    VT_VM_JCMP(Le)
+    VT_VM_JCMP(Gt)
+    VT_VM_JCMP(Ge)
+#undef VT_VM_JCMP
+
+    SCASE(AddSt) {
+        NEED(2);
+        Value r;
+        if (VT_UNLIKELY(!op_add(sp[-2], sp[-1], r))) goto e_type;
+        sp -= 2;
+        lp[ip[1].u] = r;
+        ip += 2;
+        NEXT();
+    }
+    SCASE(RetLd) {
+        ROOM(1);
+        ret = lp[ip[1].u];
+        goto do_return;
+    }
+    SCASE(StLd) {
+        NEED(1);
+        lp[ip[1].u] = sp[-1];
+        ip += 2;
+        NEXT();
+    }
+
+#if !VT_VM_THREADED
+    default:
+        goto e_type;
+    }
+#endif
+
+do_return:
+    if (fp == frames) goto done;
+    lp[-1] = ret;
+    sp = lp;
+    --fp;
+    ip = fp->ret;
+    lp = fp->lp;
+    sbase = fp->sbase;
+    clo = fp->clo;
+    if (VT_UNLIKELY(fp->jcont != nullptr)) {
+        nat = fp->jcont;
+        goto jit_enter;
+    }
+    NEXT();
+
+jit_enter: {
+    jit::State st{lp, sbase, send, clo, vm, nullptr, nullptr, jit::Exit, 0};
+    vm->stats.jit_entries++;
+    vm->jit_fp = fp;
+    ip = vm->jit->enter(&st, nat);
+    sp = st.sp;
+    clo = st.clo;   // déplacée si le code natif a déclenché une collecte
+    pending = st.cont;
+    if (VT_UNLIKELY(st.reason == jit::Deopt)) jit_deopt(vm, st.func);
+    NEXT();
+}
+
+e_type:
+    rc = fail(vm, p, ip, VT_VM_E_TYPE, "Erreur de type");
+    goto finish;
+e_underflow:
+    rc = fail(vm, p, ip, VT_VM_E_STACK, "Pile vide (stack underflow)");
+    goto finish;
+e_overflow:
+    rc = fail(vm, p, ip, VT_VM_E_STACK, "Débordement de la pile de registres");
+    goto finish;
+e_not_callable:
+    rc = fail(vm, p, ip, VT_VM_E_CALL, "Appel d’une valeur non appelable");
+    goto finish;
+e_depth:
+    rc = fail(vm, p, ip, VT_VM_E_CALL, "Profondeur d’appels dépassée");
+    goto finish;
+e_upvalue:
+    rc = fail(vm, p, ip, VT_VM_E_BOUNDS, "Upvalue hors limites");
+    goto finish;
+e_nomem:
+    rc = fail(vm, p, ip, VT_VM_E_NOMEM, "Mémoire insuffisante");
+    goto finish;
+e_native:
+    rc = fail(vm, p, ip, rc, vm->native_err.c_str());
+    goto finish;
+
+done:
+    to_result(ret, out);
+finish:
+    vm->stats.calls += calls;
+    for (const CallIC& ic : vm->ic) {
+        vm->stats.call_ic_hits += ic.hits;
+        vm->stats.call_ic_misses += ic.misses;
+    }
+    return rc;
+
+#undef CASE
+#undef SCASE
+#undef NEXT
+#undef PUSH
+#undef NEED
+#undef ROOM
+}
+
+int load_error(int code, const char* what) {
+    g_load_error = what;
+    return code;
+}
+
+// Suite du chargement, chunk décodé dans p->chunk.
+int load_decoded(std::unique_ptr<vt_vm_program> p, vt::ChunkError e, uint32_t flags, uint64_t superops,
+                 vt_vm_program** out) {
+    if (e != vt::ChunkError::Ok) {
+        return load_error(e == vt::ChunkError::BadHash ? VT_VM_E_HASH : VT_VM_E_FORMAT, vt::chunk_strerror(e));
+    }
+    const vt::Chunk& c = p->chunk;
+    const size_t nops = c.ops.size();
+
+    p->funcs.reserve(c.symbols.size());
+    for (const vt::ChunkSymbol& s : c.symbols) {
+        if (s.pc == VT_NATIVE_IMPORT_PC) {   // import : résolu une fois, ici
+            vt_native_info info;
+            if (vt_native_get(vt_native_find(std::string(s.name).c_str()), &info) != 0) {
+                g_load_error = "Native non enregistrée : " + std::string(s.name);
+                return VT_VM_E_NATIVE;
+            }
+            p->funcs.push_back(Func{0, s.name, static_cast<int32_t>(p->natives.size())});
+            p->natives.push_back(NativeSlot{info.fn, info.user, info.arity});
+            continue;
+        }
+        if (s.pc > nops) return load_error(VT_VM_E_BOUNDS, "Symbole hors du code");
+        p->funcs.push_back(Func{s.pc, s.name});
+    }
+
+    p->strs.reserve(c.consts.size());   // pointeurs stables pour kvals
+    p->kvals.reserve(c.consts.size());
+    for (const vt::ChunkConst& k : c.consts) {
+        switch (k.kind) {
+        case vt::ChunkConstKind::Null: p->kvals.push_back(V_NULL); break;
+        case vt::ChunkConstKind::Bool: p->kvals.push_back(from_bool(k.b)); break;
+        case vt::ChunkConstKind::I64: p->kvals.push_back(from_i64(k.i)); break;
+        case vt::ChunkConstKind::F64: p->kvals.push_back(from_f64_canon(k.f)); break;
+        case vt::ChunkConstKind::Str:
+        case vt::ChunkConstKind::Bytes: {
+            StrObj s;
+            s.kind = k.kind == vt::ChunkConstKind::Str ? ObjKind::Str : ObjKind::Bytes;
+            s.data = k.s.data();
+            s.len = k.s.size();
+            p->strs.push_back(s);
+            p->kvals.push_back(from_obj(&p->strs.back()));
+            break;
+        }
+        }
+    }
+
+    for (size_t pc = 0; pc < nops; ++pc) {
+        const vt::ChunkOp& op = c.ops[pc];
+        switch (op.code) {
+        case Op::LoadConst:
+            if (op.a >= c.consts.size()) return load_error(VT_VM_E_BOUNDS, "ConstIx hors du pool");
+            break;
+        case Op::LoadLocal:
+        case Op::StoreLocal:
+            p->nlocals = std::max(p->nlocals, op.a + 1);
+            break;
+        case Op::Jump:
+        case Op::JumpIfFalse: {
+            const int64_t t = op.jump_target(static_cast<uint32_t>(pc));
+            if (t < 0 || t > static_cast<int64_t>(nops)) return load_error(VT_VM_E_BOUNDS, "Cible de saut hors du code");
+            break;
+        }
+        case Op::MakeClosure:
+            if (op.a >= p->funcs.size()) return load_error(VT_VM_E_BOUNDS, "FuncIx hors de debug.symbols");
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!(flags & VT_VM_LOAD_NO_VERIFY)) {
+        const VerifyReport v = verify_chunk(c, std::thread::hardware_concurrency());
+        if (v.ok) {
+            p->verified = true;
+            p->max_stack = v.max_stack;
+        } else if (flags & VT_VM_LOAD_STRICT) {
+            const std::string where =
+                v.entry == kVerifyTopLevel ? std::string("code de haut niveau") : std::string(c.symbols[v.entry].name);
+            g_load_error = std::string(v.what) + " (pc " + std::to_string(v.pc) + ", entrée " + where + ")";
+            return VT_VM_E_VERIFY;
+        }
+        // Sinon : programme chargé tel quel, pile testée à chaque op (exec<false>).
+    }
+
+    const bool profile = (flags & VT_VM_LOAD_PROFILE) != 0;
+    p->superops = profile ? 0 : superops & kSuperopsAll;
+    p->stream = translate(c, p->kvals.data(), p->superops, profile);
+    p->prof.assign(p->stream.prof_pc.size(), 0);
+    p->id = g_program_ids.fetch_add(1, std::memory_order_relaxed);
+    for (Func& f : p->funcs) {
+        if (f.native < 0) f.entry = p->stream.pc_word[f.entry];
+    }
+
+    const void* const* labels = nullptr;
+    (p->verified ? exec<true> : exec<false>)(nullptr, nullptr, nullptr, nullptr, &labels);
+    if (labels) {
+        for (const StreamTile& t : p->stream.tiles) {
+            p->stream.words[t.word].h = labels[static_cast<uint32_t>(t.op)];
+        }
+    }
+
+    *out = p.release();
+    return VT_VM_OK;
+}
+
+int load(std::vector<uint8_t> bytes, uint32_t flags, uint64_t superops, vt_vm_program** out) {
+    auto p = std::unique_ptr<vt_vm_program>(new (std::nothrow) vt_vm_program);
+    if (!p) return load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+    const vt::ChunkError e = vt::decode_chunk(std::move(bytes), p->chunk, !(flags & VT_VM_LOAD_NO_HASH), true);
+    return load_decoded(std::move(p), e, flags, superops, out);
+}
+
+#if !defined(_WIN32)
+// Projection privée en lecture seule ; les vues du chunk pointent dans la projection.
+// 1 : repli sur la lecture (fichier vide ou non projetable).
+int load_mapped(int fd, uint32_t flags, uint64_t superops, vt_vm_program** out) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) return load_error(VT_VM_E_IO, "Lecture impossible");
+    if (!S_ISREG(st.st_mode) || st.st_size <= 0) return 1;
+    const auto len = static_cast<size_t>(st.st_size);
+    void* m = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED) return 1;
+    std::shared_ptr<const void> keep(m, [len](const void* a) { ::munmap(const_cast<void*>(a), len); });
+
+    auto p = std::unique_ptr<vt_vm_program>(new (std::nothrow) vt_vm_program);
+    if (!p) return load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+    const auto* base = static_cast<const uint8_t*>(m);
+    const vt::ChunkError e =
+        vt::decode_chunk_mapped(std::move(keep), base, len, p->chunk, !(flags & VT_VM_LOAD_NO_HASH), true);
+    // Debug (format 1 : lu pour l’empreinte) : ses pages pleines quittent le RSS, relues depuis
+    // le fichier au besoin. Format 2 : jamais touchées.
+    const vt::ChunkDebugRaw& d = p->chunk.debug_raw;
+    if (e == vt::ChunkError::Ok && d.lazy) {
+        const auto page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const uintptr_t lo = (reinterpret_cast<uintptr_t>(d.lines) + page - 1) & ~(page - 1);
+        const uintptr_t hi = reinterpret_cast<uintptr_t>(d.end) & ~(page - 1);
+        if (hi > lo) ::madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_DONTNEED);
+    }
+    return load_decoded(std::move(p), e, flags, superops, out);
+}
+#endif
+
+} // namespace vt_vmi
+
+VT_EXTERN_C_BEGIN
+
+VT_API int vt_vm_program_load_ex(const uint8_t* data, size_t len, uint32_t flags, uint64_t superops,
+                                 vt_vm_program** out) {
+    if (!out) return VT_VM_E_FORMAT;
+    *out = nullptr;
+    if (!data && len) return vt_vmi::load_error(VT_VM_E_FORMAT, "Tampon NULL");
+    try {
+        return vt_vmi::load(std::vector<uint8_t>(data, data + len), flags, superops, out);
+    } catch (const std::bad_alloc&) {
+        return vt_vmi::load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+    }
+}
+
+VT_API int vt_vm_program_load(const uint8_t* data, size_t len, uint32_t flags, vt_vm_program** out) {
+    return vt_vm_program_load_ex(data, len, flags, VT_VM_SUPEROPS_DEFAULT, out);
+}
+
+VT_API int vt_vm_program_load_file_ex(const char* path, uint32_t flags, uint64_t superops, vt_vm_program** out) {
+    if (!out) return VT_VM_E_FORMAT;
+    *out = nullptr;
+#if !defined(_WIN32)
+    if (path) {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return vt_vmi::load_error(VT_VM_E_IO, "Ouverture impossible");
+        int rc;
+        try {
+            rc = vt_vmi::load_mapped(fd, flags, superops, out);
+        } catch (const std::bad_alloc&) {
+            rc = vt_vmi::load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+        }
+        ::close(fd);
+        if (rc != 1) return rc;
+    }
+#endif
+    std::FILE* f = path ? std::fopen(path, "rb") : nullptr;
+    if (!f) return vt_vmi::load_error(VT_VM_E_IO, "Ouverture impossible");
+    std::vector<uint8_t> bytes;
+    try {
+        uint8_t buf[1 << 16];
+        size_t got;
+        while ((got = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + got);
+    } catch (const std::bad_alloc&) {
+        std::fclose(f);
+        return vt_vmi::load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+    }
+    const bool io_err = std::ferror(f) != 0;
+    std::fclose(f);
+    if (io_err) return vt_vmi::load_error(VT_VM_E_IO, "Lecture impossible");
+    try {
+        return vt_vmi::load(std::move(bytes), flags, superops, out);
+    } catch (const std::bad_alloc&) {
+        return vt_vmi::load_error(VT_VM_E_NOMEM, "Mémoire insuffisante");
+    }
+}
+
+VT_API int vt_vm_program_load_file(const char* path, uint32_t flags, vt_vm_program** out) {
+    return vt_vm_program_load_file_ex(path, flags, VT_VM_SUPEROPS_DEFAULT, out);
+}
+
+VT_API void vt_vm_program_free(vt_vm_program* p) { delete p; }
+
+VT_API const char* vt_vm_program_error(void) { return vt_vmi::g_load_error.c_str(); }
+
+VT_API void vt_vm_program_code_stats(const vt_vm_program* p, vt_vm_code_stats* out) {
+    if (!p || !out) return;
+    *out = vt_vm_code_stats{};
+    out->ops = p->stream.nops;
+    out->insns = static_cast<uint32_t>(p->stream.tiles.size() - 1);   // sans Halt
+    out->words = static_cast<uint32_t>(p->stream.words.size());
+    for (const vt::vm::StreamTile& t : p->stream.tiles) {
+        out->superinsns += static_cast<uint32_t>(t.op) > static_cast<uint32_t>(vt::vm::SOp::Prof);
+    }
+    out->superops = p->superops;
+    out->verified = p->verified;
+    out->max_stack = p->max_stack;
+    out->debug_loaded = p->debug.loaded();
+    out->line_bytes = static_cast<uint32_t>(p->debug.line_bytes());
+}
+
+VT_API uint32_t vt_vm_program_line_for_pc(const vt_vm_program* p, uint32_t pc) {
+    return p ? p->debug.line_for_pc(pc) : 0;
+}
+
+VT_API int vt_vm_program_profile(const vt_vm_program* p, vt_vm_profile* out) {
+    if (!p || !out) return VT_VM_E_STATE;
+    *out = vt_vm_profile{};
+    if (p->stream.prof_pc.empty() && p->stream.nops) return VT_VM_E_STATE;
+    out->nsuperops = vt::vm::kSuperopCount;
+    out->ops = vt::vm::profile_weights(p->chunk, p->stream, p->prof.data(), out->superops);
+    for (uint64_t k : p->prof) out->blocks += k;
+    return VT_VM_OK;
+}
+
+VT_API size_t vt_vm_superop_count(void) { return vt::vm::kSuperopCount; }
+
+VT_API const char* vt_vm_superop_name(size_t i) {
+    return i < vt::vm::kSuperopCount ? vt::vm::superop_name(static_cast<uint32_t>(i)) : nullptr;
+}
+
+VT_API uint64_t vt_vm_superops_select(const vt_vm_profile* prof, double min_share) {
+    if (!prof || !prof->ops) return 0;
+    return vt::vm::select_superops(prof->superops, prof->ops, min_share);
+}
+
+VT_API void vt_vm_config_default(vt_vm_config* cfg) {
+    if (!cfg) return;
+    cfg->stack_slots = 1u << 20;
+    cfg->max_frames = 1u << 16;
+    cfg->backend = VT_VM_BACKEND_INTERP;
+    cfg->jit_threshold = 1000;
+    cfg->jit_max_deopts = 64;
+    cfg->gc_nursery_bytes = 1u << 20;
+    cfg->gc_major_bytes = 8u << 20;
+}
+
+VT_API vt_vm* vt_vm_new(const vt_vm_config* cfg) {
+    auto vm = std::unique_ptr<vt_vm>(new (std::nothrow) vt_vm);
+    if (!vm) return nullptr;
+    vt_vm_config_default(&vm->cfg);
+    if (cfg) {
+        if (cfg->stack_slots) vm->cfg.stack_slots = std::max<uint32_t>(cfg->stack_slots, 16);
+        if (cfg->max_frames) vm->cfg.max_frames = cfg->max_frames;
+        vm->cfg.backend = cfg->backend;
+        if (cfg->jit_threshold) vm->cfg.jit_threshold = cfg->jit_threshold;
+        if (cfg->jit_max_deopts) vm->cfg.jit_max_deopts = cfg->jit_max_deopts;
+        if (cfg->gc_nursery_bytes) vm->cfg.gc_nursery_bytes = cfg->gc_nursery_bytes;
+        if (cfg->gc_major_bytes) vm->cfg.gc_major_bytes = cfg->gc_major_bytes;
+    }
+    if (vm->cfg.backend == VT_VM_BACKEND_JIT) {
+        vm->jit.reset(new (std::nothrow) vt::vm::jit::CodeCache);
+        if (vm->jit && !vm->jit->available()) vm->jit.reset();   // plateforme non prise en charge
+    }
+    if (!vm->heap.init(vm->cfg.gc_nursery_bytes, vm->cfg.gc_major_bytes)) return nullptr;
+    vm->heap.set_hook(&vt_vmi::gc_event, vm.get());
+    vm->regs.reset(new (std::nothrow) vt::vm::Value[vm->cfg.stack_slots]);
+    vm->frames.reset(new (std::nothrow) vt_vmi::Frame[vm->cfg.max_frames]);
+    if (!vm->regs || !vm->frames) return nullptr;
+    return vm.release();
+}
+
+VT_API void vt_vm_free(vt_vm* vm) { delete vm; }
+
+VT_API void vt_vm_set_print(vt_vm* vm, vt_vm_print_fn fn, void* user) {
+    if (!vm) return;
+    vm->print_fn = fn;
+    vm->print_user = user;
+}
+
+VT_API int vt_vm_run(vt_vm* vm, const vt_vm_program* p, const char* entry, vt_vm_result* out) {
+    if (!vm || !p) return VT_VM_E_ENTRY;
+    vm->err.clear();
+    const vt::vm::Word* start = p->stream.words.data();
+    if (entry) {
+        const std::string_view name(entry);
+        const auto it = std::find_if(p->funcs.begin(), p->funcs.end(),
+                                     [&](const vt_vmi::Func& f) { return f.name == name; });
+        if (it == p->funcs.end() || it->native >= 0) {
+            vm->err = "Symbole d’entrée inconnu : " + std::string(name);
+            return VT_VM_E_ENTRY;
+        }
+        start += it->entry;
+    }
+    try {
+        vm->ic.assign(p->stream.ncall_sites, vt_vmi::CallIC{});
+        for (uint32_t i = 0; i < p->stream.ncall_sites; ++i) vm->ic[i].pc = p->stream.site_pc[i];
+        if (vm->jit && vm->jit_prog != p->id) {
+            vm->jit->reset();
+            vm->jfuncs.assign(p->funcs.size(), vt_vmi::JitFunc{});
+            vm->jit_prog = p->id;
+        }
+    } catch (const std::bad_alloc&) {
+        vm->err = "Mémoire insuffisante";
+        return VT_VM_E_NOMEM;
+    }
+    vm->heap.reset();   // les fermetures du run précédent (et leurs clés de cache) disparaissent
+    vm->release_owned();
+    vm->cur = p;
+    return (p->verified ? vt_vmi::exec<true> : vt_vmi::exec<false>)(vm, p, start, out, nullptr);
+}
+
+VT_API const char* vt_vm_last_error(const vt_vm* vm) { return vm ? vm->err.c_str() : ""; }
+
+VT_API size_t vt_vm_ic_sites(const vt_vm* vm, vt_vm_ic_site* out, size_t cap) {
+    if (!vm) return 0;
+    const size_t n = std::min(cap, vm->ic.size());
+    for (size_t i = 0; i < n && out; ++i) {
+        const vt_vmi::CallIC& ic = vm->ic[i];
+        uint32_t state = ic.n > 1 ? static_cast<uint32_t>(VT_VM_IC_POLY) : ic.n;
+        if (ic.mega) state = VT_VM_IC_MEGA;
+        out[i] = vt_vm_ic_site{ic.pc, state, ic.n, ic.hits, ic.misses};
+    }
+    return vm->ic.size();
+}
+
+VT_API void vt_vm_get_gc_stats(const vt_vm* vm, vt_vm_gc_stats* out) {
+    if (!vm || !out) return;
+    const vt::vm::gc::Stats s = vm->heap.stats();
+    *out = vt_vm_gc_stats{s.minor,           s.major,          s.pause_ns, s.max_pause_ns,
+                          s.allocated_bytes, s.promoted_bytes, s.old_bytes, s.heap_bytes};
+}
+
+VT_API void vt_vm_set_gc_hook(vt_vm* vm, vt_vm_gc_fn fn, void* user) {
+    if (!vm) return;
+    vm->gc_fn = fn;
+    vm->gc_user = user;
+}
+
+VT_API void vt_vm_get_stats(const vt_vm* vm, vt_vm_stats* out) {
+    if (!vm || !out) return;
+    *out = vm->stats;
+    if (vm->jit) out->jit_code_bytes = vm->jit->code_bytes();
+}
+
+VT_EXTERN_C_END
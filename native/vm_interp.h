@@ -0,0 +1,278 @@
+// native/vm_interp.h
+// Moteur d’exécution natif du jeu d’instructions `Op` (crates/vitte-core/src/bytecode/ops.rs) :
+// dispatch en threading direct (computed goto) sur un flux pré-décodé au chargement, avec
+// superinstructions pour les séquences fréquentes, valeurs NaN-boxées sur 8 octets, pile de
+// registres contiguë (locaux + opérandes de chaque frame côte à côte) et `Call` avec cache
+// en ligne par site d’appel. Embarquable tel quel (desktop, hôtes C++).
+//
+// API C exposée (ABI stable pour FFI):
+//   int   vt_vm_program_load(const uint8_t* data, size_t len, uint32_t flags, vt_vm_program** out);
+//   int   vt_vm_program_load_file(const char* path, uint32_t flags, vt_vm_program** out);
+//   int   vt_vm_program_load_ex(const uint8_t* data, size_t len, uint32_t flags, uint64_t superops,
+//                               vt_vm_program** out);
+//   int   vt_vm_program_load_file_ex(const char* path, uint32_t flags, uint64_t superops,
+//                                    vt_vm_program** out);
+//   void  vt_vm_program_free(vt_vm_program* p);
+//   const char* vt_vm_program_error(void);
+//   void  vt_vm_program_code_stats(const vt_vm_program* p, vt_vm_code_stats* out);
+//   uint32_t vt_vm_program_line_for_pc(const vt_vm_program* p, uint32_t pc);
+//
+//   size_t      vt_vm_superop_count(void);
+//   const char* vt_vm_superop_name(size_t i);
+//   int         vt_vm_program_profile(const vt_vm_program* p, vt_vm_profile* out);
+//   uint64_t    vt_vm_superops_select(const vt_vm_profile* prof, double min_share);
+//
+//   void    vt_vm_config_default(vt_vm_config* cfg);
+//   vt_vm*  vt_vm_new(const vt_vm_config* cfg);
+//   void    vt_vm_free(vt_vm* vm);
+//   void    vt_vm_set_print(vt_vm* vm, vt_vm_print_fn fn, void* user);
+//   int     vt_vm_run(vt_vm* vm, const vt_vm_program* p, const char* entry, vt_vm_result* out);
+//   const char* vt_vm_last_error(const vt_vm* vm);
+//   void    vt_vm_get_stats(const vt_vm* vm, vt_vm_stats* out);
+//   size_t  vt_vm_ic_sites(const vt_vm* vm, vt_vm_ic_site* out, size_t cap);
+//   void    vt_vm_get_gc_stats(const vt_vm* vm, vt_vm_gc_stats* out);
+//   void    vt_vm_set_gc_hook(vt_vm* vm, vt_vm_gc_fn fn, void* user);
+//
+// Sémantique (alignée sur la mini-VM Rust `vitte_vm::Vm::run` / `runtime::eval`) :
+// - Arithmétique : chemin rapide entier ; sinon calcul en f64, résultat ramené en entier
+//   s’il est entier à 1e-12 près. Comparaisons numériques, Eq structurel (chaînes par
+//   contenu, entier ≠ flottant). JumpIfFalse consomme la condition (faux : false/null).
+// - Appels : pile [.., callee, a0..aN-1] → résultat ; les arguments deviennent les locaux
+//   0..N-1 de l’appelé, ReturnVoid rend null. `FuncIx` indexe `debug.symbols` (nom, pc
+//   d’entrée), seule table de fonctions du format actuel.
+// - MakeClosure(f, n) capture par valeur les n premiers locaux du frame courant.
+//
+// Remarques :
+// - Entiers immédiats sur 48 bits signés ; au-delà, représentés en double (exact jusqu’à
+//   2^53, comme le calcul en f64 de la VM Rust).
+// - Valeurs : vt_value (vt_value.h), le mot NaN-boxé de la pile ; vt_vm_result.v le rend
+//   tel quel à l’hôte.
+// - Natives (vt_native.h) : les imports de debug.symbols (pc VT_NATIVE_IMPORT_PC) sont
+//   résolus au chargement contre le registre ; Call/TailCall sur un tel FuncIx appelle la
+//   fonction hôte sur la tranche d’arguments en place (cache d’appel compris, aucune frame).
+//   Objets comptés rendus : possédés par le vt_vm jusqu’au run suivant.
+// - Les fermetures vivent dans le tas générationnel du vt_vm (vm_gc.hpp) : nursery à
+//   allocation par incrément et collecte mineure par copie, ancienne génération mark-region
+//   (collecte majeure non déplaçante). Racines exactes : pile de registres, frames, valeurs
+//   possédées ; tout le tas est rendu au vt_vm_run() suivant ou à vt_vm_free().
+// - Un vt_vm par thread ; un vt_vm_program est en lecture seule et partageable (sauf chargé
+//   avec VT_VM_LOAD_PROFILE : ses compteurs ne sont pas atomiques).
+// - Superinstructions : bit i du masque = motif i (vt_vm_superop_name). Choix par profil :
+//   charger avec VT_VM_LOAD_PROFILE, exécuter une charge représentative, puis
+//   vt_vm_superops_select(profil, part) et recharger avec vt_vm_program_load_ex().
+// - Vérification au chargement (vm_verify.hpp, entrées réparties sur un pool de threads) :
+//   profondeur de pile de chaque op atteignable, indices et cibles de saut. Un programme
+//   prouvé s’exécute sans test de pile par op (place réservée une fois par frame) ; un
+//   programme non prouvable est chargé avec les tests, ou refusé sous VT_VM_LOAD_STRICT.
+// - Debug (lignes, fichiers) : décodé à la première erreur ou vt_vm_program_line_for_pc(),
+//   en table compacte ; un chunk strippé et un chunk complet se chargent au même coût.
+//   vt_vm_program_load_file() projette le fichier (mmap, POSIX) sans copie.
+// - Sans GCC/Clang (computed goto), repli automatique sur un `switch`.
+// - JIT (VT_VM_BACKEND_JIT) : une fonction appelée jit_threshold fois est compilée en code
+//   x86-64 (vm_jit.hpp) ; gardes de type sur les chemins entiers, désoptimisation vers
+//   l’interpréteur à l’op qui échoue. Le code compilé vit avec le vt_vm (un programme à la
+//   fois : exécuter un autre programme le libère).
+
+#ifndef VITTE_NATIVE_VM_INTERP_H
+#define VITTE_NATIVE_VM_INTERP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+#include "vt_native.h"
+#include "vt_value.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef struct vt_vm vt_vm;
+typedef struct vt_vm_program vt_vm_program;
+
+enum {
+    VT_VM_OK = 0,
+    VT_VM_E_IO = -1,            // lecture du fichier
+    VT_VM_E_FORMAT = -2,        // chunk illisible (magic, version, tags, troncature)
+    VT_VM_E_HASH = -3,          // empreinte FNV-1a invalide
+    VT_VM_E_BOUNDS = -4,        // const/FuncIx/cible de saut hors limites
+    VT_VM_E_TYPE = -5,          // opérandes de mauvais type
+    VT_VM_E_STACK = -6,         // débordement / sous-dépassement de pile
+    VT_VM_E_CALL = -7,          // appel d’une non-fonction, profondeur d’appels dépassée
+    VT_VM_E_NOMEM = -8,
+    VT_VM_E_ENTRY = -9,         // symbole d’entrée inconnu
+    VT_VM_E_STATE = -10,        // programme non chargé en mode profil
+    VT_VM_E_NATIVE = -11,       // import natif non enregistré (chargement), échec d’une native
+    VT_VM_E_VERIFY = -12,       // rejeté par le vérificateur (VT_VM_LOAD_STRICT)
+};
+
+// Options de chargement.
+enum {
+    VT_VM_LOAD_NO_HASH = 1u << 0,   // ne pas vérifier l’empreinte de l’en-tête
+    VT_VM_LOAD_PROFILE = 1u << 1,   // compteurs de blocs de base, sans superinstructions
+    VT_VM_LOAD_NO_VERIFY = 1u << 2, // pas de vérification : pile testée à chaque op
+    VT_VM_LOAD_STRICT = 1u << 3,    // échec de vérification ⇒ VT_VM_E_VERIFY (sinon repli testé)
+};
+
+// Masques de superinstructions.
+#define VT_VM_SUPEROP_MAX 32
+#define VT_VM_SUPEROPS_ALL ((uint64_t)0x7FF)
+#define VT_VM_SUPEROPS_DEFAULT VT_VM_SUPEROPS_ALL
+
+enum {
+    VT_VM_NULL = 0,
+    VT_VM_BOOL = 1,
+    VT_VM_INT = 2,
+    VT_VM_FLOAT = 3,
+    VT_VM_STR = 4,
+    VT_VM_BYTES = 5,
+    VT_VM_FUNC = 6,
+    VT_VM_ARRAY = 7,       // rendus par une native (vt_value.h)
+    VT_VM_FOREIGN = 8,
+};
+
+typedef struct vt_vm_result {
+    int kind;              // VT_VM_NULL…
+    int64_t i;             // BOOL (0/1), INT, FUNC (FuncIx)
+    double f;              // FLOAT
+    const char* s;         // STR/BYTES : vue sur le programme (pas de terminaison NUL)
+    size_t n;              // ARRAY : nombre d’éléments
+    vt_value v;            // valeur brute (vt_value.h) : objets statiques, valides jusqu’au run suivant
+} vt_vm_result;
+
+// Moteur d’exécution (`backend = "vm" | "jit"` de vitte.toml).
+enum {
+    VT_VM_BACKEND_INTERP = 0,
+    VT_VM_BACKEND_JIT = 1,   // x86-64 Linux ; ailleurs, interpréteur seul
+};
+
+typedef struct vt_vm_config {
+    uint32_t stack_slots;     // valeurs de la pile de registres (défaut 1 << 20)
+    uint32_t max_frames;      // profondeur d’appels (défaut 1 << 16)
+    uint32_t backend;         // VT_VM_BACKEND_* (défaut INTERP)
+    uint32_t jit_threshold;   // appels d’une fonction avant compilation (défaut 1000)
+    uint32_t jit_max_deopts;  // désoptimisations avant retour définitif à l’interpréteur (défaut 64)
+    uint32_t gc_nursery_bytes;   // nursery des fermetures (défaut 1 Mio, min 64 Kio)
+    uint32_t gc_major_bytes;     // promotions déclenchant la première collecte majeure (défaut 8 Mio)
+} vt_vm_config;
+
+typedef struct vt_vm_stats {
+    uint64_t calls;            // Call + TailCall
+    uint64_t call_ic_misses;   // résolutions hors cache
+    uint64_t closures;         // fermetures allouées (n > 0)
+    uint64_t jit_compiled;     // montées de niveau (fonctions compilées)
+    uint64_t jit_failed;       // fonctions non compilables
+    uint64_t jit_entries;      // entrées dans du code natif (appel ou reprise après Call)
+    uint64_t jit_deopts;       // gardes échouées (reprise dans l’interpréteur)
+    uint64_t jit_discarded;    // fonctions rendues à l’interpréteur (trop de deopts)
+    uint64_t jit_code_bytes;   // code machine généré
+    uint64_t native_calls;     // appels de natives (vt_native.h)
+    uint64_t call_ic_hits;     // appels servis par le cache du site
+} vt_vm_stats;
+
+// État d’un cache d’appel (jusqu’à 4 cibles par site).
+enum {
+    VT_VM_IC_EMPTY = 0,   // site jamais exécuté
+    VT_VM_IC_MONO = 1,
+    VT_VM_IC_POLY = 2,
+    VT_VM_IC_MEGA = 3,    // plus de cibles que de voies : évictions, résolutions répétées
+};
+
+typedef struct vt_vm_ic_site {
+    uint32_t pc;           // Call/TailCall du chunk
+    uint32_t state;        // VT_VM_IC_*
+    uint32_t targets;      // voies remplies
+    uint64_t hits;
+    uint64_t misses;       // résolutions (premier appel, nouvelle cible, après collecte)
+} vt_vm_ic_site;
+
+// Cumulés depuis vt_vm_new (le tas est vidé à chaque run, pas les compteurs).
+typedef struct vt_vm_gc_stats {
+    uint64_t minor;            // collectes de la nursery
+    uint64_t major;            // collectes de l’ancienne génération
+    uint64_t pause_ns;         // pauses cumulées
+    uint64_t max_pause_ns;
+    uint64_t allocated_bytes;  // octets alloués (fermetures)
+    uint64_t promoted_bytes;   // survivants copiés vers l’ancienne génération
+    uint64_t old_bytes;        // ancienne génération vivante après la dernière collecte
+    uint64_t heap_bytes;       // blocs + gros objets réservés
+} vt_vm_gc_stats;
+
+enum {
+    VT_VM_GC_MINOR = 0,
+    VT_VM_GC_MAJOR = 1,
+};
+
+typedef struct vt_vm_gc_event {
+    uint32_t kind;             // VT_VM_GC_*
+    uint64_t pause_ns;
+    uint64_t live_bytes;       // survivants (mineure) / ancienne génération marquée (majeure)
+    uint64_t freed_bytes;
+} vt_vm_gc_event;
+
+// Appelé en fin de collecte, sur le thread du run ; ne doit pas rappeler la VM.
+typedef void (*vt_vm_gc_fn)(void* user, const vt_vm_gc_event* ev);
+
+typedef struct vt_vm_code_stats {
+    uint32_t ops;          // ops du chunk
+    uint32_t insns;        // instructions du flux (après fusion, sans Halt)
+    uint32_t words;        // mots de 8 octets (handlers + opérandes)
+    uint32_t superinsns;   // instructions fusionnées
+    uint64_t superops;     // masque appliqué
+    uint32_t verified;     // 1 : prouvé au chargement (vm_verify.hpp), sans tests de pile par op
+    uint32_t max_stack;    // profondeur d’opérandes maximale prouvée
+    uint32_t debug_loaded; // 1 : sections de debug décodées (première erreur ou ligne demandée)
+    uint32_t line_bytes;   // taille de la table des lignes compacte (0 avant décodage)
+} vt_vm_code_stats;
+
+typedef struct vt_vm_profile {
+    uint64_t ops;                           // ops exécutées
+    uint64_t blocks;                        // entrées de blocs de base
+    uint32_t nsuperops;                     // motifs renseignés
+    uint64_t superops[VT_VM_SUPEROP_MAX];   // exécutions de chaque motif (chevauchements inclus)
+} vt_vm_profile;
+
+// Sortie de `Print` (une valeur formatée, sans '\n'). Défaut : stdout + '\n'.
+typedef void (*vt_vm_print_fn)(void* user, const char* s, size_t n);
+
+// 0 ou VT_VM_E_*. *out reste NULL en cas d’échec (message : vt_vm_program_error()).
+// Sans suffixe _ex : superinstructions VT_VM_SUPEROPS_DEFAULT.
+VT_API int   vt_vm_program_load(const uint8_t* data, size_t len, uint32_t flags, vt_vm_program** out);
+VT_API int   vt_vm_program_load_file(const char* path, uint32_t flags, vt_vm_program** out);
+VT_API int   vt_vm_program_load_ex(const uint8_t* data, size_t len, uint32_t flags, uint64_t superops,
+                                   vt_vm_program** out);
+VT_API int   vt_vm_program_load_file_ex(const char* path, uint32_t flags, uint64_t superops,
+                                        vt_vm_program** out);
+VT_API void  vt_vm_program_free(vt_vm_program* p);
+// Dernier échec de chargement du thread courant.
+VT_API const char* vt_vm_program_error(void);
+VT_API void  vt_vm_program_code_stats(const vt_vm_program* p, vt_vm_code_stats* out);
+// Ligne source de l’op `pc` (0 : inconnue, chunk strippé). Le premier appel décode les
+// sections de debug.
+VT_API uint32_t vt_vm_program_line_for_pc(const vt_vm_program* p, uint32_t pc);
+
+VT_API size_t      vt_vm_superop_count(void);
+VT_API const char* vt_vm_superop_name(size_t i);   // "ldl+ldc+add+stl"… ; NULL hors menu
+// Poids cumulés depuis le chargement. VT_VM_E_STATE sans VT_VM_LOAD_PROFILE.
+VT_API int         vt_vm_program_profile(const vt_vm_program* p, vt_vm_profile* out);
+// Motifs dont les dispatchs économisés atteignent min_share des ops exécutées (ex. 0.01).
+VT_API uint64_t    vt_vm_superops_select(const vt_vm_profile* prof, double min_share);
+
+VT_API void    vt_vm_config_default(vt_vm_config* cfg);
+// cfg NULL ⇒ défauts. NULL si l’allocation échoue.
+VT_API vt_vm*  vt_vm_new(const vt_vm_config* cfg);
+VT_API void    vt_vm_free(vt_vm* vm);
+VT_API void    vt_vm_set_print(vt_vm* vm, vt_vm_print_fn fn, void* user);
+
+// Exécute depuis pc 0 (entry NULL) ou depuis le symbole `entry`. Le résultat est la valeur
+// du Return de plus haut niveau (ou le sommet de pile en fin de code, null si vide).
+// 0 ou VT_VM_E_* (message : vt_vm_last_error, avec pc et ligne).
+VT_API int     vt_vm_run(vt_vm* vm, const vt_vm_program* p, const char* entry, vt_vm_result* out);
+VT_API const char* vt_vm_last_error(const vt_vm* vm);
+VT_API void    vt_vm_get_stats(const vt_vm* vm, vt_vm_stats* out);
+// Sites d’appel du dernier run (ordre du chunk) : copie min(cap, total), rend le total.
+VT_API size_t  vt_vm_ic_sites(const vt_vm* vm, vt_vm_ic_site* out, size_t cap);
+VT_API void    vt_vm_get_gc_stats(const vt_vm* vm, vt_vm_gc_stats* out);
+VT_API void    vt_vm_set_gc_hook(vt_vm* vm, vt_vm_gc_fn fn, void* user);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_VM_INTERP_H
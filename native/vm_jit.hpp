@@ -0,0 +1,689 @@
+// native/vm_jit.hpp
+// JIT de base (templates) du moteur natif, x86-64 Linux : une fonction chaude (seuil
+// d’appels, cf. vm_interp.cpp) est recopiée op par op en code machine, avec les chemins
+// rapides entiers d’Add/Sub/Mul/Lt/… en ligne derrière des gardes de type. Header-only,
+// inclus par vm_interp.cpp.
+//
+// Modèle d’exécution :
+// - Le code natif travaille sur la pile de registres de l’interpréteur : r12 = lp (locaux),
+//   r14 = sbase (opérandes), r15 = State. La profondeur de pile de chaque op est connue à
+//   la compilation (analyse depuis l’entrée) : les opérandes sont adressés à [r14 + 8·i],
+//   sans pointeur de pile ni test de sous-dépassement ; le débordement est vérifié une
+//   fois à l’entrée de la fonction.
+// - Sorties vers l’interpréteur : Call/TailCall/Return (gestion des frames), fin de code,
+//   et désoptimisation quand une garde échoue (flottant, chaîne, dépassement 48 bits…).
+//   L’interpréteur reprend au mot du flux de l’op (début de la superinstruction qui la
+//   contient) et la ré-exécute par son chemin générique. Après un Call sorti du JIT, le
+//   retour reprend dans le code natif (State::cont, conservé dans la frame).
+// - Pas d’appel natif à natif : une fonction sans boucle qui appelle (récursion type fib)
+//   n’est pas compilée, ses transitions coûteraient plus que l’interprétation.
+// - Div/Mod/Neg/Eq/Ne, Print et MakeClosure capturante passent par des fonctions d’aide.
+// - GC (vm_gc.hpp) : avant le hook d’allocation, State::sp reçoit le sommet de pile de l’op
+//   (profondeur statique) — c’est la carte de pile du code compilé. StoreUpvalue d’un objet
+//   passe par le hook de barrière d’écriture.
+//
+// Remarques :
+// - W^X : chaque fonction est écrite dans une projection RW puis basculée en RX
+//   (mprotect) avant la première exécution ; aucune page n’est jamais RW et X à la fois.
+// - Le code embarque des adresses propres au programme (constantes objets, mots du flux) :
+//   un CodeCache sert un seul programme à la fois (reset au changement).
+// - Ailleurs qu’en x86-64 Linux, available() est faux et l’interpréteur reste seul.
+
+#ifndef VITTE_NATIVE_VM_JIT_HPP
+#define VITTE_NATIVE_VM_JIT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "vm_chunk.hpp"
+#include "vm_stream.hpp"
+#include "vm_value.hpp"
+#include "vm_verify.hpp"
+
+#if defined(__x86_64__) && defined(__linux__)
+#define VT_VM_JIT_X64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define VT_VM_JIT_X64 0
+#endif
+
+namespace vt::vm::jit {
+
+enum Reason : uint32_t {
+    Exit = 0,    // sortie prévue (appel, retour, fin de code)
+    Deopt = 1,   // garde échouée
+};
+
+// Partagé avec le code généré (offsets figés par offsetof).
+struct State {
+    Value* lp;           // entrée
+    Value* sbase;        // entrée
+    Value* send;         // entrée : fin de la pile de registres
+    Closure* clo;        // entrée
+    void* ctx;           // entrée : contexte des hooks
+    Value* sp;           // sortie ; sommet exact pendant un hook d’allocation
+    const void* cont;    // sortie : reprise native après un Call sorti du JIT (sinon nullptr)
+    uint32_t reason;     // sortie
+    uint32_t func;       // sortie : FuncIx du code sorti
+};
+
+struct Hooks {
+    void (*print)(State* st, Value v);
+    Value (*make_closure)(State* st, uint32_t func, uint32_t n);   // 0 : mémoire insuffisante
+    uint64_t (*barrier)(State* st, Closure* c, Value v);           // 0 : mémoire insuffisante
+};
+
+struct Input {
+    const Chunk* chunk;
+    const Stream* stream;
+    const Value* kvals;
+    uint32_t func;       // FuncIx
+    uint32_t entry_pc;
+    Hooks hooks;
+};
+
+namespace detail {
+
+// Chemins lents appelés par le code natif : slot[0] (op) slot[1] → slot[0] ; false : type.
+inline bool h_div(Value* s) { return op_div(s[0], s[1], s[0]); }
+inline bool h_mod(Value* s) { return op_mod(s[0], s[1], s[0]); }
+inline bool h_neg(Value* s) { return op_neg(s[0], s[0]); }
+inline bool h_eq(Value* s) {
+    s[0] = from_bool(values_eq(s[0], s[1]));
+    return true;
+}
+inline bool h_ne(Value* s) {
+    s[0] = from_bool(!values_eq(s[0], s[1]));
+    return true;
+}
+
+enum Reg : uint8_t { RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+                     R8, R9, R10, R11, R12, R13, R14, R15 };
+enum Cond : uint8_t { CO = 0x0, CE = 0x4, CNE = 0x5, CBE = 0x6, CL = 0xC, CGE = 0xD, CLE = 0xE, CG = 0xF };
+
+// Assembleur minimal : adressage [base + disp32] et registre-registre uniquement.
+class Asm {
+public:
+    std::vector<uint8_t> b;
+
+    size_t pos() const { return b.size(); }
+    void u8(uint8_t v) { b.push_back(v); }
+    void u32(uint32_t v) { put(&v, 4); }
+    void u64(uint64_t v) { put(&v, 8); }
+
+    void load(Reg d, Reg base, int32_t disp) { op_mem(true, 0x8B, d, base, disp); }
+    void load32(Reg d, Reg base, int32_t disp) { op_mem(false, 0x8B, d, base, disp); }
+    void store(Reg base, int32_t disp, Reg s) { op_mem(true, 0x89, s, base, disp); }
+    void store32_imm(Reg base, int32_t disp, uint32_t imm) {
+        op_mem(false, 0xC7, RAX, base, disp);
+        u32(imm);
+    }
+    // Rend la position de l’immédiat 64 bits (adresses résolues après placement).
+    size_t mov_imm64(Reg d, uint64_t imm) {
+        rex(true, RAX, d);
+        u8(static_cast<uint8_t>(0xB8 + (d & 7)));
+        const size_t at = pos();
+        u64(imm);
+        return at;
+    }
+    void mov_imm32(Reg d, uint32_t imm) {
+        rex(false, RAX, d);
+        u8(static_cast<uint8_t>(0xB8 + (d & 7)));
+        u32(imm);
+    }
+    void mov(Reg d, Reg s) { op_rr(true, 0x89, s, d); }
+    void add(Reg d, Reg s) { op_rr(true, 0x01, s, d); }
+    void sub(Reg d, Reg s) { op_rr(true, 0x29, s, d); }
+    void or_(Reg d, Reg s) { op_rr(true, 0x09, s, d); }
+    void cmp(Reg d, Reg s) { op_rr(true, 0x39, s, d); }
+    void test(Reg d, Reg s) { op_rr(true, 0x85, s, d); }
+    void test8(Reg d, Reg s) { op_rr(false, 0x84, s, d); }   // registres < 4
+    void xor32(Reg d, Reg s) { op_rr(false, 0x31, s, d); }
+    void imul(Reg d, Reg s) {
+        rex(true, d, s);
+        u8(0x0F);
+        u8(0xAF);
+        modrm_rr(d, s);
+    }
+    void add_imm(Reg d, int32_t imm) { alu_imm(true, 0, d, imm); }
+    void cmp_imm(Reg d, int32_t imm) { alu_imm(true, 7, d, imm); }
+    void cmp32_imm(Reg d, uint32_t imm) { alu_imm(false, 7, d, static_cast<int32_t>(imm)); }
+    void shl(Reg d, uint8_t n) { shift(4, d, n); }
+    void shr(Reg d, uint8_t n) { shift(5, d, n); }
+    void sar(Reg d, uint8_t n) { shift(7, d, n); }
+    void setcc(Cond c, Reg d) {   // registres < 4
+        u8(0x0F);
+        u8(static_cast<uint8_t>(0x90 | c));
+        modrm_rr(RAX, d);
+    }
+    void call(Reg r) {
+        rex(false, RAX, r);
+        u8(0xFF);
+        modrm_rr(static_cast<Reg>(2), r);
+    }
+    void jmp_r(Reg r) {
+        rex(false, RAX, r);
+        u8(0xFF);
+        modrm_rr(static_cast<Reg>(4), r);
+    }
+    void push(Reg r) {
+        rex(false, RAX, r);
+        u8(static_cast<uint8_t>(0x50 + (r & 7)));
+    }
+    void pop(Reg r) {
+        rex(false, RAX, r);
+        u8(static_cast<uint8_t>(0x58 + (r & 7)));
+    }
+    void ret() { u8(0xC3); }
+    // Sauts rel32 : rendent la position du déplacement à corriger.
+    size_t jcc(Cond c) {
+        u8(0x0F);
+        u8(static_cast<uint8_t>(0x80 | c));
+        u32(0);
+        return pos() - 4;
+    }
+    size_t jmp() {
+        u8(0xE9);
+        u32(0);
+        return pos() - 4;
+    }
+    void patch_rel(size_t at, size_t target) {
+        const auto rel = static_cast<int32_t>(static_cast<int64_t>(target) - static_cast<int64_t>(at + 4));
+        std::memcpy(b.data() + at, &rel, 4);
+    }
+    void patch_u64(size_t at, uint64_t v) { std::memcpy(b.data() + at, &v, 8); }
+
+private:
+    void put(const void* p, size_t n) {
+        const auto* c = static_cast<const uint8_t*>(p);
+        b.insert(b.end(), c, c + n);
+    }
+    void rex(bool w, Reg reg, Reg rm) {
+        const uint8_t r = static_cast<uint8_t>(0x40 | (w ? 8 : 0) | ((reg >> 3) << 2) | (rm >> 3));
+        if (r != 0x40) u8(r);
+    }
+    void modrm_rr(Reg reg, Reg rm) { u8(static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7))); }
+    void op_mem(bool w, uint8_t opc, Reg reg, Reg base, int32_t disp) {
+        rex(w, reg, base);
+        u8(opc);
+        u8(static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7)));
+        if ((base & 7) == 4) u8(0x24);   // rsp/r12 : SIB obligatoire
+        u32(static_cast<uint32_t>(disp));
+    }
+    void op_rr(bool w, uint8_t opc, Reg reg, Reg rm) {
+        rex(w, reg, rm);
+        u8(opc);
+        modrm_rr(reg, rm);
+    }
+    void alu_imm(bool w, uint8_t ext, Reg d, int32_t imm) {
+        rex(w, RAX, d);
+        u8(0x81);
+        modrm_rr(static_cast<Reg>(ext), d);
+        u32(static_cast<uint32_t>(imm));
+    }
+    void shift(uint8_t ext, Reg d, uint8_t n) {
+        rex(true, RAX, d);
+        u8(0xC1);
+        modrm_rr(static_cast<Reg>(ext), d);
+        u8(n);
+    }
+};
+
+constexpr int32_t kLp = offsetof(State, lp);
+constexpr int32_t kSbase = offsetof(State, sbase);
+constexpr int32_t kSend = offsetof(State, send);
+constexpr int32_t kClo = offsetof(State, clo);
+constexpr int32_t kSp = offsetof(State, sp);
+constexpr int32_t kCont = offsetof(State, cont);
+constexpr int32_t kReason = offsetof(State, reason);
+constexpr int32_t kFunc = offsetof(State, func);
+
+inline int32_t closure_n_offset() {
+    static const int32_t off = [] {
+        Closure c{};
+        return static_cast<int32_t>(reinterpret_cast<const char*>(&c.n) - reinterpret_cast<const char*>(&c));
+    }();
+    return off;
+}
+
+} // namespace detail
+
+class CodeCache {
+public:
+    CodeCache() { init(); }
+    ~CodeCache() {
+        reset();
+#if VT_VM_JIT_X64
+        if (tramp_) munmap(tramp_, page_);
+#endif
+    }
+    CodeCache(const CodeCache&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+
+    bool available() const { return tramp_ != nullptr; }
+    size_t code_bytes() const { return bytes_; }
+
+    // Libère tout le code compilé (aucune frame ne doit plus y faire référence).
+    void reset() {
+#if VT_VM_JIT_X64
+        for (const Map& m : maps_) munmap(m.p, m.n);
+#endif
+        maps_.clear();
+        bytes_ = 0;
+    }
+
+    // Exécute depuis `target` (entrée de fonction ou reprise) jusqu’à la prochaine sortie ;
+    // rend le mot du flux où l’interpréteur reprend.
+    const Word* enter(State* st, const void* target) const {
+        using Fn = const Word* (*)(State*, const void*);
+        Fn fn;
+        std::memcpy(&fn, &tramp_, sizeof(fn));
+        return fn(st, target);
+    }
+
+    // Compile la fonction ; nullptr si non compilable (profondeurs incohérentes, trop
+    // grande), dominée par ses appels (sans boucle, avec Call/TailCall) ou plateforme non
+    // prise en charge.
+    const void* compile(const Input& in);
+
+private:
+    struct Map {
+        void* p;
+        size_t n;
+    };
+    void* tramp_ = nullptr;
+    size_t page_ = 4096;
+    size_t bytes_ = 0;
+    std::vector<Map> maps_;
+
+    void* place(const std::vector<uint8_t>& code, size_t& n);
+    void init();
+};
+
+#if VT_VM_JIT_X64
+
+inline void* CodeCache::place(const std::vector<uint8_t>& code, size_t& n) {
+    n = (code.size() + page_ - 1) & ~(page_ - 1);
+    void* p = mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return nullptr;
+    return p;
+}
+
+inline void CodeCache::init() {
+    const long ps = sysconf(_SC_PAGESIZE);
+    if (ps > 0) page_ = static_cast<size_t>(ps);
+    using namespace detail;
+    // enter(State* st = rdi, const void* target = rsi) : 3 push → pile alignée sur 16 pour
+    // les appels d’aide ; chaque sortie dépile elle-même (pop r15, r14, r12 ; ret).
+    Asm a;
+    a.push(R12);
+    a.push(R14);
+    a.push(R15);
+    a.mov(R15, RDI);
+    a.load(R12, R15, kLp);
+    a.load(R14, R15, kSbase);
+    a.jmp_r(RSI);
+    size_t n = 0;
+    void* p = place(a.b, n);
+    if (!p) return;
+    std::memcpy(p, a.b.data(), a.b.size());
+    if (mprotect(p, n, PROT_READ | PROT_EXEC) != 0) {
+        munmap(p, n);
+        return;
+    }
+    tramp_ = p;
+}
+
+inline const void* CodeCache::compile(const Input& in) {
+    using namespace detail;
+    using C = ChunkOpCode;
+    if (!tramp_) return nullptr;
+    const Chunk& c = *in.chunk;
+    const Stream& s = *in.stream;
+    const auto n = static_cast<uint32_t>(c.ops.size());
+    constexpr uint32_t kMaxOps = 1u << 16;
+
+    // 1) Profondeur de pile de chaque op atteignable depuis l’entrée.
+    std::vector<int32_t> depth(n + 1, -1);
+    std::vector<uint32_t> work{in.entry_pc};
+    depth[in.entry_pc] = 0;
+    int32_t maxd = 0;
+    uint32_t count = 0;
+    uint32_t calls = 0;   // Call/TailCall atteignables
+    bool loop = false;    // saut arrière atteignable
+    auto reach = [&](uint32_t pc, int32_t d) {
+        if (depth[pc] < 0) {
+            depth[pc] = d;
+            work.push_back(pc);
+            return true;
+        }
+        return depth[pc] == d;
+    };
+    while (!work.empty()) {
+        const uint32_t pc = work.back();
+        work.pop_back();
+        if (pc == n || ++count > kMaxOps) {
+            if (count > kMaxOps) return nullptr;
+            continue;
+        }
+        const ChunkOp& op = c.ops[pc];
+        int32_t pop, push;
+        stack_effect(op, pop, push);
+        const int32_t d = depth[pc];
+        if (d < pop) continue;   // sous-dépassement : sortie vers l’interpréteur (erreur)
+        const int32_t nd = d - pop + push;
+        maxd = std::max({maxd, nd, d});
+        bool ok = true;
+        switch (op.code) {
+        case C::TailCall:
+            ++calls;
+            break;
+        case C::Return: case C::ReturnVoid:
+            break;
+        case C::Jump:
+            loop |= op.jump_target(pc) <= static_cast<int64_t>(pc);
+            ok = reach(static_cast<uint32_t>(op.jump_target(pc)), nd);
+            break;
+        case C::JumpIfFalse:
+            loop |= op.jump_target(pc) <= static_cast<int64_t>(pc);
+            ok = reach(static_cast<uint32_t>(op.jump_target(pc)), nd) && reach(pc + 1, nd);
+            break;
+        case C::Call:
+            ++calls;
+            ok = reach(pc + 1, d - static_cast<int32_t>(op.n));   // résultat à la place du callee
+            break;
+        default:
+            ok = reach(pc + 1, nd);
+            break;
+        }
+        if (!ok) return nullptr;
+    }
+    // Sans boucle, chaque op s’exécute au plus une fois par appel, et chaque Call/TailCall
+    // ressort par le trampoline (sortie, frame interprétée, rentrée) : le coût des
+    // transitions dépasse le gain (fib récursif ~1,6× plus lent). Fonction laissée à
+    // l’interpréteur.
+    if (calls && !loop) return nullptr;
+
+    // Reprise interprétée d’une op : début de son tuile dans le flux.
+    std::vector<uint32_t> tile_pc(n + 1);
+    for (uint32_t pc = 0, cur = 0; pc <= n; ++pc) {
+        if (s.pc_word[pc] != UINT32_MAX) cur = pc;
+        tile_pc[pc] = cur;
+    }
+    const std::vector<uint8_t> lead = stream_detail::leaders(c);
+
+    // 2) Émission.
+    Asm a;
+    std::vector<int64_t> label(n + 1, -1);
+    std::vector<std::pair<size_t, uint32_t>> jumps;    // (rel32, pc cible)
+    std::vector<std::pair<size_t, uint32_t>> abs;      // (imm64, pc de reprise native)
+    std::vector<std::pair<size_t, uint32_t>> deopts;   // (rel32, pc)
+
+    // Sortie : sp = sbase + profondeur de la tuile, reprise au mot de la tuile.
+    auto exit_at = [&](uint32_t pc, Reason why) {
+        const uint32_t t = tile_pc[pc];
+        a.mov(RAX, R14);
+        a.add_imm(RAX, 8 * depth[t]);
+        a.store(R15, kSp, RAX);
+        a.store32_imm(R15, kReason, why);
+        a.store32_imm(R15, kFunc, in.func);
+        a.mov_imm64(RAX, reinterpret_cast<uint64_t>(s.words.data() + s.pc_word[t]));
+        a.pop(R15);
+        a.pop(R14);
+        a.pop(R12);
+        a.ret();
+    };
+    auto guard = [&](Cond c2, uint32_t pc) { deopts.emplace_back(a.jcc(c2), pc); };
+    auto guard_int = [&](Reg r, uint32_t pc) {
+        a.mov(RDX, r);
+        a.shr(RDX, 48);
+        a.cmp32_imm(RDX, 0xFFF9);
+        guard(CNE, pc);
+    };
+    auto slot = [](int32_t i) { return 8 * i; };
+    auto helper = [&](bool (*fn)(Value*), int32_t at, uint32_t pc) {
+        a.mov(RDI, R14);
+        a.add_imm(RDI, slot(at));
+        a.mov_imm64(RAX, reinterpret_cast<uint64_t>(fn));
+        a.call(RAX);
+        a.test8(RAX, RAX);
+        guard(CE, pc);
+    };
+
+    // Entrée : débordement de pile vérifié une fois pour toute la fonction.
+    const size_t entry = a.pos();
+    a.load(RAX, R15, kSend);
+    a.sub(RAX, R14);
+    a.cmp_imm(RAX, 8 * (maxd + 1));
+    const size_t small = a.jcc(CL);
+    jumps.emplace_back(a.jmp(), in.entry_pc);
+    a.patch_rel(small, a.pos());
+    exit_at(in.entry_pc, Deopt);
+
+    for (uint32_t pc = 0; pc <= n; ++pc) {
+        if (depth[pc] < 0) continue;
+        label[pc] = static_cast<int64_t>(a.pos());
+        if (pc == n) {
+            exit_at(pc, Exit);   // Halt
+            continue;
+        }
+        const ChunkOp& op = c.ops[pc];
+        const int32_t d = depth[pc];
+        int32_t pop, push;
+        stack_effect(op, pop, push);
+        if (d < pop) {
+            exit_at(pc, Exit);
+            continue;
+        }
+        switch (op.code) {
+        case C::Nop:
+        case C::Pop:
+            break;
+        case C::LoadConst:
+        case C::LoadTrue:
+        case C::LoadFalse:
+        case C::LoadNull: {
+            const Value v = op.code == C::LoadConst ? in.kvals[op.a]
+                          : op.code == C::LoadTrue  ? V_TRUE
+                          : op.code == C::LoadFalse ? V_FALSE
+                                                    : V_NULL;
+            a.mov_imm64(RAX, v);
+            a.store(R14, slot(d), RAX);
+            break;
+        }
+        case C::LoadLocal:
+            a.load(RAX, R12, slot(static_cast<int32_t>(op.a)));
+            a.store(R14, slot(d), RAX);
+            break;
+        case C::StoreLocal:
+            a.load(RAX, R14, slot(d - 1));
+            a.store(R12, slot(static_cast<int32_t>(op.a)), RAX);
+            break;
+        case C::Add:
+        case C::Sub:
+        case C::Mul: {
+            // Entiers 48 bits décalés de 16 : le débordement 64 bits (OF) = hors 48 bits.
+            a.load(RAX, R14, slot(d - 2));
+            a.load(RCX, R14, slot(d - 1));
+            guard_int(RAX, pc);
+            guard_int(RCX, pc);
+            a.shl(RAX, 16);
+            if (op.code == C::Mul) {
+                a.shl(RCX, 16);
+                a.sar(RCX, 16);
+                a.imul(RAX, RCX);
+            } else {
+                a.shl(RCX, 16);
+                if (op.code == C::Add) a.add(RAX, RCX); else a.sub(RAX, RCX);
+            }
+            guard(CO, pc);
+            a.shr(RAX, 16);
+            a.mov_imm64(RDX, TAG_INT);
+            a.or_(RAX, RDX);
+            a.store(R14, slot(d - 2), RAX);
+            break;
+        }
+        case C::Div: helper(&h_div, d - 2, pc); break;
+        case C::Mod: helper(&h_mod, d - 2, pc); break;
+        case C::Neg: helper(&h_neg, d - 1, pc); break;
+        case C::Eq: helper(&h_eq, d - 2, pc); break;
+        case C::Ne: helper(&h_ne, d - 2, pc); break;
+        case C::Not:
+            a.load(RAX, R14, slot(d - 1));
+            a.mov_imm32(RCX, 1);
+            a.or_(RAX, RCX);
+            a.mov_imm64(RDX, V_FALSE);
+            a.xor32(RCX, RCX);
+            a.cmp(RAX, RDX);
+            a.setcc(CE, RCX);
+            a.add(RDX, RCX);
+            a.store(R14, slot(d - 1), RDX);
+            break;
+        case C::Lt:
+        case C::Le:
+        case C::Gt:
+        case C::Ge: {
+            static constexpr Cond cc[] = {CL, CLE, CG, CGE};
+            const Cond k = cc[static_cast<uint32_t>(op.code) - static_cast<uint32_t>(C::Lt)];
+            a.load(RAX, R14, slot(d - 2));
+            a.load(RCX, R14, slot(d - 1));
+            guard_int(RAX, pc);
+            guard_int(RCX, pc);
+            a.shl(RAX, 16);
+            a.shl(RCX, 16);
+            const bool fuse = pc + 1 < n && c.ops[pc + 1].code == C::JumpIfFalse && !lead[pc + 1];
+            if (fuse) {
+                a.cmp(RAX, RCX);
+                jumps.emplace_back(a.jcc(static_cast<Cond>(k ^ 1)), static_cast<uint32_t>(c.ops[pc + 1].jump_target(pc + 1)));
+                ++pc;   // le jz est absorbé ; pc + 1 n’est cible d’aucun saut
+                break;
+            }
+            a.xor32(RDX, RDX);
+            a.cmp(RAX, RCX);
+            a.setcc(k, RDX);
+            a.mov_imm64(RAX, V_FALSE);
+            a.add(RAX, RDX);
+            a.store(R14, slot(d - 2), RAX);
+            break;
+        }
+        case C::Jump:
+            jumps.emplace_back(a.jmp(), static_cast<uint32_t>(op.jump_target(pc)));
+            break;
+        case C::JumpIfFalse:
+            // falsy ⇔ (v | 1) == V_FALSE (null = V_FALSE − 1).
+            a.load(RAX, R14, slot(d - 1));
+            a.mov_imm32(RCX, 1);
+            a.or_(RAX, RCX);
+            a.mov_imm64(RDX, V_FALSE);
+            a.cmp(RAX, RDX);
+            jumps.emplace_back(a.jcc(CE), static_cast<uint32_t>(op.jump_target(pc)));
+            break;
+        case C::Call: {
+            const size_t at = a.mov_imm64(RCX, 0);
+            abs.emplace_back(at, pc + 1);
+            a.store(R15, kCont, RCX);
+            exit_at(pc, Exit);
+            break;
+        }
+        case C::TailCall:
+        case C::Return:
+        case C::ReturnVoid:
+            exit_at(pc, Exit);
+            break;
+        case C::Print:
+            a.mov(RDI, R15);
+            a.load(RSI, R14, slot(d - 1));
+            a.mov_imm64(RAX, reinterpret_cast<uint64_t>(in.hooks.print));
+            a.call(RAX);
+            break;
+        case C::MakeClosure:
+            if (op.n == 0) {
+                a.mov_imm64(RAX, TAG_FUNC | op.a);
+            } else {
+                a.mov(RCX, R14);   // sommet de pile pour les racines du GC
+                a.add_imm(RCX, slot(d));
+                a.store(R15, kSp, RCX);
+                a.mov(RDI, R15);
+                a.mov_imm32(RSI, op.a);
+                a.mov_imm32(RDX, op.n);
+                a.mov_imm64(RAX, reinterpret_cast<uint64_t>(in.hooks.make_closure));
+                a.call(RAX);
+                a.test(RAX, RAX);
+                guard(CE, pc);
+            }
+            a.store(R14, slot(d), RAX);
+            break;
+        case C::LoadUpvalue:
+        case C::StoreUpvalue: {
+            a.load(RAX, R15, kClo);
+            a.test(RAX, RAX);
+            guard(CE, pc);
+            a.load32(RCX, RAX, closure_n_offset());
+            a.cmp32_imm(RCX, op.a);
+            guard(CBE, pc);
+            const int32_t up = static_cast<int32_t>(sizeof(Closure) + 8 * static_cast<size_t>(op.a));
+            if (op.code == C::LoadUpvalue) {
+                a.load(RCX, RAX, up);
+                a.store(R14, slot(d), RCX);
+            } else {
+                a.load(RCX, R14, slot(d - 1));
+                a.store(RAX, up, RCX);
+                a.mov(RDX, RCX);   // barrière d’écriture si la valeur est un objet
+                a.shr(RDX, 48);
+                a.cmp32_imm(RDX, 0xFFFB);
+                const size_t skip = a.jcc(CNE);
+                a.mov(RDI, R15);
+                a.mov(RSI, RAX);
+                a.mov(RDX, RCX);
+                a.mov_imm64(RAX, reinterpret_cast<uint64_t>(in.hooks.barrier));
+                a.call(RAX);
+                a.test(RAX, RAX);
+                guard(CE, pc);
+                a.patch_rel(skip, a.pos());
+            }
+            break;
+        }
+        }
+    }
+
+    // Désoptimisations hors ligne, une par op.
+    std::vector<int64_t> stub(n + 1, -1);
+    for (const auto& [at, pc] : deopts) {
+        if (stub[pc] < 0) {
+            stub[pc] = static_cast<int64_t>(a.pos());
+            exit_at(pc, Deopt);
+        }
+        a.patch_rel(at, static_cast<size_t>(stub[pc]));
+    }
+    for (const auto& [at, pc] : jumps) a.patch_rel(at, static_cast<size_t>(label[pc]));
+
+    size_t len = 0;
+    auto* p = static_cast<uint8_t*>(place(a.b, len));
+    if (!p) return nullptr;
+    for (const auto& [at, pc] : abs) a.patch_u64(at, reinterpret_cast<uint64_t>(p + label[pc]));
+    std::memcpy(p, a.b.data(), a.b.size());
+    if (mprotect(p, len, PROT_READ | PROT_EXEC) != 0) {
+        munmap(p, len);
+        return nullptr;
+    }
+    maps_.push_back(Map{p, len});
+    bytes_ += a.b.size();
+    return p + entry;
+}
+
+#else
+
+inline void* CodeCache::place(const std::vector<uint8_t>&, size_t&) { return nullptr; }
+inline void CodeCache::init() {}
+inline const void* CodeCache::compile(const Input&) { return nullptr; }
+
+#endif
+
+} // namespace vt::vm::jit
+
+#endif // VITTE_NATIVE_VM_JIT_HPP
@@ -0,0 +1,366 @@
+// native/vm_stream.hpp
+// Passe de traduction au chargement : Chunk → flux pré-décodé pour le moteur natif
+// (vm_interp.cpp). Opérandes décodés une fois, constantes en immédiats, sauts en adresses
+// absolues, et séquences fréquentes fusionnées en superinstructions. Header-only.
+//
+// Flux : suite de mots de 8 octets. Une instruction = un mot d’opcode (remplacé par
+// l’adresse de son handler par le moteur) suivi de 0 à 3 mots d’opérandes :
+//   LoadConst     [v]                 valeur boxée (tous les ConstValue, pas seulement I64/F64)
+//   Load/StoreLocal, Load/StoreUpvalue [idx]
+//   Jump, JumpIfFalse [cible]         pointeur vers le mot d’opcode de destination
+//   Call, TailCall [argc | site << 32]   site = index de cache en ligne
+//   MakeClosure   [func | n << 32]
+//
+// Superinstructions (menu compilé ; bit i du masque `superops`) :
+//   0 ldl+ldl            LdLd     [a | b << 16]
+//   1 ldl+ldc+add        LdAddK   [a] [k]
+//   2 ldl+ldc+sub        LdSubK   [a] [k]
+//   3 ldl+ldc+add+stl    LdAddKSt [a | b << 16] [k]     (i = i + 1)
+//   4 ldl+ldc+sub+stl    LdSubKSt [a | b << 16] [k]
+//   5 ldl+ldc+cmp+jz     J*LdK    [a] [k] [cible]       cmp ∈ {lt, le, gt, ge}
+//   6 ldl+ldl+cmp+jz     J*LdLd   [a | b << 16] [cible]
+//   7 cmp+jz             J*       [cible]
+//   8 add+stl            AddSt    [b]
+//   9 ldl+ret            RetLd    [a]
+//  10 stl+ldl (même a)   StLd     [a]
+// Le menu vient des n-grammes dominants des profils (benchmarks/micro/vm_dispatch.cpp,
+// boucles et appels) ; profile_weights() mesure chaque motif sur un programme profilé
+// pour choisir le masque.
+//
+// Remarques :
+// - Découpage optimal par bloc de base (programmation dynamique : nombre minimal
+//   d’instructions) ; aucune fusion ne traverse une cible de saut ou une entrée de fonction.
+// - Mode profil : une instruction Prof (compteur) en tête de chaque bloc de base, sans
+//   fusion ; les poids des motifs = Σ compteur du bloc × occurrences dans le bloc.
+// - `tiles` garde pour chaque instruction le pc d’origine (erreurs, lignes) : une erreur
+//   dans une superinstruction est rapportée au pc de sa première op.
+
+#ifndef VITTE_NATIVE_VM_STREAM_HPP
+#define VITTE_NATIVE_VM_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "vm_chunk.hpp"
+#include "vm_value.hpp"
+
+namespace vt::vm {
+
+// 0..30 : ChunkOpCode (mêmes numéros), puis internes, puis superinstructions.
+enum class SOp : uint16_t {
+    Halt = vt::kChunkOpCount,
+    Prof,
+    LdLd,
+    LdAddK,
+    LdSubK,
+    LdAddKSt,
+    LdSubKSt,
+    JLtLdK, JLeLdK, JGtLdK, JGeLdK,
+    JLtLdLd, JLeLdLd, JGtLdLd, JGeLdLd,
+    JLt, JLe, JGt, JGe,
+    AddSt,
+    RetLd,
+    StLd,
+    Count_,
+};
+constexpr uint32_t kSOpCount = static_cast<uint32_t>(SOp::Count_);
+
+constexpr SOp sop(ChunkOpCode c) { return static_cast<SOp>(static_cast<uint16_t>(c)); }
+
+constexpr uint32_t kSuperopCount = 11;
+constexpr uint64_t kSuperopsAll = (1ull << kSuperopCount) - 1;
+
+inline const char* superop_name(uint32_t i) {
+    static const char* const names[kSuperopCount] = {
+        "ldl+ldl", "ldl+ldc+add", "ldl+ldc+sub", "ldl+ldc+add+stl", "ldl+ldc+sub+stl",
+        "ldl+ldc+cmp+jz", "ldl+ldl+cmp+jz", "cmp+jz", "add+stl", "ldl+ret", "stl+ldl",
+    };
+    return i < kSuperopCount ? names[i] : nullptr;
+}
+
+inline const char* sop_name(SOp s) {
+    static const char* const base[] = {
+        "nop", "ret", "retv", "ldc", "ldtrue", "ldfalse", "ldnull", "ldl", "stl",
+        "add", "sub", "mul", "div", "mod", "neg", "not",
+        "eq", "ne", "lt", "le", "gt", "ge",
+        "jmp", "jz", "pop", "call", "tcall", "print", "mkclo", "ldu", "stu",
+        "halt", "prof", "ldl+ldl", "ldl+ldc+add", "ldl+ldc+sub", "ldl+ldc+add+stl",
+        "ldl+ldc+sub+stl", "ldl+ldc+lt+jz", "ldl+ldc+le+jz", "ldl+ldc+gt+jz", "ldl+ldc+ge+jz",
+        "ldl+ldl+lt+jz", "ldl+ldl+le+jz", "ldl+ldl+gt+jz", "ldl+ldl+ge+jz",
+        "lt+jz", "le+jz", "gt+jz", "ge+jz", "add+stl", "ldl+ret", "stl+ldl",
+    };
+    static_assert(sizeof(base) / sizeof(base[0]) == kSOpCount);
+    const auto i = static_cast<uint32_t>(s);
+    return i < kSOpCount ? base[i] : "?";
+}
+
+// Nombre d’ops d’origine couvertes par le motif m.
+inline uint32_t superop_len(uint32_t m) {
+    static const uint8_t len[kSuperopCount] = {2, 3, 3, 4, 4, 4, 4, 2, 2, 2, 2};
+    return m < kSuperopCount ? len[m] : 0;
+}
+
+// Motifs dont les dispatchs économisés (poids × (longueur − 1)) dépassent min_share des
+// ops exécutées.
+inline uint64_t select_superops(const uint64_t weights[kSuperopCount], uint64_t total_ops, double min_share) {
+    uint64_t mask = 0;
+    for (uint32_t m = 0; m < kSuperopCount; ++m) {
+        const double saved = static_cast<double>(weights[m]) * (superop_len(m) - 1);
+        if (weights[m] && saved >= min_share * static_cast<double>(total_ops)) mask |= 1ull << m;
+    }
+    return mask;
+}
+
+union Word {
+    const void* h;   // handler (après threading) ou opcode (avant)
+    uint64_t u;
+    Value v;
+    const Word* t;
+};
+static_assert(sizeof(Word) == 8);
+
+struct StreamTile {
+    uint32_t word;   // index du mot d’opcode
+    uint32_t pc;     // première op d’origine
+    SOp op;
+};
+
+struct Stream {
+    std::vector<Word> words;
+    std::vector<StreamTile> tiles;       // croissant par `word`
+    std::vector<uint32_t> pc_word;       // pc → mot de début ; UINT32_MAX si pc fusionné
+    uint32_t ncall_sites = 0;
+    std::vector<uint32_t> site_pc;       // site d’appel → pc du Call/TailCall
+    uint32_t nops = 0;
+    // Mode profil : un compteur par bloc de base [prof_pc[i], prof_pc[i] + prof_len[i]).
+    std::vector<uint32_t> prof_pc;
+    std::vector<uint32_t> prof_len;
+
+    Stream() = default;
+    Stream(const Stream&) = delete;              // les cibles de saut pointent dans `words`
+    Stream& operator=(const Stream&) = delete;
+    Stream(Stream&&) = default;
+    Stream& operator=(Stream&&) = default;
+
+    const StreamTile& tile_at(const Word* ip) const {
+        const auto w = static_cast<uint32_t>(ip - words.data());
+        auto it = std::upper_bound(tiles.begin(), tiles.end(), w,
+                                   [](uint32_t x, const StreamTile& t) { return x < t.word; });
+        return *(it == tiles.begin() ? it : it - 1);
+    }
+};
+
+namespace stream_detail {
+
+inline bool is_cmp(ChunkOpCode c) {
+    return c == ChunkOpCode::Lt || c == ChunkOpCode::Le || c == ChunkOpCode::Gt || c == ChunkOpCode::Ge;
+}
+inline uint16_t cmp_ix(ChunkOpCode c) {
+    return static_cast<uint16_t>(static_cast<uint16_t>(c) - static_cast<uint16_t>(ChunkOpCode::Lt));
+}
+
+// Longueur (en ops) du motif `m` à la position i, 0 sinon ; ne déborde pas de [i, end).
+inline uint32_t match(uint32_t m, const std::vector<ChunkOp>& ops, uint32_t i, uint32_t end) {
+    auto at = [&](uint32_t k, ChunkOpCode c) { return i + k < end && ops[i + k].code == c; };
+    auto cmp = [&](uint32_t k) { return i + k < end && is_cmp(ops[i + k].code); };
+    using C = ChunkOpCode;
+    switch (m) {
+    case 0: return at(0, C::LoadLocal) && at(1, C::LoadLocal) ? 2 : 0;
+    case 1: return at(0, C::LoadLocal) && at(1, C::LoadConst) && at(2, C::Add) ? 3 : 0;
+    case 2: return at(0, C::LoadLocal) && at(1, C::LoadConst) && at(2, C::Sub) ? 3 : 0;
+    case 3: return at(0, C::LoadLocal) && at(1, C::LoadConst) && at(2, C::Add) && at(3, C::StoreLocal) ? 4 : 0;
+    case 4: return at(0, C::LoadLocal) && at(1, C::LoadConst) && at(2, C::Sub) && at(3, C::StoreLocal) ? 4 : 0;
+    case 5: return at(0, C::LoadLocal) && at(1, C::LoadConst) && cmp(2) && at(3, C::JumpIfFalse) ? 4 : 0;
+    case 6: return at(0, C::LoadLocal) && at(1, C::LoadLocal) && cmp(2) && at(3, C::JumpIfFalse) ? 4 : 0;
+    case 7: return cmp(0) && at(1, C::JumpIfFalse) ? 2 : 0;
+    case 8: return at(0, C::Add) && at(1, C::StoreLocal) ? 2 : 0;
+    case 9: return at(0, C::LoadLocal) && at(1, C::Return) ? 2 : 0;
+    case 10: return at(0, C::StoreLocal) && at(1, C::LoadLocal) && ops[i].a == ops[i + 1].a ? 2 : 0;
+    default: return 0;
+    }
+}
+
+// Têtes de blocs de base : pc 0, entrées de fonctions, cibles de saut, op suivant un
+// transfert de contrôle (saut, appel, retour). Taille n + 1 (n = fin de code).
+inline std::vector<uint8_t> leaders(const Chunk& c) {
+    const auto n = static_cast<uint32_t>(c.ops.size());
+    std::vector<uint8_t> lead(n + 1, 0);
+    lead[0] = 1;
+    lead[n] = 1;
+    for (const ChunkSymbol& s : c.symbols) {
+        if (s.pc <= n) lead[s.pc] = 1;
+    }
+    for (uint32_t pc = 0; pc < n; ++pc) {
+        const ChunkOp& op = c.ops[pc];
+        switch (op.code) {
+        case ChunkOpCode::Jump:
+        case ChunkOpCode::JumpIfFalse: {
+            const int64_t t = op.jump_target(pc);
+            if (t >= 0 && t <= n) lead[static_cast<size_t>(t)] = 1;
+            lead[pc + 1] = 1;
+            break;
+        }
+        case ChunkOpCode::Call:
+        case ChunkOpCode::TailCall:
+        case ChunkOpCode::Return:
+        case ChunkOpCode::ReturnVoid:
+            lead[pc + 1] = 1;
+            break;
+        default:
+            break;
+        }
+    }
+    return lead;
+}
+
+} // namespace stream_detail
+
+// Traduit `c` (déjà validé : ConstIx, cibles de saut, FuncIx). kvals[i] = constante i boxée.
+// superops : masque des motifs autorisés ; profile : compteurs de blocs, aucune fusion.
+inline Stream translate(const Chunk& c, const Value* kvals, uint64_t superops, bool profile) {
+    using namespace stream_detail;
+    using C = ChunkOpCode;
+    Stream s;
+    const auto n = static_cast<uint32_t>(c.ops.size());
+    const std::vector<uint8_t> lead = leaders(c);
+    if (profile) superops = 0;
+
+    // 1) Découpage : best[i] = nombre minimal d’instructions pour [i, fin du bloc).
+    std::vector<uint32_t> best(n + 1, 0), pick(n + 1, 0);   // pick : motif + 1 (0 = op seule)
+    uint32_t block_end = n;
+    for (uint32_t i = n; i-- > 0;) {
+        if (lead[i + 1]) block_end = i + 1;
+        best[i] = 1 + best[i + 1];
+        pick[i] = 0;
+        for (uint32_t m = 0; m < kSuperopCount; ++m) {
+            if (!(superops >> m & 1)) continue;
+            const uint32_t len = match(m, c.ops, i, block_end);
+            if (len > 1 && 1 + best[i + len] <= best[i]) {
+                best[i] = 1 + best[i + len];
+                pick[i] = m + 1;
+            }
+        }
+    }
+
+    // 2) Émission (cibles de saut en pc, résolues en 3).
+    std::vector<std::pair<uint32_t, uint32_t>> fixups;   // (mot d’opérande, pc cible)
+    s.pc_word.assign(n + 1, UINT32_MAX);
+    s.nops = n;
+    s.words.reserve(static_cast<size_t>(n) * 2 + 2);
+    auto word = [&](uint64_t u) {
+        Word w;
+        w.u = u;
+        s.words.push_back(w);
+    };
+    auto value = [&](Value v) {
+        Word w;
+        w.v = v;
+        s.words.push_back(w);
+    };
+    auto target = [&](uint32_t pc, const ChunkOp& op) {
+        fixups.emplace_back(static_cast<uint32_t>(s.words.size()), static_cast<uint32_t>(op.jump_target(pc)));
+        word(0);
+    };
+    auto begin = [&](uint32_t pc, SOp o) {
+        s.tiles.push_back(StreamTile{static_cast<uint32_t>(s.words.size()), pc, o});
+        word(static_cast<uint64_t>(o));
+    };
+
+    for (uint32_t pc = 0; pc < n;) {
+        s.pc_word[pc] = static_cast<uint32_t>(s.words.size());
+        if (profile && lead[pc]) {
+            uint32_t end = pc + 1;
+            while (!lead[end]) ++end;
+            begin(pc, SOp::Prof);
+            word(s.prof_pc.size());
+            s.prof_pc.push_back(pc);
+            s.prof_len.push_back(end - pc);
+        }
+        const ChunkOp& op = c.ops[pc];
+        const uint32_t m = pick[pc];
+        if (m == 0) {
+            begin(pc, sop(op.code));
+            switch (op.code) {
+            case C::LoadConst: value(kvals[op.a]); break;
+            case C::LoadLocal:
+            case C::StoreLocal:
+            case C::LoadUpvalue:
+            case C::StoreUpvalue: word(op.a); break;
+            case C::Jump:
+            case C::JumpIfFalse: target(pc, op); break;
+            case C::Call:
+            case C::TailCall:
+                s.site_pc.push_back(pc);
+                word(op.n | static_cast<uint64_t>(s.ncall_sites++) << 32);
+                break;
+            case C::MakeClosure: word(op.a | static_cast<uint64_t>(op.n) << 32); break;
+            default: break;
+            }
+            ++pc;
+            continue;
+        }
+        const ChunkOp* o = &c.ops[pc];
+        const auto ab = [&](uint32_t i, uint32_t j) { return o[i].a | static_cast<uint64_t>(o[j].a) << 16; };
+        switch (m - 1) {
+        case 0: begin(pc, SOp::LdLd); word(ab(0, 1)); break;
+        case 1: begin(pc, SOp::LdAddK); word(o[0].a); value(kvals[o[1].a]); break;
+        case 2: begin(pc, SOp::LdSubK); word(o[0].a); value(kvals[o[1].a]); break;
+        case 3: begin(pc, SOp::LdAddKSt); word(ab(0, 3)); value(kvals[o[1].a]); break;
+        case 4: begin(pc, SOp::LdSubKSt); word(ab(0, 3)); value(kvals[o[1].a]); break;
+        case 5:
+            begin(pc, static_cast<SOp>(static_cast<uint16_t>(SOp::JLtLdK) + cmp_ix(o[2].code)));
+            word(o[0].a);
+            value(kvals[o[1].a]);
+            target(pc + 3, o[3]);
+            break;
+        case 6:
+            begin(pc, static_cast<SOp>(static_cast<uint16_t>(SOp::JLtLdLd) + cmp_ix(o[2].code)));
+            word(ab(0, 1));
+            target(pc + 3, o[3]);
+            break;
+        case 7:
+            begin(pc, static_cast<SOp>(static_cast<uint16_t>(SOp::JLt) + cmp_ix(o[0].code)));
+            target(pc + 1, o[1]);
+            break;
+        case 8: begin(pc, SOp::AddSt); word(o[1].a); break;
+        case 9: begin(pc, SOp::RetLd); word(o[0].a); break;
+        case 10: begin(pc, SOp::StLd); word(o[0].a); break;
+        default: break;
+        }
+        pc += match(m - 1, c.ops, pc, n);
+    }
+    s.pc_word[n] = static_cast<uint32_t>(s.words.size());
+    begin(n, SOp::Halt);
+
+    // 3) Cibles absolues (les cibles sont des têtes de bloc, jamais fusionnées).
+    for (const auto& [w, pc] : fixups) s.words[w].t = s.words.data() + s.pc_word[pc];
+    return s;
+}
+
+// Poids dynamiques des motifs d’après les compteurs d’un flux profilé : weights[m] =
+// nombre d’exécutions du motif m (occurrences chevauchantes comptées séparément) ;
+// rend le nombre total d’ops exécutées.
+inline uint64_t profile_weights(const Chunk& c, const Stream& s, const uint64_t* counts,
+                                uint64_t weights[kSuperopCount]) {
+    std::fill(weights, weights + kSuperopCount, uint64_t(0));
+    uint64_t total = 0;
+    for (size_t b = 0; b < s.prof_pc.size(); ++b) {
+        const uint64_t k = counts[b];
+        if (!k) continue;
+        const uint32_t start = s.prof_pc[b], end = start + s.prof_len[b];
+        total += k * s.prof_len[b];
+        for (uint32_t i = start; i < end; ++i) {
+            for (uint32_t m = 0; m < kSuperopCount; ++m) {
+                if (stream_detail::match(m, c.ops, i, end)) weights[m] += k;
+            }
+        }
+    }
+    return total;
+}
+
+} // namespace vt::vm
+
+#endif // VITTE_NATIVE_VM_STREAM_HPP
@@ -0,0 +1,248 @@
+// native/vm_value.hpp
+// Valeurs NaN-boxées du moteur natif (vm_interp.cpp, vm_stream.hpp) et opérations de base
+// partagées par les handlers simples, les superinstructions et les chemins lents.
+// Header-only.
+//
+// Codage (u64) — celui de la valeur C ABI vt_value.h, partagée avec les hôtes et les natives :
+//   double          tel quel (tout motif < 0xFFF9 << 48, dont les NaN 0x7FF8… / 0xFFF8…)
+//   0xFFF9 | i48    entier signé 48 bits
+//   0xFFFA | 0/1/2  null / false / true
+//   0xFFFB | ptr    objet (chaîne, octets, fermeture) — pointeur utilisateur 48 bits
+//   0xFFFC | idx    fonction sans capture (FuncIx)
+//
+// Remarques :
+// - Objets : en-tête vt_obj (compteur, kind) ; ceux de la VM (constantes, fermetures du
+//   tas vm_gc.hpp) sont statiques (VT_OBJ_STATIC) et passent aux natives sans copie.
+// - Les NaN à charge utile (constantes) doivent passer par from_f64_canon().
+// - Sémantique arithmétique de la VM Rust (bin_num) : calcul en f64, résultat ramené en
+//   entier s’il est entier à 1e-12 près ; chemin entier exact tant qu’il tient sur 48 bits.
+
+#ifndef VITTE_NATIVE_VM_VALUE_HPP
+#define VITTE_NATIVE_VM_VALUE_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "vt_value.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VT_VM_INLINE inline __attribute__((always_inline))
+#else
+#define VT_VM_INLINE inline
+#endif
+
+namespace vt::vm {
+
+using Value = vt_value;
+
+constexpr uint64_t TAG_INT = VT_VALUE_TAG_INT;
+constexpr uint64_t TAG_MISC = VT_VALUE_TAG_MISC;
+constexpr uint64_t TAG_OBJ = VT_VALUE_TAG_OBJ;
+constexpr uint64_t TAG_FUNC = VT_VALUE_TAG_FUNC;
+constexpr uint64_t PAYLOAD = VT_VALUE_PAYLOAD;
+constexpr Value V_NULL = VT_VALUE_NULL;
+constexpr Value V_FALSE = VT_VALUE_FALSE;
+constexpr Value V_TRUE = VT_VALUE_TRUE;
+constexpr Value V_CANON_NAN = VT_VALUE_NAN;
+
+VT_VM_INLINE uint32_t tag(Value v) { return static_cast<uint32_t>(v >> 48); }
+VT_VM_INLINE bool is_f64(Value v) { return v < TAG_INT; }
+VT_VM_INLINE bool is_int(Value v) { return tag(v) == 0xFFF9; }
+VT_VM_INLINE bool is_obj(Value v) { return tag(v) == 0xFFFB; }
+VT_VM_INLINE bool is_func(Value v) { return tag(v) == 0xFFFC; }
+VT_VM_INLINE bool is_bool(Value v) { return v - V_FALSE <= 1; }
+VT_VM_INLINE bool is_num(Value v) { return is_f64(v) || is_int(v); }
+VT_VM_INLINE bool falsy(Value v) { return v == V_FALSE || v == V_NULL; }
+
+VT_VM_INLINE int64_t as_int(Value v) { return static_cast<int64_t>(v << 16) >> 16; }
+VT_VM_INLINE double as_f64(Value v) {
+    double d;
+    std::memcpy(&d, &v, 8);
+    return d;
+}
+VT_VM_INLINE double as_num(Value v) { return is_int(v) ? static_cast<double>(as_int(v)) : as_f64(v); }
+
+VT_VM_INLINE bool fits48(int64_t i) { return (static_cast<int64_t>(static_cast<uint64_t>(i) << 16) >> 16) == i; }
+VT_VM_INLINE Value from_bool(bool b) { return V_FALSE + (b ? 1 : 0); }
+VT_VM_INLINE Value from_int48(int64_t i) { return TAG_INT | (static_cast<uint64_t>(i) & PAYLOAD); }
+VT_VM_INLINE Value from_f64(double d) {
+    Value v;
+    std::memcpy(&v, &d, 8);
+    return v;
+}
+inline Value from_f64_canon(double d) { return d != d ? V_CANON_NAN : from_f64(d); }
+VT_VM_INLINE Value from_i64(int64_t i) { return fits48(i) ? from_int48(i) : from_f64(static_cast<double>(i)); }
+
+// `res as i64` (Rust : saturant).
+inline int64_t sat_i64(double r) {
+    if (r >= 9223372036854775807.0) return INT64_MAX;
+    if (r <= -9223372036854775808.0) return INT64_MIN;
+    return static_cast<int64_t>(r);
+}
+
+// Heuristique de bin_num (VM Rust) : entier si |fract| < 1e-12.
+inline Value num_result(double r) {
+    if (std::fabs(r - std::trunc(r)) < 1e-12) return from_i64(sat_i64(r));   // NaN/inf : faux
+    return from_f64(r);
+}
+
+VT_VM_INLINE bool mul48(int64_t a, int64_t b, int64_t& r) {
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, &r) && fits48(r);
+#else
+    if (std::fabs(static_cast<double>(a) * static_cast<double>(b)) >= 140737488355328.0) return false;
+    r = a * b;
+    return true;
+#endif
+}
+
+// --- Objets -----------------------------------------------------------------------------
+
+enum class ObjKind : uint8_t { Str = VT_OBJ_STR, Bytes = VT_OBJ_BYTES, Closure = VT_OBJ_CLOSURE };
+
+// Même disposition que vt_obj (vérifiée dans vt_value.cpp).
+struct Obj {
+    uint32_t rc = VT_OBJ_STATIC;
+    ObjKind kind;
+    uint8_t flags = 0;
+    uint16_t aux = 0;
+};
+
+struct StrObj : Obj {
+    const char* data;
+    size_t len;
+};
+
+struct alignas(8) Closure : Obj {
+    uint32_t func;
+    uint32_t n;
+    Value* upv() { return reinterpret_cast<Value*>(this + 1); }
+};
+
+// Fermeture dans un bloc de sizeof(Closure) + n * 8 octets (upvalues à initialiser).
+// flags : bits du tas (vm_gc.hpp) ; 0 hors tas.
+VT_VM_INLINE Closure* new_closure(void* m, uint32_t func, uint32_t n, uint8_t flags = 0) {
+    auto* c = ::new (m) Closure{};
+    c->kind = ObjKind::Closure;
+    c->flags = flags;
+    c->func = func;
+    c->n = n;
+    return c;
+}
+
+VT_VM_INLINE Obj* as_obj(Value v) { return reinterpret_cast<Obj*>(static_cast<uintptr_t>(v & PAYLOAD)); }
+VT_VM_INLINE Value from_obj(const Obj* o) { return TAG_OBJ | static_cast<uint64_t>(reinterpret_cast<uintptr_t>(o)); }
+VT_VM_INLINE Closure* as_closure(Value v) {
+    return is_obj(v) && as_obj(v)->kind == ObjKind::Closure ? static_cast<Closure*>(as_obj(v)) : nullptr;
+}
+
+// --- Opérations (false : opérandes non numériques) ------------------------------------
+
+inline bool values_eq(Value a, Value b) {
+    if (is_f64(a) || is_f64(b)) return is_f64(a) && is_f64(b) && as_f64(a) == as_f64(b);
+    if (a == b) return true;
+    if (!is_obj(a) || !is_obj(b)) return false;
+    const Obj* x = as_obj(a);
+    const Obj* y = as_obj(b);
+    if (x->kind != ObjKind::Str || y->kind != ObjKind::Str) return false;
+    const auto* s = static_cast<const StrObj*>(x);
+    const auto* t = static_cast<const StrObj*>(y);
+    return s->len == t->len && std::memcmp(s->data, t->data, s->len) == 0;
+}
+
+VT_VM_INLINE bool op_add(Value a, Value b, Value& r) {
+    if (is_int(a) && is_int(b)) {
+        const int64_t s = as_int(a) + as_int(b);
+        if (fits48(s)) {
+            r = from_int48(s);
+            return true;
+        }
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = num_result(as_num(a) + as_num(b));
+    return true;
+}
+
+VT_VM_INLINE bool op_sub(Value a, Value b, Value& r) {
+    if (is_int(a) && is_int(b)) {
+        const int64_t s = as_int(a) - as_int(b);
+        if (fits48(s)) {
+            r = from_int48(s);
+            return true;
+        }
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = num_result(as_num(a) - as_num(b));
+    return true;
+}
+
+VT_VM_INLINE bool op_mul(Value a, Value b, Value& r) {
+    int64_t p;
+    if (is_int(a) && is_int(b) && mul48(as_int(a), as_int(b), p)) {
+        r = from_int48(p);
+        return true;
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = num_result(as_num(a) * as_num(b));
+    return true;
+}
+
+inline bool op_div(Value a, Value b, Value& r) {
+    if (is_int(a) && is_int(b)) {
+        const int64_t x = as_int(a), y = as_int(b);
+        if (y != 0 && x % y == 0 && fits48(x / y)) {
+            r = from_int48(x / y);
+            return true;
+        }
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = num_result(as_num(a) / as_num(b));
+    return true;
+}
+
+inline bool op_mod(Value a, Value b, Value& r) {
+    if (is_int(a) && is_int(b) && as_int(b) != 0) {
+        r = from_int48(as_int(a) % as_int(b));
+        return true;
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = num_result(std::fmod(as_num(a), as_num(b)));
+    return true;
+}
+
+inline bool op_neg(Value a, Value& r) {
+    if (is_int(a)) {
+        r = from_i64(-as_int(a));
+    } else if (is_f64(a)) {
+        r = from_f64(-as_f64(a));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+enum class Cmp : uint8_t { Lt, Le, Gt, Ge };
+
+template <Cmp C, class T> VT_VM_INLINE bool cmp_apply(T x, T y) {
+    if constexpr (C == Cmp::Lt) return x < y;
+    if constexpr (C == Cmp::Le) return x <= y;
+    if constexpr (C == Cmp::Gt) return x > y;
+    return x >= y;
+}
+
+template <Cmp C> VT_VM_INLINE bool op_cmp(Value a, Value b, bool& r) {
+    if (is_int(a) && is_int(b)) {
+        r = cmp_apply<C>(as_int(a), as_int(b));
+        return true;
+    }
+    if (!is_num(a) || !is_num(b)) return false;
+    r = cmp_apply<C>(as_num(a), as_num(b));
+    return true;
+}
+
+} // namespace vt::vm
+
+#endif // VITTE_NATIVE_VM_VALUE_HPP
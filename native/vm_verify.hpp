@@ -0,0 +1,284 @@
+// native/vm_verify.hpp
+// Vérificateur de bytecode au chargement (format Chunk, cf. vm_chunk.hpp) : interprétation
+// abstraite par blocs de base depuis chaque entrée (pc 0 + chaque symbole non importé),
+// domaine = profondeur de pile exacte. Prouve pour tout chemin atteignable :
+//   - aucun sous-dépassement (pop ≤ profondeur, Call n : n + 1 valeurs) ;
+//   - une seule profondeur par pc (jonctions cohérentes) ; profondeur maximale bornée ;
+//   - ConstIx < consts, LocalIx / UpvalueIx sur 16 bits (ops.rs), FuncIx < symbols,
+//     cibles de saut dans [0, n] (n : fin de code, arrêt).
+// Les entrées sont réparties sur un pool de threads (une tâche = une entrée, état de
+// travail propre à chaque thread). Header-only ; utilisé par vm_interp.cpp, réutilisable
+// par les outils (disasm, lints).
+//
+// Usage :
+//   vt::vm::VerifyReport r = vt::vm::verify_chunk(chunk, std::thread::hardware_concurrency());
+//   if (!r.ok) { /* r.what, r.pc, r.entry */ }
+//
+// Remarques :
+// - Effets de pile : stack_effect(), aligné sur `Op::stack_delta` (ops.rs), complété pour
+//   Call/TailCall par la convention [.., callee, a0..an-1] → résultat et pour Return
+//   (consomme 1). Le JIT (vm_jit.hpp) en dérive aussi sa carte de pile.
+// - Le code inatteignable depuis toute entrée n’est pas vérifié (jamais exécuté).
+// - Parallélisme : sans intérêt sous kParallelMinOps ops dans le chunk ; en dessous,
+//   tout se fait sur le thread appelant. Résultat déterministe : première entrée fautive
+//   dans l’ordre (pc 0, puis symboles).
+// - Coût par entrée proportionnel au code atteint : l’état (profondeur par pc) est remis à
+//   zéro sur les seuls pcs visités.
+
+#ifndef VITTE_NATIVE_VM_VERIFY_HPP
+#define VITTE_NATIVE_VM_VERIFY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "vm_chunk.hpp"
+
+namespace vt::vm {
+
+// Effet d’une op sur la profondeur : (consommés, produits).
+inline void stack_effect(const ChunkOp& op, int32_t& pop, int32_t& push) {
+    using C = ChunkOpCode;
+    pop = 0;
+    push = 0;
+    switch (op.code) {
+    case C::LoadConst: case C::LoadTrue: case C::LoadFalse: case C::LoadNull:
+    case C::LoadLocal: case C::LoadUpvalue: case C::MakeClosure:
+        push = 1;
+        break;
+    case C::StoreLocal: case C::StoreUpvalue: case C::Pop: case C::Print:
+    case C::JumpIfFalse: case C::Return:
+        pop = 1;
+        break;
+    case C::Add: case C::Sub: case C::Mul: case C::Div: case C::Mod:
+    case C::Eq: case C::Ne: case C::Lt: case C::Le: case C::Gt: case C::Ge:
+        pop = 2;
+        push = 1;
+        break;
+    case C::Neg: case C::Not:
+        pop = 1;
+        push = 1;
+        break;
+    case C::Call: case C::TailCall:
+        pop = op.n + 1;
+        push = 1;
+        break;
+    default:
+        break;
+    }
+}
+
+inline constexpr uint32_t kVerifyTopLevel = UINT32_MAX;   // VerifyReport::entry : code à pc 0
+inline constexpr uint32_t kVerifyMaxDepth = 1u << 20;
+inline constexpr size_t kParallelMinOps = 1u << 15;
+
+struct VerifyReport {
+    bool ok = true;
+    uint32_t max_stack = 0;   // profondeur maximale, toutes entrées
+    uint32_t entries = 0;     // entrées vérifiées
+    uint32_t threads = 1;     // threads effectivement utilisés
+    // Première erreur : entrée (indice de symbole ou kVerifyTopLevel), pc, motif.
+    uint32_t entry = kVerifyTopLevel;
+    uint32_t pc = 0;
+    const char* what = nullptr;
+};
+
+namespace verify_detail {
+
+struct Result {
+    uint32_t max_stack = 0;
+    uint32_t pc = 0;
+    const char* what = nullptr;   // nullptr : ok
+};
+
+// État de travail d’un thread, réutilisé d’une entrée à l’autre.
+struct Scratch {
+    std::vector<int32_t> depth;    // -1 : non visité
+    std::vector<uint32_t> seen;    // pcs à remettre à -1
+    std::vector<uint32_t> work;    // débuts de blocs en attente
+};
+
+inline Result verify_entry(const Chunk& c, uint32_t entry, Scratch& s) {
+    using C = ChunkOpCode;
+    const auto n = static_cast<uint32_t>(c.ops.size());
+    const size_t nconsts = c.consts.size();
+    const size_t nfuncs = c.symbols.size();
+    Result r;
+    auto fail = [&](uint32_t pc, const char* what) {
+        r.pc = pc;
+        r.what = what;
+    };
+    // Jonction : false si la profondeur diffère de celle déjà vue.
+    auto reach = [&](uint32_t pc, int32_t d) {
+        if (s.depth[pc] < 0) {
+            s.depth[pc] = d;
+            s.seen.push_back(pc);
+            s.work.push_back(pc);
+            return true;
+        }
+        return s.depth[pc] == d;
+    };
+
+    s.work.clear();
+    reach(entry, 0);
+    while (!r.what && !s.work.empty()) {
+        uint32_t pc = s.work.back();
+        s.work.pop_back();
+        // Un bloc : ops en séquence jusqu’à un saut, une sortie ou un pc déjà visité.
+        for (;;) {
+            if (pc == n) break;   // fin de code : arrêt du run
+            const ChunkOp& op = c.ops[pc];
+            const int32_t d = s.depth[pc];
+            int32_t pop, push;
+            stack_effect(op, pop, push);
+            if (d < pop) {
+                fail(pc, "Sous-dépassement de pile");
+                break;
+            }
+            const int32_t nd = d - pop + push;
+            if (nd > static_cast<int32_t>(kVerifyMaxDepth)) {
+                fail(pc, "Profondeur de pile excessive");
+                break;
+            }
+            r.max_stack = std::max(r.max_stack, static_cast<uint32_t>(std::max(d, nd)));
+            switch (op.code) {
+            case C::LoadConst:
+                if (op.a >= nconsts) fail(pc, "ConstIx hors du pool");
+                break;
+            case C::LoadLocal: case C::StoreLocal:
+            case C::LoadUpvalue: case C::StoreUpvalue:
+                if (op.a > 0xFFFF) fail(pc, "Indice de local/upvalue hors de u16");
+                break;
+            case C::MakeClosure:
+                if (op.a >= nfuncs) fail(pc, "FuncIx hors de debug.symbols");
+                break;
+            case C::Jump: case C::JumpIfFalse: {
+                const int64_t t = op.jump_target(pc);
+                if (t < 0 || t > static_cast<int64_t>(n)) fail(pc, "Cible de saut hors du code");
+                break;
+            }
+            default:
+                break;
+            }
+            if (r.what) break;
+
+            bool ok = true;
+            bool next = true;   // le bloc continue à pc + 1
+            switch (op.code) {
+            case C::Return: case C::ReturnVoid: case C::TailCall:
+                next = false;
+                break;
+            case C::Jump:
+                ok = reach(static_cast<uint32_t>(op.jump_target(pc)), nd);
+                next = false;
+                break;
+            case C::JumpIfFalse:
+                ok = reach(static_cast<uint32_t>(op.jump_target(pc)), nd);
+                break;
+            default:
+                break;
+            }
+            if (!ok) {
+                fail(pc, "Profondeur de pile incohérente à une jonction");
+                break;
+            }
+            if (!next) break;
+            ++pc;
+            if (s.depth[pc] >= 0) {   // entrée d’un bloc déjà vu
+                if (s.depth[pc] != nd) fail(pc, "Profondeur de pile incohérente à une jonction");
+                break;
+            }
+            s.depth[pc] = nd;
+            s.seen.push_back(pc);
+        }
+    }
+    for (uint32_t pc : s.seen) s.depth[pc] = -1;
+    s.seen.clear();
+    return r;
+}
+
+} // namespace verify_detail
+
+// threads : 0 ou 1 ⇒ thread appelant seul. Ne lève pas (mémoire insuffisante : !ok).
+inline VerifyReport verify_chunk(const Chunk& c, unsigned threads) {
+    using namespace verify_detail;
+    VerifyReport rep;
+    const auto n = static_cast<uint32_t>(c.ops.size());
+    try {
+        std::vector<uint32_t> entries{0};   // indice 0 : code de haut niveau
+        std::vector<uint32_t> ids{kVerifyTopLevel};
+        for (size_t i = 0; i < c.symbols.size(); ++i) {
+            const uint32_t pc = c.symbols[i].pc;
+            if (pc == UINT32_MAX) continue;   // import natif
+            if (pc > n) {
+                rep.ok = false;
+                rep.entry = static_cast<uint32_t>(i);
+                rep.pc = pc;
+                rep.what = "Symbole hors du code";
+                return rep;
+            }
+            entries.push_back(pc);
+            ids.push_back(static_cast<uint32_t>(i));
+        }
+        std::vector<Result> res(entries.size());
+
+        // Parallèle seulement si le volume le justifie (chaque entrée couvre surtout son corps).
+        size_t nt = std::max(1u, threads);
+        if (n < kParallelMinOps) nt = 1;
+        nt = std::min(nt, entries.size());
+
+        std::atomic<size_t> next{0};
+        std::atomic<bool> oom{false};
+        auto worker = [&] {
+            try {
+                Scratch s;
+                s.depth.assign(static_cast<size_t>(n) + 1, -1);
+                for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < entries.size();) {
+                    res[i] = verify_entry(c, entries[i], s);
+                }
+            } catch (const std::bad_alloc&) {
+                oom.store(true, std::memory_order_relaxed);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < nt; ++t) {
+            try {
+                pool.emplace_back(worker);
+            } catch (const std::system_error&) {
+                break;   // moins de threads que demandé : le reste sur l’appelant
+            }
+        }
+        worker();
+        for (std::thread& t : pool) t.join();
+        rep.threads = static_cast<uint32_t>(pool.size() + 1);
+        if (oom.load()) {
+            rep.ok = false;
+            rep.what = "Mémoire insuffisante";
+            return rep;
+        }
+
+        rep.entries = static_cast<uint32_t>(entries.size());
+        for (size_t i = 0; i < res.size(); ++i) {
+            if (res[i].what && rep.ok) {
+                rep.ok = false;
+                rep.entry = ids[i];
+                rep.pc = res[i].pc;
+                rep.what = res[i].what;
+            }
+            rep.max_stack = std::max(rep.max_stack, res[i].max_stack);
+        }
+    } catch (const std::bad_alloc&) {
+        rep.ok = false;
+        rep.what = "Mémoire insuffisante";
+    }
+    return rep;
+}
+
+} // namespace vt::vm
+
+#endif // VITTE_NATIVE_VM_VERIFY_HPP
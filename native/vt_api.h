@@ -0,0 +1,25 @@
+// native/vt_api.h
+// Macros communes aux modules natifs Vitte (C ABI stable pour FFI `extern(c)`).
+//
+// Chaque module natif de ce dossier expose ses symboles via VT_API et
+// encadre ses déclarations par VT_EXTERN_C_BEGIN / VT_EXTERN_C_END pour
+// rester consommable depuis C, C++ et le runtime Vitte.
+
+#ifndef VITTE_NATIVE_VT_API_H
+#define VITTE_NATIVE_VT_API_H
+
+#if defined(_WIN32)
+  #define VT_API __declspec(dllexport)
+#else
+  #define VT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+  #define VT_EXTERN_C_BEGIN extern "C" {
+  #define VT_EXTERN_C_END   }
+#else
+  #define VT_EXTERN_C_BEGIN
+  #define VT_EXTERN_C_END
+#endif
+
+#endif // VITTE_NATIVE_VT_API_H
@@ -0,0 +1,103 @@
+// native/vt_native.cpp
+// Registre global des natives (cf. vt_native.h) : table append-only + index par nom.
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vt_native.cpp -o build/vt_native.o
+//
+// Remarques :
+// - std::deque : les entrées (et leurs noms) ne bougent jamais, vt_native_info.name reste
+//   valide sans copie.
+// - Le hachage du nom n’a lieu qu’à l’enregistrement et à la résolution des imports.
+
+#include "vt_native.h"
+
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vt_nat {
+
+struct Entry {
+    std::string name;
+    vt_native_fn fn;
+    void* user;
+    int32_t arity;
+    uint32_t flags;
+};
+
+struct Registry {
+    std::mutex mu;
+    std::deque<Entry> entries;
+    std::unordered_map<std::string_view, int> by_name;   // vues sur entries[i].name
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+} // namespace vt_nat
+
+VT_EXTERN_C_BEGIN
+
+VT_API int vt_register_native_ex(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags,
+                                 void* user) {
+    if (!name || !*name || !fn || arity < VT_NATIVE_VARIADIC) return VT_NATIVE_E_ARG;
+    vt_nat::Registry& r = vt_nat::registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    try {
+        const auto it = r.by_name.find(std::string_view(name));
+        if (it != r.by_name.end()) {
+            if (!(flags & VT_NATIVE_REPLACE)) return VT_NATIVE_E_EXISTS;
+            vt_nat::Entry& e = r.entries[static_cast<size_t>(it->second)];
+            e.fn = fn;
+            e.user = user;
+            e.arity = arity;
+            e.flags = flags & ~VT_NATIVE_REPLACE;
+            return it->second;
+        }
+        const int idx = static_cast<int>(r.entries.size());
+        r.entries.push_back(vt_nat::Entry{name, fn, user, arity, flags & ~VT_NATIVE_REPLACE});
+        try {
+            r.by_name.emplace(r.entries.back().name, idx);
+        } catch (...) {
+            r.entries.pop_back();
+            throw;
+        }
+        return idx;
+    } catch (const std::bad_alloc&) {
+        return VT_NATIVE_E_NOMEM;
+    }
+}
+
+VT_API int vt_register_native(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags) {
+    return vt_register_native_ex(name, fn, arity, flags, nullptr);
+}
+
+VT_API int vt_native_find(const char* name) {
+    if (!name) return VT_NATIVE_E_NOTFOUND;
+    vt_nat::Registry& r = vt_nat::registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    const auto it = r.by_name.find(std::string_view(name));
+    return it == r.by_name.end() ? VT_NATIVE_E_NOTFOUND : it->second;
+}
+
+VT_API int vt_native_get(int idx, vt_native_info* out) {
+    vt_nat::Registry& r = vt_nat::registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    if (idx < 0 || static_cast<size_t>(idx) >= r.entries.size() || !out) return VT_NATIVE_E_NOTFOUND;
+    const vt_nat::Entry& e = r.entries[static_cast<size_t>(idx)];
+    *out = vt_native_info{e.name.c_str(), e.fn, e.user, e.arity, e.flags};
+    return 0;
+}
+
+VT_API size_t vt_native_count(void) {
+    vt_nat::Registry& r = vt_nat::registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    return r.entries.size();
+}
+
+VT_EXTERN_C_END
@@ -0,0 +1,88 @@
+// native/vt_native.h
+// Registre des fonctions natives (hôte C/C++ → bytecode) : un nom, un pointeur de fonction,
+// une arité. Le registre est global au processus ; chaque programme chargé (vm_interp)
+// résout UNE fois ses imports contre lui et garde sa propre table indexée. Un appel chaud
+// devient alors un index de tableau + un appel indirect, sans hachage ni conversion :
+// la native reçoit directement la tranche de pile (`const vt_value*`, cf. vt_value.h).
+//
+// API C exposée (ABI stable pour FFI):
+//   int  vt_register_native(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags);
+//   int  vt_register_native_ex(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags,
+//                              void* user);
+//   int  vt_native_find(const char* name);
+//   int  vt_native_get(int idx, vt_native_info* out);
+//   size_t vt_native_count(void);
+//
+// Exemple (backend Qt) :
+//   static int qt_title(void* user, const vt_value* a, size_t n, vt_value* ret) {
+//       size_t len;
+//       const char* s = vt_value_str_view(a[0], &len);
+//       if (!s) return -1;
+//       static_cast<QWidget*>(user)->setWindowTitle(QString::fromUtf8(s, (int)len));
+//       return 0;   // *ret vaut null par défaut
+//   }
+//   vt_register_native_ex("ui.set_title", qt_title, 1, 0, window);
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vt_native.cpp -o build/vt_native.o
+//
+// Remarques :
+// - Côté chunk, un import est une entrée de debug.symbols de pc 0xFFFFFFFF (VT_NATIVE_IMPORT_PC) :
+//   son FuncIx s’appelle comme une fonction du programme (MakeClosure f 0 ; Call n).
+// - Indices stables pour la vie du processus ; enregistrer avant de charger les programmes
+//   qui importent. Remplacer une native (VT_NATIVE_REPLACE) ne touche pas les programmes
+//   déjà chargés.
+// - Valeur de retour : *ret (null par défaut) ; un objet compté rendu est possédé par la VM
+//   jusqu’à son prochain run. Arguments empruntés (vt_value_retain pour les garder).
+// - Une native ne doit pas relancer vt_vm_run sur le vt_vm qui l’appelle.
+// - Enregistrement thread-safe (verrou) ; le chemin d’appel ne consulte jamais le registre.
+
+#ifndef VITTE_NATIVE_VT_NATIVE_H
+#define VITTE_NATIVE_VT_NATIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vt_api.h"
+#include "vt_value.h"
+
+VT_EXTERN_C_BEGIN
+
+// 0 : succès ; autre : échec (le run s’arrête avec VT_VM_E_NATIVE).
+typedef int (*vt_native_fn)(void* user, const vt_value* args, size_t argc, vt_value* ret);
+
+#define VT_NATIVE_VARIADIC (-1)
+#define VT_NATIVE_IMPORT_PC 0xFFFFFFFFu
+
+enum {
+    VT_NATIVE_REPLACE = 1u << 0,   // remplace une native du même nom (même indice)
+    VT_NATIVE_PURE = 1u << 1,      // sans effet de bord (indication pour les optimiseurs)
+};
+
+enum {
+    VT_NATIVE_E_ARG = -1,          // nom/fonction nuls, arité < -1
+    VT_NATIVE_E_EXISTS = -2,       // nom déjà pris (sans VT_NATIVE_REPLACE)
+    VT_NATIVE_E_NOTFOUND = -3,
+    VT_NATIVE_E_NOMEM = -4,
+};
+
+typedef struct vt_native_info {
+    const char* name;              // stable pour la vie du processus
+    vt_native_fn fn;
+    void* user;
+    int32_t arity;                 // VT_NATIVE_VARIADIC : libre
+    uint32_t flags;
+} vt_native_info;
+
+// Indice (>= 0) ou VT_NATIVE_E_*.
+VT_API int vt_register_native(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags);
+VT_API int vt_register_native_ex(const char* name, vt_native_fn fn, int32_t arity, uint32_t flags,
+                                 void* user);
+
+VT_API int    vt_native_find(const char* name);   // indice ou VT_NATIVE_E_NOTFOUND
+VT_API int    vt_native_get(int idx, vt_native_info* out);
+VT_API size_t vt_native_count(void);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_VT_NATIVE_H
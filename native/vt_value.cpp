@@ -0,0 +1,130 @@
+// native/vt_value.cpp
+// Objets comptés de vt_value.h : allocation en un bloc (en-tête + charge utile), compteur
+// atomique, libération récursive des tableaux.
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vt_value.cpp -o build/vt_value.o
+//
+// Remarques :
+// - Chaînes et octets sont copiés derrière l’en-tête : un seul malloc, data pointe dedans.
+// - Les objets statiques (constantes, tas de fermetures de la VM) ne sont jamais libérés ici.
+
+#include "vt_value.h"
+#include "vm_value.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace vt_val {
+
+template <class T> T* alloc_obj(uint8_t kind, size_t extra) {
+    void* m = std::malloc(sizeof(T) + extra);
+    if (!m) return nullptr;
+    T* o = static_cast<T*>(m);
+    o->h = vt_obj{1, kind, 0, 0};
+    return o;
+}
+
+vt_value make_bytes(uint8_t kind, const void* p, size_t n) {
+    auto* s = alloc_obj<vt_str>(kind, n);
+    if (!s) return VT_VALUE_NULL;
+    char* d = reinterpret_cast<char*>(s + 1);
+    if (n) std::memcpy(d, p, n);
+    s->data = d;
+    s->len = n;
+    return vt_value_from_obj(&s->h);
+}
+
+std::atomic_ref<uint32_t> rc_of(vt_obj* o) { return std::atomic_ref<uint32_t>(o->rc); }
+
+void drop(vt_obj* o) {
+    switch (o->kind) {
+    case VT_OBJ_ARRAY: {
+        const auto* a = reinterpret_cast<const vt_array*>(o);
+        for (size_t i = 0; i < a->len; ++i) vt_value_release(a->items[i]);
+        break;
+    }
+    case VT_OBJ_FOREIGN: {
+        const auto* f = reinterpret_cast<const vt_foreign*>(o);
+        if (f->drop) f->drop(f->ptr);
+        break;
+    }
+    default: break;
+    }
+    std::free(o);
+}
+
+} // namespace vt_val
+
+// Le moteur natif manipule les mêmes mots et les mêmes en-têtes.
+static_assert(sizeof(vt_value) == sizeof(vt::vm::Value));
+static_assert(VT_VALUE_TAG_INT == vt::vm::TAG_INT && VT_VALUE_TAG_OBJ == vt::vm::TAG_OBJ);
+static_assert(VT_VALUE_NULL == vt::vm::V_NULL && VT_VALUE_TRUE == vt::vm::V_TRUE);
+static_assert(VT_OBJ_STR == static_cast<int>(vt::vm::ObjKind::Str));
+static_assert(VT_OBJ_BYTES == static_cast<int>(vt::vm::ObjKind::Bytes));
+static_assert(VT_OBJ_CLOSURE == static_cast<int>(vt::vm::ObjKind::Closure));
+static_assert(sizeof(vt_obj) == sizeof(vt::vm::Obj));
+static_assert(sizeof(vt_str) == sizeof(vt::vm::StrObj));
+
+VT_EXTERN_C_BEGIN
+
+VT_API vt_value vt_value_str(const char* s, size_t n) { return vt_val::make_bytes(VT_OBJ_STR, s, n); }
+
+VT_API vt_value vt_value_bytes(const uint8_t* p, size_t n) { return vt_val::make_bytes(VT_OBJ_BYTES, p, n); }
+
+VT_API vt_value vt_value_array(const vt_value* items, size_t n) {
+    auto* a = vt_val::alloc_obj<vt_array>(VT_OBJ_ARRAY, n * sizeof(vt_value));
+    if (!a) return VT_VALUE_NULL;
+    auto* d = reinterpret_cast<vt_value*>(a + 1);
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = items[i];
+        vt_value_retain(items[i]);
+    }
+    a->items = d;
+    a->len = n;
+    return vt_value_from_obj(&a->h);
+}
+
+VT_API vt_value vt_value_foreign(void* ptr, vt_foreign_drop_fn drop) {
+    auto* f = vt_val::alloc_obj<vt_foreign>(VT_OBJ_FOREIGN, 0);
+    if (!f) {
+        if (drop) drop(ptr);
+        return VT_VALUE_NULL;
+    }
+    f->ptr = ptr;
+    f->drop = drop;
+    return vt_value_from_obj(&f->h);
+}
+
+// Le test statique lit le compteur pendant que d’autres threads le modifient : lecture
+// atomique relaxée (un compteur vivant n’atteint jamais VT_OBJ_STATIC).
+VT_API void vt_value_retain(vt_value v) {
+    vt_obj* o = vt_value_as_obj(v);
+    if (!o) return;
+    auto rc = vt_val::rc_of(o);
+    if (rc.load(std::memory_order_relaxed) == VT_OBJ_STATIC) return;
+    rc.fetch_add(1, std::memory_order_relaxed);
+}
+
+VT_API void vt_value_release(vt_value v) {
+    vt_obj* o = vt_value_as_obj(v);
+    if (!o) return;
+    auto rc = vt_val::rc_of(o);
+    if (rc.load(std::memory_order_relaxed) == VT_OBJ_STATIC) return;
+    if (rc.fetch_sub(1, std::memory_order_acq_rel) == 1) vt_val::drop(o);
+}
+
+VT_API int vt_value_equal(vt_value a, vt_value b) {
+    const vt_array* x = vt_value_as_array(a);
+    const vt_array* y = vt_value_as_array(b);
+    if (!x || !y) return vt::vm::values_eq(a, b);
+    if (x->len != y->len) return 0;
+    for (size_t i = 0; i < x->len; ++i) {
+        if (!vt_value_equal(x->items[i], y->items[i])) return 0;
+    }
+    return 1;
+}
+
+VT_EXTERN_C_END
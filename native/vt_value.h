@@ -0,0 +1,211 @@
+// native/vt_value.h
+// Valeur C ABI de Vitte : un mot de 64 bits NaN-boxé, partagé tel quel par le moteur natif
+// (vm_interp), l’hôte desktop, les modules natifs et les embarquements C/C++. Les immédiats
+// (null, booléens, entiers 48 bits, doubles) tiennent dans le mot ; un objet est un pointeur
+// vers un en-tête compté (vt_obj) suivi de sa charge utile. Une fonction native reçoit ses
+// arguments en `const vt_value*` + longueur, sans conversion ni allocation.
+//
+// Codage (u64) — identique à vm_value.hpp :
+//   double          tel quel (tout motif < 0xFFF9 << 48 ; NaN canonique 0x7FF8…)
+//   0xFFF9 | i48    entier signé 48 bits
+//   0xFFFA | 0/1/2  null / false / true
+//   0xFFFB | ptr    objet (vt_obj*) — pointeur utilisateur 48 bits
+//   0xFFFC | idx    fonction du programme sans capture (FuncIx)
+//
+// API C exposée (ABI stable pour FFI):
+//   vt_value vt_value_str(const char* s, size_t n);
+//   vt_value vt_value_bytes(const uint8_t* p, size_t n);
+//   vt_value vt_value_array(const vt_value* items, size_t n);
+//   vt_value vt_value_foreign(void* ptr, vt_foreign_drop_fn drop);
+//   void     vt_value_retain(vt_value v);
+//   void     vt_value_release(vt_value v);
+//   int      vt_value_equal(vt_value a, vt_value b);
+//   (+ constructeurs/accesseurs inline : vt_value_int, vt_value_as_f64, vt_value_type, …)
+//
+// Build (exemples):
+//   g++ -std=c++20 -O2 -fPIC -c native/vt_value.cpp -o vt_value.o
+//
+// Remarques :
+// - Propriété : un constructeur rend une référence (rc = 1), libérée par vt_value_release.
+//   Un span `const vt_value*` passé à une native est emprunté : vt_value_retain pour garder
+//   une valeur au-delà de l’appel. Les immédiats ignorent retain/release.
+// - Objets statiques (rc == VT_OBJ_STATIC) : constantes d’un programme chargé, fermetures du
+//   tas de la VM ; retain/release sans effet, durée de vie celle du programme / du run (une
+//   fermeture peut être déplacée par une collecte : ne pas garder son adresse).
+// - Compteur atomique : une valeur peut changer de thread ; chaînes, octets et tableaux sont
+//   immuables après construction.
+// - Entiers hors 48 bits : double (exact jusqu’à 2^53), comme la VM ; vt_value_int le fait.
+
+#ifndef VITTE_NATIVE_VT_VALUE_H
+#define VITTE_NATIVE_VT_VALUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vt_api.h"
+
+VT_EXTERN_C_BEGIN
+
+typedef uint64_t vt_value;
+
+#define VT_VALUE_TAG_INT   ((uint64_t)0xFFF9 << 48)
+#define VT_VALUE_TAG_MISC  ((uint64_t)0xFFFA << 48)
+#define VT_VALUE_TAG_OBJ   ((uint64_t)0xFFFB << 48)
+#define VT_VALUE_TAG_FUNC  ((uint64_t)0xFFFC << 48)
+#define VT_VALUE_PAYLOAD   (((uint64_t)1 << 48) - 1)
+
+#define VT_VALUE_NULL   (VT_VALUE_TAG_MISC | 0)
+#define VT_VALUE_FALSE  (VT_VALUE_TAG_MISC | 1)
+#define VT_VALUE_TRUE   (VT_VALUE_TAG_MISC | 2)
+#define VT_VALUE_NAN    ((uint64_t)0x7FF8000000000000)
+
+// Type observable (vt_value_type) ; 0..6 coïncident avec VT_VM_NULL…VT_VM_FUNC.
+enum {
+    VT_TYPE_NULL = 0,
+    VT_TYPE_BOOL = 1,
+    VT_TYPE_INT = 2,
+    VT_TYPE_FLOAT = 3,
+    VT_TYPE_STR = 4,
+    VT_TYPE_BYTES = 5,
+    VT_TYPE_FUNC = 6,      // FuncIx ou fermeture
+    VT_TYPE_ARRAY = 7,
+    VT_TYPE_FOREIGN = 8,
+};
+
+// vt_obj.kind
+enum {
+    VT_OBJ_STR = 0,
+    VT_OBJ_BYTES = 1,
+    VT_OBJ_CLOSURE = 2,    // interne à la VM (charge utile opaque)
+    VT_OBJ_ARRAY = 3,
+    VT_OBJ_FOREIGN = 4,
+};
+
+#define VT_OBJ_STATIC 0xFFFFFFFFu
+
+// En-tête commun (8 octets) ; la charge utile suit, alignée sur 8.
+typedef struct vt_obj {
+    uint32_t rc;       // références, ou VT_OBJ_STATIC
+    uint8_t kind;      // VT_OBJ_*
+    uint8_t flags;     // 0 hors VM ; bits du tas de fermetures (vm_gc.hpp)
+    uint16_t aux;      // réservé (0)
+} vt_obj;
+
+// Chaîne UTF-8 ou octets (pas de terminaison NUL garantie).
+typedef struct vt_str {
+    vt_obj h;
+    const char* data;
+    size_t len;
+} vt_str;
+
+typedef struct vt_array {
+    vt_obj h;
+    const vt_value* items;   // références détenues par le tableau
+    size_t len;
+} vt_array;
+
+typedef void (*vt_foreign_drop_fn)(void* ptr);
+
+// Poignée hôte opaque (widget Qt, fichier…) ; drop appelé à la dernière référence.
+typedef struct vt_foreign {
+    vt_obj h;
+    void* ptr;
+    vt_foreign_drop_fn drop;
+} vt_foreign;
+
+// --- Immédiats -------------------------------------------------------------------------
+
+static inline vt_value vt_value_bool(int b) { return b ? VT_VALUE_TRUE : VT_VALUE_FALSE; }
+
+static inline vt_value vt_value_f64(double d) {
+    vt_value v;
+    if (d != d) return VT_VALUE_NAN;
+    memcpy(&v, &d, 8);
+    return v;
+}
+
+static inline vt_value vt_value_int(int64_t i) {
+    if (i >= -((int64_t)1 << 47) && i < ((int64_t)1 << 47)) return VT_VALUE_TAG_INT | ((uint64_t)i & VT_VALUE_PAYLOAD);
+    return vt_value_f64((double)i);
+}
+
+static inline int vt_value_is_f64(vt_value v) { return v < VT_VALUE_TAG_INT; }
+static inline int vt_value_is_int(vt_value v) { return (v >> 48) == 0xFFF9; }
+static inline int vt_value_is_num(vt_value v) { return v <= (VT_VALUE_TAG_INT | VT_VALUE_PAYLOAD); }
+static inline int vt_value_is_null(vt_value v) { return v == VT_VALUE_NULL; }
+static inline int vt_value_is_bool(vt_value v) { return v - VT_VALUE_FALSE <= 1; }
+static inline int vt_value_is_obj(vt_value v) { return (v >> 48) == 0xFFFB; }
+static inline int vt_value_truthy(vt_value v) { return v != VT_VALUE_FALSE && v != VT_VALUE_NULL; }
+
+static inline int64_t vt_value_as_int(vt_value v) { return (int64_t)(v << 16) >> 16; }
+
+static inline double vt_value_as_f64(vt_value v) {
+    double d;
+    memcpy(&d, &v, 8);
+    return d;
+}
+
+// Entier ou double, en double.
+static inline double vt_value_as_num(vt_value v) {
+    return vt_value_is_int(v) ? (double)vt_value_as_int(v) : vt_value_as_f64(v);
+}
+
+// --- Objets ----------------------------------------------------------------------------
+
+static inline vt_obj* vt_value_as_obj(vt_value v) {
+    return vt_value_is_obj(v) ? (vt_obj*)(uintptr_t)(v & VT_VALUE_PAYLOAD) : NULL;
+}
+
+static inline vt_value vt_value_from_obj(const vt_obj* o) { return VT_VALUE_TAG_OBJ | (uint64_t)(uintptr_t)o; }
+
+static inline int vt_value_type(vt_value v) {
+    const vt_obj* o;
+    if (vt_value_is_int(v)) return VT_TYPE_INT;
+    if (vt_value_is_f64(v)) return VT_TYPE_FLOAT;
+    if (v == VT_VALUE_NULL) return VT_TYPE_NULL;
+    if (vt_value_is_bool(v)) return VT_TYPE_BOOL;
+    if ((v >> 48) == 0xFFFC) return VT_TYPE_FUNC;
+    o = vt_value_as_obj(v);
+    switch (o->kind) {
+    case VT_OBJ_STR: return VT_TYPE_STR;
+    case VT_OBJ_BYTES: return VT_TYPE_BYTES;
+    case VT_OBJ_ARRAY: return VT_TYPE_ARRAY;
+    case VT_OBJ_FOREIGN: return VT_TYPE_FOREIGN;
+    default: return VT_TYPE_FUNC;
+    }
+}
+
+// Vue sur une chaîne ou des octets ; NULL sinon.
+static inline const char* vt_value_str_view(vt_value v, size_t* n) {
+    const vt_obj* o = vt_value_as_obj(v);
+    if (!o || (o->kind != VT_OBJ_STR && o->kind != VT_OBJ_BYTES)) return NULL;
+    if (n) *n = ((const vt_str*)o)->len;
+    return ((const vt_str*)o)->data;
+}
+
+static inline const vt_array* vt_value_as_array(vt_value v) {
+    const vt_obj* o = vt_value_as_obj(v);
+    return o && o->kind == VT_OBJ_ARRAY ? (const vt_array*)o : NULL;
+}
+
+static inline void* vt_value_foreign_ptr(vt_value v) {
+    const vt_obj* o = vt_value_as_obj(v);
+    return o && o->kind == VT_OBJ_FOREIGN ? ((const vt_foreign*)o)->ptr : NULL;
+}
+
+// Constructeurs : VT_VALUE_NULL si l’allocation échoue.
+VT_API vt_value vt_value_str(const char* s, size_t n);
+VT_API vt_value vt_value_bytes(const uint8_t* p, size_t n);
+VT_API vt_value vt_value_array(const vt_value* items, size_t n);   // retient chaque élément
+VT_API vt_value vt_value_foreign(void* ptr, vt_foreign_drop_fn drop);
+
+VT_API void vt_value_retain(vt_value v);
+VT_API void vt_value_release(vt_value v);
+
+// Égalité de la VM (Eq) : chaînes par contenu, entier ≠ flottant ; tableaux élément à élément.
+VT_API int vt_value_equal(vt_value a, vt_value b);
+
+VT_EXTERN_C_END
+
+#endif // VITTE_NATIVE_VT_VALUE_H
@@ -0,0 +1,161 @@
+// native/zstd_dl.hpp
+// libzstd chargée à l’exécution (dlopen "libzstd.so.1", LoadLibrary "zstd.dll") : pas de
+// zstd.h ni de -lzstd à la compilation. Seules quelques fonctions de l’API stable sont
+// déclarées ici ; utilisé par vitbc_zstd.cpp et vitbc_pack.cpp. Header-only.
+//
+// Usage :
+//   const vt::zstd_dl::Api* z = vt::zstd_dl::api();   // nullptr : libzstd introuvable
+//   void* c = z->createCCtx();
+//   size_t r = z->compressCCtx(c, dst, cap, src, n, 10);
+//   if (z->isError(r)) { /* z->getErrorName(r) */ }
+//
+// Remarques :
+// - Résolution une fois (premier appel, sûre entre threads) ; la bibliothèque reste chargée
+//   jusqu’à la fin du processus.
+// - Contextes opaques (void*) : ZSTD_CCtx / ZSTD_DCtx / ZSTD_CDict / ZSTD_DDict.
+// - ZDICT_* facultatives (libzstd sans dictBuilder) : ZDICT_trainFromBuffer == nullptr.
+
+#ifndef VITTE_NATIVE_ZSTD_DL_HPP
+#define VITTE_NATIVE_ZSTD_DL_HPP
+
+#include <cstddef>
+#include <initializer_list>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace vt::zstd_dl {
+
+struct InBuf {   // ZSTD_inBuffer
+    const void* src;
+    size_t size;
+    size_t pos;
+};
+
+struct OutBuf {   // ZSTD_outBuffer
+    void* dst;
+    size_t size;
+    size_t pos;
+};
+
+// Valeurs de zstd.h (API stable).
+inline constexpr int kCompressionLevel = 100;   // ZSTD_c_compressionLevel
+inline constexpr int kContentSizeFlag = 200;    // ZSTD_c_contentSizeFlag
+inline constexpr int kChecksumFlag = 201;       // ZSTD_c_checksumFlag
+inline constexpr int kEndContinue = 0;          // ZSTD_e_continue
+inline constexpr int kEndFlush = 1;             // ZSTD_e_flush
+inline constexpr int kEndFrame = 2;             // ZSTD_e_end
+inline constexpr int kResetSession = 1;         // ZSTD_reset_session_only
+inline constexpr unsigned long long kContentSizeUnknown = 0ULL - 1;   // ZSTD_CONTENTSIZE_UNKNOWN
+inline constexpr unsigned long long kContentSizeError = 0ULL - 2;     // ZSTD_CONTENTSIZE_ERROR
+
+struct Api {
+    size_t (*compressBound)(size_t);
+    unsigned (*isError)(size_t);
+    const char* (*getErrorName)(size_t);
+
+    void* (*createCCtx)();
+    size_t (*freeCCtx)(void*);
+    size_t (*compressCCtx)(void*, void*, size_t, const void*, size_t, int);
+    size_t (*CCtx_setParameter)(void*, int, int);
+    size_t (*CCtx_reset)(void*, int);
+    size_t (*compressStream2)(void*, OutBuf*, InBuf*, int);
+    size_t (*CStreamInSize)();
+    size_t (*CStreamOutSize)();
+
+    void* (*createDCtx)();
+    size_t (*freeDCtx)(void*);
+    size_t (*decompressDCtx)(void*, void*, size_t, const void*, size_t);
+    size_t (*decompressStream)(void*, OutBuf*, InBuf*);
+    size_t (*DCtx_reset)(void*, int);
+    size_t (*DStreamInSize)();
+    size_t (*DStreamOutSize)();
+
+    // Dictionnaires (CDict : niveau figé à la création).
+    void* (*createCDict)(const void*, size_t, int);
+    size_t (*freeCDict)(void*);
+    size_t (*CCtx_refCDict)(void*, const void*);
+    size_t (*compress_usingCDict)(void*, void*, size_t, const void*, size_t, const void*);
+    void* (*createDDict)(const void*, size_t);
+    size_t (*freeDDict)(void*);
+    size_t (*DCtx_refDDict)(void*, const void*);
+    size_t (*decompress_usingDDict)(void*, void*, size_t, const void*, size_t, const void*);
+    unsigned (*getDictID_fromDict)(const void*, size_t);
+    unsigned (*getDictID_fromFrame)(const void*, size_t);
+    unsigned long long (*getFrameContentSize)(const void*, size_t);   // 0 : trame skippable
+
+    // Entraînement (ZDICT_*) : nullptr si la bibliothèque est compilée sans dictBuilder.
+    size_t (*ZDICT_trainFromBuffer)(void*, size_t, const void*, const size_t*, unsigned);
+    unsigned (*ZDICT_isError)(size_t);
+    const char* (*ZDICT_getErrorName)(size_t);
+};
+
+namespace detail {
+
+template <class F>
+inline bool bind(void* lib, const char* name, F& f) {
+#if defined(_WIN32)
+    f = reinterpret_cast<F>(reinterpret_cast<void*>(::GetProcAddress(static_cast<HMODULE>(lib), name)));
+#else
+    f = reinterpret_cast<F>(::dlsym(lib, name));
+#endif
+    return f != nullptr;
+}
+
+inline void* open_lib() {
+#if defined(_WIN32)
+    for (const char* n : {"zstd.dll", "libzstd.dll"}) {
+        if (HMODULE h = ::LoadLibraryA(n)) return h;
+    }
+#else
+    for (const char* n : {"libzstd.so.1", "libzstd.so", "libzstd.1.dylib", "libzstd.dylib"}) {
+        if (void* h = ::dlopen(n, RTLD_NOW | RTLD_LOCAL)) return h;
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace detail
+
+inline const Api* api() {
+    static const Api* z = []() -> const Api* {
+        void* lib = detail::open_lib();
+        if (!lib) return nullptr;
+        static Api s;
+        using detail::bind;
+        const bool ok =
+            bind(lib, "ZSTD_compressBound", s.compressBound) && bind(lib, "ZSTD_isError", s.isError) &&
+            bind(lib, "ZSTD_getErrorName", s.getErrorName) && bind(lib, "ZSTD_createCCtx", s.createCCtx) &&
+            bind(lib, "ZSTD_freeCCtx", s.freeCCtx) && bind(lib, "ZSTD_compressCCtx", s.compressCCtx) &&
+            bind(lib, "ZSTD_CCtx_setParameter", s.CCtx_setParameter) && bind(lib, "ZSTD_CCtx_reset", s.CCtx_reset) &&
+            bind(lib, "ZSTD_compressStream2", s.compressStream2) && bind(lib, "ZSTD_CStreamInSize", s.CStreamInSize) &&
+            bind(lib, "ZSTD_CStreamOutSize", s.CStreamOutSize) && bind(lib, "ZSTD_createDCtx", s.createDCtx) &&
+            bind(lib, "ZSTD_freeDCtx", s.freeDCtx) && bind(lib, "ZSTD_decompressDCtx", s.decompressDCtx) &&
+            bind(lib, "ZSTD_decompressStream", s.decompressStream) && bind(lib, "ZSTD_DCtx_reset", s.DCtx_reset) &&
+            bind(lib, "ZSTD_DStreamInSize", s.DStreamInSize) && bind(lib, "ZSTD_DStreamOutSize", s.DStreamOutSize) &&
+            bind(lib, "ZSTD_createCDict", s.createCDict) && bind(lib, "ZSTD_freeCDict", s.freeCDict) &&
+            bind(lib, "ZSTD_CCtx_refCDict", s.CCtx_refCDict) &&
+            bind(lib, "ZSTD_compress_usingCDict", s.compress_usingCDict) &&
+            bind(lib, "ZSTD_createDDict", s.createDDict) && bind(lib, "ZSTD_freeDDict", s.freeDDict) &&
+            bind(lib, "ZSTD_DCtx_refDDict", s.DCtx_refDDict) &&
+            bind(lib, "ZSTD_decompress_usingDDict", s.decompress_usingDDict) &&
+            bind(lib, "ZSTD_getDictID_fromDict", s.getDictID_fromDict) &&
+            bind(lib, "ZSTD_getDictID_fromFrame", s.getDictID_fromFrame) &&
+            bind(lib, "ZSTD_getFrameContentSize", s.getFrameContentSize);
+        if (ok && !(bind(lib, "ZDICT_trainFromBuffer", s.ZDICT_trainFromBuffer) &&
+                    bind(lib, "ZDICT_isError", s.ZDICT_isError) && bind(lib, "ZDICT_getErrorName", s.ZDICT_getErrorName)))
+            s.ZDICT_trainFromBuffer = nullptr;
+        return ok ? &s : nullptr;
+    }();
+    return z;
+}
+
+} // namespace vt::zstd_dl
+
+#endif // VITTE_NATIVE_ZSTD_DL_HPP